@@ -28,8 +28,20 @@ namespace stingray
 	{ _connection = _timer->SetTimer(ReportBandwidthTimeout, Bind(&BandwidthReporter::Report, this)); }
 
 
+	BandwidthReporter::BandwidthReporter(const std::string& name, const ITimerPtr& timer, const optional<OccupancyGetter>& occupancyGetter)
+		:	_name(name),
+			_occupancyGetter(occupancyGetter),
+			_dataTotal(0),
+			_dataSinceLastReport(0),
+			_timer(STINGRAYKIT_REQUIRE_NOT_NULL(timer))
+	{ _connection = _timer->SetTimer(ReportBandwidthTimeout, Bind(&BandwidthReporter::Report, this)); }
+
+
 	void BandwidthReporter::Read(IDataConsumer& consumer, const ICancellationToken& token)
-	{ _source->ReadToFunction(Bind(&BandwidthReporter::DoPush, this, wrap_ref(consumer), _1, _2), Bind(&IDataConsumer::EndOfData, wrap_ref(consumer), _1), token); }
+	{
+		STINGRAYKIT_CHECK(_source, InvalidOperationException("Reporter has no source"));
+		_source->ReadToFunction(Bind(&BandwidthReporter::DoPush, this, wrap_ref(consumer), _1, _2), Bind(&IDataConsumer::EndOfData, wrap_ref(consumer), _1), token);
+	}
 
 
 	void BandwidthReporter::Report()
@@ -38,7 +50,14 @@ namespace stingray
 
 		const u64 speedInKbytes = (_dataSinceLastReport * 1000 / _timeSinceLastReport.ElapsedMilliseconds()) / 1024;
 
-		Logger::Info() << "Data: " << _dataSinceLastReport << " total: " << _dataTotal << " avg speed: " << speedInKbytes << " KB/s";
+		LoggerStream logStream(Logger::Info());
+		if (!_name.empty())
+			logStream << _name << ": ";
+
+		logStream << "Data: " << _dataSinceLastReport << " total: " << _dataTotal << " avg speed: " << speedInKbytes << " KB/s";
+
+		if (_occupancyGetter)
+			logStream << " occupancy: " << (*_occupancyGetter)();
 
 		_dataSinceLastReport = 0;
 		_timeSinceLastReport.Restart();
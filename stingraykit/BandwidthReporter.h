@@ -15,30 +15,43 @@
 namespace stingray
 {
 
+	/**
+	 * @brief Periodically logs amount of data passed through and average speed
+	 * @details Either wraps a data source, or is fed by BytesProcessed and reports on a timer shared with other reporters.
+	 * In the latter case an optional occupancy getter is queried on each report, e.g. to log queue fill level.
+	 */
 	class BandwidthReporter final : public virtual IDataSource
 	{
+	public:
+		using OccupancyGetter = function<size_t ()>;
+
 	private:
-		IDataSourcePtr			_source;
+		IDataSourcePtr				_source;
+		std::string					_name;
+		optional<OccupancyGetter>	_occupancyGetter;
 
-		Mutex					_mutex;
-		u64						_dataTotal;
-		u64						_dataSinceLastReport;
-		ElapsedTime				_timeSinceLastReport;
+		Mutex						_mutex;
+		u64							_dataTotal;
+		u64							_dataSinceLastReport;
+		ElapsedTime					_timeSinceLastReport;
 
-		ITimerPtr				_timer;
-		Token					_connection;
+		ITimerPtr					_timer;
+		Token						_connection;
 
 	public:
 		BandwidthReporter(const IDataSourcePtr& source, const std::string& timerName);
+		BandwidthReporter(const std::string& name, const ITimerPtr& timer, const optional<OccupancyGetter>& occupancyGetter = null);
 
 		void Read(IDataConsumer& consumer, const ICancellationToken& token) override;
 
+		void BytesProcessed(size_t bytesCount);
+
 	private:
 		void Report();
 
 		size_t DoPush(IDataConsumer& consumer, ConstByteData data, const ICancellationToken& token);
-		void BytesProcessed(size_t bytesCount);
 	};
+	STINGRAYKIT_DECLARE_PTR(BandwidthReporter);
 
 }
 
@@ -0,0 +1,286 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/RecyclingObjectPool.h>
+
+#include <stingraykit/thread/posix/ThreadLocal.h>
+
+#include <algorithm>
+
+namespace stingray
+{
+
+	namespace Detail
+	{
+
+		namespace
+		{
+
+			const size_t CacheEntriesCount = 4;
+			const u32 MaxCachedObjects = 64;
+
+			const u64 IndexMask = 0xFFFFFFFF;
+
+			AtomicU64::Type s_coreIdCounter = 0;
+
+
+			size_t AlignUp(size_t size, size_t alignment)
+			{ return (size + alignment - 1) / alignment * alignment; }
+
+			u64 MakeHead(u64 oldHead, u32 index)
+			{ return ((oldHead >> 32) + 1) << 32 | index; }
+
+
+			class ThreadCache
+			{
+				STINGRAYKIT_NONCOPYABLE(ThreadCache);
+
+			private:
+				struct Entry
+				{
+					u64							CoreId;
+					RecyclingPoolCoreWeakPtr	Core;
+					u32							First;
+					u32							Count;
+
+					Entry() : CoreId(), First(RecyclingPoolCore::NullIndex), Count()
+					{ }
+				};
+
+			private:
+				Entry			_entries[CacheEntriesCount];
+				size_t			_nextVictim;
+
+			public:
+				ThreadCache() : _nextVictim()
+				{ }
+
+				~ThreadCache()
+				{
+					for (size_t i = 0; i < CacheEntriesCount; ++i)
+						Flush(_entries[i]);
+				}
+
+				void* Pop(const RecyclingPoolCorePtr& core)
+				{
+					Entry* const entry = Find(core->GetId());
+					if (!entry || entry->Count == 0)
+						return core->Pop();
+
+					const u32 index = entry->First;
+					entry->First = core->GetNext(index);
+					--entry->Count;
+					return core->GetObject(index);
+				}
+
+				void Push(const RecyclingPoolCorePtr& core, void* object)
+				{
+					Entry* entry = Find(core->GetId());
+					if (!entry)
+						entry = &Acquire(core);
+
+					const u32 index = core->GetIndex(object);
+					core->SetNext(index, entry->First);
+					entry->First = index;
+
+					if (++entry->Count < MaxCachedObjects)
+						return;
+
+					u32 last = entry->First;
+					for (u32 i = 1; i < MaxCachedObjects / 2; ++i)
+						last = core->GetNext(last);
+
+					const u32 first = entry->First;
+					entry->First = core->GetNext(last);
+					entry->Count -= MaxCachedObjects / 2;
+					core->PushChain(first, last);
+				}
+
+			private:
+				Entry* Find(u64 coreId)
+				{
+					for (size_t i = 0; i < CacheEntriesCount; ++i)
+						if (_entries[i].CoreId == coreId)
+							return &_entries[i];
+					return null;
+				}
+
+				Entry& Acquire(const RecyclingPoolCorePtr& core)
+				{
+					Entry* victim = null;
+					for (size_t i = 0; i < CacheEntriesCount && !victim; ++i)
+						if (_entries[i].Count == 0 || _entries[i].Core.expired())
+							victim = &_entries[i];
+
+					if (!victim)
+					{
+						victim = &_entries[_nextVictim];
+						_nextVictim = (_nextVictim + 1) % CacheEntriesCount;
+					}
+
+					Flush(*victim);
+					victim->CoreId = core->GetId();
+					victim->Core = core;
+					return *victim;
+				}
+
+				static void Flush(Entry& entry)
+				{
+					// Objects of an already destroyed core were destroyed together with it
+					if (entry.Count != 0)
+						if (const RecyclingPoolCorePtr core = entry.Core.lock())
+						{
+							u32 last = entry.First;
+							while (core->GetNext(last) != RecyclingPoolCore::NullIndex)
+								last = core->GetNext(last);
+							core->PushChain(entry.First, last);
+						}
+
+					entry = Entry();
+				}
+			};
+
+
+			STINGRAYKIT_DECLARE_THREAD_LOCAL(ThreadCache, ThreadCacheHolder);
+			STINGRAYKIT_DEFINE_THREAD_LOCAL(ThreadCache, ThreadCacheHolder);
+
+		}
+
+
+		const u32 RecyclingPoolCore::NullIndex;
+
+
+		RecyclingPoolCore::RecyclingPoolCore(size_t objectSize, DestroyFunc* destroyFunc)
+			:	_id(AtomicU64::Inc(s_coreIdCounter)),
+				_nodeSize(AlignUp(sizeof(NodeHeader), alignof(std::max_align_t)) + AlignUp(objectSize, alignof(std::max_align_t))),
+				_objectOffset(AlignUp(sizeof(NodeHeader), alignof(std::max_align_t))),
+				_destroyFunc(destroyFunc),
+				_head(0),
+				_chunks(),
+				_allocated(0)
+		{ }
+
+
+		RecyclingPoolCore::~RecyclingPoolCore()
+		{
+			std::sort(_discarded.begin(), _discarded.end());
+
+			for (u32 index = 1; index <= _allocated; ++index)
+				if (!std::binary_search(_discarded.begin(), _discarded.end(), index))
+					_destroyFunc(GetObject(index));
+
+			for (size_t i = 0; i < MaxChunks; ++i)
+				::operator delete(_chunks[i]);
+		}
+
+
+		void* RecyclingPoolCore::Pop()
+		{
+			u64 head = AtomicU64::Load(_head);
+			while (true)
+			{
+				const u32 index = head & IndexMask;
+				if (index == NullIndex)
+					return null;
+
+				// Node memory is never freed while the core is alive, so reading 'next' of a node popped concurrently is harmless: tag makes CAS fail
+				const u64 newHead = MakeHead(head, GetNext(index));
+				const u64 prevHead = AtomicU64::CompareAndExchange(_head, head, newHead);
+				if (prevHead == head)
+					return GetObject(index);
+
+				head = prevHead;
+			}
+		}
+
+
+		void* RecyclingPoolCore::Grow()
+		{
+			MutexLock l(_growMutex);
+
+			if (!_discarded.empty())
+			{
+				const u32 index = _discarded.back();
+				_discarded.pop_back();
+				return GetObject(index);
+			}
+
+			STINGRAYKIT_CHECK(_allocated < (FirstChunkSize << (MaxChunks - 1)), std::bad_alloc());
+
+			const u32 index = _allocated + 1;
+			const size_t chunk = 31 - __builtin_clz((index - 1) / FirstChunkSize + 1);
+			if (!_chunks[chunk])
+				_chunks[chunk] = static_cast<u8*>(::operator new((FirstChunkSize << chunk) * _nodeSize));
+
+			_allocated = index;
+
+			NodeHeader* const header = reinterpret_cast<NodeHeader*>(GetNode(index));
+			header->Next = NullIndex;
+			header->Index = index;
+			return GetObject(index);
+		}
+
+
+		void RecyclingPoolCore::Discard(void* object)
+		{
+			MutexLock l(_growMutex);
+			_discarded.push_back(GetIndex(object));
+		}
+
+
+		void RecyclingPoolCore::PushChain(u32 first, u32 last)
+		{
+			u64 head = AtomicU64::Load(_head);
+			while (true)
+			{
+				SetNext(last, head & IndexMask);
+
+				const u64 prevHead = AtomicU64::CompareAndExchange(_head, head, MakeHead(head, first));
+				if (prevHead == head)
+					return;
+
+				head = prevHead;
+			}
+		}
+
+
+		size_t RecyclingPoolCore::GetAllocatedCount() const
+		{
+			MutexLock l(_growMutex);
+			return _allocated - _discarded.size();
+		}
+
+
+		u8* RecyclingPoolCore::GetNode(u32 index) const
+		{
+			const u32 offset = (index - 1) / FirstChunkSize + 1;
+			const size_t chunk = 31 - __builtin_clz(offset);
+			const size_t indexInChunk = (index - 1) - FirstChunkSize * ((1u << chunk) - 1);
+			return _chunks[chunk] + indexInChunk * _nodeSize;
+		}
+
+
+		void* RecyclingPoolThreadCache::Pop(const RecyclingPoolCorePtr& core)
+		{
+			if (ThreadCache* cache = ThreadCacheHolder::TryGet())
+				return cache->Pop(core);
+
+			return core->Pop();
+		}
+
+
+		void RecyclingPoolThreadCache::Push(const RecyclingPoolCorePtr& core, void* object)
+		{
+			if (ThreadCache* cache = ThreadCacheHolder::TryGet())
+				return cache->Push(core, object);
+
+			core->Push(object);
+		}
+
+	}
+
+}
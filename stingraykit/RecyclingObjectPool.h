@@ -0,0 +1,250 @@
+#ifndef STINGRAYKIT_RECYCLINGOBJECTPOOL_H
+#define STINGRAYKIT_RECYCLINGOBJECTPOOL_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/function/function.h>
+#include <stingraykit/memory/PoolAllocator.h>
+#include <stingraykit/optional.h>
+#include <stingraykit/thread/Thread.h>
+#include <stingraykit/thread/atomic/AtomicInt.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace stingray
+{
+
+	namespace Detail
+	{
+
+		/**
+		 * @brief Type-erased storage of RecyclingObjectPool
+		 * @details Nodes are addressed by index and never freed while the core is alive, so free nodes are kept in a lock-free stack
+		 * with ABA-tagged head. Each thread additionally keeps a small cache of free nodes per core (see RecyclingPoolThreadCache).
+		 */
+		class RecyclingPoolCore
+		{
+			STINGRAYKIT_NONCOPYABLE(RecyclingPoolCore);
+
+		public:
+			typedef void DestroyFunc(void* object);
+
+			static const u32 NullIndex = 0;
+
+		private:
+			static const size_t MaxChunks = 24;
+			static const size_t FirstChunkSize = 16;
+
+			struct NodeHeader
+			{
+				u32				Next;
+				u32				Index;
+			};
+
+		private:
+			const u64				_id;
+			const size_t			_nodeSize;
+			const size_t			_objectOffset;
+			DestroyFunc* const		_destroyFunc;
+
+			AtomicU64::Type			_head;
+
+			mutable Mutex			_growMutex;
+			u8*						_chunks[MaxChunks];
+			u32						_allocated;
+			std::vector<u32>		_discarded;
+
+		public:
+			RecyclingPoolCore(size_t objectSize, DestroyFunc* destroyFunc);
+			~RecyclingPoolCore();
+
+			/// @returns Object of a free node or null if there are no free nodes
+			void* Pop();
+
+			/// @brief Reserves a brand-new node, caller must construct an object in returned storage
+			void* Grow();
+
+			/// @brief Returns storage of a node, whose object could not be constructed
+			void Discard(void* object);
+
+			void Push(void* object)
+			{
+				const u32 index = GetIndex(object);
+				PushChain(index, index);
+			}
+
+			/// @brief Pushes chain of nodes linked with SetNext, 'last' node must be the tail of the chain
+			void PushChain(u32 first, u32 last);
+
+			/// @brief Unique among all cores ever created, unlike the address
+			u64 GetId() const						{ return _id; }
+
+			u32 GetIndex(void* object) const		{ return GetHeader(object)->Index; }
+			void* GetObject(u32 index) const		{ return GetNode(index) + _objectOffset; }
+
+			u32 GetNext(u32 index) const			{ return reinterpret_cast<NodeHeader*>(GetNode(index))->Next; }
+			void SetNext(u32 index, u32 next)		{ reinterpret_cast<NodeHeader*>(GetNode(index))->Next = next; }
+
+			size_t GetAllocatedCount() const;
+
+		private:
+			NodeHeader* GetHeader(void* object) const
+			{ return reinterpret_cast<NodeHeader*>(static_cast<u8*>(object) - _objectOffset); }
+
+			u8* GetNode(u32 index) const;
+		};
+		STINGRAYKIT_DECLARE_PTR(RecyclingPoolCore);
+
+
+		struct RecyclingPoolThreadCache
+		{
+			static void* Pop(const RecyclingPoolCorePtr& core);
+			static void Push(const RecyclingPoolCorePtr& core, void* object);
+		};
+
+	}
+
+
+	/**
+	 * @brief Pool of reusable objects of type T
+	 * @details Acquired objects are not destroyed on release, but returned to the pool (after optional reset hook) and handed out again.
+	 * Released objects first go to a small per-thread free list, overflow goes to a lock-free global stack shared by all threads.
+	 * Objects may be released from any thread. The pool must outlive all acquired objects.
+	 * @par Example:
+	 * @code
+	 * RecyclingObjectPool<ByteArray> pool([](){ return ByteArray(1500); });
+	 * RecyclingObjectPool<ByteArray>::Handle packet = pool.Acquire();
+	 * @endcode
+	 */
+	template < typename T >
+	class RecyclingObjectPool
+	{
+		STINGRAYKIT_NONCOPYABLE(RecyclingObjectPool);
+
+		static_assert(alignof(T) <= alignof(std::max_align_t), "Overaligned types are not supported");
+
+	public:
+		using FactoryType = function<T ()>;
+		using ResetHookType = function<void (T&)>;
+
+		class Handle
+		{
+			STINGRAYKIT_NONCOPYABLE(Handle);
+
+			friend class RecyclingObjectPool;
+
+		private:
+			RecyclingObjectPool*	_pool;
+			T*						_object;
+
+		private:
+			Handle(RecyclingObjectPool* pool, T* object) : _pool(pool), _object(object)
+			{ }
+
+		public:
+			Handle() : _pool(), _object()
+			{ }
+
+			Handle(Handle&& other) : _pool(other._pool), _object(other._object)
+			{ other._object = null; }
+
+			~Handle()
+			{ reset(); }
+
+			Handle& operator = (Handle&& other)
+			{
+				Handle tmp(std::move(other));
+				std::swap(_pool, tmp._pool);
+				std::swap(_object, tmp._object);
+				return *this;
+			}
+
+			explicit operator bool () const		{ return _object; }
+
+			T* get() const						{ return _object; }
+
+			T* operator -> () const				{ return &**this; }
+
+			T& operator * () const
+			{
+				STINGRAYKIT_CHECK(_object, NullPointerException("RecyclingObjectPool<" + TypeInfo(typeid(T)).GetName() + ">::Handle"));
+				return *_object;
+			}
+
+			/// @brief Returns the object to the pool
+			void reset()
+			{
+				if (_object)
+					_pool->Release(_object);
+				_object = null;
+			}
+		};
+
+	private:
+		struct Releaser
+		{
+			RecyclingObjectPool*	Pool;
+
+			void operator () (T* object) const
+			{ Pool->Release(object); }
+		};
+
+	private:
+		Detail::RecyclingPoolCorePtr	_core;
+		optional<FactoryType>			_factory;
+		optional<ResetHookType>			_resetHook;
+
+	public:
+		/// @param factory Creates new objects when the pool is empty, T is default-constructed if not specified
+		/// @param resetHook Called for every released object before it goes back to the pool
+		explicit RecyclingObjectPool(const optional<FactoryType>& factory = null, const optional<ResetHookType>& resetHook = null)
+			: _core(make_shared_ptr<Detail::RecyclingPoolCore>(sizeof(T), &Destroy)), _factory(factory), _resetHook(resetHook)
+		{ }
+
+		Handle Acquire()
+		{ return Handle(this, DoAcquire()); }
+
+		/// @brief Same as Acquire, but object is returned to the pool when the last shared_ptr to it goes away
+		shared_ptr<T> AcquireShared()
+		{ return shared_ptr<T>(DoAcquire(), Releaser{this}, PoolAllocator<T>()); }
+
+		/// @returns Count of objects ever created by the pool, both in use and free
+		size_t GetAllocatedCount() const
+		{ return _core->GetAllocatedCount(); }
+
+	private:
+		T* DoAcquire()
+		{
+			if (void* object = Detail::RecyclingPoolThreadCache::Pop(_core))
+				return static_cast<T*>(object);
+
+			void* const storage = _core->Grow();
+			try
+			{ return _factory ? new(storage) T((*_factory)()) : new(storage) T(); }
+			catch (...)
+			{
+				_core->Discard(storage);
+				throw;
+			}
+		}
+
+		void Release(T* object)
+		{
+			if (_resetHook)
+				(*_resetHook)(*object);
+			Detail::RecyclingPoolThreadCache::Push(_core, object);
+		}
+
+		static void Destroy(void* object)
+		{ static_cast<T*>(object)->~T(); }
+	};
+
+}
+
+#endif
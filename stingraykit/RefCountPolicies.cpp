@@ -0,0 +1,38 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/RefCountPolicies.h>
+
+#include <stingraykit/fatal.h>
+#include <stingraykit/thread/posix/ThreadLocal.h>
+
+namespace stingray
+{
+
+	namespace Detail
+	{
+
+		namespace
+		{
+			STINGRAYKIT_DECLARE_THREAD_LOCAL(char, ThreadMarker);
+			STINGRAYKIT_DEFINE_THREAD_LOCAL(char, ThreadMarker);
+		}
+
+
+		const void* LocalRefCounterHelper::GetCurrentThreadMarker()
+		{ return &ThreadMarker::Get(); }
+
+
+		void LocalRefCounterHelper::CheckThread(const void* ownerMarker)
+		{
+			if (ownerMarker != GetCurrentThreadMarker())
+				STINGRAYKIT_FATAL("Local reference counter was accessed from a thread other than the one it was created in");
+		}
+
+	}
+
+}
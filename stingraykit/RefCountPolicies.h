@@ -0,0 +1,105 @@
+#ifndef STINGRAYKIT_REFCOUNTPOLICIES_H
+#define STINGRAYKIT_REFCOUNTPOLICIES_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/thread/atomic/AtomicInt.h>
+#include <stingraykit/toolkit.h>
+
+namespace stingray
+{
+
+	namespace Detail
+	{
+
+		template < typename IntType >
+		class AtomicRefCounter
+		{
+			using AtomicType = BasicAtomicInt<IntType>;
+
+		private:
+			mutable typename AtomicType::Type	_value;
+
+		public:
+			explicit AtomicRefCounter(IntType value) : _value(value)
+			{ }
+
+			IntType Inc() const											{ return AtomicType::Inc(_value); }
+			IntType Dec() const											{ return AtomicType::Dec(_value); }
+			IntType Load() const										{ return AtomicType::Load(_value); }
+			IntType CompareAndExchange(IntType oldVal, IntType newVal)	{ return AtomicType::CompareAndExchange(_value, oldVal, newVal); }
+		};
+
+
+		struct LocalRefCounterHelper
+		{
+			static const void* GetCurrentThreadMarker();
+			static void CheckThread(const void* ownerMarker);
+		};
+
+
+		template < typename IntType >
+		class LocalRefCounter
+		{
+		private:
+			mutable IntType			_value;
+#ifdef DEBUG
+			const void*				_ownerMarker;
+#endif
+
+		public:
+			explicit LocalRefCounter(IntType value)
+				:	_value(value)
+#ifdef DEBUG
+					, _ownerMarker(LocalRefCounterHelper::GetCurrentThreadMarker())
+#endif
+			{ }
+
+			IntType Inc() const											{ CheckThread(); return ++_value; }
+			IntType Dec() const											{ CheckThread(); return --_value; }
+			IntType Load() const										{ CheckThread(); return _value; }
+
+			IntType CompareAndExchange(IntType oldVal, IntType newVal)
+			{
+				CheckThread();
+
+				const IntType result = _value;
+				if (result == oldVal)
+					_value = newVal;
+				return result;
+			}
+
+		private:
+			void CheckThread() const
+			{ STINGRAYKIT_DEBUG_ONLY(LocalRefCounterHelper::CheckThread(_ownerMarker)); }
+		};
+
+	}
+
+
+	/** @brief Thread-safe reference counting, default for shared_ptr and self_counter */
+	struct AtomicRefCountPolicy
+	{
+		template < typename IntType >
+		using Counter = Detail::AtomicRefCounter<IntType>;
+	};
+
+
+	/**
+	 * @brief Plain integer reference counting for objects that never leave the thread they were created in
+	 * @details Debug builds abort if a counter is touched from any other thread
+	 */
+	struct LocalRefCountPolicy
+	{
+		template < typename IntType >
+		using Counter = Detail::LocalRefCounter<IntType>;
+	};
+
+}
+
+#endif
@@ -13,6 +13,9 @@
 #include <stingraykit/fatal.h>
 #include <stingraykit/reference.h>
 
+#include <memory>
+#include <new>
+
 namespace stingray
 {
 
@@ -20,11 +23,18 @@ namespace stingray
 	class TypeErasureImpl;
 
 
+	template < typename Concepts_, typename Wrapped_, typename Allocator_ >
+	class AllocatedTypeErasureImpl;
+
+
 	class TypeErasureBase
 	{
 		template < typename C, typename W >
 		friend class TypeErasureImpl;
 
+		template < typename C, typename W, typename A >
+		friend class AllocatedTypeErasureImpl;
+
 	public:
 		typedef void DetypedFunction();
 		typedef DetypedFunction* DetypedFunctionPtr;
@@ -71,11 +81,87 @@ namespace stingray
 		};
 
 
+		template < typename Concepts_, typename Wrapped_, typename Allocator_ >
+		struct ConceptInvoker<AllocatedTypeErasureImpl<Concepts_, Wrapped_, Allocator_>, Concepts::Destructor>
+		{
+			static void DoCall(TypeErasureBase* self)
+			{ AllocatedTypeErasureImpl<Concepts_, Wrapped_, Allocator_>::Destroy(static_cast<AllocatedTypeErasureImpl<Concepts_, Wrapped_, Allocator_>*>(self)); }
+		};
+
+
 		struct TypeErasureHelper
 		{
 			static void Terminate()
 			{ STINGRAYKIT_FATAL("Pure virtual function called"); }
 		};
+
+
+		template < typename Self_, typename Concepts_ >
+		class TypeErasureVTable
+		{
+			typedef void DetypedFunction();
+			typedef DetypedFunction* DetypedFunctionPtr;
+
+			template < size_t Index >
+			struct VTableHelper
+			{
+				static bool Call(size_t functionIndex, DetypedFunctionPtr& result)
+				{
+					if (functionIndex != Index)
+						return true;
+
+					typedef typename GetTypeListItem<Concepts_, Index>::ValueT Concept;
+
+					CallImpl<Concept>(std::make_index_sequence<GetTypeListLength<typename Concept::ParamTypes>::Value>(), result);
+					return false;
+				}
+
+			private:
+				template < typename Concept, size_t... ParamIndex >
+				static void CallImpl(std::index_sequence<ParamIndex...>, DetypedFunctionPtr& result)
+				{
+					typedef ConceptInvoker<Self_, Concept, typename GetTypeListItem<typename Concept::ParamTypes, ParamIndex>::ValueT...> ConceptInvoker;
+
+					result = reinterpret_cast<DetypedFunctionPtr>(&ConceptInvoker::DoCall);
+				}
+			};
+
+		public:
+			static DetypedFunctionPtr Get(size_t functionIndex)
+			{
+				DetypedFunctionPtr result = NULL;
+				if (ForIf<GetTypeListLength<Concepts_>::Value, VTableHelper>::Do(functionIndex, wrap_ref(result)))
+					TypeErasureHelper::Terminate();
+				return result;
+			}
+		};
+
+
+		template < typename Allocator_, bool IsEmpty = std::is_empty<Allocator_>::value && !std::is_final<Allocator_>::value >
+		class TypeErasureAllocatorHolder : private Allocator_
+		{
+		public:
+			explicit TypeErasureAllocatorHolder(const Allocator_& allocator) : Allocator_(allocator)
+			{ }
+
+			const Allocator_& GetAllocator() const
+			{ return *this; }
+		};
+
+
+		template < typename Allocator_ >
+		class TypeErasureAllocatorHolder<Allocator_, false>
+		{
+		private:
+			Allocator_		_allocator;
+
+		public:
+			explicit TypeErasureAllocatorHolder(const Allocator_& allocator) : _allocator(allocator)
+			{ }
+
+			const Allocator_& GetAllocator() const
+			{ return _allocator; }
+		};
 	}
 
 
@@ -114,6 +200,15 @@ namespace stingray
 			return result;
 		}
 
+		/// @brief Same as Allocate, but memory for the wrapped object is obtained from the given std-compatible allocator and returned to its copy on Free
+		template < typename Wrapped, typename Allocator, typename... Ts >
+		Wrapped* AllocateUsing(const Allocator& allocator, Ts&&... args)
+		{
+			Wrapped* result = AllocatedTypeErasureImpl<AllConcepts, Wrapped, Allocator>::Create(allocator, std::forward<Ts>(args)...);
+			_data = result;
+			return result;
+		}
+
 		void Free()
 		{
 			Call<Concepts::Destructor>();
@@ -155,40 +250,55 @@ namespace stingray
 		{ TypeErasureBase::_vTable = NULL; }
 
 	private:
-		typedef void DetypedFunction();
-		typedef DetypedFunction* DetypedFunctionPtr;
+		static typename TypeErasureBase::DetypedFunctionPtr VTableFuncImpl(size_t functionIndex)
+		{ return Detail::TypeErasureVTable<Self, Concepts>::Get(functionIndex); }
+	};
 
-		template < size_t Index >
-		struct VTableHelper
-		{
-			static bool Call(size_t functionIndex, DetypedFunctionPtr& result)
-			{
-				if (functionIndex != Index)
-					return true;
 
-				typedef typename GetTypeListItem<Concepts, Index>::ValueT Concept;
+	template < typename Concepts_, typename Wrapped_, typename Allocator_ >
+	class AllocatedTypeErasureImpl : public Wrapped_, private Detail::TypeErasureAllocatorHolder<typename std::allocator_traits<Allocator_>::template rebind_alloc<AllocatedTypeErasureImpl<Concepts_, Wrapped_, Allocator_>>>
+	{
+		typedef Wrapped_													Wrapped;
+		typedef Concepts_													Concepts;
+		typedef AllocatedTypeErasureImpl<Concepts_, Wrapped_, Allocator_>	Self;
 
-				CallImpl<Concept>(std::make_index_sequence<GetTypeListLength<typename Concept::ParamTypes>::Value>(), result);
-				return false;
-			}
+		typedef typename std::allocator_traits<Allocator_>::template rebind_alloc<Self>		SelfAllocator;
+		typedef std::allocator_traits<SelfAllocator>										SelfAllocatorTraits;
+		typedef Detail::TypeErasureAllocatorHolder<SelfAllocator>							AllocatorHolder;
 
-		private:
-			template < typename Concept, size_t... ParamIndex >
-			static void CallImpl(std::index_sequence<ParamIndex...>, DetypedFunctionPtr& result)
-			{
-				typedef Detail::ConceptInvoker<Self, Concept, typename GetTypeListItem<typename Concept::ParamTypes, ParamIndex>::ValueT...> ConceptInvoker;
+	public:
+		template < typename... Ts >
+		AllocatedTypeErasureImpl(const SelfAllocator& allocator, Ts&&... args) : Wrapped(std::forward<Ts>(args)...), AllocatorHolder(allocator)
+		{ TypeErasureBase::_vTable = &VTableFuncImpl; }
 
-				result = reinterpret_cast<DetypedFunctionPtr>(&ConceptInvoker::DoCall);
+		~AllocatedTypeErasureImpl()
+		{ TypeErasureBase::_vTable = NULL; }
+
+		template < typename... Ts >
+		static Self* Create(const Allocator_& allocator, Ts&&... args)
+		{
+			SelfAllocator selfAllocator(allocator);
+			Self* const result = SelfAllocatorTraits::allocate(selfAllocator, 1);
+
+			try
+			{ return new(result) Self(selfAllocator, std::forward<Ts>(args)...); }
+			catch (...)
+			{
+				SelfAllocatorTraits::deallocate(selfAllocator, result, 1);
+				throw;
 			}
-		};
+		}
 
-		static DetypedFunctionPtr VTableFuncImpl(size_t functionIndex)
+		static void Destroy(Self* self)
 		{
-			DetypedFunctionPtr result = NULL;
-			if (ForIf<GetTypeListLength<Concepts>::Value, VTableHelper>::Do(functionIndex, wrap_ref(result)))
-				Detail::TypeErasureHelper::Terminate();
-			return result;
+			SelfAllocator selfAllocator(self->GetAllocator());
+			self->~Self();
+			SelfAllocatorTraits::deallocate(selfAllocator, self, 1);
 		}
+
+	private:
+		static typename TypeErasureBase::DetypedFunctionPtr VTableFuncImpl(size_t functionIndex)
+		{ return Detail::TypeErasureVTable<Self, Concepts>::Get(functionIndex); }
 	};
 
 }
@@ -10,9 +10,13 @@
 
 #include <stingraykit/collection/array.h>
 #include <stingraykit/collection/iterator_base.h>
+#include <stingraykit/memory/PoolAllocator.h>
+#include <stingraykit/self_counter.h>
 #include <stingraykit/shared_ptr.h>
 
 #include <algorithm>
+#include <cstddef>
+#include <initializer_list>
 
 #define DETAIL_BYTEDATA_INDEX_CHECK(Arg1, Arg2) STINGRAYKIT_CHECK((Arg1) <= (Arg2), IndexOutOfRangeException(Arg1, Arg2))
 
@@ -95,6 +99,103 @@ namespace stingray
 			{ (void)begin; (void)end; return iterator(ptr); }
 		};
 #endif
+
+
+		/**
+		 * @brief Storage of uninitialized ByteArray
+		 * @details Reference counter, size and payload are placed in a single block obtained from ByteBufferPool. Payload is not initialized.
+		 * Growing beyond the capacity moves payload to a separate buffer, which is referenced from the block, so all arrays sharing the
+		 * block keep seeing the same contents.
+		 */
+		class ByteArrayBlock
+		{
+			STINGRAYKIT_NONCOPYABLE(ByteArrayBlock);
+
+			template < typename U >
+			friend class stingray::self_count_ptr;
+
+		private:
+			static const size_t PayloadOffset = (sizeof(AtomicRefCountPolicy::Counter<s32>) + 3 * sizeof(size_t) + sizeof(u8*) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+		private:
+			AtomicRefCountPolicy::Counter<s32>	_value;
+			size_t								_size;
+			size_t								_capacity;
+			const size_t						_inlineCapacity;
+			u8*									_external;
+
+		private:
+			ByteArrayBlock(size_t size, size_t capacity)
+				: _value(1), _size(size), _capacity(capacity), _inlineCapacity(capacity), _external()
+			{ }
+
+			~ByteArrayBlock()
+			{
+				if (_external)
+					ByteBufferPool::Deallocate(_external, _capacity);
+			}
+
+		public:
+			/// @param capacity Minimal capacity in bytes, actual one may be bigger
+			static self_count_ptr<ByteArrayBlock> Create(size_t size, size_t capacity)
+			{
+				STINGRAYKIT_CHECK(size <= capacity, IndexOutOfRangeException(size, capacity));
+				STINGRAYKIT_CHECK(capacity <= std::numeric_limits<size_t>::max() - PayloadOffset, std::bad_alloc());
+
+				const size_t allocated = ByteBufferPool::GetCapacity(PayloadOffset + capacity);
+				return self_count_ptr<ByteArrayBlock>(new(ByteBufferPool::Allocate(PayloadOffset + capacity)) ByteArrayBlock(size, allocated - PayloadOffset));
+			}
+
+			u8* GetData()						{ return _external ? _external : reinterpret_cast<u8*>(this) + PayloadOffset; }
+
+			size_t GetSize() const				{ return _size; }
+			size_t GetCapacity() const			{ return _capacity; }
+
+			void SetSize(size_t size)
+			{
+				STINGRAYKIT_CHECK(size <= _capacity, IndexOutOfRangeException(size, _capacity));
+				_size = size;
+			}
+
+			/// @param capacity Minimal capacity in bytes, grows at least twice to keep appends amortized
+			void Reserve(size_t capacity)
+			{
+				if (_capacity >= capacity)
+					return;
+
+				const size_t size = std::max(capacity, 2 * _capacity);
+				u8* const external = static_cast<u8*>(ByteBufferPool::Allocate(size));
+				std::copy(GetData(), GetData() + _size, external);
+
+				if (_external)
+					ByteBufferPool::Deallocate(_external, _capacity);
+
+				_external = external;
+				_capacity = ByteBufferPool::GetCapacity(size);
+			}
+
+			size_t use_count() const			{ return _value.Load(); }
+
+		private:
+			void add_ref() const				{ _value.Inc(); }
+
+			void release_ref()
+			{
+				if (_value.Dec() != 0)
+				{
+					STINGRAYKIT_ANNOTATE_HAPPENS_BEFORE(&_value);
+					return;
+				}
+
+				STINGRAYKIT_ANNOTATE_HAPPENS_AFTER(&_value);
+				STINGRAYKIT_ANNOTATE_RELEASE(&_value);
+
+				const size_t allocated = PayloadOffset + _inlineCapacity;
+				this->~ByteArrayBlock();
+				ByteBufferPool::Deallocate(this, allocated);
+			}
+		};
+		STINGRAYKIT_DECLARE_SELF_COUNT_PTR(ByteArrayBlock);
 	}
 
 	template < typename T >
@@ -131,9 +232,10 @@ namespace stingray
 		static const size_t NoSizeLimit = ~(size_t)0;
 
 	private:
-		CollectionTypePtr		_data;
-		size_t					_offset;
-		size_t					_sizeLimit;
+		CollectionTypePtr						_data;
+		Detail::ByteArrayBlockSelfCountPtr		_block;
+		size_t									_offset;
+		size_t									_sizeLimit;
 
 	public:
 		BasicByteArray()
@@ -168,57 +270,83 @@ namespace stingray
 
 		template < typename U, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0 >
 		BasicByteArray(const BasicByteArray<U>& other)
-			: _data(other._data), _offset(other._offset), _sizeLimit(other._sizeLimit)
+			: _data(other._data), _block(other._block), _offset(other._offset), _sizeLimit(other._sizeLimit)
 		{ }
 
 		template < typename U, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0 >
 		BasicByteArray(BasicByteArray<U>&& other)
-			: _data(std::move(other._data)), _offset(other._offset), _sizeLimit(other._sizeLimit)
+			: _data(std::move(other._data)), _block(std::move(other._block)), _offset(other._offset), _sizeLimit(other._sizeLimit)
 		{ }
 
 		template < typename U, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0 >
 		BasicByteArray(const BasicByteArray<U>& other, size_t offset)
-			: _data(other._data), _offset(other._offset + offset), _sizeLimit(other._sizeLimit == NoSizeLimit ? NoSizeLimit : other._sizeLimit - offset)
-		{ STINGRAYKIT_CHECK(_data->size() >= _offset, IndexOutOfRangeException(_offset, _data->size())); }
+			: _data(other._data), _block(other._block), _offset(other._offset + offset), _sizeLimit(other._sizeLimit == NoSizeLimit ? NoSizeLimit : other._sizeLimit - offset)
+		{ STINGRAYKIT_CHECK(GetStorageSize() >= _offset, IndexOutOfRangeException(_offset, GetStorageSize())); }
 
 		template < typename U, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0 >
 		BasicByteArray(BasicByteArray<U>&& other, size_t offset)
-			: _data(std::move(other._data)), _offset(other._offset + offset), _sizeLimit(other._sizeLimit == NoSizeLimit ? NoSizeLimit : other._sizeLimit - offset)
-		{ STINGRAYKIT_CHECK(_data->size() >= _offset, IndexOutOfRangeException(_offset, _data->size())); }
+			: _data(std::move(other._data)), _block(std::move(other._block)), _offset(other._offset + offset), _sizeLimit(other._sizeLimit == NoSizeLimit ? NoSizeLimit : other._sizeLimit - offset)
+		{ STINGRAYKIT_CHECK(GetStorageSize() >= _offset, IndexOutOfRangeException(_offset, GetStorageSize())); }
 
 		template < typename U, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0 >
 		BasicByteArray(const BasicByteArray<U>& other, size_t offset, size_t sizeLimit)
-			: _data(other._data), _offset(other._offset + offset), _sizeLimit(sizeLimit)
+			: _data(other._data), _block(other._block), _offset(other._offset + offset), _sizeLimit(sizeLimit)
 		{
-			STINGRAYKIT_CHECK(_data->size() >= _offset, IndexOutOfRangeException(_offset, _data->size()));
-			STINGRAYKIT_CHECK(_sizeLimit == NoSizeLimit || _sizeLimit + offset <= _data->size(), IndexOutOfRangeException(_sizeLimit + offset, offset, _data->size()));
+			STINGRAYKIT_CHECK(GetStorageSize() >= _offset, IndexOutOfRangeException(_offset, GetStorageSize()));
+			STINGRAYKIT_CHECK(_sizeLimit == NoSizeLimit || _sizeLimit + offset <= GetStorageSize(), IndexOutOfRangeException(_sizeLimit + offset, offset, GetStorageSize()));
 			STINGRAYKIT_CHECK(_sizeLimit + offset <= other._sizeLimit, IndexOutOfRangeException(_sizeLimit + offset, offset, other._sizeLimit));
 		}
 
 		template < typename U, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0 >
 		BasicByteArray(BasicByteArray<U>&& other, size_t offset, size_t sizeLimit)
-			: _data(std::move(other._data)), _offset(other._offset + offset), _sizeLimit(sizeLimit)
+			: _data(std::move(other._data)), _block(std::move(other._block)), _offset(other._offset + offset), _sizeLimit(sizeLimit)
 		{
-			STINGRAYKIT_CHECK(_data->size() >= _offset, IndexOutOfRangeException(_offset, _data->size()));
-			STINGRAYKIT_CHECK(_sizeLimit == NoSizeLimit || _sizeLimit + offset <= _data->size(), IndexOutOfRangeException(_sizeLimit + offset, offset, _data->size()));
+			STINGRAYKIT_CHECK(GetStorageSize() >= _offset, IndexOutOfRangeException(_offset, GetStorageSize()));
+			STINGRAYKIT_CHECK(_sizeLimit == NoSizeLimit || _sizeLimit + offset <= GetStorageSize(), IndexOutOfRangeException(_sizeLimit + offset, offset, GetStorageSize()));
 			STINGRAYKIT_CHECK(_sizeLimit + offset <= other._sizeLimit, IndexOutOfRangeException(_sizeLimit + offset, offset, other._sizeLimit));
 		}
 
+		/**
+		 * @brief Creates array, whose contents are left uninitialized
+		 * @details Unlike ByteArray(size), which allocates a vector and zeroes its contents, contents of such array are placed in a single block
+		 * along with the reference counter, and the block is taken from ByteBufferPool. RequireSize doesn't zero new contents either.
+		 * Like with ordinary arrays, copies and sub-arrays share the storage and see its growth.
+		 */
+		static BasicByteArray CreateUninitialized(size_t size)
+		{
+			static_assert(std::is_trivial<NonConstType>::value, "Only trivial types may be left uninitialized");
+			static_assert(alignof(NonConstType) <= alignof(std::max_align_t), "Overaligned types are not supported");
+
+			STINGRAYKIT_CHECK(size <= std::numeric_limits<size_t>::max() / sizeof(T), std::bad_alloc());
+			return BasicByteArray(Detail::ByteArrayBlock::Create(size * sizeof(T), size * sizeof(T)));
+		}
+
 		void RequireSize(size_t size)
 		{
 			STINGRAYKIT_CHECK(_sizeLimit == NoSizeLimit, NotImplementedException());
-			if (_data->size() < size + _offset)
+			if (GetStorageSize() >= size + _offset)
+				return;
+
+			if (_block)
+			{
+				ReserveBlock(size + _offset);
+				_block->SetSize((size + _offset) * sizeof(T));
+			}
+			else
 				_data->resize(size + _offset);
 		}
 
 		T& operator [] (size_t index) const
 		{
 			STINGRAYKIT_CHECK(index < size(), IndexOutOfRangeException(index, size()));
-			return (*_data)[index + _offset];
+			return GetStorageData()[index + _offset];
 		}
 
 		size_t size() const
-		{ return _data->size() >= _offset ? std::min(_data->size() - _offset, _sizeLimit) : 0; }
+		{
+			const size_t storageSize = GetStorageSize();
+			return storageSize >= _offset ? std::min(storageSize - _offset, _sizeLimit) : 0;
+		}
 
 		bool empty() const
 		{ return size() == 0; }
@@ -227,7 +355,10 @@ namespace stingray
 		void append(InputIterator first, InputIterator last)
 		{
 			STINGRAYKIT_CHECK(_sizeLimit == NoSizeLimit, NotImplementedException());
-			_data->insert(_data->end(), first, last);
+			if (_block)
+				AppendToBlock(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+			else
+				_data->insert(_data->end(), first, last);
 		}
 
 		template < typename Range, decltype(std::declval<Range>().begin(), std::declval<Range>().end(), bool()) = false >
@@ -241,18 +372,27 @@ namespace stingray
 		void reserve(size_t n)
 		{
 			STINGRAYKIT_CHECK(_sizeLimit == NoSizeLimit, NotImplementedException());
-			_data->reserve(_offset + n);
+			if (_block)
+				ReserveBlock(_offset + n);
+			else
+				_data->reserve(_offset + n);
 		}
 
 		void swap(BasicByteArray& other)
 		{
 			_data.swap(other._data);
+			_block.swap(other._block);
 			std::swap(_offset, other._offset);
 			std::swap(_sizeLimit, other._sizeLimit);
 		}
 
 		void clear()
-		{ _data->clear(); }
+		{
+			if (_block)
+				_block->SetSize(0);
+			else
+				_data->clear();
+		}
 
 		iterator begin() const
 		{
@@ -273,7 +413,7 @@ namespace stingray
 		{ return reverse_iterator(begin()); }
 
 		T* data() const
-		{ return empty() ? NULL : &(*_data)[_offset]; }
+		{ return empty() ? NULL : GetStorageData() + _offset; }
 
 		template < typename ObjectOStream >
 		void Serialize(ObjectOStream& ar) const
@@ -305,6 +445,41 @@ namespace stingray
 		{ return std::lexicographical_compare(data(), data() + size(), other.data(), other.data() + other.size()); }
 
 		STINGRAYKIT_GENERATE_RELATIONAL_OPERATORS_FROM_LESS(BasicByteArray);
+
+	private:
+		explicit BasicByteArray(const Detail::ByteArrayBlockSelfCountPtr& block)
+			: _block(block), _offset(0), _sizeLimit(NoSizeLimit)
+		{ }
+
+		T* GetStorageData() const
+		{ return _block ? reinterpret_cast<T*>(_block->GetData()) : _data->data(); }
+
+		size_t GetStorageSize() const
+		{ return _block ? _block->GetSize() / sizeof(T) : _data->size(); }
+
+		void ReserveBlock(size_t size)
+		{
+			STINGRAYKIT_CHECK(size <= std::numeric_limits<size_t>::max() / sizeof(T), std::bad_alloc());
+			_block->Reserve(size * sizeof(T));
+		}
+
+		template < typename ForwardIterator >
+		void AppendToBlock(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+		{
+			const size_t storageSize = GetStorageSize();
+			const size_t count = std::distance(first, last);
+
+			ReserveBlock(storageSize + count);
+			std::copy(first, last, GetStorageData() + storageSize);
+			_block->SetSize((storageSize + count) * sizeof(T));
+		}
+
+		template < typename InputIterator >
+		void AppendToBlock(InputIterator first, InputIterator last, std::input_iterator_tag)
+		{
+			const std::vector<NonConstType> buffer(first, last);
+			AppendToBlock(buffer.begin(), buffer.end(), std::forward_iterator_tag());
+		}
 	};
 
 
@@ -434,6 +609,78 @@ namespace stingray
 	using ConstByteArray = BasicByteArray<const u8>;
 	using ByteArray = BasicByteArray<u8>;
 
+
+	/**
+	 * @brief Scatter/gather list of memory regions for vectored I/O
+	 * @details Refers to regions kept by the caller in a braced list, C array, array or std::vector, so passing a list does not allocate.
+	 * Must not outlive the call it is passed to, braced list is destroyed at the end of full expression.
+	 */
+	template < typename T >
+	class BasicByteDataSpan
+	{
+	public:
+		using value_type = BasicByteData<T>;
+		using const_iterator = const value_type*;
+		using iterator = const_iterator;
+
+	private:
+		const value_type*		_data;
+		size_t					_size;
+
+	public:
+		BasicByteDataSpan()
+			: _data(), _size()
+		{ }
+
+		BasicByteDataSpan(const value_type* data, size_t size)
+			: _data(data), _size(size)
+		{ }
+
+		BasicByteDataSpan(std::initializer_list<value_type> data)
+			: BasicByteDataSpan(data.begin(), data.size())
+		{ }
+
+		BasicByteDataSpan(const std::vector<value_type>& data)
+			: _data(data.empty() ? NULL : &data[0]), _size(data.size())
+		{ }
+
+		template < size_t N >
+		BasicByteDataSpan(const array<value_type, N>& data)
+			: _data(data.empty() ? NULL : &data[0]), _size(data.size())
+		{ }
+
+		template < size_t N >
+		BasicByteDataSpan(const value_type(&data)[N])
+			: _data(&data[0]), _size(N)
+		{ }
+
+		const value_type& operator [] (size_t index) const
+		{
+			STINGRAYKIT_CHECK(index < _size, IndexOutOfRangeException(index, _size));
+			return _data[index];
+		}
+
+		const value_type* data() const	{ return _data; }
+
+		size_t size() const				{ return _size; }
+		bool empty() const				{ return _size == 0; }
+
+		const_iterator begin() const	{ return _data; }
+		const_iterator end() const		{ return _data + _size; }
+
+		/// @returns Sum of sizes of all regions
+		size_t GetTotalSize() const
+		{
+			size_t result = 0;
+			for (const_iterator it = begin(); it != end(); ++it)
+				result += it->size();
+			return result;
+		}
+	};
+
+	using ConstByteDataSpan = BasicByteDataSpan<const u8>;
+	using ByteDataSpan = BasicByteDataSpan<u8>;
+
 	/** @} */
 
 }
@@ -0,0 +1,164 @@
+#ifndef STINGRAYKIT_COLLECTION_BYTEROPE_H
+#define STINGRAYKIT_COLLECTION_BYTEROPE_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/ByteData.h>
+#include <stingraykit/string/ToString.h>
+
+namespace stingray
+{
+
+	/**
+	 * @ingroup toolkit_bits_bytedata
+	 * @{
+	 */
+
+	/**
+	 * @brief Sequence of bytes made of shared ConstByteArray segments
+	 * @details Appended segments are referenced, not copied, so a large message can be assembled from received chunks without copying them.
+	 * Every segment is stored with its starting offset, so looking up a byte by offset costs O(log n) of the number of segments,
+	 * appending is amortized O(1) and slicing copies references to the segments it spans only.
+	 * Segments are exposed as a range of ConstByteArray, which may be passed to vectored writes via ToByteDataVector.
+	 * @par Example:
+	 * @code
+	 * ByteRope message;
+	 * message.Append(header);
+	 * message.Append(payload);
+	 * stream->WriteV(message.ToByteDataVector(), token);
+	 * @endcode
+	 */
+	class ByteRope
+	{
+	public:
+		using SegmentsType = std::vector<ConstByteArray>;
+		using const_iterator = SegmentsType::const_iterator;
+
+	private:
+		SegmentsType			_segments;
+		std::vector<u64>		_offsets;
+		u64						_size;
+
+	public:
+		ByteRope()
+			: _size(0)
+		{ }
+
+		explicit ByteRope(const ConstByteArray& segment)
+			: _size(0)
+		{ Append(segment); }
+
+		u64 size() const								{ return _size; }
+		bool empty() const								{ return _size == 0; }
+
+		size_t GetSegmentsCount() const					{ return _segments.size(); }
+
+		const_iterator begin() const					{ return _segments.begin(); }
+		const_iterator end() const						{ return _segments.end(); }
+
+		void Append(const ConstByteArray& segment)
+		{
+			if (segment.empty())
+				return;
+
+			_segments.push_back(segment);
+			_offsets.push_back(_size);
+			_size += segment.size();
+		}
+
+		void Append(const ByteRope& other)
+		{
+			_segments.reserve(_segments.size() + other._segments.size());
+			_offsets.reserve(_offsets.size() + other._offsets.size());
+
+			for (const ConstByteArray& segment : other._segments)
+				Append(segment);
+		}
+
+		void clear()
+		{
+			_segments.clear();
+			_offsets.clear();
+			_size = 0;
+		}
+
+		u8 operator [] (u64 offset) const
+		{
+			STINGRAYKIT_CHECK(offset < _size, IndexOutOfRangeException(offset, _size));
+
+			const size_t index = FindSegment(offset);
+			return _segments[index][offset - _offsets[index]];
+		}
+
+		/// @brief Returns part of the rope, which shares segments with it
+		ByteRope Slice(u64 offset, u64 size) const
+		{
+			STINGRAYKIT_CHECK(offset <= _size && size <= _size - offset, IndexOutOfRangeException(offset + size, _size));
+
+			ByteRope result;
+			if (size == 0)
+				return result;
+
+			for (size_t index = FindSegment(offset); result._size < size; ++index)
+			{
+				const size_t segmentOffset = offset + result._size - _offsets[index];
+				result.Append(ConstByteArray(_segments[index], segmentOffset, std::min<u64>(_segments[index].size() - segmentOffset, size - result._size)));
+			}
+
+			return result;
+		}
+
+		/// @returns Number of bytes copied, which is less than size of data only if the rope ends earlier
+		size_t CopyTo(u64 offset, ByteData data) const
+		{
+			STINGRAYKIT_CHECK(offset <= _size, IndexOutOfRangeException(offset, _size));
+
+			size_t result = 0;
+			if (offset == _size)
+				return result;
+
+			for (size_t index = FindSegment(offset); index < _segments.size() && result < data.size(); ++index)
+			{
+				const ConstByteArray& segment = _segments[index];
+				const size_t segmentOffset = offset + result - _offsets[index];
+				const size_t count = std::min<size_t>(segment.size() - segmentOffset, data.size() - result);
+
+				std::copy(segment.data() + segmentOffset, segment.data() + segmentOffset + count, data.data() + result);
+				result += count;
+			}
+
+			return result;
+		}
+
+		/// @brief Returns contiguous copy of the rope, single segment is returned as is
+		ConstByteArray ToByteArray() const
+		{
+			if (_segments.size() == 1)
+				return _segments.front();
+
+			ByteArray result(ByteArray::CreateUninitialized(_size));
+			CopyTo(0, result);
+			return result;
+		}
+
+		std::vector<ConstByteData> ToByteDataVector() const
+		{ return std::vector<ConstByteData>(_segments.begin(), _segments.end()); }
+
+		std::string ToString() const
+		{ return StringBuilder() % "ByteRope { size: " % _size % ", segments: " % _segments.size() % " }"; }
+
+	private:
+		size_t FindSegment(u64 offset) const
+		{ return std::upper_bound(_offsets.begin(), _offsets.end(), offset) - _offsets.begin() - 1; }
+	};
+
+	/** @} */
+
+}
+
+#endif
@@ -136,7 +136,8 @@ namespace stingray
 
 		static BasicBytesOwner Create(BasicByteData<const T> other)
 		{
-			unique_ptr<DeconstT[]> arr(make_unique_ptr<DeconstT[]>(other.size()));
+			// Contents are overwritten right away, so they are default-initialized instead of being zeroed
+			unique_ptr<DeconstT[]> arr(new DeconstT[other.size()]);
 			std::copy(other.begin(), other.end(), arr.get());
 
 			const DataType data(arr.get(), other.size());
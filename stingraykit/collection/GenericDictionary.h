@@ -22,10 +22,25 @@ namespace stingray
 	 * @{
 	 */
 
+	namespace Detail
+	{
+
+		template < typename MapType_, typename Enabler = void >
+		struct HasGenericDictionaryComparer : public comparers::IsRelationalComparer<typename MapType_::key_compare>
+		{ };
+
+		template < typename MapType_ >
+		struct HasGenericDictionaryComparer<MapType_, typename EnableIf<decltype(std::declval<typename MapType_::key_equal*>(), TrueType())::Value, void>::ValueT>
+			:	public comparers::IsEqualsComparer<typename MapType_::key_equal>
+		{ };
+
+	}
+
+
 	template < typename MapType_ >
 	class GenericDictionary : public virtual IDictionary<typename MapType_::key_type, typename MapType_::mapped_type>
 	{
-		static_assert(comparers::IsRelationalComparer<typename MapType_::key_compare>::Value, "Expected Relational comparer");
+		static_assert(Detail::HasGenericDictionaryComparer<MapType_>::Value, "Expected Relational comparer, or Equals comparer for hash map");
 
 	public:
 		using KeyType = typename MapType_::key_type;
@@ -73,8 +88,7 @@ namespace stingray
 			:	_map(make_shared_ptr<MapType>())
 		{
 			STINGRAYKIT_CHECK(enumerator, NullArgumentException("enumerator"));
-			FOR_EACH(const PairType pair IN enumerator)
-				Set(pair.Key, pair.Value);
+			DoInit<MapType>(enumerator, 0);
 		}
 
 		shared_ptr<IEnumerator<PairType>> GetEnumerator() const override
@@ -152,18 +166,7 @@ namespace stingray
 		size_t RemoveWhere(const function<bool (const KeyType&, const ValueType&)>& pred) override
 		{
 			CopyOnWrite();
-			size_t ret = 0;
-			for (auto it = _map->begin(); it != _map->end(); )
-			{
-				if (pred(it->first, it->second))
-				{
-					it = _map->erase(it);
-					++ret;
-				}
-				else
-					++it;
-			}
-			return ret;
+			return DoRemoveWhere<MapType>(pred, 0);
 		}
 
 		void Clear() override
@@ -178,6 +181,46 @@ namespace stingray
 		}
 
 	private:
+		template < typename MapType__ >
+		auto DoInit(const shared_ptr<IEnumerator<PairType>>& enumerator, int) -> decltype(std::declval<MapType__>().lower_bound(std::declval<KeyType>()), void())
+		{
+			// order of sorted map doesn't depend on insertion order, so pairs are inserted at once in reverse to keep the last value of a key, as Set does
+			std::vector<typename MapType__::value_type> pairs;
+			FOR_EACH(const PairType pair IN enumerator)
+				pairs.emplace_back(pair.Key, pair.Value);
+
+			_map->insert(pairs.rbegin(), pairs.rend());
+		}
+
+		template < typename MapType__ >
+		void DoInit(const shared_ptr<IEnumerator<PairType>>& enumerator, long)
+		{
+			FOR_EACH(const PairType pair IN enumerator)
+				Set(pair.Key, pair.Value);
+		}
+
+		template < typename MapType__ >
+		auto DoRemoveWhere(const function<bool (const KeyType&, const ValueType&)>& pred, int)
+				-> decltype(erase_if(std::declval<MapType__&>(), std::declval<bool (*)(const typename MapType__::value_type&)>()), size_t())
+		{ return erase_if(*_map, [&pred](const typename MapType__::value_type& pair) { return pred(pair.first, pair.second); }); }
+
+		template < typename MapType__ >
+		size_t DoRemoveWhere(const function<bool (const KeyType&, const ValueType&)>& pred, long)
+		{
+			size_t ret = 0;
+			for (auto it = _map->begin(); it != _map->end(); )
+			{
+				if (pred(it->first, it->second))
+				{
+					it = _map->erase(it);
+					++ret;
+				}
+				else
+					++it;
+			}
+			return ret;
+		}
+
 		template < typename MapType__ >
 		auto DoAdd(const KeyType& key, const ValueType& value, int) -> decltype(std::declval<MapType__>().lower_bound(key), bool())
 		{
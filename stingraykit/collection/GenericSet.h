@@ -9,6 +9,7 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #include <stingraykit/collection/EnumerableHelpers.h>
+#include <stingraykit/collection/ForEach.h>
 #include <stingraykit/collection/ISet.h>
 #include <stingraykit/function/function.h>
 
@@ -20,10 +21,25 @@ namespace stingray
 	 * @{
 	 */
 
+	namespace Detail
+	{
+
+		template < typename SetType_, typename Enabler = void >
+		struct HasGenericSetComparer : public comparers::IsRelationalComparer<typename SetType_::value_compare>
+		{ };
+
+		template < typename SetType_ >
+		struct HasGenericSetComparer<SetType_, typename EnableIf<decltype(std::declval<typename SetType_::key_equal*>(), TrueType())::Value, void>::ValueT>
+			:	public comparers::IsEqualsComparer<typename SetType_::key_equal>
+		{ };
+
+	}
+
+
 	template < typename SetType_ >
 	class GenericSet : public virtual ISet<typename SetType_::value_type>
 	{
-		static_assert(comparers::IsRelationalComparer<typename SetType_::value_compare>::Value, "Expected Relational comparer");
+		static_assert(Detail::HasGenericSetComparer<SetType_>::Value, "Expected Relational comparer, or Equals comparer for hash set");
 
 	public:
 		using ValueType = typename SetType_::value_type;
@@ -69,7 +85,13 @@ namespace stingray
 			:	_items(make_shared_ptr<SetType>())
 		{
 			STINGRAYKIT_CHECK(enumerator, NullArgumentException("enumerator"));
-			Enumerable::ForEach(enumerator, Bind(&GenericSet::Add, this, _1));
+
+			// range insertion keeps the first of equal values, as Add does, and lets flat sets sort all values at once
+			std::vector<ValueType> values;
+			FOR_EACH(const ValueType value IN enumerator)
+				values.push_back(value);
+
+			_items->insert(values.begin(), values.end());
 		}
 
 		shared_ptr<IEnumerator<ValueType>> GetEnumerator() const override
@@ -125,18 +147,7 @@ namespace stingray
 		size_t RemoveWhere(const function<bool (const ValueType&)>& pred) override
 		{
 			CopyOnWrite();
-			size_t ret = 0;
-			for (auto it = _items->begin(); it != _items->end(); )
-			{
-				if (pred(*it))
-				{
-					it = _items->erase(it);
-					++ret;
-				}
-				else
-					++it;
-			}
-			return ret;
+			return DoRemoveWhere<SetType>(pred, 0);
 		}
 
 		void Clear() override
@@ -151,6 +162,28 @@ namespace stingray
 		}
 
 	private:
+		template < typename SetType__ >
+		auto DoRemoveWhere(const function<bool (const ValueType&)>& pred, int)
+				-> decltype(erase_if(std::declval<SetType__&>(), pred), size_t())
+		{ return erase_if(*_items, pred); }
+
+		template < typename SetType__ >
+		size_t DoRemoveWhere(const function<bool (const ValueType&)>& pred, long)
+		{
+			size_t ret = 0;
+			for (auto it = _items->begin(); it != _items->end(); )
+			{
+				if (pred(*it))
+				{
+					it = _items->erase(it);
+					++ret;
+				}
+				else
+					++it;
+			}
+			return ret;
+		}
+
 		template < typename SetType__ >
 		auto DoAdd(const ValueType& value, int) -> decltype(std::declval<SetType__>().lower_bound(value), bool())
 		{
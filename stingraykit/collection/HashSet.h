@@ -0,0 +1,30 @@
+#ifndef STINGRAYKIT_COLLECTION_HASHSET_H
+#define STINGRAYKIT_COLLECTION_HASHSET_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/GenericSet.h>
+#include <stingraykit/collection/flat_hash_set.h>
+
+namespace stingray
+{
+
+	/**
+	 * @addtogroup toolkit_collections
+	 * @{
+	 */
+
+	/// @brief Set backed by flat_hash_set, enumerates its values in no particular order
+	template < typename ValueType, typename HashType = std::hash<ValueType>, typename EqualsType = comparers::Equals >
+	using HashSet = GenericSet<flat_hash_set<ValueType, HashType, EqualsType>>;
+
+	/** @} */
+
+}
+
+#endif
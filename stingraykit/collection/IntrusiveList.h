@@ -142,8 +142,20 @@ namespace stingray
 		bool empty() const					{ return _root.unlinked(); }
 		size_t size() const					{ return std::distance(begin(), end()); }
 
+		ValueType& front()					{ return *begin(); }
+		const ValueType& front() const		{ return *begin(); }
+
+		ValueType& back()					{ return *--end(); }
+		const ValueType& back() const		{ return *--end(); }
+
 		void push_back(ValueType& value)	{ value.insert_before(&_root); }
 		void erase(ValueType& value)		{ value.unlink(); }
+
+		void clear()
+		{
+			while (!empty())
+				_root._next->unlink();
+		}
 	};
 
 	/** @} */
@@ -10,11 +10,13 @@
 
 #include <stingraykit/collection/DefaultCacheSizeMapper.h>
 #include <stingraykit/collection/ICache.h>
+#include <stingraykit/collection/IntrusiveList.h>
 #include <stingraykit/compare/comparers.h>
 #include <stingraykit/signal/signals.h>
 #include <stingraykit/string/ToString.h>
 
 #include <map>
+#include <unordered_map>
 
 namespace stingray
 {
@@ -26,11 +28,41 @@ namespace stingray
 	};
 
 
-	template < typename Key_, typename Value_, QueueEvictionPolicy::Enum EvictionPolicy_, typename SizeMapper_ = DefaultCacheSizeMapper, typename Less_ = comparers::Less >
-	class QueueCache final : public virtual ICache<Key_, Value_>
+	namespace Detail
 	{
-		static_assert(comparers::IsRelationalComparer<Less_>::Value, "Expected Relational comparer");
 
+		template < typename Key_ > auto		TestIsStdHashable(int) -> decltype(std::declval<const std::hash<Key_>&>()(std::declval<const Key_&>()), TrueType());
+		template < typename Key_ > FalseType	TestIsStdHashable(...);
+
+		template < typename Key_ >
+		struct DefaultQueueCacheComparer
+		{ using ValueT = typename If<decltype(TestIsStdHashable<Key_>(0))::Value, comparers::Equals, comparers::Less>::ValueT; };
+
+		template < typename Key_, typename Entry_, typename Comparer_, typename Hash_, bool IsRelational = comparers::IsRelationalComparer<Comparer_>::Value >
+		struct QueueCacheDictionary
+		{
+			static_assert(comparers::IsEqualsComparer<Comparer_>::Value, "Expected Relational or Equals comparer");
+
+			using ValueT = std::unordered_map<Key_, Entry_, Hash_, Comparer_>;
+		};
+
+		template < typename Key_, typename Entry_, typename Comparer_, typename Hash_ >
+		struct QueueCacheDictionary<Key_, Entry_, Comparer_, Hash_, true>
+		{ using ValueT = std::map<Key_, Entry_, Comparer_>; };
+
+	}
+
+
+	/**
+	 * @brief Cache evicting entries in order of insertion (Fifo) or last access (Lru)
+	 * @details Entries are linked into an intrusive queue, so hit, insertion and eviction do not allocate anything except
+	 * the dictionary node of a new entry. With an Equals comparer the dictionary is a hash table using Hash_, with a Relational
+	 * one it is an ordered map and Hash_ is unused. By default keys hashable with std::hash get the hash table, others get
+	 * the ordered map with comparers::Less.
+	 */
+	template < typename Key_, typename Value_, QueueEvictionPolicy::Enum EvictionPolicy_, typename SizeMapper_ = DefaultCacheSizeMapper, typename Comparer_ = typename Detail::DefaultQueueCacheComparer<Key_>::ValueT, typename Hash_ = std::hash<Key_> >
+	class QueueCache final : public virtual ICache<Key_, Value_>
+	{
 		using Base = ICache<Key_, Value_>;
 
 		using KeyPassingType = typename Base::KeyPassingType;
@@ -38,30 +70,26 @@ namespace stingray
 
 		using OnEvictedSignature = typename Base::OnEvictedSignature;
 
-		using StampType = u64;
-
-		struct StampedValue
+		struct Entry : public IntrusiveListNode<Entry>
 		{
+			const Key_*	KeyPtr;
 			Value_		Value;
-			StampType	Stamp;
 
 		public:
-			StampedValue(ValuePassingType value, StampType stamp)
-				:	Value(value),
-					Stamp(stamp)
+			explicit Entry(ValuePassingType value)
+				:	KeyPtr(),
+					Value(value)
 			{ }
 		};
 
-		using Dictionary = std::map<Key_, StampedValue, Less_>;
-		using Queue = std::map<StampType, typename Dictionary::iterator>;
+		using Dictionary = typename Detail::QueueCacheDictionary<Key_, Entry, Comparer_, Hash_>::ValueT;
+		using Queue = IntrusiveList<Entry>;
 
 	private:
 		size_t							_capacity;
 		size_t							_size;
 		SizeMapper_						_sizeMapper;
 
-		StampType						_monotonic;
-
 		Dictionary						_dictionary;
 		Queue							_queue;
 
@@ -70,30 +98,33 @@ namespace stingray
 	public:
 		QueueCache(size_t capacity)
 			:	_capacity(capacity),
-				_size(),
-				_monotonic()
+				_size()
 		{ }
 
+		~QueueCache() override
+		{ _queue.clear(); }
+
 		bool TryGet(KeyPassingType key, Value_& out) override
 		{ return DoTryGet<EvictionPolicy_>(key, out); }
 
 		void Set(KeyPassingType key, ValuePassingType value) override
 		{
-			const StampType newStamp = MakeStamp();
-
 			typename Dictionary::iterator dictionaryIter = _dictionary.find(key);
 			if (dictionaryIter != _dictionary.end())
 			{
-				StampedValue& stampedValue = dictionaryIter->second;
+				Entry& entry = dictionaryIter->second;
 
-				_size -= _sizeMapper(stampedValue.Value);
-				_queue.erase(stampedValue.Stamp);
-				stampedValue = StampedValue(value, newStamp);
+				_size -= _sizeMapper(entry.Value);
+				_queue.erase(entry);
+				entry.Value = value;
 			}
 			else
-				dictionaryIter = _dictionary.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(value, newStamp)).first;
+			{
+				dictionaryIter = _dictionary.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(value)).first;
+				dictionaryIter->second.KeyPtr = &dictionaryIter->first;
+			}
 
-			_queue.emplace(newStamp, dictionaryIter);
+			_queue.push_back(dictionaryIter->second);
 			_size += _sizeMapper(value);
 
 			EvictExpired();
@@ -105,10 +136,7 @@ namespace stingray
 			if (dictionaryIter == _dictionary.end())
 				return false;
 
-			const typename Queue::iterator queueIter = _queue.find(dictionaryIter->second.Stamp);
-			STINGRAYKIT_CHECK(queueIter != _queue.end(), "No corresponding queue entry for existing dictionary entry.");
-
-			DoRemove(dictionaryIter, queueIter);
+			DoRemove(dictionaryIter);
 			return true;
 		}
 
@@ -117,7 +145,6 @@ namespace stingray
 			_size = 0;
 			_queue.clear();
 			_dictionary.clear();
-			_monotonic = 0;
 		}
 
 		size_t GetSize() const override
@@ -145,54 +172,47 @@ namespace stingray
 			if (iter == _dictionary.end())
 				return false;
 
-			StampedValue& value = iter->second;
+			Entry& entry = iter->second;
 
-			const StampType newStamp = MakeStamp();
+			_queue.erase(entry);
+			_queue.push_back(entry);
 
-			_queue.erase(value.Stamp);
-			_queue.emplace(newStamp, iter);
-			value.Stamp = newStamp;
-
-			out = value.Value;
+			out = entry.Value;
 			return true;
 		}
 
-		StampType MakeStamp()
-		{ return _monotonic++; }
-
 		void EvictExpired()
 		{
 			while (_size > _capacity)
 			{
 				STINGRAYKIT_CHECK(!_queue.empty(), StringBuilder() % "Size limit reached, but the queue is empty. Size: " % _size % ", capacity: " % _capacity);
 
-				const typename Queue::iterator queueIter = _queue.begin();
-				const typename Dictionary::iterator dictionaryIter = queueIter->second;
+				const Entry& entry = _queue.front();
 
-				const Key_ key = dictionaryIter->first;
-				const Value_ value = dictionaryIter->second.Value;
+				const Key_ key = *entry.KeyPtr;
+				const Value_ value = entry.Value;
 
-				DoRemove(dictionaryIter, queueIter);
+				DoRemove(_dictionary.find(key));
 
 				_onEvicted(key, value);
 			}
 		}
 
-		void DoRemove(typename Dictionary::iterator dictionaryIter, typename Queue::iterator queueIter)
+		void DoRemove(typename Dictionary::iterator dictionaryIter)
 		{
 			_size -= _sizeMapper(dictionaryIter->second.Value);
-			_queue.erase(queueIter);
+			_queue.erase(dictionaryIter->second);
 			_dictionary.erase(dictionaryIter);
 		}
 	};
 
 
-	template < typename Key_, typename Value_, typename SizeMapper_ = DefaultCacheSizeMapper, typename Less_ = comparers::Less >
-	using FifoCache = QueueCache<Key_, Value_, QueueEvictionPolicy::Fifo, SizeMapper_, Less_>;
+	template < typename Key_, typename Value_, typename SizeMapper_ = DefaultCacheSizeMapper, typename Comparer_ = typename Detail::DefaultQueueCacheComparer<Key_>::ValueT, typename Hash_ = std::hash<Key_> >
+	using FifoCache = QueueCache<Key_, Value_, QueueEvictionPolicy::Fifo, SizeMapper_, Comparer_, Hash_>;
 
 
-	template < typename Key_, typename Value_, typename SizeMapper_ = DefaultCacheSizeMapper, typename Less_ = comparers::Less >
-	using LruCache = QueueCache<Key_, Value_, QueueEvictionPolicy::Lru, SizeMapper_, Less_>;
+	template < typename Key_, typename Value_, typename SizeMapper_ = DefaultCacheSizeMapper, typename Comparer_ = typename Detail::DefaultQueueCacheComparer<Key_>::ValueT, typename Hash_ = std::hash<Key_> >
+	using LruCache = QueueCache<Key_, Value_, QueueEvictionPolicy::Lru, SizeMapper_, Comparer_, Hash_>;
 
 }
 
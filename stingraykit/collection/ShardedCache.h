@@ -0,0 +1,291 @@
+#ifndef STINGRAYKIT_COLLECTION_SHARDEDCACHE_H
+#define STINGRAYKIT_COLLECTION_SHARDEDCACHE_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/QueueCache.h>
+#include <stingraykit/collection/inplace_vector.h>
+#include <stingraykit/function/bind.h>
+#include <stingraykit/future.h>
+#include <stingraykit/unique_ptr.h>
+
+namespace stingray
+{
+
+	/**
+	 * @brief Thread-safe cache made of independently locked shards
+	 * @details Key is mapped to one of the shards by its hash, and every shard is a separate ShardCache_ (LruCache, TwoQueueCache, etc.)
+	 * guarded by its own mutex, so threads working with different shards do not contend. Capacity is set per shard.
+	 * OnEvicted is invoked after the shard lock is released, with all the entries evicted by the operation.
+	 * @par Example:
+	 * @code
+	 * ShardedCache<std::string, ImagePtr> cache(16, 64);
+	 * const ImagePtr image = cache.GetOrCompute(path, Bind(&DecodeImage, path));
+	 * @endcode
+	 */
+	template < typename Key_, typename Value_, typename ShardCache_ = LruCache<Key_, Value_>, typename Hash_ = std::hash<Key_>, typename Equals_ = comparers::Equals >
+	class ShardedCache final : public virtual ICache<Key_, Value_>
+	{
+		static_assert(comparers::IsEqualsComparer<Equals_>::Value, "Expected Equals comparer");
+
+		using Base = ICache<Key_, Value_>;
+
+		using KeyPassingType = typename Base::KeyPassingType;
+		using ValuePassingType = typename Base::ValuePassingType;
+
+		using OnEvictedSignature = typename Base::OnEvictedSignature;
+
+		using EvictedEntry = std::pair<Key_, Value_>;
+		using EvictedEntries = inplace_vector<EvictedEntry, 4>;
+		using PendingMap = std::unordered_map<Key_, shared_future<Value_>, Hash_, Equals_>;
+
+		struct Shard
+		{
+			Mutex						Guard;
+			ShardCache_					Cache;
+			PendingMap					Pending;
+			EvictedEntries				Evicted;
+			Token						Connection;
+
+		public:
+			template < typename... Args >
+			explicit Shard(const Args&... args)
+				:	Cache(args...),
+					Connection(Cache.OnEvicted().connect(Bind(&Shard::AddEvicted, this, _1, _2)))
+			{ }
+
+			void TakeEvicted(EvictedEntries& evicted)
+			{
+				if (Evicted.empty())
+					return;
+
+				for (EvictedEntry& entry : Evicted)
+					evicted.push_back(std::move(entry));
+
+				Evicted.clear();
+			}
+
+		private:
+			void AddEvicted(KeyPassingType key, ValuePassingType value)
+			{ Evicted.emplace_back(key, value); }
+		};
+		STINGRAYKIT_DECLARE_UNIQ_PTR(Shard);
+
+		class PendingGuard
+		{
+			STINGRAYKIT_NONCOPYABLE(PendingGuard);
+
+		private:
+			Shard&						_shard;
+			KeyPassingType				_key;
+			bool						_active;
+
+		public:
+			PendingGuard(Shard& shard, KeyPassingType key)
+				:	_shard(shard),
+					_key(key),
+					_active(false)
+			{ }
+
+			~PendingGuard()
+			{
+				if (!_active)
+					return;
+
+				MutexLock l(_shard.Guard);
+				_shard.Pending.erase(_key);
+			}
+
+			/// @brief Registers pending computation, shard lock must be held
+			void Acquire(const shared_future<Value_>& future)
+			{
+				_shard.Pending.emplace(_key, future);
+				_active = true;
+			}
+
+			/// @brief Erases pending computation, shard lock must be held
+			void Release()
+			{
+				_shard.Pending.erase(_key);
+				_active = false;
+			}
+		};
+
+	private:
+		Hash_							_hash;
+		std::vector<ShardUniqPtr>		_shards;
+
+		signal<OnEvictedSignature>		_onEvicted;
+
+	public:
+		/// @param shardArgs Arguments passed to constructor of every shard, e.g. capacity of the shard
+		template < typename... ShardArgs >
+		explicit ShardedCache(size_t shardsCount, const ShardArgs&... shardArgs)
+		{
+			STINGRAYKIT_CHECK(shardsCount != 0, ArgumentException("shardsCount"));
+
+			_shards.reserve(shardsCount);
+			for (size_t i = 0; i < shardsCount; ++i)
+				_shards.push_back(make_unique_ptr<Shard>(shardArgs...));
+		}
+
+		bool TryGet(KeyPassingType key, Value_& out) override
+		{
+			Shard& shard = GetShard(key);
+
+			EvictedEntries evicted;
+			bool result = false;
+			{
+				MutexLock l(shard.Guard);
+				result = shard.Cache.TryGet(key, out);
+				shard.TakeEvicted(evicted);
+			}
+
+			InvokeOnEvicted(evicted);
+			return result;
+		}
+
+		void Set(KeyPassingType key, ValuePassingType value) override
+		{
+			Shard& shard = GetShard(key);
+
+			EvictedEntries evicted;
+			{
+				MutexLock l(shard.Guard);
+				shard.Cache.Set(key, value);
+				shard.TakeEvicted(evicted);
+			}
+
+			InvokeOnEvicted(evicted);
+		}
+
+		bool Remove(KeyPassingType key) override
+		{
+			Shard& shard = GetShard(key);
+
+			EvictedEntries evicted;
+			bool result = false;
+			{
+				MutexLock l(shard.Guard);
+				result = shard.Cache.Remove(key);
+				shard.TakeEvicted(evicted);
+			}
+
+			InvokeOnEvicted(evicted);
+			return result;
+		}
+
+		void Clear() override
+		{
+			for (const ShardUniqPtr& shard : _shards)
+			{
+				MutexLock l(shard->Guard);
+				shard->Cache.Clear();
+			}
+		}
+
+		size_t GetSize() const override
+		{
+			size_t result = 0;
+			for (const ShardUniqPtr& shard : _shards)
+			{
+				MutexLock l(shard->Guard);
+				result += shard->Cache.GetSize();
+			}
+			return result;
+		}
+
+		signal_connector<OnEvictedSignature> OnEvicted() const override
+		{ return _onEvicted.connector(); }
+
+		/**
+		 * @brief Returns cached value or the one created by factory, which is then put into the cache
+		 * @details Factory is invoked without any lock held. Concurrent calls for the same key wait for the first one to compute the value
+		 * instead of invoking factory again, and get the exception thrown by it, if any (BrokenPromise for the exceptions not derived from
+		 * std::exception). Value set by Set during the computation is replaced by the computed one.
+		 */
+		template < typename FactoryFunc >
+		Value_ GetOrCompute(KeyPassingType key, const FactoryFunc& factory)
+		{
+			Shard& shard = GetShard(key);
+
+			promise<Value_> computation;
+			shared_future<Value_> pending;
+			optional<Value_> cached;
+
+			// Pending computation is erased on every exit path, otherwise the key would be stuck with a broken promise
+			PendingGuard pendingGuard(shard, key);
+
+			EvictedEntries evicted;
+			{
+				MutexLock l(shard.Guard);
+
+				Value_ value;
+				if (shard.Cache.TryGet(key, value))
+					cached.emplace(value);
+				else
+				{
+					const typename PendingMap::const_iterator pendingIt = shard.Pending.find(key);
+					if (pendingIt != shard.Pending.end())
+						pending = pendingIt->second;
+					else
+						pendingGuard.Acquire(computation.get_future());
+				}
+
+				shard.TakeEvicted(evicted);
+			}
+
+			InvokeOnEvicted(evicted);
+
+			if (cached)
+				return *cached;
+
+			if (pending.valid())
+				return pending.get();
+
+			optional<Value_> computed;
+			EvictedEntries evictedBySet;
+			try
+			{
+				computed.emplace(factory());
+
+				MutexLock l(shard.Guard);
+				pendingGuard.Release();
+				shard.Cache.Set(key, *computed);
+				shard.TakeEvicted(evictedBySet);
+			}
+			catch (const std::exception& ex)
+			{
+				computation.set_exception(MakeExceptionPtr(ex));
+				throw;
+			}
+
+			computation.set_value(*computed);
+			InvokeOnEvicted(evictedBySet);
+
+			return *computed;
+		}
+
+	private:
+		Shard& GetShard(KeyPassingType key) const
+		{
+			// Fibonacci hashing spreads identity hashes of integers over all the shards
+			const u64 hash = (u64)_hash(key) * 0x9E3779B97F4A7C15ull;
+			return *_shards[(hash >> 32) % _shards.size()];
+		}
+
+		void InvokeOnEvicted(const EvictedEntries& evicted) const
+		{
+			for (const EvictedEntry& entry : evicted)
+				_onEvicted(entry.first, entry.second);
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,373 @@
+#ifndef STINGRAYKIT_COLLECTION_TINYLFUCACHE_H
+#define STINGRAYKIT_COLLECTION_TINYLFUCACHE_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/DefaultCacheSizeMapper.h>
+#include <stingraykit/collection/ICache.h>
+#include <stingraykit/collection/IntrusiveList.h>
+#include <stingraykit/compare/comparers.h>
+#include <stingraykit/signal/signals.h>
+#include <stingraykit/string/ToString.h>
+
+#include <unordered_map>
+
+namespace stingray
+{
+
+	namespace Detail
+	{
+
+		/**
+		 * @brief Count-min sketch of 4-bit counters estimating how often a hash was seen recently
+		 * @details Counters are halved once the number of increments reaches ten times the number of expected entries, so old popularity fades out.
+		 */
+		class FrequencySketch
+		{
+			static const size_t Depth = 4;
+			static const size_t CountersPerWord = 16;
+			static const size_t MaxWidthLog2 = 24;
+
+		private:
+			std::vector<u64>	_table;
+			size_t				_widthLog2;
+			size_t				_additions;
+			size_t				_sampleSize;
+
+		public:
+			explicit FrequencySketch(size_t expectedEntries)
+				:	_widthLog2(4),
+					_additions(0)
+			{
+				while (_widthLog2 < MaxWidthLog2 && ((size_t)1 << _widthLog2) < expectedEntries)
+					++_widthLog2;
+
+				_sampleSize = 10 * ((size_t)1 << _widthLog2);
+
+				// every row has four times more counters than expected entries to keep collisions rare
+				_widthLog2 += 2;
+				_table.resize(Depth * GetRowWords());
+			}
+
+			void Increment(u64 hash)
+			{
+				bool added = false;
+				for (size_t row = 0; row < Depth; ++row)
+				{
+					const size_t index = GetIndex(hash, row);
+					u64& word = _table[GetWordIndex(index, row)];
+					const size_t shift = GetShift(index);
+
+					if (((word >> shift) & 0xF) != 0xF)
+					{
+						word += (u64)1 << shift;
+						added = true;
+					}
+				}
+
+				if (added && ++_additions == _sampleSize)
+					Age();
+			}
+
+			u8 GetFrequency(u64 hash) const
+			{
+				u8 result = 0xF;
+				for (size_t row = 0; row < Depth; ++row)
+				{
+					const size_t index = GetIndex(hash, row);
+					result = std::min<u8>(result, (_table[GetWordIndex(index, row)] >> GetShift(index)) & 0xF);
+				}
+				return result;
+			}
+
+			void Clear()
+			{
+				std::fill(_table.begin(), _table.end(), 0);
+				_additions = 0;
+			}
+
+		private:
+			size_t GetRowWords() const
+			{ return ((size_t)1 << _widthLog2) / CountersPerWord; }
+
+			size_t GetIndex(u64 hash, size_t row) const
+			{
+				static const u64 Seeds[Depth] = { 0xC3A5C85C97CB3127ull, 0xB492B66FBE98F273ull, 0x9AE16A3B2F90404Full, 0xCBF29CE484222325ull };
+				return (size_t)(((hash + Seeds[row]) * 0x9E3779B97F4A7C15ull) >> (64 - _widthLog2));
+			}
+
+			size_t GetWordIndex(size_t index, size_t row) const
+			{ return row * GetRowWords() + index / CountersPerWord; }
+
+			static size_t GetShift(size_t index)
+			{ return (index % CountersPerWord) * 4; }
+
+			void Age()
+			{
+				for (u64& word : _table)
+					word = (word >> 1) & 0x7777777777777777ull;
+				_additions /= 2;
+			}
+		};
+
+	}
+
+
+	/**
+	 * @brief Scan-resistant cache with W-TinyLFU eviction policy
+	 * @details New entries go to a small LRU window (1% of capacity). Entries leaving the window become candidates for the main area,
+	 * which is a segmented LRU of probation and protected (80%) queues. A candidate is admitted only if its access frequency, estimated by
+	 * a count-min sketch, is higher than the one of the main area victim, so one-shot scans do not flush frequently used entries.
+	 * Hit, insertion and eviction cost O(1).
+	 */
+	template < typename Key_, typename Value_, typename SizeMapper_ = DefaultCacheSizeMapper, typename Hash_ = std::hash<Key_>, typename Equals_ = comparers::Equals >
+	class TinyLfuCache final : public virtual ICache<Key_, Value_>
+	{
+		static_assert(comparers::IsEqualsComparer<Equals_>::Value, "Expected Equals comparer");
+
+		using Base = ICache<Key_, Value_>;
+
+		using KeyPassingType = typename Base::KeyPassingType;
+		using ValuePassingType = typename Base::ValuePassingType;
+
+		using OnEvictedSignature = typename Base::OnEvictedSignature;
+
+		struct Segment;
+
+		struct Entry : public IntrusiveListNode<Entry>
+		{
+			const Key_*	KeyPtr;
+			Value_		Value;
+			size_t		Size;
+			u64			Hash;
+			Segment*	Owner;
+
+		public:
+			Entry(ValuePassingType value, size_t size, u64 hash)
+				:	KeyPtr(),
+					Value(value),
+					Size(size),
+					Hash(hash),
+					Owner()
+			{ }
+		};
+
+		struct Segment
+		{
+			IntrusiveList<Entry>	Entries;
+			size_t					Size;
+			size_t					Capacity;
+
+		public:
+			explicit Segment(size_t capacity) : Size(0), Capacity(capacity) { }
+		};
+
+		using Dictionary = std::unordered_map<Key_, Entry, Hash_, Equals_>;
+
+	private:
+		size_t							_capacity;
+		SizeMapper_						_sizeMapper;
+		Hash_							_hash;
+
+		Dictionary						_dictionary;
+
+		Segment							_window;
+		Segment							_probation;
+		Segment							_protected;
+
+		Detail::FrequencySketch			_sketch;
+
+		signal<OnEvictedSignature>		_onEvicted;
+
+	public:
+		/// @param expectedEntries Number of entries the frequency sketch is sized for, equals to capacity if zero. Set it for caches with custom SizeMapper_.
+		explicit TinyLfuCache(size_t capacity, size_t expectedEntries = 0)
+			:	_capacity(capacity),
+				_window(capacity == 0 ? 0 : std::max<size_t>(capacity / 100, 1)),
+				_probation(0),
+				_protected((capacity - _window.Capacity) * 4 / 5),
+				_sketch(expectedEntries == 0 ? capacity : expectedEntries)
+		{ }
+
+		~TinyLfuCache() override
+		{ ClearSegments(); }
+
+		bool TryGet(KeyPassingType key, Value_& out) override
+		{
+			_sketch.Increment(_hash(key));
+
+			const typename Dictionary::iterator iter = _dictionary.find(key);
+			if (iter == _dictionary.end())
+				return false;
+
+			Entry& entry = iter->second;
+			OnHit(entry);
+
+			out = entry.Value;
+			return true;
+		}
+
+		void Set(KeyPassingType key, ValuePassingType value) override
+		{
+			const u64 hash = _hash(key);
+			_sketch.Increment(hash);
+
+			const size_t size = _sizeMapper(value);
+
+			const typename Dictionary::iterator iter = _dictionary.find(key);
+			if (iter != _dictionary.end())
+			{
+				Entry& entry = iter->second;
+
+				entry.Owner->Size -= entry.Size;
+				entry.Value = value;
+				entry.Size = size;
+				entry.Owner->Size += entry.Size;
+
+				OnHit(entry);
+			}
+			else
+			{
+				const typename Dictionary::iterator newIter = _dictionary.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(value, size, hash)).first;
+				Entry& entry = newIter->second;
+
+				entry.KeyPtr = &newIter->first;
+				Link(entry, _window);
+			}
+
+			EvictExpired();
+		}
+
+		bool Remove(KeyPassingType key) override
+		{
+			const typename Dictionary::iterator iter = _dictionary.find(key);
+			if (iter == _dictionary.end())
+				return false;
+
+			DoRemove(iter);
+			return true;
+		}
+
+		void Clear() override
+		{
+			ClearSegments();
+			_dictionary.clear();
+			_sketch.Clear();
+		}
+
+		size_t GetSize() const override
+		{ return _window.Size + _probation.Size + _protected.Size; }
+
+		signal_connector<OnEvictedSignature> OnEvicted() const override
+		{ return _onEvicted.connector(); }
+
+	private:
+		void OnHit(Entry& entry)
+		{
+			if (entry.Owner != &_probation)
+			{
+				Move(entry, *entry.Owner);
+				return;
+			}
+
+			Move(entry, _protected);
+
+			while (_protected.Size > _protected.Capacity)
+				Move(_protected.Entries.front(), _probation);
+		}
+
+		void EvictExpired()
+		{
+			size_t candidates = 0;
+			while (_window.Size > _window.Capacity)
+			{
+				Move(_window.Entries.front(), _probation);
+				++candidates;
+			}
+
+			while (GetSize() > _capacity)
+			{
+				Entry& victim = GetVictim();
+
+				if (candidates == 0 || victim.Owner != &_probation)
+				{
+					Evict(victim);
+					continue;
+				}
+
+				Entry& candidate = _probation.Entries.back();
+				if (&candidate != &victim && _sketch.GetFrequency(candidate.Hash) > _sketch.GetFrequency(victim.Hash))
+					Evict(victim);
+				else
+				{
+					Evict(candidate);
+					--candidates;
+				}
+			}
+		}
+
+		Entry& GetVictim()
+		{
+			if (!_probation.Entries.empty())
+				return _probation.Entries.front();
+
+			if (!_protected.Entries.empty())
+				return _protected.Entries.front();
+
+			STINGRAYKIT_CHECK(!_window.Entries.empty(), StringBuilder() % "Size limit reached, but the cache is empty. Size: " % GetSize() % ", capacity: " % _capacity);
+			return _window.Entries.front();
+		}
+
+		void Evict(Entry& entry)
+		{
+			const Key_ key = *entry.KeyPtr;
+			const Value_ value = entry.Value;
+
+			DoRemove(_dictionary.find(key));
+
+			_onEvicted(key, value);
+		}
+
+		void DoRemove(typename Dictionary::iterator iter)
+		{
+			Unlink(iter->second);
+			_dictionary.erase(iter);
+		}
+
+		void Link(Entry& entry, Segment& segment)
+		{
+			segment.Entries.push_back(entry);
+			segment.Size += entry.Size;
+			entry.Owner = &segment;
+		}
+
+		void Unlink(Entry& entry)
+		{
+			entry.Owner->Entries.erase(entry);
+			entry.Owner->Size -= entry.Size;
+		}
+
+		void Move(Entry& entry, Segment& segment)
+		{
+			Unlink(entry);
+			Link(entry, segment);
+		}
+
+		void ClearSegments()
+		{
+			for (Segment* segment : { &_window, &_probation, &_protected })
+			{
+				segment->Entries.clear();
+				segment->Size = 0;
+			}
+		}
+	};
+
+}
+
+#endif
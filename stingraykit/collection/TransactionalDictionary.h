@@ -12,6 +12,7 @@
 #include <stingraykit/collection/ITransactionalDictionary.h>
 #include <stingraykit/collection/KeyExceptionCreator.h>
 #include <stingraykit/collection/TransactionHelpers.h>
+#include <stingraykit/collection/persistent_map.h>
 #include <stingraykit/diagnostics/ExecutorsProfiler.h>
 #include <stingraykit/signal/signals.h>
 
@@ -52,7 +53,8 @@ namespace stingray
 		using ValueEqualsComparer = ValueEqualsComparer_;
 
 	private:
-		using MapType = std::map<KeyType, ValueType, KeyLessComparer>;
+		// persistent_map copies share nodes, so copy-on-write of a map held by a snapshot costs O(log n) per changed entry, not O(n)
+		using MapType = persistent_map<KeyType, ValueType, KeyLessComparer>;
 		STINGRAYKIT_DECLARE_PTR(MapType);
 		STINGRAYKIT_DECLARE_CONST_PTR(MapType);
 
@@ -387,7 +389,7 @@ namespace stingray
 					if (!ValueEqualsComparer()(value, addedIt->second))
 					{
 						CopyAddedOnWrite(_added.get());
-						(*_added)[key] = value;
+						_added->insert_or_assign(key, value);
 					}
 				}
 				else
@@ -520,6 +522,57 @@ namespace stingray
 			{ return Utils::CopyOnWrite(_removed, _removedHolder, src); }
 		};
 
+		class SnapshotDiffEnumerator : public virtual IEnumerator<DiffEntryType>
+		{
+			using DiffEnumeratorType = typename MapType::template diff_enumerator<ValueEqualsComparer>;
+
+		private:
+			const HolderPtr				_from;
+			const HolderPtr				_to;
+			DiffEnumeratorType			_enumerator;
+
+		public:
+			SnapshotDiffEnumerator(const HolderPtr& from, const HolderPtr& to)
+				:	_from(STINGRAYKIT_REQUIRE_NOT_NULL(from)),
+					_to(STINGRAYKIT_REQUIRE_NOT_NULL(to)),
+					_enumerator(*_from->Items, *_to->Items)
+			{ }
+
+			bool Valid() const override
+			{ return _enumerator.valid(); }
+
+			DiffEntryType Get() const override
+			{
+				STINGRAYKIT_CHECK(Valid(), "Enumerator is not valid!");
+				return Utils::MakeDiffEntry(_enumerator.removed() ? CollectionOp::Removed : CollectionOp::Added, _enumerator.get());
+			}
+
+			void Next() override
+			{
+				STINGRAYKIT_CHECK(Valid(), "Enumerator is not valid!");
+				_enumerator.next();
+			}
+		};
+
+	public:
+		/// @brief Contents of the dictionary at some moment, keeping it costs only the nodes changed by later commits
+		class Snapshot : public virtual IEnumerable<PairType>
+		{
+			friend class TransactionalDictionary;
+
+		private:
+			const HolderPtr				_holder;
+
+		public:
+			explicit Snapshot(const HolderPtr& holder)
+				:	_holder(STINGRAYKIT_REQUIRE_NOT_NULL(holder))
+			{ }
+
+			shared_ptr<IEnumerator<PairType>> GetEnumerator() const override
+			{ return EnumeratorFromStlContainer<PairType>(*_holder->Items, _holder); }
+		};
+		STINGRAYKIT_DECLARE_PTR(Snapshot);
+
 	private:
 		const ImplDataPtr					_impl;
 
@@ -608,6 +661,21 @@ namespace stingray
 		signal_connector<OnChangedSignature> OnChanged() const override
 		{ return _impl->OnChanged.connector(); }
 
+		SnapshotPtr GetSnapshot() const
+		{ return make_shared_ptr<Snapshot>(_impl->GetItemsHolder()); }
+
+		/**
+		 * @brief Returns changes turning 'from' snapshot into 'to' one, in the same order as Diff() of a transaction
+		 * @details Snapshots share the entries not changed between them, and these are skipped without enumeration. So the cost is
+		 * proportional to the number of changed entries, e.g. for an observer getting changes made since its last snapshot.
+		 */
+		static DiffTypePtr Diff(const SnapshotPtr& from, const SnapshotPtr& to)
+		{
+			STINGRAYKIT_CHECK(from, NullArgumentException("from"));
+			STINGRAYKIT_CHECK(to, NullArgumentException("to"));
+			return MakeSimpleEnumerable(Bind(MakeShared<SnapshotDiffEnumerator>(), from->_holder, to->_holder));
+		}
+
 		const Mutex& GetSyncRoot() const override
 		{ return *_impl->Guard; }
 	};
@@ -13,7 +13,7 @@
 namespace stingray
 {
 
-	template < typename Key_, typename Value_, typename SizeMapper_ = DefaultCacheSizeMapper, typename Less_ = comparers::Less >
+	template < typename Key_, typename Value_, typename SizeMapper_ = DefaultCacheSizeMapper, typename Comparer_ = typename Detail::DefaultQueueCacheComparer<Key_>::ValueT, typename Hash_ = std::hash<Key_> >
 	class TwoQueueCache final : public virtual ICache<Key_, Value_>
 	{
 		using Base = ICache<Key_, Value_>;
@@ -23,8 +23,8 @@ namespace stingray
 
 		using OnEvictedSignature = typename Base::OnEvictedSignature;
 
-		using HotCache = LruCache<Key_, Value_, SizeMapper_, Less_>;
-		using Queue = FifoCache<Key_, Value_, SizeMapper_, Less_>;
+		using HotCache = LruCache<Key_, Value_, SizeMapper_, Comparer_, Hash_>;
+		using Queue = FifoCache<Key_, Value_, SizeMapper_, Comparer_, Hash_>;
 
 	private:
 		Queue							_inQueue;
@@ -0,0 +1,1047 @@
+#ifndef STINGRAYKIT_COLLECTION_BTREE_H
+#define STINGRAYKIT_COLLECTION_BTREE_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/iterator_base.h>
+#include <stingraykit/compare/comparers.h>
+#include <stingraykit/core/NullPtrType.h>
+#include <stingraykit/metaprogramming/EnableIf.h>
+#include <stingraykit/metaprogramming/If.h>
+#include <stingraykit/metaprogramming/TypeRelationships.h>
+#include <stingraykit/metaprogramming/TypeTraits.h>
+#include <stingraykit/Types.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+#if defined(__SSE2__)
+#	include <emmintrin.h>
+#endif
+
+namespace stingray
+{
+
+	namespace Detail
+	{
+
+		template < typename Compare_ >
+		struct IsBTreeNaturalLess : public FalseType
+		{ };
+
+		template < typename T >
+		struct IsBTreeNaturalLess<std::less<T>> : public TrueType
+		{ };
+
+		template < >
+		struct IsBTreeNaturalLess<comparers::Less> : public TrueType
+		{ };
+
+
+		/// @brief Searches sorted keys of a single node
+		template < typename Key_, typename Compare_, typename Enabler = void >
+		struct BTreeKeySearch
+		{
+			template < typename K >
+			static size_t LowerBound(const Key_* keys, size_t count, const K& key, const Compare_& cmp)
+			{ return std::lower_bound(keys, keys + count, key, cmp) - keys; }
+
+			template < typename K >
+			static size_t UpperBound(const Key_* keys, size_t count, const K& key, const Compare_& cmp)
+			{ return std::upper_bound(keys, keys + count, key, cmp) - keys; }
+		};
+
+
+#if defined(__SSE2__)
+
+		/**
+		 * @brief Compares four 32-bit keys at once with SSE2
+		 * @details Keys are sorted, so the bound is within the first block having a key on the other side of the searched one. Unsigned
+		 * keys are biased to be compared with signed comparisons. Lookups by other types of keys use the generic binary search.
+		 */
+		template < typename Key_, typename Compare_ >
+		struct BTreeKeySearch<Key_, Compare_, typename EnableIf<IsInt<Key_>::Value && sizeof(Key_) == 4 && IsBTreeNaturalLess<Compare_>::Value, void>::ValueT>
+		{
+			static size_t LowerBound(const Key_* keys, size_t count, Key_ key, const Compare_&)
+			{
+				const __m128i bias = _mm_set1_epi32(IsSigned<Key_>::Value ? 0 : (s32)0x80000000);
+				const __m128i needle = _mm_xor_si128(_mm_set1_epi32((s32)key), bias);
+
+				size_t index = 0;
+				for (; index + 4 <= count; index += 4)
+				{
+					const __m128i block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + index)), bias);
+					const int less = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(block, needle)));
+					if (less != 0xF)
+						return index + __builtin_ctz(~less);
+				}
+
+				while (index < count && keys[index] < key)
+					++index;
+				return index;
+			}
+
+			static size_t UpperBound(const Key_* keys, size_t count, Key_ key, const Compare_&)
+			{
+				const __m128i bias = _mm_set1_epi32(IsSigned<Key_>::Value ? 0 : (s32)0x80000000);
+				const __m128i needle = _mm_xor_si128(_mm_set1_epi32((s32)key), bias);
+
+				size_t index = 0;
+				for (; index + 4 <= count; index += 4)
+				{
+					const __m128i block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + index)), bias);
+					const int greater = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(block, needle)));
+					if (greater != 0)
+						return index + __builtin_ctz(greater);
+				}
+
+				while (index < count && !(key < keys[index]))
+					++index;
+				return index;
+			}
+
+			template < typename K >
+			static size_t LowerBound(const Key_* keys, size_t count, const K& key, const Compare_& cmp)
+			{ return std::lower_bound(keys, keys + count, key, cmp) - keys; }
+
+			template < typename K >
+			static size_t UpperBound(const Key_* keys, size_t count, const K& key, const Compare_& cmp)
+			{ return std::upper_bound(keys, keys + count, key, cmp) - keys; }
+		};
+
+#endif
+
+
+		/**
+		 * @brief In-memory B+tree
+		 * @details Values are kept in leaves linked into a list, inner nodes only hold separator keys, so all keys of a child are not less
+		 * than the separator on its left and are less than the separator on its right. Nodes are sized to a few cache lines and are
+		 * searched linearly, with SSE2 for 32-bit integer keys compared naturally. Insertion at the end of the tree keeps nodes full, so
+		 * sorted input produces a compact tree.
+		 * Any insertion or erasure may move other values between nodes and invalidates all iterators and references, unlike std::map.
+		 * Swapping or moving the tree invalidates its end iterator.
+		 * @tparam Policy_ Provides KeyType, ValueType, MutableValueType layout compatible with ValueType, and GetKey()
+		 */
+		template < typename Policy_, typename Compare_, typename Allocator_ >
+		class BTree
+		{
+		protected:
+			template < typename Compare__, typename Enabler = void >
+			struct IsTransparent : public FalseType
+			{ };
+
+			template < typename Compare__ >
+			struct IsTransparent<Compare__, typename EnableIf<decltype(std::declval<typename Compare__::is_transparent*>(), TrueType())::Value, void>::ValueT> : public TrueType
+			{ };
+
+		public:
+			using key_type = typename Policy_::KeyType;
+			using value_type = typename Policy_::ValueType;
+			using size_type = size_t;
+			using difference_type = std::ptrdiff_t;
+			using key_compare = Compare_;
+			using allocator_type = Allocator_;
+			using reference = value_type&;
+			using const_reference = const value_type&;
+			using pointer = value_type*;
+			using const_pointer = const value_type*;
+
+			static const size_t TargetNodeSize = 512;
+
+		private:
+			using Key = key_type;
+			using MutableValue = typename Policy_::MutableValueType;
+			using KeySearch = BTreeKeySearch<Key, Compare_>;
+
+			static const bool IsSet = IsSame<Key, value_type>::Value;
+
+			/// @note Values are moved between slots as MutableValue, so keys of a map are moved rather than copied
+			union Slot
+			{
+				value_type				Value;
+				MutableValue			Mutable;
+
+				Slot() { }
+				~Slot() { }
+			};
+
+			struct InnerNode;
+
+			struct NodeBase
+			{
+				InnerNode*				Parent;
+				u16						Position;
+				u16						Count;
+				bool					Leaf;
+
+				explicit NodeBase(bool leaf) : Parent(), Position(0), Count(0), Leaf(leaf) { }
+			};
+
+			static const size_t MinCapacity = 4;
+			static const size_t LeafFit = (TargetNodeSize - 4 * sizeof(void*)) / sizeof(Slot);
+			static const size_t InnerFit = (TargetNodeSize - 3 * sizeof(void*)) / (sizeof(Key) + sizeof(void*));
+
+			static const size_t LeafCapacity = LeafFit < MinCapacity ? MinCapacity : LeafFit;
+			static const size_t InnerCapacity = InnerFit < MinCapacity ? MinCapacity : InnerFit;
+
+			static const size_t MinLeafCount = LeafCapacity / 2;
+			static const size_t MinInnerCount = InnerCapacity / 2;
+
+			struct LeafNode : public NodeBase
+			{
+				LeafNode*				Prev;
+				LeafNode*				Next;
+				Slot					Slots[LeafCapacity];
+
+				LeafNode() : NodeBase(true), Prev(), Next() { }
+			};
+
+			/// @note Has room for an extra key and child, so an overflowing node is split after insertion
+			struct InnerNode : public NodeBase
+			{
+				typename std::aligned_storage<sizeof(Key), alignof(Key)>::type		KeyStorage[InnerCapacity + 1];
+				NodeBase*															Children[InnerCapacity + 2];
+
+				InnerNode() : NodeBase(false) { }
+
+				Key* Keys() { return reinterpret_cast<Key*>(KeyStorage); }
+			};
+
+			using LeafAllocator = typename std::allocator_traits<Allocator_>::template rebind_alloc<LeafNode>;
+			using InnerAllocator = typename std::allocator_traits<Allocator_>::template rebind_alloc<InnerNode>;
+
+			template < typename ValueType_ >
+			class Iterator : public iterator_base<Iterator<ValueType_>, ValueType_, std::bidirectional_iterator_tag>
+			{
+				using base = iterator_base<Iterator<ValueType_>, ValueType_, std::bidirectional_iterator_tag>;
+
+				friend class BTree;
+
+			private:
+				const BTree*	_tree;
+				LeafNode*		_leaf;
+				size_t			_index;
+
+			public:
+				Iterator() : _tree(), _leaf(), _index(0) { }
+
+				template < typename OtherValueType_, typename EnableIf<IsConvertible<OtherValueType_*, ValueType_*>::Value, int>::ValueT = 0 >
+				Iterator(const Iterator<OtherValueType_>& other) : _tree(other._tree), _leaf(other._leaf), _index(other._index) { }
+
+				typename base::reference dereference() const
+				{ return _leaf->Slots[_index].Value; }
+
+				template < typename OtherValueType_ >
+				bool equal(const Iterator<OtherValueType_>& other) const
+				{ return _leaf == other._leaf && _index == other._index; }
+
+				void increment()
+				{
+					if (++_index == _leaf->Count)
+					{
+						_leaf = _leaf->Next;
+						_index = 0;
+					}
+				}
+
+				void decrement()
+				{
+					if (!_leaf)
+					{
+						_leaf = _tree->_last;
+						_index = _leaf->Count - 1;
+					}
+					else if (_index == 0)
+					{
+						_leaf = _leaf->Prev;
+						_index = _leaf->Count - 1;
+					}
+					else
+						--_index;
+				}
+
+			private:
+				Iterator(const BTree* tree, LeafNode* leaf, size_t index) : _tree(tree), _leaf(leaf), _index(index) { }
+
+				template < typename OtherValueType_ >
+				friend class Iterator;
+			};
+
+		public:
+			// elements of a set are keys, so they are never mutable
+			using iterator = Iterator<typename If<IsSet, const value_type, value_type>::ValueT>;
+			using const_iterator = Iterator<const value_type>;
+			using reverse_iterator = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		private:
+			NodeBase*			_root;
+			LeafNode*			_first;
+			LeafNode*			_last;
+			size_t				_size;
+			Compare_			_cmp;
+			Allocator_			_alloc;
+
+		public:
+			explicit BTree(const Compare_& comp = Compare_(), const Allocator_& alloc = Allocator_())
+				:	_root(), _first(), _last(), _size(0), _cmp(comp), _alloc(alloc)
+			{ }
+
+			BTree(const BTree& other)
+				:	_root(), _first(), _last(), _size(0), _cmp(other._cmp), _alloc(std::allocator_traits<Allocator_>::select_on_container_copy_construction(other._alloc))
+			{ CopyFrom(other); }
+
+			BTree(const BTree& other, const Allocator_& alloc)
+				:	_root(), _first(), _last(), _size(0), _cmp(other._cmp), _alloc(alloc)
+			{ CopyFrom(other); }
+
+			BTree(BTree&& other)
+				:	_root(other._root), _first(other._first), _last(other._last), _size(other._size), _cmp(other._cmp), _alloc(other._alloc)
+			{
+				other._root = null;
+				other._first = other._last = null;
+				other._size = 0;
+			}
+
+			BTree(BTree&& other, const Allocator_& alloc)
+				:	_root(), _first(), _last(), _size(0), _cmp(other._cmp), _alloc(alloc)
+			{
+				if (_alloc == other._alloc)
+					swap(other);
+				else
+					CopyFrom(other);
+			}
+
+			~BTree()
+			{ clear(); }
+
+			BTree& operator = (const BTree& other)
+			{
+				BTree tmp(other);
+				swap(tmp);
+				return *this;
+			}
+
+			BTree& operator = (BTree&& other)
+			{
+				BTree tmp(std::move(other));
+				swap(tmp);
+				return *this;
+			}
+
+			allocator_type get_allocator() const	{ return _alloc; }
+
+			iterator begin()						{ return MakeIterator<iterator>(_first, 0); }
+			const_iterator begin() const			{ return MakeIterator<const_iterator>(_first, 0); }
+			const_iterator cbegin() const			{ return begin(); }
+
+			iterator end()							{ return MakeIterator<iterator>(null, 0); }
+			const_iterator end() const				{ return MakeIterator<const_iterator>(null, 0); }
+			const_iterator cend() const				{ return end(); }
+
+			reverse_iterator rbegin()				{ return reverse_iterator(end()); }
+			const_reverse_iterator rbegin() const	{ return const_reverse_iterator(end()); }
+			const_reverse_iterator crbegin() const	{ return rbegin(); }
+
+			reverse_iterator rend()					{ return reverse_iterator(begin()); }
+			const_reverse_iterator rend() const		{ return const_reverse_iterator(begin()); }
+			const_reverse_iterator crend() const	{ return rend(); }
+
+			bool empty() const						{ return _size == 0; }
+			size_type size() const					{ return _size; }
+			size_type max_size() const				{ return std::allocator_traits<Allocator_>::max_size(_alloc); }
+
+			key_compare key_comp() const			{ return _cmp; }
+
+			void clear()
+			{
+				if (!_root)
+					return;
+
+				DestroySubtree(_root);
+				_root = null;
+				_first = _last = null;
+				_size = 0;
+			}
+
+			void swap(BTree& other)
+			{
+				std::swap(_root, other._root);
+				std::swap(_first, other._first);
+				std::swap(_last, other._last);
+				std::swap(_size, other._size);
+				std::swap(_cmp, other._cmp);
+				std::swap(_alloc, other._alloc);
+			}
+
+			std::pair<iterator, bool> insert(const value_type& value)
+			{ return DoEmplace(Policy_::GetKey(value), value); }
+
+			std::pair<iterator, bool> insert(value_type&& value)
+			{ return DoEmplace(Policy_::GetKey(value), std::move(value)); }
+
+			iterator insert(const_iterator hint, const value_type& value)
+			{ return DoEmplaceHint(hint, Policy_::GetKey(value), value); }
+
+			iterator insert(const_iterator hint, value_type&& value)
+			{ return DoEmplaceHint(hint, Policy_::GetKey(value), std::move(value)); }
+
+			template < class InputIterator >
+			void insert(InputIterator first, InputIterator last)
+			{
+				for (; first != last; ++first)
+					emplace_hint(cend(), *first);
+			}
+
+			void insert(std::initializer_list<value_type> list)
+			{ insert(list.begin(), list.end()); }
+
+			template < typename... Ts >
+			std::pair<iterator, bool> emplace(Ts&&... args)
+			{
+				value_type value(std::forward<Ts>(args)...);
+				return DoEmplace(Policy_::GetKey(value), std::move(value));
+			}
+
+			template < typename... Ts >
+			iterator emplace_hint(const_iterator hint, Ts&&... args)
+			{
+				value_type value(std::forward<Ts>(args)...);
+				return DoEmplaceHint(hint, Policy_::GetKey(value), std::move(value));
+			}
+
+			iterator erase(const_iterator pos)
+			{ return EraseAt(pos._leaf, pos._index); }
+
+			iterator erase(const_iterator first, const_iterator last)
+			{
+				if (first == cbegin() && last == cend())
+				{
+					clear();
+					return end();
+				}
+
+				// erasure moves values between nodes and invalidates last, so the range is erased by count
+				iterator result = MakeIterator<iterator>(first._leaf, first._index);
+				for (size_t count = std::distance(first, last); count != 0; --count)
+					result = EraseAt(result._leaf, result._index);
+				return result;
+			}
+
+			size_type erase(const Key& key)
+			{
+				const const_iterator pos = find(key);
+				if (pos == end())
+					return 0;
+
+				erase(pos);
+				return 1;
+			}
+
+			size_type count(const Key& key) const										{ return find(key) == end() ? 0 : 1; }
+
+			template < typename K, typename Compare__ = Compare_, typename EnableIf<IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+			size_type count(const K& key) const											{ return find(key) == end() ? 0 : 1; }
+
+			iterator find(const Key& key)												{ return DoFind<iterator>(key); }
+			const_iterator find(const Key& key) const									{ return DoFind<const_iterator>(key); }
+
+			template < typename K, typename Compare__ = Compare_, typename EnableIf<IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+			iterator find(const K& key)													{ return DoFind<iterator>(key); }
+			template < typename K, typename Compare__ = Compare_, typename EnableIf<IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+			const_iterator find(const K& key) const										{ return DoFind<const_iterator>(key); }
+
+			std::pair<iterator, iterator> equal_range(const Key& key)					{ return std::make_pair(lower_bound(key), upper_bound(key)); }
+			std::pair<const_iterator, const_iterator> equal_range(const Key& key) const	{ return std::make_pair(lower_bound(key), upper_bound(key)); }
+
+			template < typename K, typename Compare__ = Compare_, typename EnableIf<IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+			std::pair<iterator, iterator> equal_range(const K& key)						{ return std::make_pair(lower_bound(key), upper_bound(key)); }
+			template < typename K, typename Compare__ = Compare_, typename EnableIf<IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+			std::pair<const_iterator, const_iterator> equal_range(const K& key) const	{ return std::make_pair(lower_bound(key), upper_bound(key)); }
+
+			iterator lower_bound(const Key& key)										{ return DoLowerBound<iterator>(key); }
+			const_iterator lower_bound(const Key& key) const							{ return DoLowerBound<const_iterator>(key); }
+
+			template < typename K, typename Compare__ = Compare_, typename EnableIf<IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+			iterator lower_bound(const K& key)											{ return DoLowerBound<iterator>(key); }
+			template < typename K, typename Compare__ = Compare_, typename EnableIf<IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+			const_iterator lower_bound(const K& key) const								{ return DoLowerBound<const_iterator>(key); }
+
+			iterator upper_bound(const Key& key)										{ return DoUpperBound<iterator>(key); }
+			const_iterator upper_bound(const Key& key) const							{ return DoUpperBound<const_iterator>(key); }
+
+			template < typename K, typename Compare__ = Compare_, typename EnableIf<IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+			iterator upper_bound(const K& key)											{ return DoUpperBound<iterator>(key); }
+			template < typename K, typename Compare__ = Compare_, typename EnableIf<IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+			const_iterator upper_bound(const K& key) const								{ return DoUpperBound<const_iterator>(key); }
+
+			friend bool operator == (const BTree& lhs, const BTree& rhs)
+			{ return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin()); }
+
+			friend bool operator != (const BTree& lhs, const BTree& rhs)
+			{ return !(lhs == rhs); }
+
+			friend bool operator < (const BTree& lhs, const BTree& rhs)
+			{ return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+
+			friend bool operator > (const BTree& lhs, const BTree& rhs)
+			{ return rhs < lhs; }
+
+			friend bool operator <= (const BTree& lhs, const BTree& rhs)
+			{ return !(rhs < lhs); }
+
+			friend bool operator >= (const BTree& lhs, const BTree& rhs)
+			{ return !(lhs < rhs); }
+
+		protected:
+			template < typename K, typename... Ts >
+			std::pair<iterator, bool> DoEmplace(const K& key, Ts&&... args)
+			{
+				if (!_root)
+				{
+					LeafNode* const leaf = NewLeaf();
+					try
+					{ InsertIntoLeaf(leaf, 0, std::forward<Ts>(args)...); }
+					catch (...)
+					{
+						FreeLeaf(leaf);
+						throw;
+					}
+
+					_root = _first = _last = leaf;
+					_size = 1;
+					return std::make_pair(MakeIterator<iterator>(leaf, 0), true);
+				}
+
+				LeafNode* const leaf = FindLeaf(key);
+				const size_t index = LeafLowerBound(leaf, key);
+
+				if (index < leaf->Count && !_cmp(key, GetKey(leaf, index)))
+					return std::make_pair(MakeIterator<iterator>(leaf, index), false);
+
+				return std::make_pair(InsertAt(leaf, index, std::forward<Ts>(args)...), true);
+			}
+
+			template < typename K, typename... Ts >
+			iterator DoEmplaceHint(const_iterator hint, const K& key, Ts&&... args)
+			{
+				// a hint at the first value of a leaf is ignored, as the key may belong to the previous leaf
+				if (_root)
+				{
+					if (!hint._leaf)
+					{
+						if (_cmp(GetKey(_last, _last->Count - 1), key))
+							return InsertAt(_last, _last->Count, std::forward<Ts>(args)...);
+					}
+					else if (hint._index != 0 && _cmp(key, GetKey(hint._leaf, hint._index)) && _cmp(GetKey(hint._leaf, hint._index - 1), key))
+						return InsertAt(hint._leaf, hint._index, std::forward<Ts>(args)...);
+				}
+
+				return DoEmplace(key, std::forward<Ts>(args)...).first;
+			}
+
+		private:
+			static const Key& GetKey(const LeafNode* leaf, size_t index)
+			{ return Policy_::GetKey(leaf->Slots[index].Value); }
+
+			template < typename IteratorType >
+			IteratorType MakeIterator(LeafNode* leaf, size_t index) const
+			{
+				if (leaf && index == leaf->Count)
+				{
+					leaf = leaf->Next;
+					index = 0;
+				}
+
+				return IteratorType(this, leaf, index);
+			}
+
+			template < typename IteratorType, typename K >
+			IteratorType DoFind(const K& key) const
+			{
+				if (!_root)
+					return MakeIterator<IteratorType>(null, 0);
+
+				LeafNode* const leaf = FindLeaf(key);
+				const size_t index = LeafLowerBound(leaf, key);
+				return index < leaf->Count && !_cmp(key, GetKey(leaf, index)) ? MakeIterator<IteratorType>(leaf, index) : MakeIterator<IteratorType>(null, 0);
+			}
+
+			template < typename IteratorType, typename K >
+			IteratorType DoLowerBound(const K& key) const
+			{
+				if (!_root)
+					return MakeIterator<IteratorType>(null, 0);
+
+				LeafNode* const leaf = FindLeaf(key);
+				return MakeIterator<IteratorType>(leaf, LeafLowerBound(leaf, key));
+			}
+
+			template < typename IteratorType, typename K >
+			IteratorType DoUpperBound(const K& key) const
+			{
+				if (!_root)
+					return MakeIterator<IteratorType>(null, 0);
+
+				LeafNode* const leaf = FindLeaf(key);
+				return MakeIterator<IteratorType>(leaf, LeafUpperBound(leaf, key));
+			}
+
+			template < typename K >
+			LeafNode* FindLeaf(const K& key) const
+			{
+				NodeBase* node = _root;
+				while (!node->Leaf)
+				{
+					InnerNode* const inner = static_cast<InnerNode*>(node);
+					node = inner->Children[KeySearch::UpperBound(inner->Keys(), inner->Count, key, _cmp)];
+				}
+				return static_cast<LeafNode*>(node);
+			}
+
+			template < typename K >
+			size_t LeafLowerBound(const LeafNode* leaf, const K& key) const
+			{ return DoLeafLowerBound(leaf, key, integral_constant<bool, IsSet>()); }
+
+			template < typename K >
+			size_t LeafUpperBound(const LeafNode* leaf, const K& key) const
+			{ return DoLeafUpperBound(leaf, key, integral_constant<bool, IsSet>()); }
+
+			template < typename K >
+			size_t DoLeafLowerBound(const LeafNode* leaf, const K& key, TrueType) const
+			{ return KeySearch::LowerBound(reinterpret_cast<const Key*>(leaf->Slots), leaf->Count, key, _cmp); }
+
+			template < typename K >
+			size_t DoLeafLowerBound(const LeafNode* leaf, const K& key, FalseType) const
+			{
+				const Compare_& cmp = _cmp;
+				return std::lower_bound(leaf->Slots, leaf->Slots + leaf->Count, key, [&cmp](const Slot& slot, const K& k) { return cmp(Policy_::GetKey(slot.Value), k); }) - leaf->Slots;
+			}
+
+			template < typename K >
+			size_t DoLeafUpperBound(const LeafNode* leaf, const K& key, TrueType) const
+			{ return KeySearch::UpperBound(reinterpret_cast<const Key*>(leaf->Slots), leaf->Count, key, _cmp); }
+
+			template < typename K >
+			size_t DoLeafUpperBound(const LeafNode* leaf, const K& key, FalseType) const
+			{
+				const Compare_& cmp = _cmp;
+				return std::upper_bound(leaf->Slots, leaf->Slots + leaf->Count, key, [&cmp](const K& k, const Slot& slot) { return cmp(k, Policy_::GetKey(slot.Value)); }) - leaf->Slots;
+			}
+
+			static void Transfer(Slot* dst, Slot* src)
+			{
+				new (&dst->Mutable) MutableValue(std::move(src->Mutable));
+				src->Mutable.~MutableValue();
+			}
+
+			template < typename... Ts >
+			static void InsertIntoLeaf(LeafNode* leaf, size_t index, Ts&&... args)
+			{
+				for (size_t i = leaf->Count; i > index; --i)
+					Transfer(&leaf->Slots[i], &leaf->Slots[i - 1]);
+
+				try
+				{ new (&leaf->Slots[index].Value) value_type(std::forward<Ts>(args)...); }
+				catch (...)
+				{
+					for (size_t i = index; i < leaf->Count; ++i)
+						Transfer(&leaf->Slots[i], &leaf->Slots[i + 1]);
+					throw;
+				}
+
+				++leaf->Count;
+			}
+
+			template < typename... Ts >
+			iterator InsertAt(LeafNode* leaf, size_t index, Ts&&... args)
+			{
+				if (leaf->Count < LeafCapacity)
+				{
+					InsertIntoLeaf(leaf, index, std::forward<Ts>(args)...);
+					++_size;
+					return MakeIterator<iterator>(leaf, index);
+				}
+
+				// appending to the last leaf leaves it full, so sorted input doesn't produce half-empty leaves
+				const size_t leftCount = index == LeafCapacity && !leaf->Next ? LeafCapacity : (LeafCapacity + 1) / 2;
+				const size_t splitAt = index < leftCount ? leftCount - 1 : leftCount;
+
+				LeafNode* const right = NewLeaf();
+				for (size_t i = splitAt; i < leaf->Count; ++i)
+					Transfer(&right->Slots[i - splitAt], &leaf->Slots[i]);
+				right->Count = leaf->Count - splitAt;
+				leaf->Count = splitAt;
+
+				right->Prev = leaf;
+				right->Next = leaf->Next;
+				(leaf->Next ? leaf->Next->Prev : _last) = right;
+				leaf->Next = right;
+
+				LeafNode* const target = index < leftCount ? leaf : right;
+				const size_t targetIndex = index < leftCount ? index : index - splitAt;
+
+				try
+				{ InsertIntoLeaf(target, targetIndex, std::forward<Ts>(args)...); }
+				catch (...)
+				{
+					if (right->Count != 0)
+						InsertIntoParent(leaf, Key(GetKey(right, 0)), right);
+					else
+					{
+						(right->Next ? right->Next->Prev : _last) = leaf;
+						leaf->Next = right->Next;
+						FreeLeaf(right);
+					}
+					throw;
+				}
+
+				++_size;
+				InsertIntoParent(leaf, Key(GetKey(right, 0)), right);
+				return MakeIterator<iterator>(target, targetIndex);
+			}
+
+			void InsertIntoParent(NodeBase* left, Key&& key, NodeBase* right)
+			{
+				InnerNode* const parent = left->Parent;
+				if (!parent)
+				{
+					InnerNode* const root = NewInner();
+					new (&root->Keys()[0]) Key(std::move(key));
+					root->Count = 1;
+					SetChild(root, 0, left);
+					SetChild(root, 1, right);
+					_root = root;
+					return;
+				}
+
+				const size_t pos = left->Position;
+				InsertKey(parent, pos, std::move(key));
+				for (size_t i = parent->Count + 1; i > pos + 1; --i)
+					SetChild(parent, i, parent->Children[i - 1]);
+				SetChild(parent, pos + 1, right);
+				++parent->Count;
+
+				if (parent->Count > InnerCapacity)
+					SplitInner(parent, pos + 1 == parent->Count);
+			}
+
+			void SplitInner(InnerNode* node, bool appended)
+			{
+				const size_t leftCount = appended && IsRightmost(node) ? InnerCapacity - 1 : node->Count / 2;
+				const size_t rightCount = node->Count - leftCount - 1;
+
+				InnerNode* const right = NewInner();
+
+				Key* const keys = node->Keys();
+				for (size_t i = 0; i < rightCount; ++i)
+				{
+					new (&right->Keys()[i]) Key(std::move(keys[leftCount + 1 + i]));
+					keys[leftCount + 1 + i].~Key();
+				}
+				for (size_t i = 0; i <= rightCount; ++i)
+					SetChild(right, i, node->Children[leftCount + 1 + i]);
+				right->Count = rightCount;
+
+				Key middle(std::move(keys[leftCount]));
+				keys[leftCount].~Key();
+				node->Count = leftCount;
+
+				InsertIntoParent(node, std::move(middle), right);
+			}
+
+			iterator EraseAt(LeafNode* leaf, size_t index)
+			{
+				leaf->Slots[index].Value.~value_type();
+				for (size_t i = index + 1; i < leaf->Count; ++i)
+					Transfer(&leaf->Slots[i - 1], &leaf->Slots[i]);
+				--leaf->Count;
+				--_size;
+
+				if (index == 0 && leaf->Count != 0)
+					RefreshSeparator(leaf);
+
+				if (leaf == _root)
+				{
+					if (leaf->Count == 0)
+					{
+						FreeLeaf(leaf);
+						_root = null;
+						_first = _last = null;
+					}
+				}
+				else if (leaf->Count < MinLeafCount)
+					RebalanceLeaf(leaf, index);
+
+				return _root ? MakeIterator<iterator>(leaf, index) : end();
+			}
+
+			/// @brief Keeps the separator preceding the leaf equal to its first key, so that separators never refer to erased values
+			void RefreshSeparator(LeafNode* leaf)
+			{
+				NodeBase* node = leaf;
+				while (node->Parent && node->Position == 0)
+					node = node->Parent;
+
+				if (node->Parent)
+					node->Parent->Keys()[node->Position - 1] = GetKey(leaf, 0);
+			}
+
+			/// @brief Borrows a value from a sibling or merges with it, adjusting the position of the value following the erased one
+			void RebalanceLeaf(LeafNode*& leaf, size_t& index)
+			{
+				InnerNode* const parent = leaf->Parent;
+				const size_t pos = leaf->Position;
+
+				LeafNode* const left = pos > 0 ? static_cast<LeafNode*>(parent->Children[pos - 1]) : null;
+				LeafNode* const right = pos < parent->Count ? static_cast<LeafNode*>(parent->Children[pos + 1]) : null;
+
+				if (left && left->Count > MinLeafCount)
+				{
+					for (size_t i = leaf->Count; i > 0; --i)
+						Transfer(&leaf->Slots[i], &leaf->Slots[i - 1]);
+					Transfer(&leaf->Slots[0], &left->Slots[left->Count - 1]);
+					--left->Count;
+					++leaf->Count;
+					++index;
+
+					parent->Keys()[pos - 1] = GetKey(leaf, 0);
+				}
+				else if (right && right->Count > MinLeafCount)
+				{
+					Transfer(&leaf->Slots[leaf->Count], &right->Slots[0]);
+					for (size_t i = 1; i < right->Count; ++i)
+						Transfer(&right->Slots[i - 1], &right->Slots[i]);
+					--right->Count;
+					++leaf->Count;
+
+					parent->Keys()[pos] = GetKey(right, 0);
+				}
+				else if (left)
+				{
+					index += left->Count;
+					MergeLeaves(left, leaf);
+					leaf = left;
+				}
+				else
+					MergeLeaves(leaf, right);
+			}
+
+			void MergeLeaves(LeafNode* left, LeafNode* right)
+			{
+				for (size_t i = 0; i < right->Count; ++i)
+					Transfer(&left->Slots[left->Count + i], &right->Slots[i]);
+				left->Count += right->Count;
+
+				left->Next = right->Next;
+				(right->Next ? right->Next->Prev : _last) = left;
+
+				InnerNode* const parent = left->Parent;
+				RemoveFromInner(parent, left->Position);
+				FreeLeaf(right);
+
+				RebalanceInner(parent);
+			}
+
+			void RebalanceInner(InnerNode* node)
+			{
+				if (node == _root)
+				{
+					if (node->Count == 0)
+					{
+						_root = node->Children[0];
+						_root->Parent = null;
+						_root->Position = 0;
+						FreeInner(node);
+					}
+					return;
+				}
+
+				if (node->Count >= MinInnerCount)
+					return;
+
+				InnerNode* const parent = node->Parent;
+				const size_t pos = node->Position;
+
+				InnerNode* const left = pos > 0 ? static_cast<InnerNode*>(parent->Children[pos - 1]) : null;
+				InnerNode* const right = pos < parent->Count ? static_cast<InnerNode*>(parent->Children[pos + 1]) : null;
+
+				if (left && left->Count > MinInnerCount)
+				{
+					InsertKey(node, 0, std::move(parent->Keys()[pos - 1]));
+					for (size_t i = node->Count + 1; i > 0; --i)
+						SetChild(node, i, node->Children[i - 1]);
+					SetChild(node, 0, left->Children[left->Count]);
+					++node->Count;
+
+					parent->Keys()[pos - 1] = std::move(left->Keys()[left->Count - 1]);
+					left->Keys()[left->Count - 1].~Key();
+					--left->Count;
+				}
+				else if (right && right->Count > MinInnerCount)
+				{
+					new (&node->Keys()[node->Count]) Key(std::move(parent->Keys()[pos]));
+					SetChild(node, node->Count + 1, right->Children[0]);
+					++node->Count;
+
+					parent->Keys()[pos] = std::move(right->Keys()[0]);
+					EraseKey(right, 0);
+					for (size_t i = 0; i < right->Count; ++i)
+						SetChild(right, i, right->Children[i + 1]);
+					--right->Count;
+				}
+				else if (left)
+					MergeInner(left, node);
+				else
+					MergeInner(node, right);
+			}
+
+			void MergeInner(InnerNode* left, InnerNode* right)
+			{
+				InnerNode* const parent = left->Parent;
+				const size_t separator = left->Position;
+
+				new (&left->Keys()[left->Count]) Key(std::move(parent->Keys()[separator]));
+				for (size_t i = 0; i < right->Count; ++i)
+				{
+					new (&left->Keys()[left->Count + 1 + i]) Key(std::move(right->Keys()[i]));
+					right->Keys()[i].~Key();
+				}
+				for (size_t i = 0; i <= right->Count; ++i)
+					SetChild(left, left->Count + 1 + i, right->Children[i]);
+				left->Count += right->Count + 1;
+
+				RemoveFromInner(parent, separator);
+				FreeInner(right);
+
+				RebalanceInner(parent);
+			}
+
+			/// @brief Removes the key at the index and the child to the right of it
+			static void RemoveFromInner(InnerNode* node, size_t index)
+			{
+				EraseKey(node, index);
+				for (size_t i = index + 1; i < node->Count; ++i)
+					SetChild(node, i, node->Children[i + 1]);
+				--node->Count;
+			}
+
+			static void InsertKey(InnerNode* node, size_t index, Key&& key)
+			{
+				Key* const keys = node->Keys();
+				if (index == node->Count)
+				{
+					new (&keys[index]) Key(std::move(key));
+					return;
+				}
+
+				new (&keys[node->Count]) Key(std::move(keys[node->Count - 1]));
+				std::move_backward(keys + index, keys + node->Count - 1, keys + node->Count);
+				keys[index] = std::move(key);
+			}
+
+			static void EraseKey(InnerNode* node, size_t index)
+			{
+				Key* const keys = node->Keys();
+				std::move(keys + index + 1, keys + node->Count, keys + index);
+				keys[node->Count - 1].~Key();
+			}
+
+			static void SetChild(InnerNode* node, size_t index, NodeBase* child)
+			{
+				node->Children[index] = child;
+				child->Parent = node;
+				child->Position = (u16)index;
+			}
+
+			static bool IsRightmost(const NodeBase* node)
+			{
+				for (; node->Parent; node = node->Parent)
+					if (node->Position != node->Parent->Count)
+						return false;
+				return true;
+			}
+
+			void CopyFrom(const BTree& other)
+			{
+				try
+				{
+					for (const value_type& value : other)
+					{
+						LeafNode* const leaf = _last ? _last : EmplaceRoot();
+						InsertAt(leaf, leaf->Count, value);
+					}
+				}
+				catch (...)
+				{
+					clear();
+					throw;
+				}
+			}
+
+			LeafNode* EmplaceRoot()
+			{
+				LeafNode* const leaf = NewLeaf();
+				_root = _first = _last = leaf;
+				return leaf;
+			}
+
+			void DestroySubtree(NodeBase* node)
+			{
+				if (node->Leaf)
+				{
+					LeafNode* const leaf = static_cast<LeafNode*>(node);
+					for (size_t i = 0; i < leaf->Count; ++i)
+						leaf->Slots[i].Value.~value_type();
+					FreeLeaf(leaf);
+					return;
+				}
+
+				InnerNode* const inner = static_cast<InnerNode*>(node);
+				for (size_t i = 0; i <= inner->Count; ++i)
+					DestroySubtree(inner->Children[i]);
+				for (size_t i = 0; i < inner->Count; ++i)
+					inner->Keys()[i].~Key();
+				FreeInner(inner);
+			}
+
+			LeafNode* NewLeaf()
+			{
+				LeafAllocator alloc(_alloc);
+				LeafNode* const leaf = std::allocator_traits<LeafAllocator>::allocate(alloc, 1);
+				return new (leaf) LeafNode();
+			}
+
+			void FreeLeaf(LeafNode* leaf)
+			{
+				LeafAllocator alloc(_alloc);
+				leaf->~LeafNode();
+				std::allocator_traits<LeafAllocator>::deallocate(alloc, leaf, 1);
+			}
+
+			InnerNode* NewInner()
+			{
+				InnerAllocator alloc(_alloc);
+				InnerNode* const inner = std::allocator_traits<InnerAllocator>::allocate(alloc, 1);
+				return new (inner) InnerNode();
+			}
+
+			void FreeInner(InnerNode* inner)
+			{
+				InnerAllocator alloc(_alloc);
+				inner->~InnerNode();
+				std::allocator_traits<InnerAllocator>::deallocate(alloc, inner, 1);
+			}
+		};
+
+	}
+
+}
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef STINGRAYKIT_COLLECTION_BTREE_MAP_H
+#define STINGRAYKIT_COLLECTION_BTREE_MAP_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/KeyExceptionCreator.h>
+#include <stingraykit/collection/btree.h>
+#include <stingraykit/function/function_info.h>
+
+#include <tuple>
+
+namespace stingray
+{
+
+	namespace Detail
+	{
+
+		template < typename Key_, typename T_ >
+		struct BTreeMapPolicy
+		{
+			using KeyType = Key_;
+			using ValueType = std::pair<const Key_, T_>;
+			using MutableValueType = std::pair<Key_, T_>;
+
+			static const Key_& GetKey(const ValueType& value) { return value.first; }
+		};
+
+	}
+
+
+	/**
+	 * @brief Sorted map storing its elements in a B+tree, see Detail::BTree
+	 * @details Unlike std::map, any insertion or erasure invalidates all iterators and references. Heterogeneous lookup is enabled if
+	 * Compare declares is_transparent.
+	 */
+	template < class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, T>> >
+	class btree_map : public Detail::BTree<Detail::BTreeMapPolicy<Key, T>, Compare, Allocator>
+	{
+		using Base = Detail::BTree<Detail::BTreeMapPolicy<Key, T>, Compare, Allocator>;
+
+	public:
+		using mapped_type = T;
+
+		using typename Base::key_type;
+		using typename Base::value_type;
+		using typename Base::size_type;
+		using typename Base::iterator;
+		using typename Base::const_iterator;
+
+		class value_compare : public function_info<bool (value_type, value_type)>
+		{
+			friend class btree_map;
+
+		private:
+			Compare						_cmp;
+
+		private:
+			value_compare(Compare comp) : _cmp(comp) { }
+
+		public:
+			bool operator () (const value_type& lhs, const value_type& rhs) const
+			{ return _cmp(lhs.first, rhs.first); }
+		};
+
+	public:
+		btree_map() { }
+
+		explicit btree_map(const Compare& comp, const Allocator& alloc = Allocator())
+			: Base(comp, alloc)
+		{ }
+
+		explicit btree_map(const Allocator& alloc)
+			: Base(Compare(), alloc)
+		{ }
+
+		template < class InputIterator >
+		btree_map(InputIterator first, InputIterator last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+			: Base(comp, alloc)
+		{ this->insert(first, last); }
+
+		template < class InputIterator >
+		btree_map(InputIterator first, InputIterator last, const Allocator& alloc)
+			: Base(Compare(), alloc)
+		{ this->insert(first, last); }
+
+		btree_map(const btree_map& other, const Allocator& alloc)
+			: Base(other, alloc)
+		{ }
+
+		btree_map(btree_map&& other, const Allocator& alloc)
+			: Base(std::move(other), alloc)
+		{ }
+
+		btree_map(std::initializer_list<value_type> list, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+			: Base(comp, alloc)
+		{ this->insert(list.begin(), list.end()); }
+
+		btree_map(std::initializer_list<value_type> list, const Allocator& alloc)
+			: Base(Compare(), alloc)
+		{ this->insert(list.begin(), list.end()); }
+
+		btree_map& operator = (std::initializer_list<value_type> list)
+		{
+			this->clear();
+			this->insert(list.begin(), list.end());
+			return *this;
+		}
+
+		T& at(const Key& key)
+		{
+			const iterator result = this->find(key);
+			STINGRAYKIT_CHECK(result != this->end(), CreateKeyNotFoundException(key));
+			return result->second;
+		}
+
+		const T& at(const Key& key) const
+		{
+			const const_iterator result = this->find(key);
+			STINGRAYKIT_CHECK(result != this->end(), CreateKeyNotFoundException(key));
+			return result->second;
+		}
+
+		template < typename K, typename Compare__ = Compare, typename EnableIf<Base::template IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+		T& at(const K& key)
+		{
+			const iterator result = this->find(key);
+			STINGRAYKIT_CHECK(result != this->end(), CreateKeyNotFoundException(key));
+			return result->second;
+		}
+
+		template < typename K, typename Compare__ = Compare, typename EnableIf<Base::template IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+		const T& at(const K& key) const
+		{
+			const const_iterator result = this->find(key);
+			STINGRAYKIT_CHECK(result != this->end(), CreateKeyNotFoundException(key));
+			return result->second;
+		}
+
+		T& operator [] (const Key& key)
+		{ return try_emplace(key).first->second; }
+
+		T& operator [] (Key&& key)
+		{ return try_emplace(std::move(key)).first->second; }
+
+		template < typename... Ts >
+		std::pair<iterator, bool> try_emplace(const Key& key, Ts&&... args)
+		{ return this->DoEmplace(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Ts>(args)...)); }
+
+		template < typename... Ts >
+		std::pair<iterator, bool> try_emplace(Key&& key, Ts&&... args)
+		{ return this->DoEmplace(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Ts>(args)...)); }
+
+		template < typename... Ts >
+		iterator try_emplace(const_iterator hint, const Key& key, Ts&&... args)
+		{ return this->DoEmplaceHint(hint, key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Ts>(args)...)); }
+
+		template < typename... Ts >
+		iterator try_emplace(const_iterator hint, Key&& key, Ts&&... args)
+		{ return this->DoEmplaceHint(hint, key, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Ts>(args)...)); }
+
+		template < typename M >
+		std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj)
+		{
+			const std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(obj));
+			if (!result.second)
+				result.first->second = std::forward<M>(obj);
+			return result;
+		}
+
+		template < typename M >
+		std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj)
+		{
+			const std::pair<iterator, bool> result = try_emplace(std::move(key), std::forward<M>(obj));
+			if (!result.second)
+				result.first->second = std::forward<M>(obj);
+			return result;
+		}
+
+		value_compare value_comp() const
+		{ return value_compare(this->key_comp()); }
+
+		void swap(btree_map& other)
+		{ Base::swap(other); }
+	};
+
+
+	template < class Key, class T, class Compare, class Allocator >
+	void swap(btree_map<Key, T, Compare, Allocator>& lhs, btree_map<Key, T, Compare, Allocator>& rhs)
+	{ lhs.swap(rhs); }
+
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef STINGRAYKIT_COLLECTION_BTREE_SET_H
+#define STINGRAYKIT_COLLECTION_BTREE_SET_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/btree.h>
+
+namespace stingray
+{
+
+	namespace Detail
+	{
+
+		template < typename Key_ >
+		struct BTreeSetPolicy
+		{
+			using KeyType = Key_;
+			using ValueType = Key_;
+			using MutableValueType = Key_;
+
+			static const Key_& GetKey(const ValueType& value) { return value; }
+		};
+
+	}
+
+
+	/**
+	 * @brief Sorted set storing its elements in a B+tree, see Detail::BTree
+	 * @details Unlike std::set, any insertion or erasure invalidates all iterators and references. Heterogeneous lookup is enabled if
+	 * Compare declares is_transparent.
+	 */
+	template < class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key> >
+	class btree_set : public Detail::BTree<Detail::BTreeSetPolicy<Key>, Compare, Allocator>
+	{
+		using Base = Detail::BTree<Detail::BTreeSetPolicy<Key>, Compare, Allocator>;
+
+	public:
+		using value_compare = Compare;
+
+		using typename Base::value_type;
+
+	public:
+		btree_set() { }
+
+		explicit btree_set(const Compare& comp, const Allocator& alloc = Allocator())
+			: Base(comp, alloc)
+		{ }
+
+		explicit btree_set(const Allocator& alloc)
+			: Base(Compare(), alloc)
+		{ }
+
+		template < class InputIterator >
+		btree_set(InputIterator first, InputIterator last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+			: Base(comp, alloc)
+		{ this->insert(first, last); }
+
+		template < class InputIterator >
+		btree_set(InputIterator first, InputIterator last, const Allocator& alloc)
+			: Base(Compare(), alloc)
+		{ this->insert(first, last); }
+
+		btree_set(const btree_set& other, const Allocator& alloc)
+			: Base(other, alloc)
+		{ }
+
+		btree_set(btree_set&& other, const Allocator& alloc)
+			: Base(std::move(other), alloc)
+		{ }
+
+		btree_set(std::initializer_list<value_type> list, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+			: Base(comp, alloc)
+		{ this->insert(list.begin(), list.end()); }
+
+		btree_set(std::initializer_list<value_type> list, const Allocator& alloc)
+			: Base(Compare(), alloc)
+		{ this->insert(list.begin(), list.end()); }
+
+		btree_set& operator = (std::initializer_list<value_type> list)
+		{
+			this->clear();
+			this->insert(list.begin(), list.end());
+			return *this;
+		}
+
+		value_compare value_comp() const
+		{ return this->key_comp(); }
+
+		void swap(btree_set& other)
+		{ Base::swap(other); }
+	};
+
+
+	template < class Key, class Compare, class Allocator >
+	void swap(btree_set<Key, Compare, Allocator>& lhs, btree_set<Key, Compare, Allocator>& rhs)
+	{ lhs.swap(rhs); }
+
+}
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef STINGRAYKIT_COLLECTION_DENSE_ORDERED_MAP_H
+#define STINGRAYKIT_COLLECTION_DENSE_ORDERED_MAP_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/CollectionHelpers.h>
+#include <stingraykit/collection/KeyExceptionCreator.h>
+#include <stingraykit/collection/btree_set.h>
+#include <stingraykit/collection/dense_ordered_table.h>
+
+#include <tuple>
+
+namespace stingray
+{
+
+	namespace Detail
+	{
+
+		template < typename Key_, typename T_ >
+		struct DenseOrderedMapPolicy
+		{
+			using KeyType = Key_;
+			using ValueType = std::pair<const Key_, T_>;
+			using MutableValueType = std::pair<Key_, T_>;
+
+			static const Key_& GetKey(const ValueType& value) { return value.first; }
+		};
+
+	}
+
+
+	/**
+	 * @brief Map preserving insertion order of its elements, stored in a dense array, see Detail::DenseOrderedTable
+	 * @details Lookup goes through SortedIndex, a std::set-like container of element pointers. Hints of insertion are positions in
+	 * that order: a new element is placed before the hint. Unlike ordered_map, it does not allocate per element and iterates over
+	 * contiguous memory, but insertion and erasure may move elements, invalidating all iterators and references, and insertion
+	 * before an existing element may take linear time.
+	 */
+	template < class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<std::pair<const Key, T>>, template < typename, typename, typename > class SortedIndex = btree_set >
+	class dense_ordered_map : public Detail::DenseOrderedTable<Detail::DenseOrderedMapPolicy<Key, T>, Compare, Allocator, SortedIndex>
+	{
+		using Base = Detail::DenseOrderedTable<Detail::DenseOrderedMapPolicy<Key, T>, Compare, Allocator, SortedIndex>;
+
+	public:
+		using mapped_type = T;
+
+		using typename Base::key_type;
+		using typename Base::value_type;
+		using typename Base::size_type;
+		using typename Base::iterator;
+		using typename Base::const_iterator;
+
+		class value_compare : public function_info<bool (value_type, value_type)>
+		{
+			friend class dense_ordered_map;
+
+		private:
+			Compare						_cmp;
+
+		private:
+			value_compare(Compare comp) : _cmp(comp) { }
+
+		public:
+			bool operator () (const value_type& lhs, const value_type& rhs) const
+			{ return _cmp(lhs.first, rhs.first); }
+		};
+
+	public:
+		dense_ordered_map() { }
+
+		explicit dense_ordered_map(const Compare& comp, const Allocator& alloc = Allocator())
+			: Base(comp, alloc)
+		{ }
+
+		explicit dense_ordered_map(const Allocator& alloc)
+			: Base(Compare(), alloc)
+		{ }
+
+		template < class InputIterator >
+		dense_ordered_map(InputIterator first, InputIterator last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+			: Base(comp, alloc)
+		{ this->insert(first, last); }
+
+		template < class InputIterator >
+		dense_ordered_map(InputIterator first, InputIterator last, const Allocator& alloc)
+			: Base(Compare(), alloc)
+		{ this->insert(first, last); }
+
+		dense_ordered_map(const dense_ordered_map& other, const Allocator& alloc)
+			: Base(other, alloc)
+		{ }
+
+		dense_ordered_map(dense_ordered_map&& other, const Allocator& alloc)
+			: Base(std::move(other), alloc)
+		{ }
+
+		dense_ordered_map(std::initializer_list<value_type> list, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+			: Base(comp, alloc)
+		{ this->insert(list.begin(), list.end()); }
+
+		dense_ordered_map(std::initializer_list<value_type> list, const Allocator& alloc)
+			: Base(Compare(), alloc)
+		{ this->insert(list.begin(), list.end()); }
+
+		dense_ordered_map& operator = (std::initializer_list<value_type> list)
+		{
+			this->clear();
+			this->insert(list.begin(), list.end());
+			return *this;
+		}
+
+		T& at(const Key& key)
+		{
+			const iterator result = this->find(key);
+			STINGRAYKIT_CHECK(result != this->end(), CreateKeyNotFoundException(key));
+			return result->second;
+		}
+
+		const T& at(const Key& key) const
+		{
+			const const_iterator result = this->find(key);
+			STINGRAYKIT_CHECK(result != this->end(), CreateKeyNotFoundException(key));
+			return result->second;
+		}
+
+		template < typename K, typename Compare__ = Compare, typename EnableIf<Base::template IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+		T& at(const K& key)
+		{
+			const iterator result = this->find(key);
+			STINGRAYKIT_CHECK(result != this->end(), CreateKeyNotFoundException(key));
+			return result->second;
+		}
+
+		template < typename K, typename Compare__ = Compare, typename EnableIf<Base::template IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+		const T& at(const K& key) const
+		{
+			const const_iterator result = this->find(key);
+			STINGRAYKIT_CHECK(result != this->end(), CreateKeyNotFoundException(key));
+			return result->second;
+		}
+
+		T& operator [] (const Key& key)
+		{ return this->DoEmplaceKey(this->cend(), key, std::piecewise_construct, std::forward_as_tuple(key), std::make_tuple()).first->second; }
+
+		T& operator [] (Key&& key)
+		{ return this->DoEmplaceKey(this->cend(), key, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::make_tuple()).first->second; }
+
+		template < typename K, typename Compare__ = Compare, typename EnableIf<Base::template IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+		T& operator [] (K&& key)
+		{ return this->DoEmplaceKey(this->cend(), key, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::make_tuple()).first->second; }
+
+		using Base::erase;
+
+		iterator erase(iterator pos)
+		{ return Base::erase(const_iterator(pos)); }
+
+		value_compare value_comp() const
+		{ return value_compare(this->key_comp()); }
+
+		void swap(dense_ordered_map& other)
+		{ Base::swap(other); }
+
+		template < class K, class T_, class C, class A, template < typename, typename, typename > class S, class Predicate >
+		friend typename dense_ordered_map<K, T_, C, A, S>::size_type erase_if(dense_ordered_map<K, T_, C, A, S>& map, Predicate pred);
+	};
+
+
+	template < class K, class T, class C, class A, template < typename, typename, typename > class S >
+	void swap(dense_ordered_map<K, T, C, A, S>& lhs, dense_ordered_map<K, T, C, A, S>& rhs)
+	{ lhs.swap(rhs); }
+
+
+	/// @brief Erases all elements satisfying the predicate and compacts the rest
+	template < class K, class T, class C, class A, template < typename, typename, typename > class S, class Predicate >
+	typename dense_ordered_map<K, T, C, A, S>::size_type erase_if(dense_ordered_map<K, T, C, A, S>& map, Predicate pred)
+	{ return map.DoEraseIf(pred); }
+
+
+	template < class K, class T, class C, class A, template < typename, typename, typename > class S >
+	bool operator == (const dense_ordered_map<K, T, C, A, S>& lhs, const dense_ordered_map<K, T, C, A, S>& rhs)
+	{ return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+	STINGRAYKIT_GENERATE_NON_MEMBER_EQUALITY_OPERATORS_FROM_EQUAL(MK_PARAM(template < class K, class T, class C, class A, template < typename, typename, typename > class S >), MK_PARAM(dense_ordered_map<K, T, C, A, S>), MK_PARAM(dense_ordered_map<K, T, C, A, S>));
+
+
+	template < class K, class T, class C, class A, template < typename, typename, typename > class S >
+	bool operator < (const dense_ordered_map<K, T, C, A, S>& lhs, const dense_ordered_map<K, T, C, A, S>& rhs)
+	{ return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+	STINGRAYKIT_GENERATE_NON_MEMBER_RELATIONAL_OPERATORS_FROM_LESS(MK_PARAM(template < class K, class T, class C, class A, template < typename, typename, typename > class S >), MK_PARAM(dense_ordered_map<K, T, C, A, S>), MK_PARAM(dense_ordered_map<K, T, C, A, S>));
+
+}
+
+#endif
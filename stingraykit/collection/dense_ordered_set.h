@@ -0,0 +1,130 @@
+#ifndef STINGRAYKIT_COLLECTION_DENSE_ORDERED_SET_H
+#define STINGRAYKIT_COLLECTION_DENSE_ORDERED_SET_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/CollectionHelpers.h>
+#include <stingraykit/collection/btree_set.h>
+#include <stingraykit/collection/dense_ordered_table.h>
+
+namespace stingray
+{
+
+	namespace Detail
+	{
+
+		template < typename Key_ >
+		struct DenseOrderedSetPolicy
+		{
+			using KeyType = Key_;
+			using ValueType = Key_;
+			using MutableValueType = Key_;
+
+			static const Key_& GetKey(const ValueType& value) { return value; }
+		};
+
+	}
+
+
+	/**
+	 * @brief Set preserving insertion order of its elements, stored in a dense array, see Detail::DenseOrderedTable
+	 * @details Lookup goes through SortedIndex, a std::set-like container of element pointers. Hints of insertion are positions in
+	 * that order: a new element is placed before the hint. Unlike ordered_set, it does not allocate per element and iterates over
+	 * contiguous memory, but insertion and erasure may move elements, invalidating all iterators and references, and insertion
+	 * before an existing element may take linear time.
+	 */
+	template < class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key>, template < typename, typename, typename > class SortedIndex = btree_set >
+	class dense_ordered_set : public Detail::DenseOrderedTable<Detail::DenseOrderedSetPolicy<Key>, Compare, Allocator, SortedIndex>
+	{
+		using Base = Detail::DenseOrderedTable<Detail::DenseOrderedSetPolicy<Key>, Compare, Allocator, SortedIndex>;
+
+	public:
+		using value_compare = Compare;
+
+		using typename Base::value_type;
+
+	public:
+		dense_ordered_set() { }
+
+		explicit dense_ordered_set(const Compare& comp, const Allocator& alloc = Allocator())
+			: Base(comp, alloc)
+		{ }
+
+		explicit dense_ordered_set(const Allocator& alloc)
+			: Base(Compare(), alloc)
+		{ }
+
+		template < class InputIterator >
+		dense_ordered_set(InputIterator first, InputIterator last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+			: Base(comp, alloc)
+		{ this->insert(first, last); }
+
+		template < class InputIterator >
+		dense_ordered_set(InputIterator first, InputIterator last, const Allocator& alloc)
+			: Base(Compare(), alloc)
+		{ this->insert(first, last); }
+
+		dense_ordered_set(const dense_ordered_set& other, const Allocator& alloc)
+			: Base(other, alloc)
+		{ }
+
+		dense_ordered_set(dense_ordered_set&& other, const Allocator& alloc)
+			: Base(std::move(other), alloc)
+		{ }
+
+		dense_ordered_set(std::initializer_list<value_type> list, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+			: Base(comp, alloc)
+		{ this->insert(list.begin(), list.end()); }
+
+		dense_ordered_set(std::initializer_list<value_type> list, const Allocator& alloc)
+			: Base(Compare(), alloc)
+		{ this->insert(list.begin(), list.end()); }
+
+		dense_ordered_set& operator = (std::initializer_list<value_type> list)
+		{
+			this->clear();
+			this->insert(list.begin(), list.end());
+			return *this;
+		}
+
+		value_compare value_comp() const
+		{ return this->key_comp(); }
+
+		void swap(dense_ordered_set& other)
+		{ Base::swap(other); }
+
+		template < class K, class C, class A, template < typename, typename, typename > class S, class Predicate >
+		friend typename dense_ordered_set<K, C, A, S>::size_type erase_if(dense_ordered_set<K, C, A, S>& set, Predicate pred);
+	};
+
+
+	template < class K, class C, class A, template < typename, typename, typename > class S >
+	void swap(dense_ordered_set<K, C, A, S>& lhs, dense_ordered_set<K, C, A, S>& rhs)
+	{ lhs.swap(rhs); }
+
+
+	/// @brief Erases all elements satisfying the predicate and compacts the rest
+	template < class K, class C, class A, template < typename, typename, typename > class S, class Predicate >
+	typename dense_ordered_set<K, C, A, S>::size_type erase_if(dense_ordered_set<K, C, A, S>& set, Predicate pred)
+	{ return set.DoEraseIf(pred); }
+
+
+	template < class K, class C, class A, template < typename, typename, typename > class S >
+	bool operator == (const dense_ordered_set<K, C, A, S>& lhs, const dense_ordered_set<K, C, A, S>& rhs)
+	{ return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+	STINGRAYKIT_GENERATE_NON_MEMBER_EQUALITY_OPERATORS_FROM_EQUAL(MK_PARAM(template < class K, class C, class A, template < typename, typename, typename > class S >), MK_PARAM(dense_ordered_set<K, C, A, S>), MK_PARAM(dense_ordered_set<K, C, A, S>));
+
+
+	template < class K, class C, class A, template < typename, typename, typename > class S >
+	bool operator < (const dense_ordered_set<K, C, A, S>& lhs, const dense_ordered_set<K, C, A, S>& rhs)
+	{ return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+	STINGRAYKIT_GENERATE_NON_MEMBER_RELATIONAL_OPERATORS_FROM_LESS(MK_PARAM(template < class K, class C, class A, template < typename, typename, typename > class S >), MK_PARAM(dense_ordered_set<K, C, A, S>), MK_PARAM(dense_ordered_set<K, C, A, S>));
+
+}
+
+#endif
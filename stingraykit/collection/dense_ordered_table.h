@@ -0,0 +1,725 @@
+#ifndef STINGRAYKIT_COLLECTION_DENSE_ORDERED_TABLE_H
+#define STINGRAYKIT_COLLECTION_DENSE_ORDERED_TABLE_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/iterator_base.h>
+#include <stingraykit/core/NullPtrType.h>
+#include <stingraykit/metaprogramming/EnableIf.h>
+#include <stingraykit/metaprogramming/If.h>
+#include <stingraykit/metaprogramming/TypeRelationships.h>
+#include <stingraykit/Types.h>
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace stingray
+{
+
+	namespace Detail
+	{
+
+		/**
+		 * @brief Storage of dense_ordered_map and dense_ordered_set
+		 * @details Values live in a dense array of slots in their order, so iteration is a linear scan. Erasure leaves a tombstone,
+		 * which iterators skip; slots are compacted once tombstones outnumber values, or when the array is full and a quarter of it
+		 * is tombstones. Lookup goes through SortedIndex_, a std::set-like container of slot pointers ordered by their keys, which
+		 * is rebuilt whenever values move to other slots. Insertion before an existing value reuses a tombstone right before it, if
+		 * any, and otherwise moves all the values to a new array, so it takes linear time and rebuilds the index.
+		 * Moving values invalidates all iterators and references: this happens on insertion into a full array, on insertion before
+		 * an existing value without a tombstone to reuse and on erasure triggering compaction. Otherwise, insertion and erasure
+		 * keep iterators to other values valid.
+		 * Values are moved to a new array only, copied there unless their move constructor does not throw, and the index for the new
+		 * array is built before the old one is released, so insertion leaves the container unchanged if anything throws. Failed
+		 * compaction on erasure is skipped. The only exception is a value which is not copyable and whose move constructor may throw:
+		 * a failure while moving such values leaves the container empty.
+		 */
+		template < typename Policy_, typename Compare_, typename Allocator_, template < typename, typename, typename > class SortedIndex_ >
+		class DenseOrderedTable
+		{
+		protected:
+			template < typename Compare__, typename Enabler = void >
+			struct IsTransparent : public FalseType
+			{ };
+
+			template < typename Compare__ >
+			struct IsTransparent<Compare__, typename EnableIf<decltype(std::declval<typename Compare__::is_transparent*>(), TrueType())::Value, void>::ValueT> : public TrueType
+			{ };
+
+		public:
+			using key_type = typename Policy_::KeyType;
+			using value_type = typename Policy_::ValueType;
+			using size_type = size_t;
+			using difference_type = std::ptrdiff_t;
+			using key_compare = Compare_;
+			using allocator_type = Allocator_;
+			using reference = value_type&;
+			using const_reference = const value_type&;
+			using pointer = typename std::allocator_traits<Allocator_>::pointer;
+			using const_pointer = typename std::allocator_traits<Allocator_>::const_pointer;
+
+		private:
+			using Key = key_type;
+			using MutableValue = typename Policy_::MutableValueType;
+
+			static const bool IsSet = IsSame<Key, value_type>::Value;
+
+			static const size_t MinCapacity = 4;
+			static const size_t NoPosition = ~(size_t)0;
+
+			/// @note Values are moved between slots as MutableValue, so keys of a map are moved rather than copied
+			struct Slot
+			{
+				union
+				{
+					value_type			Value;
+					MutableValue		Mutable;
+				};
+				bool					Live;
+
+				Slot() : Live(false) { }
+				~Slot() { }
+			};
+
+			struct SlotCompare
+			{
+				using is_transparent = void;
+
+				Compare_				Cmp;
+
+				SlotCompare() { }
+				SlotCompare(const Compare_& comp) : Cmp(comp) { }
+
+				bool operator () (Slot* lhs, Slot* rhs) const
+				{ return Cmp(Policy_::GetKey(lhs->Value), Policy_::GetKey(rhs->Value)); }
+
+				bool operator () (Slot* lhs, const Key& rhs) const
+				{ return Cmp(Policy_::GetKey(lhs->Value), rhs); }
+
+				bool operator () (const Key& lhs, Slot* rhs) const
+				{ return Cmp(lhs, Policy_::GetKey(rhs->Value)); }
+
+				template < typename K, typename Compare__ = Compare_, typename EnableIf<IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+				bool operator () (Slot* lhs, const K& rhs) const
+				{ return Cmp(Policy_::GetKey(lhs->Value), rhs); }
+
+				template < typename K, typename Compare__ = Compare_, typename EnableIf<IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+				bool operator () (const K& lhs, Slot* rhs) const
+				{ return Cmp(lhs, Policy_::GetKey(rhs->Value)); }
+			};
+
+			using SlotAllocator = typename std::allocator_traits<Allocator_>::template rebind_alloc<Slot>;
+			using PositionAllocator = typename std::allocator_traits<Allocator_>::template rebind_alloc<size_t>;
+
+			using Index = SortedIndex_<Slot*, SlotCompare, typename std::allocator_traits<Allocator_>::template rebind_alloc<Slot*>>;
+			using IndexIterator = typename Index::const_iterator;
+
+			template < typename ValueType_ >
+			class Iterator : public iterator_base<Iterator<ValueType_>, ValueType_, std::bidirectional_iterator_tag>
+			{
+				using base = iterator_base<Iterator<ValueType_>, ValueType_, std::bidirectional_iterator_tag>;
+
+				friend class DenseOrderedTable;
+
+			private:
+				Slot*			_slot;
+
+			public:
+				Iterator() : _slot() { }
+
+				template < typename OtherValueType_, typename EnableIf<IsConvertible<OtherValueType_*, ValueType_*>::Value, int>::ValueT = 0 >
+				Iterator(const Iterator<OtherValueType_>& other) : _slot(other._slot) { }
+
+				typename base::reference dereference() const
+				{ return _slot->Value; }
+
+				template < typename OtherValueType_ >
+				bool equal(const Iterator<OtherValueType_>& other) const
+				{ return _slot == other._slot; }
+
+				// slots are terminated by a live sentinel, and the first slot before a valid iterator is always live
+				void increment()
+				{
+					do
+						++_slot;
+					while (!_slot->Live);
+				}
+
+				void decrement()
+				{
+					do
+						--_slot;
+					while (!_slot->Live);
+				}
+
+			private:
+				explicit Iterator(Slot* slot) : _slot(slot) { }
+
+				template < typename OtherValueType_ >
+				friend class Iterator;
+			};
+
+		public:
+			// elements of a set are keys, so they are never mutable
+			using iterator = Iterator<typename If<IsSet, const value_type, value_type>::ValueT>;
+			using const_iterator = Iterator<const value_type>;
+			using reverse_iterator = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		private:
+			Slot*				_slots;
+			size_t				_count;
+			size_t				_capacity;
+			size_t				_size;
+			size_t				_head;
+			Index				_index;
+			SlotAllocator		_alloc;
+
+		public:
+			explicit DenseOrderedTable(const Compare_& comp = Compare_(), const Allocator_& alloc = Allocator_())
+				:	_slots(), _count(0), _capacity(0), _size(0), _head(0), _index(SlotCompare(comp), alloc), _alloc(alloc)
+			{ }
+
+			DenseOrderedTable(const DenseOrderedTable& other)
+				:	DenseOrderedTable(other.key_comp(), std::allocator_traits<Allocator_>::select_on_container_copy_construction(other.get_allocator()))
+			{ CopyFrom(other); }
+
+			DenseOrderedTable(const DenseOrderedTable& other, const Allocator_& alloc)
+				:	DenseOrderedTable(other.key_comp(), alloc)
+			{ CopyFrom(other); }
+
+			DenseOrderedTable(DenseOrderedTable&& other)
+				:	_slots(other._slots), _count(other._count), _capacity(other._capacity), _size(other._size), _head(other._head), _index(std::move(other._index)), _alloc(other._alloc)
+			{ other.Release(); }
+
+			DenseOrderedTable(DenseOrderedTable&& other, const Allocator_& alloc)
+				:	DenseOrderedTable(other.key_comp(), alloc)
+			{
+				if (_alloc == other._alloc)
+				{
+					swap(other);
+					return;
+				}
+
+				if (other._size != 0)
+					Relocate(other._size, 0, null);
+
+				for (size_t i = other._head; i < other._count; ++i)
+					if (other._slots[i].Live)
+						DoEmplace(cend(), std::move(other._slots[i].Mutable));
+			}
+
+			~DenseOrderedTable()
+			{
+				clear();
+				if (_slots)
+					FreeSlots(_slots, _capacity);
+			}
+
+			DenseOrderedTable& operator = (const DenseOrderedTable& other)
+			{
+				if (this != &other)
+				{
+					clear();
+					insert(other.begin(), other.end());
+				}
+				return *this;
+			}
+
+			DenseOrderedTable& operator = (DenseOrderedTable&& other)
+			{
+				DenseOrderedTable tmp(std::move(other));
+				swap(tmp);
+				return *this;
+			}
+
+			allocator_type get_allocator() const	{ return allocator_type(_alloc); }
+
+			iterator begin()						{ return iterator(_slots + _head); }
+			const_iterator begin() const			{ return const_iterator(_slots + _head); }
+			const_iterator cbegin() const			{ return begin(); }
+
+			iterator end()							{ return iterator(_slots + _count); }
+			const_iterator end() const				{ return const_iterator(_slots + _count); }
+			const_iterator cend() const				{ return end(); }
+
+			reverse_iterator rbegin()				{ return reverse_iterator(end()); }
+			const_reverse_iterator rbegin() const	{ return const_reverse_iterator(end()); }
+			const_reverse_iterator crbegin() const	{ return rbegin(); }
+
+			reverse_iterator rend()					{ return reverse_iterator(begin()); }
+			const_reverse_iterator rend() const		{ return const_reverse_iterator(begin()); }
+			const_reverse_iterator crend() const	{ return rend(); }
+
+			bool empty() const						{ return _size == 0; }
+			size_type size() const					{ return _size; }
+			size_type max_size() const				{ return std::min<size_type>(std::allocator_traits<SlotAllocator>::max_size(_alloc) - 1, _index.max_size()); }
+
+			void clear()
+			{
+				_index.clear();
+				for (size_t i = _head; i < _count; ++i)
+					if (_slots[i].Live)
+						Destroy(_slots + i);
+
+				_count = _size = _head = 0;
+				if (_slots)
+					_slots[0].Live = true;
+			}
+
+			std::pair<iterator, bool> insert(const value_type& value)
+			{ return DoEmplaceKey(cend(), Policy_::GetKey(value), value); }
+
+			std::pair<iterator, bool> insert(value_type&& value)
+			{ return DoEmplaceKey(cend(), Policy_::GetKey(value), std::move(value)); }
+
+			iterator insert(const_iterator hint, const value_type& value)
+			{ return DoEmplaceKey(hint, Policy_::GetKey(value), value).first; }
+
+			iterator insert(const_iterator hint, value_type&& value)
+			{ return DoEmplaceKey(hint, Policy_::GetKey(value), std::move(value)).first; }
+
+			template < class InputIterator >
+			void insert(InputIterator first, InputIterator last)
+			{
+				for ( ; first != last; ++first)
+					insert(*first);
+			}
+
+			void insert(std::initializer_list<value_type> list)
+			{ insert(list.begin(), list.end()); }
+
+			template < typename... Ts >
+			std::pair<iterator, bool> emplace(Ts&&... args)
+			{ return DoEmplace(cend(), std::forward<Ts>(args)...); }
+
+			template < typename... Ts >
+			iterator emplace_hint(const_iterator hint, Ts&&... args)
+			{ return DoEmplace(hint, std::forward<Ts>(args)...).first; }
+
+			iterator erase(const_iterator pos)
+			{
+				Slot* next = pos._slot;
+				Kill(next);
+
+				do
+					++next;
+				while (!next->Live);
+
+				return iterator(_slots + Settle(next - _slots));
+			}
+
+			iterator erase(const_iterator first, const_iterator last)
+			{
+				if (first == last)
+					return iterator(last._slot);
+
+				for (Slot* slot = first._slot; slot != last._slot; ++slot)
+					if (slot->Live)
+						Kill(slot);
+
+				return iterator(_slots + Settle(last._slot - _slots));
+			}
+
+			size_type erase(const Key& key)
+			{
+				const const_iterator pos = find(key);
+				if (pos == end())
+					return 0;
+
+				erase(pos);
+				return 1;
+			}
+
+			void swap(DenseOrderedTable& other)
+			{
+				std::swap(_slots, other._slots);
+				std::swap(_count, other._count);
+				std::swap(_capacity, other._capacity);
+				std::swap(_size, other._size);
+				std::swap(_head, other._head);
+				_index.swap(other._index);
+				std::swap(_alloc, other._alloc);
+			}
+
+			size_type count(const Key& key) const
+			{ return _index.count(key); }
+
+			template < typename K, typename Compare__ = Compare_, typename EnableIf<IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+			size_type count(const K& key) const
+			{ return _index.count(key); }
+
+			iterator find(const Key& key)
+			{ return DoFind<iterator>(key); }
+
+			const_iterator find(const Key& key) const
+			{ return DoFind<const_iterator>(key); }
+
+			template < typename K, typename Compare__ = Compare_, typename EnableIf<IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+			iterator find(const K& key)
+			{ return DoFind<iterator>(key); }
+
+			template < typename K, typename Compare__ = Compare_, typename EnableIf<IsTransparent<Compare__>::Value, int>::ValueT = 0 >
+			const_iterator find(const K& key) const
+			{ return DoFind<const_iterator>(key); }
+
+			key_compare key_comp() const			{ return _index.key_comp().Cmp; }
+
+		protected:
+			/// @brief Inserts a value constructed from args before pos unless the key is already present
+			template < typename K, typename... Ts >
+			std::pair<iterator, bool> DoEmplaceKey(const_iterator pos, const K& key, Ts&&... args)
+			{
+				const IndexIterator hint = _index.lower_bound(key);
+				if (hint != _index.end() && !_index.key_comp()(key, *hint))
+					return std::make_pair(iterator(*hint), false);
+
+				Slot spare;
+				Slot* const slot = _count != _capacity ? _slots + _count : &spare;
+				new (&slot->Value) value_type(std::forward<Ts>(args)...);
+				return std::make_pair(Attach(pos._slot - _slots, slot, hint), true);
+			}
+
+			/// @brief Inserts a value constructed from args before pos unless its key is already present
+			/// @note If there is no free slot, the value is constructed aside, so emplacing a present key never moves values
+			template < typename... Ts >
+			std::pair<iterator, bool> DoEmplace(const_iterator pos, Ts&&... args)
+			{
+				Slot spare;
+				Slot* const slot = _count != _capacity ? _slots + _count : &spare;
+				new (&slot->Value) value_type(std::forward<Ts>(args)...);
+
+				IndexIterator hint;
+				bool present = false;
+				try
+				{
+					hint = _index.lower_bound(slot);
+					present = hint != _index.end() && !_index.key_comp()(slot, *hint);
+				}
+				catch (...)
+				{
+					slot->Value.~value_type();
+					throw;
+				}
+
+				if (present)
+				{
+					slot->Value.~value_type();
+					return std::make_pair(iterator(*hint), false);
+				}
+
+				return std::make_pair(Attach(pos._slot - _slots, slot, hint), true);
+			}
+
+			template < typename Predicate >
+			size_type DoEraseIf(Predicate pred)
+			{
+				const size_t size = _size;
+
+				try
+				{
+					for (size_t i = _head; i < _count; ++i)
+						if (_slots[i].Live && pred(static_cast<const value_type&>(_slots[i].Value)))
+							Kill(_slots + i);
+				}
+				catch (...)
+				{
+					Settle(_count, true);
+					throw;
+				}
+
+				Settle(_count, true);
+				return size - _size;
+			}
+
+		private:
+			template < typename Iterator_, typename K >
+			Iterator_ DoFind(const K& key) const
+			{
+				const IndexIterator result = _index.find(key);
+				return result != _index.end() ? Iterator_(*result) : Iterator_(_slots + _count);
+			}
+
+			/// @brief Links the value constructed in the slot, either the one past the used ones or a spare one, so that it precedes the one at position
+			iterator Attach(size_t position, Slot* slot, IndexIterator hint)
+			{
+				const bool spare = slot != _slots + _count;
+
+				if (!spare && position == _count)
+				{
+					try
+					{ _index.insert(hint, slot); }
+					catch (...)
+					{
+						slot->Value.~value_type();
+						throw;
+					}
+
+					_slots[++_count].Live = true;
+					++_size;
+					return iterator(slot);
+				}
+
+				if (position != 0 && !_slots[position - 1].Live)
+				{
+					Slot* const target = _slots + position - 1;
+					try
+					{ Transfer(target, slot); }
+					catch (...)
+					{
+						slot->Value.~value_type();
+						throw;
+					}
+					// the slot past the used ones is the live sentinel
+					slot->Live = !spare;
+
+					try
+					{ _index.insert(hint, target); }
+					catch (...)
+					{
+						Destroy(target);
+						throw;
+					}
+
+					_head = std::min(_head, position - 1);
+					++_size;
+					return iterator(target);
+				}
+
+				try
+				{ position = Relocate(spare ? GrownCapacity() : _capacity, position, slot); }
+				catch (...)
+				{
+					slot->Value.~value_type();
+					throw;
+				}
+
+				return iterator(_slots + position);
+			}
+
+			static void Transfer(Slot* dst, Slot* src)
+			{
+				new (&dst->Mutable) MutableValue(std::move(src->Mutable));
+				dst->Live = true;
+				src->Mutable.~MutableValue();
+				src->Live = false;
+			}
+
+			static void Destroy(Slot* slot)
+			{
+				slot->Value.~value_type();
+				slot->Live = false;
+			}
+
+			void Kill(Slot* slot)
+			{
+				_index.erase(slot);
+				Destroy(slot);
+				--_size;
+			}
+
+			/// @brief Drops trailing tombstones and compacts slots once tombstones outnumber values, or if there are any and compact is set
+			/// @return New position of the value at position
+			size_t Settle(size_t position, bool compact = false)
+			{
+				while (_count != 0 && !_slots[_count - 1].Live)
+					--_count;
+				if (_slots)
+					_slots[_count].Live = true;
+
+				_head = std::min(_head, _count);
+				while (_head != _count && !_slots[_head].Live)
+					++_head;
+
+				position = std::min(position, _count);
+				if (compact ? _count == _size : _count - _size <= _size)
+					return position;
+
+				// compaction only saves memory and iteration time, so erasure succeeds even if it fails
+				try
+				{ return Relocate(_capacity, position, null); }
+				catch (...)
+				{ return std::min(position, _count); }
+			}
+
+			/// @brief Capacity of the array to move values to when there is no free slot: the same one if a quarter of slots is tombstones
+			size_t GrownCapacity() const
+			{
+				const size_t tombstones = _count - _size;
+				if (tombstones != 0 && tombstones * 4 >= _count)
+					return _capacity;
+
+				return _capacity != 0 ? _capacity * 2 : MinCapacity;
+			}
+
+			/// @brief Moves live values, in their order, to a new array, putting the value constructed in inserted, if any, before the one at position
+			/// @details The old array and index are released only when the new ones are complete, see the class description
+			/// @return New position of the inserted value, if any, or otherwise of the value at position
+			size_t Relocate(size_t capacity, size_t position, Slot* inserted)
+			{
+				std::vector<size_t, PositionAllocator> positions(_count + 1, NoPosition, PositionAllocator(_alloc));
+				Slot* const slots = NewSlots(capacity);
+
+				size_t count = 0;
+				size_t insertedPosition = NoPosition;
+				try
+				{
+					for (size_t i = 0; i <= _count; ++i)
+					{
+						if (inserted && i == position)
+						{
+							Migrate(slots + count, inserted);
+							insertedPosition = count++;
+						}
+
+						if (i == _count)
+							positions[i] = count;
+						else if (_slots[i].Live)
+						{
+							Migrate(slots + count, _slots + i);
+							positions[i] = count++;
+						}
+					}
+
+					Index index(_index.key_comp(), _index.get_allocator());
+					for (Slot* slot : _index)
+						index.insert(index.end(), slots + positions[slot - _slots]);
+					if (inserted)
+						index.insert(slots + insertedPosition);
+
+					_index.swap(index);
+				}
+				catch (...)
+				{
+					Restore(slots, positions, inserted, insertedPosition);
+					FreeSlots(slots, capacity);
+					throw;
+				}
+
+				for (size_t i = 0; i < _count; ++i)
+					if (_slots[i].Live)
+						_slots[i].Value.~value_type();
+				if (inserted)
+					inserted->Value.~value_type();
+
+				if (_slots)
+					FreeSlots(_slots, _capacity);
+
+				_slots = slots;
+				_capacity = capacity;
+				_count = count;
+				_head = 0;
+				_slots[_count].Live = true;
+
+				if (!inserted)
+					return positions[position];
+
+				++_size;
+				return insertedPosition;
+			}
+
+			// the same choice as std::move_if_noexcept makes
+			static const bool MovesValues = std::is_nothrow_move_constructible<MutableValue>::value || !std::is_copy_constructible<MutableValue>::value;
+			static const bool RestoresValues = !MovesValues || std::is_nothrow_move_constructible<MutableValue>::value;
+
+			static void Migrate(Slot* dst, Slot* src)
+			{
+				new (&dst->Mutable) MutableValue(std::move_if_noexcept(src->Mutable));
+				dst->Live = true;
+			}
+
+			/// @brief Undoes Migrate of the values whose new positions are set, giving moved values back to their slots
+			void Restore(Slot* slots, const std::vector<size_t, PositionAllocator>& positions, Slot* inserted, size_t insertedPosition)
+			{
+				if (!RestoresValues)
+				{
+					// moved-from values are left in their slots, the inserted one is destroyed by the caller
+					for (size_t i = 0; i < _count; ++i)
+						if (positions[i] != NoPosition)
+							Destroy(slots + positions[i]);
+					if (insertedPosition != NoPosition)
+						Destroy(slots + insertedPosition);
+
+					Abandon(_slots, _count);
+					return;
+				}
+
+				for (size_t i = 0; i < _count; ++i)
+					if (positions[i] != NoPosition)
+						Unmigrate(_slots + i, slots + positions[i]);
+				if (insertedPosition != NoPosition)
+					Unmigrate(inserted, slots + insertedPosition);
+			}
+
+			static void Unmigrate(Slot* slot, Slot* migrated)
+			{
+				if (MovesValues)
+				{
+					slot->Mutable.~MutableValue();
+					new (&slot->Mutable) MutableValue(std::move(migrated->Mutable));
+				}
+				Destroy(migrated);
+			}
+
+			/// @brief Destroys values in the first count of slots and empties the container
+			void Abandon(Slot* slots, size_t count)
+			{
+				_index.clear();
+				for (size_t i = 0; i < count; ++i)
+					if (slots[i].Live)
+						Destroy(slots + i);
+
+				if (slots == _slots)
+				{
+					_count = _size = _head = 0;
+					_slots[0].Live = true;
+				}
+			}
+
+			void CopyFrom(const DenseOrderedTable& other)
+			{
+				if (other._size != 0)
+					Relocate(other._size, 0, null);
+
+				for (const value_type& value : other)
+					DoEmplace(cend(), value);
+			}
+
+			void Release()
+			{
+				_slots = null;
+				_count = _capacity = _size = _head = 0;
+				_index.clear();
+			}
+
+			Slot* NewSlots(size_t capacity)
+			{
+				Slot* const slots = std::allocator_traits<SlotAllocator>::allocate(_alloc, capacity + 1);
+				for (size_t i = 0; i <= capacity; ++i)
+					new (slots + i) Slot();
+				return slots;
+			}
+
+			void FreeSlots(Slot* slots, size_t capacity)
+			{ std::allocator_traits<SlotAllocator>::deallocate(_alloc, slots, capacity + 1); }
+		};
+
+
+		template < typename Policy_, typename Compare_, typename Allocator_, template < typename, typename, typename > class SortedIndex_ >
+		const size_t DenseOrderedTable<Policy_, Compare_, Allocator_, SortedIndex_>::MinCapacity;
+
+		template < typename Policy_, typename Compare_, typename Allocator_, template < typename, typename, typename > class SortedIndex_ >
+		const size_t DenseOrderedTable<Policy_, Compare_, Allocator_, SortedIndex_>::NoPosition;
+
+	}
+
+}
+
+#endif
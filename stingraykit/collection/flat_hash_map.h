@@ -0,0 +1,163 @@
+#ifndef STINGRAYKIT_COLLECTION_FLAT_HASH_MAP_H
+#define STINGRAYKIT_COLLECTION_FLAT_HASH_MAP_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/KeyExceptionCreator.h>
+#include <stingraykit/collection/flat_hash_table.h>
+
+#include <tuple>
+
+namespace stingray
+{
+
+	namespace Detail
+	{
+
+		template < typename Key_, typename T_ >
+		struct FlatHashMapKeyGetter
+		{
+			static const Key_& Get(const std::pair<const Key_, T_>& value) { return value.first; }
+		};
+
+	}
+
+
+	/**
+	 * @brief Unordered map storing its elements in a flat open addressing table, see Detail::FlatHashTable
+	 * @details Lookup of a present key usually takes a single group probe and a single key comparison. Rehashing and erasing invalidate
+	 * iterators and references, erasing doesn't invalidate other iterators though. Heterogeneous lookup is enabled if both Hash and KeyEqual
+	 * declare is_transparent.
+	 */
+	template < class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key> >
+	class flat_hash_map : public Detail::FlatHashTable<std::pair<const Key, T>, Key, Detail::FlatHashMapKeyGetter<Key, T>, Hash, KeyEqual>
+	{
+		using Base = Detail::FlatHashTable<std::pair<const Key, T>, Key, Detail::FlatHashMapKeyGetter<Key, T>, Hash, KeyEqual>;
+
+	public:
+		using mapped_type = T;
+
+		using typename Base::key_type;
+		using typename Base::value_type;
+		using typename Base::size_type;
+		using typename Base::iterator;
+		using typename Base::const_iterator;
+
+	public:
+		flat_hash_map() { }
+
+		explicit flat_hash_map(size_type bucketCount, const Hash& hash = Hash(), const KeyEqual& equals = KeyEqual())
+			: Base(bucketCount, hash, equals)
+		{ }
+
+		template < class InputIterator >
+		flat_hash_map(InputIterator first, InputIterator last, size_type bucketCount = 0, const Hash& hash = Hash(), const KeyEqual& equals = KeyEqual())
+			: Base(bucketCount, hash, equals)
+		{ this->insert(first, last); }
+
+		flat_hash_map(std::initializer_list<value_type> list, size_type bucketCount = 0, const Hash& hash = Hash(), const KeyEqual& equals = KeyEqual())
+			: Base(bucketCount, hash, equals)
+		{ this->insert(list.begin(), list.end()); }
+
+		flat_hash_map& operator = (std::initializer_list<value_type> list)
+		{
+			this->clear();
+			this->insert(list.begin(), list.end());
+			return *this;
+		}
+
+		T& at(const Key& key)
+		{
+			const iterator result = this->find(key);
+			STINGRAYKIT_CHECK(result != this->end(), CreateKeyNotFoundException(key));
+			return result->second;
+		}
+
+		const T& at(const Key& key) const
+		{
+			const const_iterator result = this->find(key);
+			STINGRAYKIT_CHECK(result != this->end(), CreateKeyNotFoundException(key));
+			return result->second;
+		}
+
+		template < typename K, typename Hash__ = Hash, typename EnableIf<Base::template IsTransparent<Hash__, KeyEqual>::Value, int>::ValueT = 0 >
+		T& at(const K& key)
+		{
+			const iterator result = this->find(key);
+			STINGRAYKIT_CHECK(result != this->end(), CreateKeyNotFoundException(key));
+			return result->second;
+		}
+
+		template < typename K, typename Hash__ = Hash, typename EnableIf<Base::template IsTransparent<Hash__, KeyEqual>::Value, int>::ValueT = 0 >
+		const T& at(const K& key) const
+		{
+			const const_iterator result = this->find(key);
+			STINGRAYKIT_CHECK(result != this->end(), CreateKeyNotFoundException(key));
+			return result->second;
+		}
+
+		T& operator [] (const Key& key)
+		{ return try_emplace(key).first->second; }
+
+		T& operator [] (Key&& key)
+		{ return try_emplace(std::move(key)).first->second; }
+
+		template < typename... Ts >
+		std::pair<iterator, bool> try_emplace(const Key& key, Ts&&... args)
+		{ return this->DoEmplace(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Ts>(args)...)); }
+
+		template < typename... Ts >
+		std::pair<iterator, bool> try_emplace(Key&& key, Ts&&... args)
+		{ return this->DoEmplace(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Ts>(args)...)); }
+
+		template < typename... Ts >
+		iterator try_emplace(const_iterator, const Key& key, Ts&&... args)
+		{ return try_emplace(key, std::forward<Ts>(args)...).first; }
+
+		template < typename... Ts >
+		iterator try_emplace(const_iterator, Key&& key, Ts&&... args)
+		{ return try_emplace(std::move(key), std::forward<Ts>(args)...).first; }
+
+		template < typename M >
+		std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj)
+		{
+			const std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(obj));
+			if (!result.second)
+				result.first->second = std::forward<M>(obj);
+			return result;
+		}
+
+		template < typename M >
+		std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj)
+		{
+			const std::pair<iterator, bool> result = try_emplace(std::move(key), std::forward<M>(obj));
+			if (!result.second)
+				result.first->second = std::forward<M>(obj);
+			return result;
+		}
+
+		template < typename M >
+		iterator insert_or_assign(const_iterator, const Key& key, M&& obj)
+		{ return insert_or_assign(key, std::forward<M>(obj)).first; }
+
+		template < typename M >
+		iterator insert_or_assign(const_iterator, Key&& key, M&& obj)
+		{ return insert_or_assign(std::move(key), std::forward<M>(obj)).first; }
+
+		void swap(flat_hash_map& other)
+		{ Base::swap(other); }
+	};
+
+
+	template < class Key, class T, class Hash, class KeyEqual >
+	void swap(flat_hash_map<Key, T, Hash, KeyEqual>& lhs, flat_hash_map<Key, T, Hash, KeyEqual>& rhs)
+	{ lhs.swap(rhs); }
+
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef STINGRAYKIT_COLLECTION_FLAT_HASH_SET_H
+#define STINGRAYKIT_COLLECTION_FLAT_HASH_SET_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/flat_hash_table.h>
+
+namespace stingray
+{
+
+	namespace Detail
+	{
+
+		template < typename Key_ >
+		struct FlatHashSetKeyGetter
+		{
+			static const Key_& Get(const Key_& value) { return value; }
+		};
+
+	}
+
+
+	/**
+	 * @brief Unordered set storing its elements in a flat open addressing table, see Detail::FlatHashTable
+	 * @details Rehashing and erasing invalidate iterators and references, erasing doesn't invalidate other iterators though.
+	 * Heterogeneous lookup is enabled if both Hash and KeyEqual declare is_transparent.
+	 */
+	template < class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key> >
+	class flat_hash_set : public Detail::FlatHashTable<Key, Key, Detail::FlatHashSetKeyGetter<Key>, Hash, KeyEqual>
+	{
+		using Base = Detail::FlatHashTable<Key, Key, Detail::FlatHashSetKeyGetter<Key>, Hash, KeyEqual>;
+
+	public:
+		using typename Base::value_type;
+		using typename Base::size_type;
+
+	public:
+		flat_hash_set() { }
+
+		explicit flat_hash_set(size_type bucketCount, const Hash& hash = Hash(), const KeyEqual& equals = KeyEqual())
+			: Base(bucketCount, hash, equals)
+		{ }
+
+		template < class InputIterator >
+		flat_hash_set(InputIterator first, InputIterator last, size_type bucketCount = 0, const Hash& hash = Hash(), const KeyEqual& equals = KeyEqual())
+			: Base(bucketCount, hash, equals)
+		{ this->insert(first, last); }
+
+		flat_hash_set(std::initializer_list<value_type> list, size_type bucketCount = 0, const Hash& hash = Hash(), const KeyEqual& equals = KeyEqual())
+			: Base(bucketCount, hash, equals)
+		{ this->insert(list.begin(), list.end()); }
+
+		flat_hash_set& operator = (std::initializer_list<value_type> list)
+		{
+			this->clear();
+			this->insert(list.begin(), list.end());
+			return *this;
+		}
+
+		void swap(flat_hash_set& other)
+		{ Base::swap(other); }
+	};
+
+
+	template < class Key, class Hash, class KeyEqual >
+	void swap(flat_hash_set<Key, Hash, KeyEqual>& lhs, flat_hash_set<Key, Hash, KeyEqual>& rhs)
+	{ lhs.swap(rhs); }
+
+}
+
+#endif
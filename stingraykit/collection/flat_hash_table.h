@@ -0,0 +1,620 @@
+#ifndef STINGRAYKIT_COLLECTION_FLAT_HASH_TABLE_H
+#define STINGRAYKIT_COLLECTION_FLAT_HASH_TABLE_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/iterator_base.h>
+#include <stingraykit/core/NullPtrType.h>
+#include <stingraykit/metaprogramming/EnableIf.h>
+#include <stingraykit/metaprogramming/If.h>
+#include <stingraykit/metaprogramming/TypeRelationships.h>
+#include <stingraykit/Types.h>
+
+#include <functional>
+#include <memory>
+#include <string.h>
+
+#if defined(__SSE2__)
+#	include <emmintrin.h>
+#endif
+
+namespace stingray
+{
+
+	namespace Detail
+	{
+
+		struct FlatHashControl
+		{
+			static const s8 Empty = -128;
+			static const s8 Deleted = -2;
+
+			static bool IsFull(s8 ctrl) { return ctrl >= 0; }
+		};
+
+
+#if defined(__SSE2__)
+
+		/// @brief Control bytes of 16 consecutive slots, matched with a single SSE2 comparison
+		class FlatHashGroup
+		{
+		public:
+			static const size_t Width = 16;
+
+		private:
+			__m128i		_ctrl;
+
+		public:
+			explicit FlatHashGroup(const s8* ctrl) : _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) { }
+
+			u64 Match(s8 h2) const
+			{ return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl)); }
+
+			u64 MatchEmpty() const
+			{ return Match(FlatHashControl::Empty); }
+
+			u64 MatchEmptyOrDeleted() const
+			{ return (u32)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), _ctrl)); }
+
+			static size_t GetIndex(u64 mask)
+			{ return __builtin_ctzll(mask); }
+		};
+
+#else
+
+		/// @brief Control bytes of 8 consecutive slots, matched within a 64-bit word
+		class FlatHashGroup
+		{
+			static const u64 Lsbs = 0x0101010101010101ull;
+			static const u64 Msbs = 0x8080808080808080ull;
+
+		public:
+			static const size_t Width = 8;
+
+		private:
+			u64			_ctrl;
+
+		public:
+			explicit FlatHashGroup(const s8* ctrl)
+			{
+				::memcpy(&_ctrl, ctrl, sizeof(_ctrl));
+#	if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+				_ctrl = __builtin_bswap64(_ctrl);
+#	endif
+			}
+
+			/// @note May report a false positive for a byte following a real match, which is harmless as keys are compared anyway
+			u64 Match(s8 h2) const
+			{
+				const u64 x = _ctrl ^ (Lsbs * (u8)h2);
+				return (x - Lsbs) & ~x & Msbs;
+			}
+
+			u64 MatchEmpty() const
+			{ return _ctrl & (~_ctrl << 6) & Msbs; }
+
+			u64 MatchEmptyOrDeleted() const
+			{ return _ctrl & (~_ctrl << 7) & Msbs; }
+
+			static size_t GetIndex(u64 mask)
+			{ return __builtin_ctzll(mask) / 8; }
+		};
+
+#endif
+
+
+		/**
+		 * @brief Open addressing hash table with SwissTable layout
+		 * @details Every slot has a control byte: empty, deleted, or 7 bits of the key hash if the slot is full. Lookup probes groups of
+		 * control bytes, matching all of them with the hash bits at once, and compares keys only for the matched slots. Control bytes of
+		 * the first group are cloned after the last slot, so a group can start at any slot. Maximum load factor is 7/8.
+		 */
+		template < typename Value_, typename Key_, typename KeyGetter_, typename Hash_, typename KeyEqual_ >
+		class FlatHashTable
+		{
+		protected:
+			template < typename Hash__, typename KeyEqual__, typename Enabler = void >
+			struct IsTransparent : public FalseType
+			{ };
+
+			template < typename Hash__, typename KeyEqual__ >
+			struct IsTransparent<Hash__, KeyEqual__, typename EnableIf<decltype(std::declval<typename Hash__::is_transparent*>(), std::declval<typename KeyEqual__::is_transparent*>(), TrueType())::Value, void>::ValueT> : public TrueType
+			{ };
+
+			using Group = FlatHashGroup;
+
+		public:
+			using key_type = Key_;
+			using value_type = Value_;
+			using size_type = size_t;
+			using difference_type = std::ptrdiff_t;
+			using hasher = Hash_;
+			using key_equal = KeyEqual_;
+			using reference = value_type&;
+			using const_reference = const value_type&;
+			using pointer = value_type*;
+			using const_pointer = const value_type*;
+
+		private:
+			template < typename ValueType_ >
+			class Iterator : public iterator_base<Iterator<ValueType_>, ValueType_, std::bidirectional_iterator_tag>
+			{
+				using base = iterator_base<Iterator<ValueType_>, ValueType_, std::bidirectional_iterator_tag>;
+
+				friend class FlatHashTable;
+
+			private:
+				const s8*		_ctrl;
+				const s8*		_ctrlEnd;
+				ValueType_*		_slot;
+
+			public:
+				Iterator() : _ctrl(), _ctrlEnd(), _slot() { }
+
+				template < typename OtherValueType_, typename EnableIf<IsConvertible<OtherValueType_*, ValueType_*>::Value, int>::ValueT = 0 >
+				Iterator(const Iterator<OtherValueType_>& other) : _ctrl(other._ctrl), _ctrlEnd(other._ctrlEnd), _slot(other._slot) { }
+
+				typename base::reference dereference() const
+				{ return *_slot; }
+
+				template < typename OtherValueType_ >
+				bool equal(const Iterator<OtherValueType_>& other) const
+				{ return _slot == other._slot; }
+
+				void increment()
+				{
+					do
+					{
+						++_ctrl;
+						++_slot;
+					} while (_ctrl != _ctrlEnd && !FlatHashControl::IsFull(*_ctrl));
+				}
+
+				void decrement()
+				{
+					do
+					{
+						--_ctrl;
+						--_slot;
+					} while (!FlatHashControl::IsFull(*_ctrl));
+				}
+
+			private:
+				Iterator(const s8* ctrl, const s8* ctrlEnd, ValueType_* slot) : _ctrl(ctrl), _ctrlEnd(ctrlEnd), _slot(slot) { }
+
+				template < typename OtherValueType_ >
+				friend class Iterator;
+			};
+
+		public:
+			// elements of a set are keys, so they are never mutable
+			using iterator = Iterator<typename If<IsSame<Key_, Value_>::Value, const value_type, value_type>::ValueT>;
+			using const_iterator = Iterator<const value_type>;
+			using reverse_iterator = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		private:
+			s8*				_ctrl;
+			value_type*		_slots;
+			size_t			_capacity;
+			size_t			_size;
+			size_t			_growthLeft;
+			Hash_			_hash;
+			KeyEqual_		_equals;
+
+		public:
+			explicit FlatHashTable(size_t bucketCount = 0, const Hash_& hash = Hash_(), const KeyEqual_& equals = KeyEqual_())
+				:	_ctrl(), _slots(), _capacity(0), _size(0), _growthLeft(0), _hash(hash), _equals(equals)
+			{ reserve(bucketCount); }
+
+			FlatHashTable(const FlatHashTable& other)
+				:	_ctrl(), _slots(), _capacity(0), _size(0), _growthLeft(0), _hash(other._hash), _equals(other._equals)
+			{
+				if (other._size == 0)
+					return;
+
+				Allocate(other._capacity);
+				::memcpy(_ctrl, other._ctrl, GetCtrlSize(_capacity));
+
+				try
+				{
+					for (size_t index = 0; index < _capacity; ++index)
+						if (FlatHashControl::IsFull(_ctrl[index]))
+						{
+							new (&_slots[index]) value_type(other._slots[index]);
+							++_size;
+						}
+				}
+				catch (...)
+				{
+					for (size_t index = 0; _size != 0; ++index)
+						if (FlatHashControl::IsFull(_ctrl[index]))
+						{
+							_slots[index].~value_type();
+							--_size;
+						}
+
+					Deallocate();
+					throw;
+				}
+
+				_growthLeft = other._growthLeft;
+			}
+
+			FlatHashTable(FlatHashTable&& other)
+				:	_ctrl(other._ctrl), _slots(other._slots), _capacity(other._capacity), _size(other._size), _growthLeft(other._growthLeft), _hash(other._hash), _equals(other._equals)
+			{
+				other._ctrl = null;
+				other._slots = null;
+				other._capacity = other._size = other._growthLeft = 0;
+			}
+
+			~FlatHashTable()
+			{
+				DestroySlots();
+				Deallocate();
+			}
+
+			FlatHashTable& operator = (const FlatHashTable& other)
+			{
+				FlatHashTable tmp(other);
+				swap(tmp);
+				return *this;
+			}
+
+			FlatHashTable& operator = (FlatHashTable&& other)
+			{
+				FlatHashTable tmp(std::move(other));
+				swap(tmp);
+				return *this;
+			}
+
+			iterator begin()						{ return MakeIterator<iterator>(FindFirstFull()); }
+			const_iterator begin() const			{ return MakeIterator<const_iterator>(FindFirstFull()); }
+			const_iterator cbegin() const			{ return begin(); }
+
+			iterator end()							{ return MakeIterator<iterator>(_capacity); }
+			const_iterator end() const				{ return MakeIterator<const_iterator>(_capacity); }
+			const_iterator cend() const				{ return end(); }
+
+			reverse_iterator rbegin()				{ return reverse_iterator(end()); }
+			const_reverse_iterator rbegin() const	{ return const_reverse_iterator(end()); }
+			const_reverse_iterator crbegin() const	{ return rbegin(); }
+
+			reverse_iterator rend()					{ return reverse_iterator(begin()); }
+			const_reverse_iterator rend() const		{ return const_reverse_iterator(begin()); }
+			const_reverse_iterator crend() const	{ return rend(); }
+
+			bool empty() const						{ return _size == 0; }
+			size_type size() const					{ return _size; }
+			size_type bucket_count() const			{ return _capacity; }
+			float load_factor() const				{ return _capacity == 0 ? 0.0f : (float)_size / _capacity; }
+
+			hasher hash_function() const			{ return _hash; }
+			key_equal key_eq() const				{ return _equals; }
+
+			void reserve(size_type count)
+			{
+				if (GetCapacityFor(count) > _capacity)
+					Rehash(GetCapacityFor(count));
+			}
+
+			void clear()
+			{
+				DestroySlots();
+				if (_capacity != 0)
+				{
+					::memset(_ctrl, FlatHashControl::Empty, GetCtrlSize(_capacity));
+					_growthLeft = GetMaxSize(_capacity);
+				}
+			}
+
+			void swap(FlatHashTable& other)
+			{
+				std::swap(_ctrl, other._ctrl);
+				std::swap(_slots, other._slots);
+				std::swap(_capacity, other._capacity);
+				std::swap(_size, other._size);
+				std::swap(_growthLeft, other._growthLeft);
+				std::swap(_hash, other._hash);
+				std::swap(_equals, other._equals);
+			}
+
+			std::pair<iterator, bool> insert(const value_type& value)
+			{ return DoEmplace(KeyGetter_::Get(value), value); }
+
+			std::pair<iterator, bool> insert(value_type&& value)
+			{ return DoEmplace(KeyGetter_::Get(value), std::move(value)); }
+
+			iterator insert(const_iterator, const value_type& value)
+			{ return insert(value).first; }
+
+			iterator insert(const_iterator, value_type&& value)
+			{ return insert(std::move(value)).first; }
+
+			template < class InputIterator >
+			void insert(InputIterator first, InputIterator last)
+			{
+				if (IsInherited<typename std::iterator_traits<InputIterator>::iterator_category, std::random_access_iterator_tag>::Value)
+					reserve(size() + std::distance(first, last));
+
+				for (; first != last; ++first)
+					insert(*first);
+			}
+
+			void insert(std::initializer_list<value_type> list)
+			{ insert(list.begin(), list.end()); }
+
+			template < typename... Ts >
+			std::pair<iterator, bool> emplace(Ts&&... args)
+			{
+				value_type value(std::forward<Ts>(args)...);
+				return DoEmplace(KeyGetter_::Get(value), std::move(value));
+			}
+
+			template < typename... Ts >
+			iterator emplace_hint(const_iterator, Ts&&... args)
+			{ return emplace(std::forward<Ts>(args)...).first; }
+
+			iterator erase(const_iterator pos)
+			{
+				const size_t index = pos._slot - _slots;
+				EraseAt(index);
+				return ++MakeIterator<iterator>(index);
+			}
+
+			iterator erase(const_iterator first, const_iterator last)
+			{
+				while (first != last)
+					first = erase(first);
+				return MakeIterator<iterator>(last._slot - _slots);
+			}
+
+			size_type erase(const Key_& key)
+			{
+				const size_t index = FindIndex(key);
+				if (index == _capacity)
+					return 0;
+
+				EraseAt(index);
+				return 1;
+			}
+
+			iterator find(const Key_& key)									{ return MakeIterator<iterator>(FindIndex(key)); }
+			const_iterator find(const Key_& key) const						{ return MakeIterator<const_iterator>(FindIndex(key)); }
+
+			template < typename K, typename Hash__ = Hash_, typename EnableIf<IsTransparent<Hash__, KeyEqual_>::Value, int>::ValueT = 0 >
+			iterator find(const K& key)										{ return MakeIterator<iterator>(FindIndex(key)); }
+			template < typename K, typename Hash__ = Hash_, typename EnableIf<IsTransparent<Hash__, KeyEqual_>::Value, int>::ValueT = 0 >
+			const_iterator find(const K& key) const							{ return MakeIterator<const_iterator>(FindIndex(key)); }
+
+			size_type count(const Key_& key) const							{ return FindIndex(key) == _capacity ? 0 : 1; }
+
+			template < typename K, typename Hash__ = Hash_, typename EnableIf<IsTransparent<Hash__, KeyEqual_>::Value, int>::ValueT = 0 >
+			size_type count(const K& key) const								{ return FindIndex(key) == _capacity ? 0 : 1; }
+
+			std::pair<iterator, iterator> equal_range(const Key_& key)						{ return MakeRange<iterator>(FindIndex(key)); }
+			std::pair<const_iterator, const_iterator> equal_range(const Key_& key) const	{ return MakeRange<const_iterator>(FindIndex(key)); }
+
+			template < typename K, typename Hash__ = Hash_, typename EnableIf<IsTransparent<Hash__, KeyEqual_>::Value, int>::ValueT = 0 >
+			std::pair<iterator, iterator> equal_range(const K& key)							{ return MakeRange<iterator>(FindIndex(key)); }
+			template < typename K, typename Hash__ = Hash_, typename EnableIf<IsTransparent<Hash__, KeyEqual_>::Value, int>::ValueT = 0 >
+			std::pair<const_iterator, const_iterator> equal_range(const K& key) const		{ return MakeRange<const_iterator>(FindIndex(key)); }
+
+			friend bool operator == (const FlatHashTable& lhs, const FlatHashTable& rhs)
+			{
+				if (lhs.size() != rhs.size())
+					return false;
+
+				for (const value_type& value : lhs)
+				{
+					const const_iterator it = rhs.find(KeyGetter_::Get(value));
+					if (it == rhs.end() || !(*it == value))
+						return false;
+				}
+
+				return true;
+			}
+
+			friend bool operator != (const FlatHashTable& lhs, const FlatHashTable& rhs)
+			{ return !(lhs == rhs); }
+
+		protected:
+			template < typename K >
+			size_t FindIndex(const K& key) const
+			{ return _size == 0 ? _capacity : FindIndex(key, GetHash(key)); }
+
+			template < typename K >
+			size_t FindIndex(const K& key, u64 hash) const
+			{
+				if (_size == 0)
+					return _capacity;
+
+				const s8 h2 = GetH2(hash);
+				const size_t mask = _capacity - 1;
+
+				for (size_t pos = GetH1(hash) & mask, step = 0; ; step += Group::Width, pos = (pos + step) & mask)
+				{
+					const Group group(_ctrl + pos);
+
+					for (u64 matched = group.Match(h2); matched != 0; matched &= matched - 1)
+					{
+						const size_t index = (pos + Group::GetIndex(matched)) & mask;
+						if (_equals(KeyGetter_::Get(_slots[index]), key))
+							return index;
+					}
+
+					if (group.MatchEmpty() != 0)
+						return _capacity;
+				}
+			}
+
+			template < typename K, typename... Ts >
+			std::pair<iterator, bool> DoEmplace(const K& key, Ts&&... args)
+			{
+				const u64 hash = GetHash(key);
+
+				const size_t existing = FindIndex(key, hash);
+				if (existing != _capacity)
+					return std::make_pair(MakeIterator<iterator>(existing), false);
+
+				if (_growthLeft == 0)
+					Rehash(_size * 2 < GetMaxSize(_capacity) ? _capacity : (_capacity == 0 ? Group::Width : _capacity * 2));
+
+				const size_t index = FindFreeIndex(hash);
+
+				new (&_slots[index]) value_type(std::forward<Ts>(args)...);
+
+				if (_ctrl[index] == FlatHashControl::Empty)
+					--_growthLeft;
+				SetCtrl(index, GetH2(hash));
+				++_size;
+
+				return std::make_pair(MakeIterator<iterator>(index), true);
+			}
+
+			template < typename IteratorType >
+			IteratorType MakeIterator(size_t index) const
+			{ return IteratorType(_ctrl + index, _ctrl + _capacity, _slots + index); }
+
+		private:
+			template < typename IteratorType >
+			std::pair<IteratorType, IteratorType> MakeRange(size_t index) const
+			{
+				const IteratorType result = MakeIterator<IteratorType>(index);
+				return std::make_pair(result, index == _capacity ? result : ++IteratorType(result));
+			}
+
+			template < typename K >
+			u64 GetHash(const K& key) const
+			{
+				// hashes like identity of std::hash for integers must be mixed, as both position and control byte are taken from hash bits
+				u64 hash = (u64)_hash(key);
+				hash ^= hash >> 30;
+				hash *= 0xBF58476D1CE4E5B9ull;
+				hash ^= hash >> 27;
+				hash *= 0x94D049BB133111EBull;
+				return hash ^ (hash >> 31);
+			}
+
+			static size_t GetH1(u64 hash)			{ return (size_t)(hash >> 7); }
+			static s8 GetH2(u64 hash)				{ return (s8)(hash & 0x7F); }
+
+			static size_t GetCtrlSize(size_t capacity)		{ return capacity + Group::Width; }
+			static size_t GetMaxSize(size_t capacity)		{ return capacity - capacity / 8; }
+
+			static size_t GetCapacityFor(size_t count)
+			{
+				if (count == 0)
+					return 0;
+
+				size_t capacity = Group::Width;
+				while (GetMaxSize(capacity) < count)
+					capacity *= 2;
+				return capacity;
+			}
+
+			size_t FindFirstFull() const
+			{
+				size_t index = 0;
+				while (index != _capacity && !FlatHashControl::IsFull(_ctrl[index]))
+					++index;
+				return index;
+			}
+
+			size_t FindFreeIndex(u64 hash) const
+			{
+				const size_t mask = _capacity - 1;
+				for (size_t pos = GetH1(hash) & mask, step = 0; ; step += Group::Width, pos = (pos + step) & mask)
+				{
+					const u64 free = Group(_ctrl + pos).MatchEmptyOrDeleted();
+					if (free != 0)
+						return (pos + Group::GetIndex(free)) & mask;
+				}
+			}
+
+			void SetCtrl(size_t index, s8 ctrl)
+			{
+				_ctrl[index] = ctrl;
+				if (index < Group::Width)
+					_ctrl[_capacity + index] = ctrl;
+			}
+
+			void EraseAt(size_t index)
+			{
+				_slots[index].~value_type();
+				SetCtrl(index, FlatHashControl::Deleted);
+				--_size;
+			}
+
+			void Rehash(size_t capacity)
+			{
+				FlatHashTable tmp(0, _hash, _equals);
+				tmp.Allocate(capacity);
+
+				for (size_t index = 0; index < _capacity; ++index)
+					if (FlatHashControl::IsFull(_ctrl[index]))
+					{
+						const u64 hash = GetHash(KeyGetter_::Get(_slots[index]));
+						const size_t newIndex = tmp.FindFreeIndex(hash);
+
+						new (&tmp._slots[newIndex]) value_type(std::move_if_noexcept(_slots[index]));
+						tmp.SetCtrl(newIndex, GetH2(hash));
+						--tmp._growthLeft;
+						++tmp._size;
+					}
+
+				swap(tmp);
+			}
+
+			void Allocate(size_t capacity)
+			{
+				_slots = std::allocator<value_type>().allocate(capacity);
+				try
+				{ _ctrl = new s8[GetCtrlSize(capacity)]; }
+				catch (...)
+				{
+					std::allocator<value_type>().deallocate(_slots, capacity);
+					_slots = null;
+					throw;
+				}
+
+				::memset(_ctrl, FlatHashControl::Empty, GetCtrlSize(capacity));
+				_capacity = capacity;
+				_growthLeft = GetMaxSize(capacity);
+			}
+
+			void Deallocate()
+			{
+				if (_capacity == 0)
+					return;
+
+				delete[] _ctrl;
+				std::allocator<value_type>().deallocate(_slots, _capacity);
+
+				_ctrl = null;
+				_slots = null;
+				_capacity = _growthLeft = 0;
+			}
+
+			void DestroySlots()
+			{
+				for (size_t index = 0; _size != 0; ++index)
+					if (FlatHashControl::IsFull(_ctrl[index]))
+					{
+						_slots[index].~value_type();
+						--_size;
+					}
+			}
+		};
+
+	}
+
+}
+
+#endif
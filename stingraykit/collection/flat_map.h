@@ -9,6 +9,7 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #include <stingraykit/collection/KeyExceptionCreator.h>
+#include <stingraykit/core/SortedUniqueType.h>
 
 namespace stingray
 {
@@ -115,6 +116,11 @@ namespace stingray
 			: flat_map(first, last, Compare(), alloc)
 		{ }
 
+		template < class InputIterator >
+		flat_map(const SortedUniqueType&, InputIterator first, InputIterator last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+			: _container(first, last, alloc), _cmp(comp)
+		{ }
+
 		flat_map(const flat_map& other, const Allocator& alloc)
 			: _container(other._container, alloc), _cmp(Compare())
 		{ }
@@ -131,6 +137,10 @@ namespace stingray
 			: flat_map(list, Compare(), alloc)
 		{ }
 
+		flat_map(const SortedUniqueType&, std::initializer_list<value_type> list, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+			: _container(list, alloc), _cmp(comp)
+		{ }
+
 		flat_map& operator = (std::initializer_list<value_type> list)
 		{
 			clear();
@@ -249,19 +259,35 @@ namespace stingray
 			return insert(std::move(value)).first;
 		}
 
+		/// @brief Appends the range, then sorts and merges it at once. Existing elements are kept, as well as the first of equivalent ones in the range.
 		template < class InputIterator >
 		void insert(InputIterator first, InputIterator last)
 		{
-			if (IsInherited<typename std::iterator_traits<InputIterator>::iterator_category, std::random_access_iterator_tag>::Value)
-				reserve(size() + std::distance(first, last));
+			const size_type oldSize = size();
+			_container.insert(_container.end(), first, last);
+
+			const iterator appended = begin() + oldSize;
+			std::stable_sort(appended, end(), _cmp);
+			_container.erase(std::unique(appended, end(), EquivalentSortedImpl(_cmp)), end());
+
+			MergeAppended(oldSize);
+		}
 
-			while (first != last)
-				insert(*(first++));
+		/// @brief Merges the range, which must be sorted and hold no equivalent elements, in linear time
+		template < class InputIterator >
+		void insert(const SortedUniqueType&, InputIterator first, InputIterator last)
+		{
+			const size_type oldSize = size();
+			_container.insert(_container.end(), first, last);
+			MergeAppended(oldSize);
 		}
 
 		void insert(std::initializer_list<value_type> list)
 		{ insert(list.begin(), list.end()); }
 
+		void insert(const SortedUniqueType& tag, std::initializer_list<value_type> list)
+		{ insert(tag, list.begin(), list.end()); }
+
 		template < typename... Ts >
 		std::pair<iterator, bool> emplace(Ts&&... args)
 		{
@@ -373,6 +399,33 @@ namespace stingray
 		key_compare key_comp() const													{ return _cmp._cmp; }
 		value_compare value_comp() const												{ return value_compare(_cmp._cmp); }
 
+	private:
+		struct EquivalentSortedImpl
+		{
+			CompareImpl		_cmp;
+
+		public:
+			EquivalentSortedImpl(const CompareImpl& cmp) : _cmp(cmp) { }
+
+			bool operator () (const value_type& lhs, const value_type& rhs) const	{ return !_cmp(lhs, rhs); }
+		};
+
+		void MergeAppended(size_type oldSize)
+		{
+			if (oldSize == 0 || oldSize == size())
+				return;
+
+			const iterator appended = begin() + oldSize;
+			if (_cmp(*(appended - 1), *appended))
+				return;
+
+			std::inplace_merge(begin(), appended, end(), _cmp);
+			_container.erase(std::unique(begin(), end(), EquivalentSortedImpl(_cmp)), end());
+		}
+
+		template < class K, class T_, class C, class A, class Predicate >
+		friend typename flat_map<K, T_, C, A>::size_type erase_if(flat_map<K, T_, C, A>& map, Predicate pred);
+
 		template < class K, class T_, class C, class A >
 		friend bool operator == (const flat_map<K, T_, C, A>& lhs, const flat_map<K, T_, C, A>& rhs);
 		template < class K, class T_, class C, class A >
@@ -380,6 +433,17 @@ namespace stingray
 	};
 
 
+	/// @brief Erases all elements satisfying the predicate in linear time
+	template < class K, class T, class C, class A, class Predicate >
+	typename flat_map<K, T, C, A>::size_type erase_if(flat_map<K, T, C, A>& map, Predicate pred)
+	{
+		const auto it = std::remove_if(map._container.begin(), map._container.end(), pred);
+		const typename flat_map<K, T, C, A>::size_type result = std::distance(it, map._container.end());
+		map._container.erase(it, map._container.end());
+		return result;
+	}
+
+
 	template < class K, class T, class C, class A >
 	bool operator == (const flat_map<K, T, C, A>& lhs, const flat_map<K, T, C, A>& rhs)
 	{ return lhs._container == rhs._container; }
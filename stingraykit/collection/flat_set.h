@@ -9,6 +9,7 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #include <stingraykit/core/NonCopyable.h>
+#include <stingraykit/core/SortedUniqueType.h>
 #include <stingraykit/metaprogramming/EnableIf.h>
 #include <stingraykit/metaprogramming/TypeRelationships.h>
 #include <stingraykit/Macro.h>
@@ -83,6 +84,11 @@ namespace stingray
 			: flat_set(first, last, Compare(), alloc)
 		{ }
 
+		template < class InputIterator >
+		flat_set(const SortedUniqueType&, InputIterator first, InputIterator last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+			: _container(first, last, alloc), _cmp(comp)
+		{ }
+
 		flat_set(const flat_set& other, const Allocator& alloc)
 			: _container(other._container, alloc), _cmp(Compare())
 		{ }
@@ -99,6 +105,10 @@ namespace stingray
 			: flat_set(list, Compare(), alloc)
 		{ }
 
+		flat_set(const SortedUniqueType&, std::initializer_list<value_type> list, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+			: _container(list, alloc), _cmp(comp)
+		{ }
+
 		flat_set& operator = (std::initializer_list<value_type> list)
 		{
 			clear();
@@ -162,19 +172,35 @@ namespace stingray
 			return insert(std::move(value)).first;
 		}
 
+		/// @brief Appends the range, then sorts and merges it at once. Existing elements are kept, as well as the first of equivalent ones in the range.
 		template < class InputIterator >
 		void insert(InputIterator first, InputIterator last)
 		{
-			if (IsInherited<typename std::iterator_traits<InputIterator>::iterator_category, std::random_access_iterator_tag>::Value)
-				reserve(size() + std::distance(first, last));
+			const size_type oldSize = size();
+			_container.insert(_container.end(), first, last);
+
+			const typename Container::iterator appended = _container.begin() + oldSize;
+			std::stable_sort(appended, _container.end(), _cmp);
+			_container.erase(std::unique(appended, _container.end(), EquivalentSortedImpl(_cmp)), _container.end());
 
-			while (first != last)
-				insert(*(first++));
+			MergeAppended(oldSize);
+		}
+
+		/// @brief Merges the range, which must be sorted and hold no equivalent elements, in linear time
+		template < class InputIterator >
+		void insert(const SortedUniqueType&, InputIterator first, InputIterator last)
+		{
+			const size_type oldSize = size();
+			_container.insert(_container.end(), first, last);
+			MergeAppended(oldSize);
 		}
 
 		void insert(std::initializer_list<value_type> list)
 		{ insert(list.begin(), list.end()); }
 
+		void insert(const SortedUniqueType& tag, std::initializer_list<value_type> list)
+		{ insert(tag, list.begin(), list.end()); }
+
 		template < typename... Ts >
 		std::pair<iterator, bool> emplace(Ts&&... args)
 		{
@@ -283,11 +309,47 @@ namespace stingray
 		key_compare key_comp() const													{ return _cmp; }
 		value_compare value_comp() const												{ return _cmp; }
 
+	private:
+		struct EquivalentSortedImpl
+		{
+			Compare		_cmp;
+
+		public:
+			EquivalentSortedImpl(const Compare& cmp) : _cmp(cmp) { }
+
+			bool operator () (const value_type& lhs, const value_type& rhs) const	{ return !_cmp(lhs, rhs); }
+		};
+
+		void MergeAppended(size_type oldSize)
+		{
+			if (oldSize == 0 || oldSize == size())
+				return;
+
+			const typename Container::iterator appended = _container.begin() + oldSize;
+			if (_cmp(*(appended - 1), *appended))
+				return;
+
+			std::inplace_merge(_container.begin(), appended, _container.end(), _cmp);
+			_container.erase(std::unique(_container.begin(), _container.end(), EquivalentSortedImpl(_cmp)), _container.end());
+		}
+
+		template < class K, class C, class A, class Predicate > friend typename flat_set<K, C, A>::size_type erase_if(flat_set<K, C, A>& set, Predicate pred);
 		template < class K, class C, class A > friend bool operator == (const flat_set<K, C, A>& lhs, const flat_set<K, C, A>& rhs);
 		template < class K, class C, class A > friend bool operator < (const flat_set<K, C, A>& lhs, const flat_set<K, C, A>& rhs);
 	};
 
 
+	/// @brief Erases all elements satisfying the predicate in linear time
+	template < class K, class C, class A, class Predicate >
+	typename flat_set<K, C, A>::size_type erase_if(flat_set<K, C, A>& set, Predicate pred)
+	{
+		const auto it = std::remove_if(set._container.begin(), set._container.end(), pred);
+		const typename flat_set<K, C, A>::size_type result = std::distance(it, set._container.end());
+		set._container.erase(it, set._container.end());
+		return result;
+	}
+
+
 	template < class K, class C, class A >
 	bool operator == (const flat_set<K, C, A>& lhs, const flat_set<K, C, A>& rhs)
 	{ return lhs._container == rhs._container; }
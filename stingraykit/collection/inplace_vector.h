@@ -22,13 +22,14 @@ namespace stingray
 	 * @{
 	 */
 
-	template < typename T, size_t InplaceCapacity_ >
+	template < typename T, size_t InplaceCapacity_, typename Allocator_ = std::allocator<T> >
 	class inplace_vector
 	{
 		static_assert(InplaceCapacity_ != 0, "Invalid inplace capacity");
 
 	public:
 		using value_type = T;
+		using allocator_type = Allocator_;
 
 	private:
 		template < bool Const >
@@ -92,7 +93,7 @@ namespace stingray
 	private:
 		// members order is important for optimal access
 		size_t												_staticStorageSize;
-		std::vector<value_type>								_dynamicStorage;
+		std::vector<value_type, allocator_type>				_dynamicStorage;
 		array<StorageFor<value_type>, InplaceCapacity>		_staticStorage;
 
 	public:
@@ -100,12 +101,19 @@ namespace stingray
 			: _staticStorageSize(0), _staticStorage(uninitialized_array_tag())
 		{ }
 
+		/// @param alloc Used for elements that do not fit into inplace storage
+		explicit inplace_vector(const allocator_type& alloc)
+			: _staticStorageSize(0), _dynamicStorage(alloc), _staticStorage(uninitialized_array_tag())
+		{ }
+
 		inplace_vector(const inplace_vector& other)
-			: _staticStorageSize(0), _staticStorage(uninitialized_array_tag())
+			:	_staticStorageSize(0),
+				_dynamicStorage(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator())),
+				_staticStorage(uninitialized_array_tag())
 		{ Copy(other); }
 
 		inplace_vector(inplace_vector&& other)
-			: _staticStorageSize(0), _staticStorage(uninitialized_array_tag())
+			: _staticStorageSize(0), _dynamicStorage(other.get_allocator()), _staticStorage(uninitialized_array_tag())
 		{ Move(std::move(other)); }
 
 		~inplace_vector()
@@ -180,6 +188,8 @@ namespace stingray
 		const_reverse_iterator rend() const		{ return const_reverse_iterator(begin()); }
 		const_reverse_iterator crend() const	{ return const_reverse_iterator(cbegin()); }
 
+		allocator_type get_allocator() const	{ return _dynamicStorage.get_allocator(); }
+
 		bool empty() const						{ return size() == 0; }
 		size_t size() const						{ return _staticStorageSize + _dynamicStorage.size(); }
 
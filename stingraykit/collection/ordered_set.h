@@ -16,7 +16,12 @@
 namespace stingray
 {
 
-	template < class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key> >
+	/**
+	 * @brief Set preserving insertion order of its elements
+	 * @details Lookup goes through SortedIndex, a std::set-like container of element pointers. Any sorted container with the same
+	 * template signature may be used instead of std::set, e.g. btree_set for a more compact and cache friendly index.
+	 */
+	template < class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key>, template < typename, typename, typename > class SortedIndex = std::set >
 	class ordered_set
 	{
 		STINGRAYKIT_DEFAULTMOVABLE(ordered_set);
@@ -67,14 +72,13 @@ namespace stingray
 		using OrderedConstIterator = typename OrderedContainer::const_iterator;
 
 		using SortedAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<ValueEntry*>;
-		using SortedContainer = std::set<ValueEntry*, CompareImpl, SortedAllocator>;
+		using SortedContainer = SortedIndex<ValueEntry*, CompareImpl, SortedAllocator>;
 		using SortedIterator = typename SortedContainer::iterator;
 		using SortedConstIterator = typename SortedContainer::const_iterator;
 
 		struct ValueEntry
 		{
 			OrderedIterator				OrderedIt;
-			SortedIterator				SortedIt;
 			value_type					Value;
 
 			template < typename... Ts >
@@ -265,7 +269,7 @@ namespace stingray
 
 		iterator erase(const_iterator pos)
 		{
-			_sorted.erase((*pos._implIt)->SortedIt);
+			_sorted.erase(pos._implIt->get());
 			return _ordered.erase(pos._implIt);
 		}
 
@@ -328,10 +332,10 @@ namespace stingray
 		key_compare key_comp() const			{ return _sorted.key_comp().Cmp; }
 		value_compare value_comp() const		{ return _sorted.value_comp().Cmp; }
 
-		template < class K, class C, class A >
-		friend bool operator == (const ordered_set<K, C, A>& lhs, const ordered_set<K, C, A>& rhs);
-		template < class K, class C, class A >
-		friend bool operator < (const ordered_set<K, C, A>& lhs, const ordered_set<K, C, A>& rhs);
+		template < class K, class C, class A, template < typename, typename, typename > class S >
+		friend bool operator == (const ordered_set<K, C, A, S>& lhs, const ordered_set<K, C, A, S>& rhs);
+		template < class K, class C, class A, template < typename, typename, typename > class S >
+		friend bool operator < (const ordered_set<K, C, A, S>& lhs, const ordered_set<K, C, A, S>& rhs);
 
 	private:
 		template < typename Value_ >
@@ -361,7 +365,7 @@ namespace stingray
 			valueEntry->OrderedIt = _ordered.insert(orderedPos, std::move(valueEntry_));
 
 			try
-			{ valueEntry->SortedIt = _sorted.insert(sortedPos, valueEntry); }
+			{ _sorted.insert(sortedPos, valueEntry); }
 			catch (...)
 			{
 				_ordered.erase(valueEntry->OrderedIt);
@@ -373,34 +377,34 @@ namespace stingray
 	};
 
 
-	template < class K, class C, class A >
-	bool ordered_set<K, C, A>::CompareImpl::operator () (ValueEntry* lhs, ValueEntry* rhs) const
+	template < class K, class C, class A, template < typename, typename, typename > class S >
+	bool ordered_set<K, C, A, S>::CompareImpl::operator () (ValueEntry* lhs, ValueEntry* rhs) const
 	{ return Cmp(lhs->Value, rhs->Value); }
 
 
-	template < class K, class C, class A >
-	bool ordered_set<K, C, A>::CompareImpl::operator () (ValueEntry* lhs, const K& rhs) const
+	template < class K, class C, class A, template < typename, typename, typename > class S >
+	bool ordered_set<K, C, A, S>::CompareImpl::operator () (ValueEntry* lhs, const K& rhs) const
 	{ return Cmp(lhs->Value, rhs); }
 
 
-	template < class K, class C, class A >
-	bool ordered_set<K, C, A>::CompareImpl::operator () (const K& lhs, ValueEntry* rhs) const
+	template < class K, class C, class A, template < typename, typename, typename > class S >
+	bool ordered_set<K, C, A, S>::CompareImpl::operator () (const K& lhs, ValueEntry* rhs) const
 	{ return Cmp(lhs, rhs->Value); }
 
 
-	template < class K, class C, class A >
-	bool operator == (const ordered_set<K, C, A>& lhs, const ordered_set<K, C, A>& rhs)
+	template < class K, class C, class A, template < typename, typename, typename > class S >
+	bool operator == (const ordered_set<K, C, A, S>& lhs, const ordered_set<K, C, A, S>& rhs)
 	{
 		return lhs.size() == rhs.size()
-				&& std::equal(lhs._ordered.begin(), lhs._ordered.end(), rhs._ordered.begin(), rhs._ordered.end(), typename ordered_set<K, C, A>::EqualCmp());
+				&& std::equal(lhs._ordered.begin(), lhs._ordered.end(), rhs._ordered.begin(), rhs._ordered.end(), typename ordered_set<K, C, A, S>::EqualCmp());
 	}
-	STINGRAYKIT_GENERATE_NON_MEMBER_EQUALITY_OPERATORS_FROM_EQUAL(MK_PARAM(template < class K, class C, class A >), MK_PARAM(ordered_set<K, C, A>), MK_PARAM(ordered_set<K, C, A>));
+	STINGRAYKIT_GENERATE_NON_MEMBER_EQUALITY_OPERATORS_FROM_EQUAL(MK_PARAM(template < class K, class C, class A, template < typename, typename, typename > class S >), MK_PARAM(ordered_set<K, C, A, S>), MK_PARAM(ordered_set<K, C, A, S>));
 
 
-	template < class K, class C, class A >
-	bool operator < (const ordered_set<K, C, A>& lhs, const ordered_set<K, C, A>& rhs)
-	{ return std::lexicographical_compare(lhs._ordered.begin(), lhs._ordered.end(), rhs._ordered.begin(), rhs._ordered.end(), typename ordered_set<K, C, A>::LessCmp()); }
-	STINGRAYKIT_GENERATE_NON_MEMBER_RELATIONAL_OPERATORS_FROM_LESS(MK_PARAM(template < class K, class C, class A >), MK_PARAM(ordered_set<K, C, A>), MK_PARAM(ordered_set<K, C, A>));
+	template < class K, class C, class A, template < typename, typename, typename > class S >
+	bool operator < (const ordered_set<K, C, A, S>& lhs, const ordered_set<K, C, A, S>& rhs)
+	{ return std::lexicographical_compare(lhs._ordered.begin(), lhs._ordered.end(), rhs._ordered.begin(), rhs._ordered.end(), typename ordered_set<K, C, A, S>::LessCmp()); }
+	STINGRAYKIT_GENERATE_NON_MEMBER_RELATIONAL_OPERATORS_FROM_LESS(MK_PARAM(template < class K, class C, class A, template < typename, typename, typename > class S >), MK_PARAM(ordered_set<K, C, A, S>), MK_PARAM(ordered_set<K, C, A, S>));
 
 }
 
@@ -0,0 +1,696 @@
+#ifndef STINGRAYKIT_COLLECTION_PERSISTENT_MAP_H
+#define STINGRAYKIT_COLLECTION_PERSISTENT_MAP_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/iterator_base.h>
+#include <stingraykit/compare/comparers.h>
+#include <stingraykit/self_counter.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace stingray
+{
+
+	/**
+	 * @addtogroup toolkit_collections
+	 * @{
+	 */
+
+	/**
+	 * @brief Sorted map with structural sharing, backed by B+tree of reference counted nodes
+	 * @details Copying the map is O(1): copies share all the nodes, and a modification copies only the nodes on the path to the changed
+	 * leaf, if they are shared with another copy. So a copy kept as a snapshot costs nothing until the map is changed, and then it costs
+	 * O(log n) per changed entry instead of a copy of the whole map. Nodes are reference counted atomically, so copies can be read and
+	 * destroyed in different threads. Any modification invalidates iterators of the modified map (but not of its copies).
+	 */
+	template < typename Key_, typename Value_, typename Compare_ = comparers::Less >
+	class persistent_map
+	{
+		STINGRAYKIT_DEFAULTCOPYABLE(persistent_map);
+		STINGRAYKIT_DEFAULTMOVABLE(persistent_map);
+
+	public:
+		using key_type = Key_;
+		using mapped_type = Value_;
+		using value_type = std::pair<Key_, Value_>;
+		using size_type = size_t;
+		using difference_type = std::ptrdiff_t;
+		using key_compare = Compare_;
+		using reference = const value_type&;
+		using const_reference = const value_type&;
+
+	private:
+		static const size_t LeafCapacity = 16;
+		static const size_t BranchCapacity = 32;
+
+		struct Node;
+		STINGRAYKIT_DECLARE_SELF_COUNT_PTR(Node);
+
+		/// @brief Leaf keeps sorted Values, branch keeps Children and Keys separating them: Keys[i - 1] <= any key of Children[i] < Keys[i]
+		struct Node : public self_counter<Node>
+		{
+			std::vector<value_type>		Values;
+			std::vector<Key_>			Keys;
+			std::vector<NodeSelfCountPtr>	Children;
+
+		public:
+			Node() { }
+
+			Node(const Node& other)
+				:	Values(other.Values),
+					Keys(other.Keys),
+					Children(other.Children)
+			{ }
+
+			bool IsLeaf() const
+			{ return Children.empty(); }
+
+			size_t GetCount() const
+			{ return IsLeaf() ? Values.size() : Children.size(); }
+
+			size_t GetCapacity() const
+			{ return IsLeaf() ? LeafCapacity : BranchCapacity; }
+		};
+
+		struct Navigator
+		{
+			Compare_		Cmp;
+
+		public:
+			explicit Navigator(const Compare_& cmp) : Cmp(cmp) { }
+
+			size_t GetChildIndex(const Node& node, const Key_& key) const
+			{ return std::upper_bound(node.Keys.begin(), node.Keys.end(), key, Cmp) - node.Keys.begin(); }
+
+			size_t GetValueIndex(const Node& node, const Key_& key) const
+			{
+				const auto cmp = [this](const value_type& value, const Key_& key) { return Cmp(value.first, key); };
+				return std::lower_bound(node.Values.begin(), node.Values.end(), key, cmp) - node.Values.begin();
+			}
+
+			const Node* FindLeaf(const Node* root, const Key_& key) const
+			{
+				const Node* node = root;
+				while (!node->IsLeaf())
+					node = node->Children[GetChildIndex(*node, key)].get();
+				return node;
+			}
+
+			const Node* GetNextLeaf(const Node* root, const Key_& key) const
+			{
+				const Node* next = null;
+				for (const Node* node = root; !node->IsLeaf(); )
+				{
+					const size_t index = GetChildIndex(*node, key);
+					if (index + 1 < node->Children.size())
+						next = node->Children[index + 1].get();
+					node = node->Children[index].get();
+				}
+
+				if (!next)
+					return null;
+
+				while (!next->IsLeaf())
+					next = next->Children.front().get();
+				return next;
+			}
+
+			const Node* GetPrevLeaf(const Node* root, const Key_& key) const
+			{
+				const Node* prev = null;
+				for (const Node* node = root; !node->IsLeaf(); )
+				{
+					const size_t index = GetChildIndex(*node, key);
+					if (index != 0)
+						prev = node->Children[index - 1].get();
+					node = node->Children[index].get();
+				}
+
+				STINGRAYKIT_CHECK(prev, "Decrementing begin iterator");
+				return GetLastLeaf(prev);
+			}
+
+			static const Node* GetFirstLeaf(const Node* node)
+			{
+				while (!node->IsLeaf())
+					node = node->Children.front().get();
+				return node;
+			}
+
+			static const Node* GetLastLeaf(const Node* node)
+			{
+				while (!node->IsLeaf())
+					node = node->Children.back().get();
+				return node;
+			}
+		};
+
+	public:
+		class const_iterator : public iterator_base<const_iterator, const value_type, std::bidirectional_iterator_tag>
+		{
+			using base = iterator_base<const_iterator, const value_type, std::bidirectional_iterator_tag>;
+
+			friend class persistent_map;
+
+		private:
+			const Node*		_root;
+			const Node*		_leaf;
+			size_t			_index;
+			Navigator		_navigator;
+
+		public:
+			const_iterator() : _root(), _leaf(), _index(), _navigator(Compare_()) { }
+
+			typename base::reference dereference() const
+			{ return _leaf->Values[_index]; }
+
+			bool equal(const const_iterator& other) const
+			{ return _leaf == other._leaf && _index == other._index; }
+
+			void increment()
+			{
+				if (++_index != _leaf->Values.size())
+					return;
+
+				_leaf = _navigator.GetNextLeaf(_root, _leaf->Values.back().first);
+				_index = 0;
+			}
+
+			void decrement()
+			{
+				if (!_leaf)
+				{
+					_leaf = Navigator::GetLastLeaf(_root);
+					_index = _leaf->Values.size();
+				}
+				else if (_index == 0)
+				{
+					_leaf = _navigator.GetPrevLeaf(_root, _leaf->Values.front().first);
+					_index = _leaf->Values.size();
+				}
+
+				--_index;
+			}
+
+		private:
+			const_iterator(const Node* root, const Node* leaf, size_t index, const Navigator& navigator)
+				:	_root(root),
+					_leaf(leaf),
+					_index(index),
+					_navigator(navigator)
+			{
+				if (_leaf && _index == _leaf->Values.size())
+				{
+					_leaf = _navigator.GetNextLeaf(_root, _leaf->Values.back().first);
+					_index = 0;
+				}
+			}
+		};
+
+		using iterator = const_iterator;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using reverse_iterator = const_reverse_iterator;
+
+	private:
+		class Path
+		{
+			struct Frame
+			{
+				const Node*		Current;
+				size_t			Index;
+
+			public:
+				Frame(const Node* current) : Current(current), Index(0) { }
+			};
+
+		private:
+			std::vector<Frame>	_frames;
+
+		public:
+			explicit Path(const Node* root)
+			{
+				if (root)
+					Descend(root);
+			}
+
+			bool AtEnd() const
+			{ return _frames.empty(); }
+
+			const value_type& Get() const
+			{ return _frames.back().Current->Values[_frames.back().Index]; }
+
+			void Next()
+			{
+				if (++_frames.back().Index == _frames.back().Current->Values.size())
+					Skip(_frames.size() - 1);
+			}
+
+			size_t GetDepth() const
+			{ return _frames.size(); }
+
+			/// @brief Returns depth of the largest subtree starting at the current entry, equals to GetDepth() if there is no such subtree
+			size_t GetSubtreeDepth() const
+			{
+				size_t depth = _frames.size();
+				while (depth != 0 && _frames[depth - 1].Index == 0)
+					--depth;
+				return depth;
+			}
+
+			const Node* GetSubtree(size_t depth) const
+			{ return _frames[depth].Current; }
+
+			/// @brief Moves to the first entry after the subtree at the specified depth
+			void Skip(size_t depth)
+			{
+				_frames.erase(_frames.begin() + depth, _frames.end());
+
+				for (; !_frames.empty(); _frames.pop_back())
+				{
+					Frame& frame = _frames.back();
+					if (++frame.Index < frame.Current->Children.size())
+					{
+						Descend(frame.Current->Children[frame.Index].get());
+						return;
+					}
+				}
+			}
+
+		private:
+			void Descend(const Node* node)
+			{
+				for (; !node->IsLeaf(); node = node->Children.front().get())
+					_frames.push_back(node);
+				_frames.push_back(node);
+			}
+		};
+
+	public:
+		/**
+		 * @brief Enumerates entries which differ in two maps in key order: entries only in 'from' are removed, ones only in 'to' are added,
+		 * and for the same key with different values the removed entry goes first
+		 * @details Subtrees shared by the maps are skipped without visiting their entries, so when 'to' is a modified copy of 'from'
+		 * the cost is proportional to the number of changed entries rather than to the size of the maps.
+		 */
+		template < typename ValueEquals_ = comparers::Equals >
+		class diff_enumerator
+		{
+		private:
+			Path				_from;
+			Path				_to;
+			Navigator			_navigator;
+			ValueEquals_		_equals;
+			bool				_removed;
+
+		public:
+			diff_enumerator(const persistent_map& from, const persistent_map& to, const ValueEquals_& equals = ValueEquals_())
+				:	_from(from._root.get()),
+					_to(to._root.get()),
+					_navigator(from._navigator),
+					_equals(equals),
+					_removed(false)
+			{ FindDifference(); }
+
+			bool valid() const
+			{ return _removed ? !_from.AtEnd() : !_to.AtEnd(); }
+
+			bool removed() const
+			{ return _removed; }
+
+			const value_type& get() const
+			{ return _removed ? _from.Get() : _to.Get(); }
+
+			void next()
+			{
+				if (_removed)
+					_from.Next();
+				else
+					_to.Next();
+
+				FindDifference();
+			}
+
+		private:
+			void FindDifference()
+			{
+				while (!_from.AtEnd() && !_to.AtEnd())
+				{
+					if (SkipSharedSubtree())
+						continue;
+
+					const value_type& from = _from.Get();
+					const value_type& to = _to.Get();
+
+					if (_navigator.Cmp(to.first, from.first))
+					{
+						_removed = false;
+						return;
+					}
+
+					if (_navigator.Cmp(from.first, to.first) || !_equals(from.second, to.second))
+					{
+						_removed = true;
+						return;
+					}
+
+					_from.Next();
+					_to.Next();
+				}
+
+				_removed = !_from.AtEnd();
+			}
+
+			bool SkipSharedSubtree()
+			{
+				for (size_t fromDepth = _from.GetSubtreeDepth(); fromDepth < _from.GetDepth(); ++fromDepth)
+					for (size_t toDepth = _to.GetSubtreeDepth(); toDepth < _to.GetDepth(); ++toDepth)
+						if (_from.GetSubtree(fromDepth) == _to.GetSubtree(toDepth))
+						{
+							_from.Skip(fromDepth);
+							_to.Skip(toDepth);
+							return true;
+						}
+
+				return false;
+			}
+		};
+
+	private:
+		NodeSelfCountPtr		_root;
+		size_t					_size;
+		Navigator				_navigator;
+
+	public:
+		persistent_map()
+			:	_size(0),
+				_navigator(Compare_())
+		{ }
+
+		explicit persistent_map(const Compare_& comp)
+			:	_size(0),
+				_navigator(comp)
+		{ }
+
+		template < typename InputIterator >
+		persistent_map(InputIterator first, InputIterator last, const Compare_& comp = Compare_())
+			:	_size(0),
+				_navigator(comp)
+		{ insert(first, last); }
+
+		persistent_map(std::initializer_list<value_type> list, const Compare_& comp = Compare_())
+			:	persistent_map(list.begin(), list.end(), comp)
+		{ }
+
+		const_iterator begin() const				{ return _root ? const_iterator(_root.get(), Navigator::GetFirstLeaf(_root.get()), 0, _navigator) : end(); }
+		const_iterator cbegin() const				{ return begin(); }
+		const_iterator end() const					{ return const_iterator(_root.get(), null, 0, _navigator); }
+		const_iterator cend() const					{ return end(); }
+
+		const_reverse_iterator rbegin() const		{ return const_reverse_iterator(end()); }
+		const_reverse_iterator crbegin() const		{ return rbegin(); }
+		const_reverse_iterator rend() const			{ return const_reverse_iterator(begin()); }
+		const_reverse_iterator crend() const		{ return rend(); }
+
+		bool empty() const							{ return _size == 0; }
+		size_type size() const						{ return _size; }
+
+		key_compare key_comp() const				{ return _navigator.Cmp; }
+
+		void clear()
+		{
+			_root.reset();
+			_size = 0;
+		}
+
+		void swap(persistent_map& other)
+		{
+			std::swap(_root, other._root);
+			std::swap(_size, other._size);
+			std::swap(_navigator, other._navigator);
+		}
+
+		const_iterator find(const Key_& key) const
+		{
+			if (!_root)
+				return end();
+
+			const Node* leaf = _navigator.FindLeaf(_root.get(), key);
+			const size_t index = _navigator.GetValueIndex(*leaf, key);
+			if (index == leaf->Values.size() || _navigator.Cmp(key, leaf->Values[index].first))
+				return end();
+
+			return const_iterator(_root.get(), leaf, index, _navigator);
+		}
+
+		size_type count(const Key_& key) const
+		{ return find(key) != end() ? 1 : 0; }
+
+		const_iterator lower_bound(const Key_& key) const
+		{
+			if (!_root)
+				return end();
+
+			const Node* leaf = _navigator.FindLeaf(_root.get(), key);
+			return const_iterator(_root.get(), leaf, _navigator.GetValueIndex(*leaf, key), _navigator);
+		}
+
+		const_iterator upper_bound(const Key_& key) const
+		{
+			const_iterator result = lower_bound(key);
+			if (result != end() && !_navigator.Cmp(key, result->first))
+				++result;
+			return result;
+		}
+
+		const Value_& at(const Key_& key) const
+		{
+			const const_iterator it = find(key);
+			STINGRAYKIT_CHECK(it != end(), std::out_of_range("key not found"));
+			return it->second;
+		}
+
+		std::pair<const_iterator, bool> insert(const value_type& value)
+		{ return emplace(value.first, value.second); }
+
+		template < typename InputIterator >
+		void insert(InputIterator first, InputIterator last)
+		{
+			for (; first != last; ++first)
+				insert(*first);
+		}
+
+		template < typename KeyArg, typename ValueArg >
+		std::pair<const_iterator, bool> emplace(KeyArg&& key, ValueArg&& value)
+		{
+			const const_iterator it = find(key);
+			if (it != end())
+				return std::make_pair(it, false);
+
+			const Key_ newKey(std::forward<KeyArg>(key));
+			DoInsert(newKey, std::forward<ValueArg>(value));
+			return std::make_pair(find(newKey), true);
+		}
+
+		template < typename ValueArg >
+		void insert_or_assign(const Key_& key, ValueArg&& value)
+		{ DoInsert(key, std::forward<ValueArg>(value)); }
+
+		size_type erase(const Key_& key)
+		{
+			if (find(key) == end())
+				return 0;
+
+			DoErase(_root, key);
+			--_size;
+
+			if (_root->GetCount() == 0)
+				_root.reset();
+			else if (!_root->IsLeaf() && _root->Children.size() == 1)
+				_root = NodeSelfCountPtr(_root->Children.front());
+
+			return 1;
+		}
+
+		const_iterator erase(const_iterator pos)
+		{
+			const Key_ key = pos->first;
+			erase(key);
+			return lower_bound(key);
+		}
+
+	private:
+		template < typename ValueArg >
+		void DoInsert(const Key_& key, ValueArg&& value)
+		{
+			if (!_root)
+				_root = make_self_count_ptr<Node>();
+
+			if (DoInsert(_root, key, std::forward<ValueArg>(value)))
+				++_size;
+
+			if (_root->GetCount() <= _root->GetCapacity())
+				return;
+
+			const NodeSelfCountPtr newRoot = make_self_count_ptr<Node>();
+			newRoot->Children.push_back(_root);
+			Split(*newRoot, 0);
+			_root = newRoot;
+		}
+
+		template < typename ValueArg >
+		bool DoInsert(NodeSelfCountPtr& nodePtr, const Key_& key, ValueArg&& value)
+		{
+			if (nodePtr->IsLeaf())
+			{
+				const size_t index = _navigator.GetValueIndex(*nodePtr, key);
+				if (index == nodePtr->Values.size() || _navigator.Cmp(key, nodePtr->Values[index].first))
+				{
+					Node& node = Mutate(nodePtr);
+					node.Values.insert(node.Values.begin() + index, value_type(key, std::forward<ValueArg>(value)));
+					return true;
+				}
+
+				Mutate(nodePtr).Values[index].second = std::forward<ValueArg>(value);
+				return false;
+			}
+
+			Node& node = Mutate(nodePtr);
+			const size_t index = _navigator.GetChildIndex(node, key);
+			const bool inserted = DoInsert(node.Children[index], key, std::forward<ValueArg>(value));
+
+			if (node.Children[index]->GetCount() > node.Children[index]->GetCapacity())
+				Split(node, index);
+
+			return inserted;
+		}
+
+		void DoErase(NodeSelfCountPtr& nodePtr, const Key_& key)
+		{
+			Node& node = Mutate(nodePtr);
+
+			if (node.IsLeaf())
+			{
+				node.Values.erase(node.Values.begin() + _navigator.GetValueIndex(node, key));
+				return;
+			}
+
+			const size_t index = _navigator.GetChildIndex(node, key);
+			DoErase(node.Children[index], key);
+
+			if (node.Children[index]->GetCount() < node.Children[index]->GetCapacity() / 2)
+				Rebalance(node, index);
+		}
+
+		static Node& Mutate(NodeSelfCountPtr& nodePtr)
+		{
+			if (!nodePtr.unique())
+				nodePtr = make_self_count_ptr<Node>(*nodePtr);
+			return *nodePtr;
+		}
+
+		static void Split(Node& parent, size_t index)
+		{
+			Node& left = *parent.Children[index];
+			const NodeSelfCountPtr right = make_self_count_ptr<Node>();
+
+			if (left.IsLeaf())
+			{
+				const size_t middle = left.Values.size() / 2;
+				right->Values.assign(std::make_move_iterator(left.Values.begin() + middle), std::make_move_iterator(left.Values.end()));
+				left.Values.erase(left.Values.begin() + middle, left.Values.end());
+
+				parent.Keys.insert(parent.Keys.begin() + index, right->Values.front().first);
+			}
+			else
+			{
+				const size_t middle = left.Keys.size() / 2;
+				right->Keys.assign(std::make_move_iterator(left.Keys.begin() + middle + 1), std::make_move_iterator(left.Keys.end()));
+				right->Children.assign(std::make_move_iterator(left.Children.begin() + middle + 1), std::make_move_iterator(left.Children.end()));
+
+				parent.Keys.insert(parent.Keys.begin() + index, std::move(left.Keys[middle]));
+
+				left.Keys.erase(left.Keys.begin() + middle, left.Keys.end());
+				left.Children.erase(left.Children.begin() + middle + 1, left.Children.end());
+			}
+
+			parent.Children.insert(parent.Children.begin() + index + 1, right);
+		}
+
+		static void Rebalance(Node& parent, size_t index)
+		{
+			const size_t leftIndex = index + 1 < parent.Children.size() ? index : index - 1;
+
+			Node& left = Mutate(parent.Children[leftIndex]);
+			Node& right = Mutate(parent.Children[leftIndex + 1]);
+			Key_& separator = parent.Keys[leftIndex];
+
+			if (left.GetCount() + right.GetCount() <= left.GetCapacity())
+			{
+				if (left.IsLeaf())
+					left.Values.insert(left.Values.end(), std::make_move_iterator(right.Values.begin()), std::make_move_iterator(right.Values.end()));
+				else
+				{
+					left.Keys.push_back(std::move(separator));
+					left.Keys.insert(left.Keys.end(), std::make_move_iterator(right.Keys.begin()), std::make_move_iterator(right.Keys.end()));
+					left.Children.insert(left.Children.end(), std::make_move_iterator(right.Children.begin()), std::make_move_iterator(right.Children.end()));
+				}
+
+				parent.Keys.erase(parent.Keys.begin() + leftIndex);
+				parent.Children.erase(parent.Children.begin() + leftIndex + 1);
+				return;
+			}
+
+			const size_t leftCount = (left.GetCount() + right.GetCount()) / 2;
+
+			if (left.IsLeaf())
+			{
+				if (left.Values.size() < leftCount)
+				{
+					const size_t count = leftCount - left.Values.size();
+					left.Values.insert(left.Values.end(), std::make_move_iterator(right.Values.begin()), std::make_move_iterator(right.Values.begin() + count));
+					right.Values.erase(right.Values.begin(), right.Values.begin() + count);
+				}
+				else
+				{
+					right.Values.insert(right.Values.begin(), std::make_move_iterator(left.Values.begin() + leftCount), std::make_move_iterator(left.Values.end()));
+					left.Values.erase(left.Values.begin() + leftCount, left.Values.end());
+				}
+
+				separator = right.Values.front().first;
+				return;
+			}
+
+			while (left.Children.size() < leftCount)
+			{
+				left.Keys.push_back(std::move(separator));
+				left.Children.push_back(std::move(right.Children.front()));
+				separator = std::move(right.Keys.front());
+
+				right.Keys.erase(right.Keys.begin());
+				right.Children.erase(right.Children.begin());
+			}
+
+			while (left.Children.size() > leftCount)
+			{
+				right.Keys.insert(right.Keys.begin(), std::move(separator));
+				right.Children.insert(right.Children.begin(), std::move(left.Children.back()));
+				separator = std::move(left.Keys.back());
+
+				left.Keys.pop_back();
+				left.Children.pop_back();
+			}
+		}
+	};
+
+	/** @} */
+
+}
+
+#endif
@@ -127,8 +127,14 @@ namespace stingray
 	STINGRAYKIT_DEFINE_NAMED_LOGGER(AsyncByteStream);
 
 	AsyncByteStream::AsyncByteStream(const std::string& name, const IByteStreamPtr& stream, const Config& config)
+		:	AsyncByteStream(name, stream, null, config)
+	{ }
+
+
+	AsyncByteStream::AsyncByteStream(const std::string& name, const IByteStreamPtr& stream, const IAsyncIoEnginePtr& engine, const Config& config)
 		:	_name(name),
 			_stream(stream),
+			_engine(engine),
 			_wasException(false),
 			_position(stream->Tell()),
 			_length(0),
@@ -137,7 +143,9 @@ namespace stingray
 			_lastStatsDump(0),
 			_syncNext(1),
 			_syncDone(_syncNext - 1),
-			_thread(make_shared_ptr<Thread>(StringBuilder() % "asyncByteStream(" % _name % ")", Bind(&AsyncByteStream::ThreadFunc, this, _1)))
+			_opInFlight(false),
+			_stopped(false),
+			_thread(_engine ? ThreadPtr() : make_shared_ptr<Thread>(StringBuilder() % "asyncByteStream(" % _name % ")", Bind(&AsyncByteStream::ThreadFunc, this, _1)))
 	{
 		_stream->Seek(0, SeekMode::End);
 		_length = stream->Tell();
@@ -153,7 +161,11 @@ namespace stingray
 		{
 			MutexLock l(_streamOpQueueMutex);
 			_streamOpQueue.push_back(StreamOpData::Stop());
-			_condVar.Broadcast();
+			Notify();
+
+			// Completion handlers refer to this object
+			while (_engine && (_opInFlight || (!_stopped && !_wasException)))
+				_condVar.Wait(_streamOpQueueMutex);
 		}
 		_thread.reset();
 		s_logger.Info() << "Stats: " << _stats;
@@ -161,10 +173,23 @@ namespace stingray
 
 
 	u64 AsyncByteStream::Write(ConstByteData data, const ICancellationToken& token)
+	{ return DoWrite(&data, 1); }
+
+
+	u64 AsyncByteStream::WriteV(ConstByteDataSpan data, const ICancellationToken& token)
+	{ return data.empty() ? 0 : DoWrite(data.data(), data.size()); }
+
+
+	u64 AsyncByteStream::DoWrite(const ConstByteData* data, size_t count)
 	{
 		STINGRAYKIT_PROFILER(50, _name);
 		STINGRAYKIT_CHECK(!_wasException, StringBuilder() % _name % ": was exception while previous operation");
-		if (data.size() == 0)
+
+		size_t totalSize = 0;
+		for (size_t i = 0; i < count; ++i)
+			totalSize += data[i].size();
+
+		if (totalSize == 0)
 			return 0;
 
 		MutexLock l(_streamOpQueueMutex);
@@ -215,7 +240,7 @@ namespace stingray
 		if (targetOpDataIt == _streamOpQueue.rend())
 		{
 			BithreadCircularBuffer::Writer writer = _buffers.front()->Write();
-			size_t writeSize = std::min(writer.size(), std::max(_bufferPreallocationSize, data.size()));
+			size_t writeSize = std::min(writer.size(), std::max(_bufferPreallocationSize, totalSize));
 
 			ByteData writeData(writer.GetData(), 0, writeSize);
 			writer.Push(writeSize);
@@ -228,9 +253,17 @@ namespace stingray
 			_stats.Appended++;
 
 		StreamOpData& opData = *targetOpDataIt;
-		size_t written = opData.PushWriteData(data);
+		size_t written = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const size_t pushed = opData.PushWriteData(data[i]);
+			written += pushed;
+
+			if (pushed != data[i].size())
+				break;
+		}
 
-		if (written != data.size())
+		if (written != totalSize)
 			_stats.NonFully++;
 
 		const size_t bufUsed = _buffers.front()->GetDataSize();
@@ -239,8 +272,9 @@ namespace stingray
 		_position += written;
 		_length = std::max(_position, _length);
 
-		if (bufUsed >= _bufferLowWater)
-			_condVar.Broadcast();
+		// Engine is kept busy: writes are merged into queued ops while previous one is in flight
+		if (_engine || bufUsed >= _bufferLowWater)
+			Notify();
 		else
 			_stats.NotSignaled++;
 
@@ -296,7 +330,7 @@ namespace stingray
 		MutexLock l(_streamOpQueueMutex);
 		size_t syncCurrent = _syncNext++;
 		_streamOpQueue.push_back(StreamOpData::Sync(syncCurrent));
-		_condVar.Broadcast();
+		Notify();
 
 		if (_config.NonBlockingSync())
 		{
@@ -327,12 +361,49 @@ namespace stingray
 		if (!_buffers.empty())
 		{
 			_streamOpQueue.push_back(StreamOpData::PopBuffer());
-			_condVar.Broadcast();
 		}
 		_buffers.push_front(make_shared_ptr<BithreadCircularBuffer>(config.BufferSize()));
 		_config = config;
 		_bufferPreallocationSize = _config.PageSize() * _config.MergeablePagesHint();
 		_bufferLowWater = std::max(_config.BufferSize() / 10, std::min(_config.BufferSize() / 2, _bufferPreallocationSize * 2));
+
+		if (_buffers.size() > 1)
+			Notify();
+	}
+
+
+	void AsyncByteStream::Notify()
+	{
+		if (_engine)
+			ProcessQueue();
+		else
+			_condVar.Broadcast();
+	}
+
+
+	void AsyncByteStream::PopWritten(StreamOpData opData, BithreadCircularBuffer::Reader& reader, size_t written)
+	{
+		if (written == opData.GetWriteData().size())
+			reader.Pop(written + opData.GetWriteFreeSpace());
+		else
+		{
+			reader.Pop(written);
+			opData.PopWriteData(written);
+			_streamOpQueue.push_front(opData);
+		}
+
+		_stats.Syscalls++;
+		_stats.TotalWritten += written;
+	}
+
+
+	void AsyncByteStream::DumpStats()
+	{
+		if ((_stats.TotalWritten - _lastStatsDump) >= StatsDumpPeriod)
+		{
+			s_logger.Info() << _name << " stats: " << _stats;
+			_lastStatsDump = _stats.TotalWritten;
+		}
 	}
 
 
@@ -376,17 +447,7 @@ namespace stingray
 							written = (size_t)_stream->Write(writeData, token);
 						}
 
-						if (written == writeData.size())
-							reader.Pop(written + opData.GetWriteFreeSpace());
-						else
-						{
-							reader.Pop(written);
-							opData.PopWriteData(written);
-							_streamOpQueue.push_front(opData);
-						}
-
-						_stats.Syscalls++;
-						_stats.TotalWritten += written;
+						PopWritten(opData, reader, written);
 					}
 					break;
 
@@ -418,11 +479,7 @@ namespace stingray
 					break;
 				}
 
-				if ((_stats.TotalWritten - _lastStatsDump) >= StatsDumpPeriod)
-				{
-					s_logger.Info() << _name << " stats: " << _stats;
-					_lastStatsDump = _stats.TotalWritten;
-				}
+				DumpStats();
 			}
 		}
 		catch (const std::exception& ex)
@@ -432,4 +489,91 @@ namespace stingray
 		}
 	}
 
+
+	void AsyncByteStream::ProcessQueue()
+	{
+		try
+		{
+			while (!_opInFlight && !_stopped && !_wasException && !_streamOpQueue.empty())
+			{
+				const StreamOpData opData = _streamOpQueue.front();
+				_streamOpQueue.pop_front();
+
+				switch (opData.Op())
+				{
+				case StreamOp::Write:
+					STINGRAYKIT_CHECK(!_buffers.empty(), LogicException(StringBuilder() % _name % ": must be at least one buffer"));
+					_opInFlight = true;
+					_engine->SubmitWrite(_stream, opData.GetWriteStartOffset(), opData.GetWriteData(), Bind(&AsyncByteStream::WriteCompletedHandler, this, opData, _1, _2));
+					break;
+
+				case StreamOp::Stop:
+					_stopped = true;
+					break;
+
+				case StreamOp::Sync:
+					_opInFlight = true;
+					_engine->SubmitSync(_stream, Bind(&AsyncByteStream::SyncCompletedHandler, this, opData.SyncDone(), _1, _2));
+					break;
+
+				case StreamOp::PopBuffer:
+					_buffers.pop_back();
+					break;
+
+				default:
+					STINGRAYKIT_THROW(NotImplementedException(opData.Op().ToString()));
+					break;
+				}
+			}
+		}
+		catch (const std::exception& ex)
+		{ EngineFailed(ex); }
+	}
+
+
+	void AsyncByteStream::WriteCompletedHandler(const StreamOpData& opData, u64 written, const ExceptionPtr& exception)
+	{
+		MutexLock l(_streamOpQueueMutex);
+		_opInFlight = false;
+
+		if (exception)
+			EngineFailed(*exception);
+		else
+		{
+			BithreadCircularBuffer::Reader reader = _buffers.back()->Read();
+			PopWritten(opData, reader, (size_t)written);
+			DumpStats();
+			ProcessQueue();
+		}
+
+		_condVar.Broadcast();
+	}
+
+
+	void AsyncByteStream::SyncCompletedHandler(size_t syncIndex, u64 written, const ExceptionPtr& exception)
+	{
+		MutexLock l(_streamOpQueueMutex);
+		_opInFlight = false;
+
+		if (exception)
+			EngineFailed(*exception);
+		else
+		{
+			_syncDone = syncIndex;
+			_syncCondVar.Broadcast();
+			ProcessQueue();
+		}
+
+		_condVar.Broadcast();
+	}
+
+
+	void AsyncByteStream::EngineFailed(const std::exception& ex)
+	{
+		s_logger.Error() << _name << ": was exception while operating: " << ex;
+		_opInFlight = false;
+		_wasException = true;
+		_syncCondVar.Broadcast();
+	}
+
 }
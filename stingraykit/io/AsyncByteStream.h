@@ -10,6 +10,7 @@
 
 #include <stingraykit/diagnostics/AsyncProfiler.h>
 #include <stingraykit/io/BithreadCircularBuffer.h>
+#include <stingraykit/io/IAsyncIoEngine.h>
 #include <stingraykit/io/ISyncableByteStream.h>
 #include <stingraykit/log/Logger.h>
 #include <stingraykit/thread/ConditionVariable.h>
@@ -146,6 +147,7 @@ namespace stingray
 
 		const std::string			_name;
 		const IByteStreamPtr		_stream;
+		const IAsyncIoEnginePtr		_engine;
 
 		atomic<bool>				_wasException;
 
@@ -168,18 +170,26 @@ namespace stingray
 
 		AsyncProfilerPtr			_profiler;
 
+		bool						_opInFlight;
+		bool						_stopped;
+
 		ConditionVariable			_condVar;
 		ConditionVariable			_syncCondVar;
 		ThreadPtr					_thread;
 
 	public:
 		AsyncByteStream(const std::string& name, const IByteStreamPtr& stream, const Config& config = Config());
+
+		/// @brief Issues operations through engine, which may be shared by many streams, instead of dedicated thread
+		/// @param engine Dedicated thread is started if null
+		AsyncByteStream(const std::string& name, const IByteStreamPtr& stream, const IAsyncIoEnginePtr& engine, const Config& config = Config());
 		virtual ~AsyncByteStream();
 
 		virtual u64 Read(ByteData data, const ICancellationToken& token)
 		{ STINGRAYKIT_THROW(NotImplementedException(_name)); }
 
 		virtual u64 Write(ConstByteData data, const ICancellationToken& token);
+		virtual u64 WriteV(ConstByteDataSpan data, const ICancellationToken& token);
 
 		virtual void Seek(s64 offset, SeekMode mode = SeekMode::Begin);
 		virtual u64 Tell() const;
@@ -189,7 +199,18 @@ namespace stingray
 		void Reconfigure(const Config& config);
 
 	private:
+		u64 DoWrite(const ConstByteData* data, size_t count);
+
+		void Notify();
+		void PopWritten(StreamOpData opData, BithreadCircularBuffer::Reader& reader, size_t written);
+		void DumpStats();
+
 		void ThreadFunc(const ICancellationToken& token);
+
+		void ProcessQueue();
+		void WriteCompletedHandler(const StreamOpData& opData, u64 written, const ExceptionPtr& exception);
+		void SyncCompletedHandler(size_t syncIndex, u64 written, const ExceptionPtr& exception);
+		void EngineFailed(const std::exception& ex);
 	};
 	STINGRAYKIT_DECLARE_PTR(AsyncByteStream);
 
@@ -10,6 +10,10 @@
 
 #include <stingraykit/BitsGetter.h>
 
+#if defined(__SSE2__)
+#	include <emmintrin.h>
+#endif
+
 namespace stingray
 {
 
@@ -62,6 +66,137 @@ namespace stingray
 			}
 		};
 
+		template < typename ByteDataType_ >
+		inline u64 LoadBitsWord(const ByteDataType_& buf, size_t byteOffset)
+		{
+			const size_t available = buf.size() - byteOffset;
+			if (available >= 8)
+			{
+				const u8* const data = &buf[byteOffset];
+				return (u64)data[0] << 56 | (u64)data[1] << 48 | (u64)data[2] << 40 | (u64)data[3] << 32 | (u64)data[4] << 24 | (u64)data[5] << 16 | (u64)data[6] << 8 | (u64)data[7];
+			}
+
+			u64 result = 0;
+			for (size_t i = 0; i < 8; ++i)
+				result = (result << 8) | (i < available ? buf[byteOffset + i] : 0);
+			return result;
+		}
+
+		template < size_t Size, bool FitsWord = (Size <= 56) >
+		struct BigEndianBitsExtractor
+		{
+			template < typename ByteDataType_ >
+			static u64 Extract(const ByteDataType_& buf, size_t bitOffset)
+			{ return (LoadBitsWord(buf, bitOffset >> 3) << (bitOffset & 7)) >> (64 - Size); }
+		};
+
+		template < size_t Size >
+		struct BigEndianBitsExtractor<Size, false>
+		{
+			template < typename ByteDataType_ >
+			static u64 Extract(const ByteDataType_& buf, size_t bitOffset)
+			{ return BigEndianBitsExtractor<Size - 32>::Extract(buf, bitOffset) << 32 | BigEndianBitsExtractor<32>::Extract(buf, bitOffset + Size - 32); }
+		};
+
+		/// @brief Same as BitsGetter::Get<OffsetBits, Size>, but takes a 64-bit word at once and does not check bounds
+		template < size_t Size, bool BigEndian, typename ByteDataType_ >
+		inline u64 ExtractBits(const ByteDataType_& buf, size_t bitOffset)
+		{
+			static_assert(Size > 0 && Size <= 64, "Wrong Size value");
+
+			const u64 result = BigEndianBitsExtractor<Size>::Extract(buf, bitOffset);
+			if (BigEndian)
+				return result;
+
+			typedef typename MinimalTypeSelector<Size>::ValueT MinimalT;
+			return SwappableType<MinimalT>::Swap(result << (sizeof(MinimalT) * 8 - Size));
+		}
+
+
+		template < int ElementSize, bool BigEndian, bool Vectorized = (ElementSize == 8) >
+		struct BitArrayReader
+		{
+			/// @brief Reads count elements starting at bitOffset, bounds must be checked by caller
+			template < typename ByteDataType_, typename OutputIterator >
+			static OutputIterator Read(const ByteDataType_& buf, size_t bitOffset, OutputIterator it, size_t count)
+			{
+				typedef typename GetIteratorValueType<OutputIterator>::ValueT	ValueType;
+
+				for (size_t i = 0; i < count; ++i, bitOffset += ElementSize)
+					*it++ = (ValueType)static_cast<typename BitsGetterResultType<ValueType>::ValueT>(ExtractBits<ElementSize, BigEndian>(buf, bitOffset));
+				return it;
+			}
+		};
+
+#if defined(__SSE2__)
+
+		/// @brief Byte elements are extracted 16 at once, as two unaligned loads shifted towards each other
+		template < bool BigEndian >
+		struct BitArrayReader<8, BigEndian, true>
+		{
+			static const size_t Width = 16;
+
+			template < typename ByteDataType_, typename OutputIterator >
+			static OutputIterator Read(const ByteDataType_& buf, size_t bitOffset, OutputIterator it, size_t count)
+			{
+				typedef typename GetIteratorValueType<OutputIterator>::ValueT	ValueType;
+
+				const size_t byteOffset = bitOffset >> 3;
+				const int shift = bitOffset & 7;
+
+				// SSE2 has no byte shifts, so 16-bit lanes are shifted and bits, which crossed into neighbour byte, are masked off
+				const __m128i leftShift = _mm_cvtsi32_si128(shift);
+				const __m128i rightShift = _mm_cvtsi32_si128(8 - shift);
+				const __m128i leftMask = _mm_set1_epi8((char)(0xFF << shift));
+				const __m128i rightMask = _mm_set1_epi8((char)(0xFF >> (8 - shift)));
+
+				// Second load takes one byte more than result, so the tail is left to word-based extraction
+				size_t i = 0;
+				for ( ; i + Width <= count && byteOffset + i + Width < buf.size(); i += Width)
+				{
+					const u8* const data = &buf[byteOffset + i];
+					const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+					const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 1));
+
+					u8 bytes[Width];
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(bytes), _mm_or_si128(
+							_mm_and_si128(_mm_sll_epi16(first, leftShift), leftMask),
+							_mm_and_si128(_mm_srl_epi16(second, rightShift), rightMask)));
+
+					for (size_t j = 0; j < Width; ++j)
+						*it++ = (ValueType)static_cast<typename BitsGetterResultType<ValueType>::ValueT>(bytes[j]);
+				}
+
+				return BitArrayReader<8, BigEndian, false>::Read(buf, bitOffset + i * 8, it, count - i);
+			}
+		};
+
+#endif
+
+
+		template < bool BigEndian, size_t... Sizes >
+		struct BitFieldsReader
+		{
+			static const size_t TotalSize = 0;
+
+			template < typename ByteDataType_ >
+			static void Read(const ByteDataType_& buf, size_t bitOffset)
+			{ }
+		};
+
+		template < bool BigEndian, size_t Size, size_t... Sizes >
+		struct BitFieldsReader<BigEndian, Size, Sizes...>
+		{
+			static const size_t TotalSize = Size + BitFieldsReader<BigEndian, Sizes...>::TotalSize;
+
+			template < typename ByteDataType_, typename T, typename... Ts >
+			static void Read(const ByteDataType_& buf, size_t bitOffset, T& value, Ts&... values)
+			{
+				value = static_cast<typename BitsGetterResultType<T>::ValueT>(ExtractBits<Size, BigEndian>(buf, bitOffset));
+				BitFieldsReader<BigEndian, Sizes...>::Read(buf, bitOffset + Size, values...);
+			}
+		};
+
 #define DETAIL_STINGRAYKIT_DECL_BSRP_OPERATOR(Op_) \
 			template < typename T, typename ByteDataType_, bool BigEndian, int Size > T operator Op_ (const BasicBitStreamReadProxy<ByteDataType_, BigEndian, Size>& bsrp, T val) { return static_cast<T>(bsrp) Op_ val; } \
 			template < typename T, typename ByteDataType_, bool BigEndian, int Size > T operator Op_ (T val, const BasicBitStreamReadProxy<ByteDataType_, BigEndian, Size>& bsrp) { return val Op_ static_cast<T>(bsrp); }
@@ -183,7 +318,7 @@ namespace stingray
 		ByteArray ReadLengthPrefixedArray()
 		{
 			size_t size = Read<LengthPrefixSize>();
-			ByteArray result(size);
+			ByteArray result(ByteArray::CreateUninitialized(size));
 			ReadArray<8>(result.begin(), result.end());
 			return result;
 		}
@@ -216,20 +351,47 @@ namespace stingray
 		std::string ReadNullTerminatedString()
 		{ return ReadStringTerminatedBy('\0'); }
 
+		/**
+		 * @brief Reads consecutive fields of given sizes in bits at once
+		 * @details Bounds are checked once for the whole layout, every field is extracted from a 64-bit word with a shift and a mask.
+		 * Fields are decoded the same way as by Read.
+		 * @par Example:
+		 * @code
+		 * u8 syncByte; bool errorIndicator, payloadUnitStart, priority; u16 pid;
+		 * stream.ReadFields<8, 1, 1, 1, 13>(syncByte, errorIndicator, payloadUnitStart, priority, pid);
+		 * @endcode
+		 */
+		template < size_t... Sizes, typename... Ts >
+		void ReadFields(Ts&... values)
+		{
+			static_assert(sizeof...(Sizes) == sizeof...(Ts), "Fields count mismatch");
+
+			typedef Detail::BitFieldsReader<BigEndian, Sizes...> Reader;
+			STINGRAYKIT_CHECK(CanRead(Reader::TotalSize), IndexOutOfRangeException(_offset + Reader::TotalSize, _buf.size() << 3));
+
+			Reader::Read(_buf, _offset, values...);
+			_offset += Reader::TotalSize;
+		}
+
 		template < int ElementSize, typename OutputIterator >
 		void ReadArray(OutputIterator it, size_t count)
 		{
 			typedef typename Detail::GetIteratorValueType<OutputIterator>::ValueT	ValueType;
+
+			if (CanRead(count * ElementSize))
+			{
+				Detail::BitArrayReader<ElementSize, BigEndian>::Read(_buf, _offset, it, count);
+				_offset += count * ElementSize;
+				return;
+			}
+
 			for (size_t i = 0; i < count; ++i)
 				*it++ = (ValueType)Read<ElementSize>();
 		}
 
 		template < int ElementSize, typename OutputIterator >
 		void ReadArray(OutputIterator first, OutputIterator last)
-		{
-			for ( ; first != last; first++)
-				*first = Read<ElementSize>();
-		}
+		{ ReadArray<ElementSize>(first, (size_t)std::distance(first, last)); }
 
 		template < int ElementSize, typename InputIterator >
 		void WriteArray(InputIterator it, size_t count)
@@ -7,6 +7,11 @@
 
 #include <stingraykit/io/BithreadCircularBuffer.h>
 
+#include <stingraykit/string/ToString.h>
+#include <stingraykit/thread/atomic/AtomicInt.h>
+
+#include <string.h>
+
 namespace stingray
 {
 
@@ -16,20 +21,44 @@ namespace stingray
 		static const size_t PaddingSize = 8;
 
 	private:
-		BytesOwner		_storage;
-		size_t			_writeOffset, _readOffset;
-		bool			_dataIsContiguous;
+		using AtomicSize = BasicAtomicInt<size_t>;
+
+		static const size_t CacheLineSize = 64;
+		static const size_t YieldsBeforeSleep = 16;
+
+	private:
+		// Keeps reference counter, which is touched by both sides, away from the fields below
+		u8						_counterPadding[CacheLineSize];
+
+		// Positions run over [0, 2 * size), so that full and empty buffers are distinguishable without extra flag
+		const BytesOwner		_storage;
+		const size_t			_size;
+		const bool				_mirrored;
+
+		u8						_writerPadding[CacheLineSize];
+		mutable AtomicSize::Type	_pushed;
+		AtomicU32::Type			_writerSleeping;
+
+		u8						_readerPadding[CacheLineSize];
+		mutable AtomicSize::Type	_popped;
+		AtomicU32::Type			_readerSleeping;
+		AtomicU32::Type			_readerWoken;
+
+		u8						_waitPadding[CacheLineSize];
+		Mutex					_waitMutex;
+		ConditionVariable		_dataPushed;
+		ConditionVariable		_dataPopped;
 
 	public:
-		Impl(const BytesOwner& storage) :
-			_storage(storage),
-			_writeOffset(0), _readOffset(0),
-			_dataIsContiguous(true)
+		Impl(const BytesOwner& storage, bool mirrored) :
+			_storage(storage), _size(mirrored ? storage.size() / 2 : storage.size()), _mirrored(mirrored),
+			_pushed(0), _writerSleeping(0),
+			_popped(0), _readerSleeping(0), _readerWoken(0)
 		{ }
 
 
 		size_t GetDataSize() const
-		{ return _dataIsContiguous ? (_writeOffset - _readOffset) : (GetStorageSize() - _readOffset + _writeOffset); }
+		{ return GetDataSize(AtomicSize::Load(_pushed, MemoryOrderAcquire), AtomicSize::Load(_popped, MemoryOrderAcquire)); }
 
 
 		size_t GetFreeSize() const
@@ -37,7 +66,7 @@ namespace stingray
 
 
 		size_t GetStorageSize() const
-		{ return _storage.size(); }
+		{ return _size; }
 
 
 		ConstByteData GetStorage() const
@@ -46,61 +75,142 @@ namespace stingray
 
 		ByteData Write()
 		{
-			size_t size = _dataIsContiguous ? (GetStorageSize() - _writeOffset) : (_readOffset - _writeOffset);
-			return ByteData(_storage, _writeOffset, size);
+			const size_t pushed = AtomicSize::Load(_pushed, MemoryOrderRelaxed);
+			const size_t freeSize = _size - GetDataSize(pushed, AtomicSize::Load(_popped, MemoryOrderAcquire));
+			const size_t writeOffset = ToOffset(pushed);
+			return ByteData(_storage, writeOffset, _mirrored ? freeSize : std::min(freeSize, _size - writeOffset));
 		}
 
 
 		void Push(size_t pushSize)
 		{
-			STINGRAYKIT_CHECK(_writeOffset + pushSize <= GetStorageSize(), IndexOutOfRangeException(pushSize, _writeOffset, GetStorageSize()));
-			_writeOffset += pushSize;
+			const size_t pushed = AtomicSize::Load(_pushed, MemoryOrderRelaxed);
+			const size_t writeOffset = ToOffset(pushed);
+			STINGRAYKIT_CHECK(writeOffset + pushSize <= _storage.size(), IndexOutOfRangeException(pushSize, writeOffset, _storage.size()));
 
-			if (_writeOffset == GetStorageSize())
-			{
-				_writeOffset = 0;
-				_dataIsContiguous = !_dataIsContiguous;
-			}
+			AtomicSize::Store(_pushed, Advance(pushed, pushSize), MemoryOrderRelease);
+
+			Wake(_readerSleeping, _dataPushed);
 		}
 
 
 		ConstByteData Read()
 		{
-			size_t size = (_dataIsContiguous) ? (_writeOffset - _readOffset) : (GetStorageSize() - _readOffset);
-			return ByteData(_storage, _readOffset, size);
+			const size_t popped = AtomicSize::Load(_popped, MemoryOrderRelaxed);
+			const size_t dataSize = GetDataSize(AtomicSize::Load(_pushed, MemoryOrderAcquire), popped);
+			const size_t readOffset = ToOffset(popped);
+			return ByteData(_storage, readOffset, _mirrored ? dataSize : std::min(dataSize, _size - readOffset));
 		}
 
 
 		void Pop(size_t popSize)
 		{
-			STINGRAYKIT_CHECK(_readOffset + popSize <= GetStorageSize(), IndexOutOfRangeException(popSize, _readOffset, GetStorageSize()));
-			_readOffset += popSize;
+			const size_t popped = AtomicSize::Load(_popped, MemoryOrderRelaxed);
+			const size_t readOffset = ToOffset(popped);
+			STINGRAYKIT_CHECK(readOffset + popSize <= _storage.size(), IndexOutOfRangeException(popSize, readOffset, _storage.size()));
 
-			if (_readOffset == GetStorageSize())
-			{
-				_readOffset = 0;
-				_dataIsContiguous = !_dataIsContiguous;
-			}
+			AtomicSize::Store(_popped, Advance(popped, popSize), MemoryOrderRelease);
+
+			Wake(_writerSleeping, _dataPopped);
+		}
+
+
+		ConditionWaitResult WaitEmpty(size_t dataSize, const ICancellationToken& token)
+		{ return Wait(_readerSleeping, _dataPushed, &Impl::HasData, dataSize, token); }
+
+
+		ConditionWaitResult WaitFull(size_t freeSize, const ICancellationToken& token)
+		{ return Wait(_writerSleeping, _dataPopped, &Impl::HasFreeSpace, freeSize, token); }
+
+
+		void WakeReader()
+		{
+			AtomicU32::Store(_readerWoken, 1, MemoryOrderRelaxed);
+			Wake(_readerSleeping, _dataPushed);
 		}
 
 
 		void Clear()
 		{
-			_writeOffset = 0;
-			_readOffset = 0;
-			_dataIsContiguous = true;
+			AtomicSize::Store(_pushed, 0);
+			AtomicSize::Store(_popped, 0);
+
+			Wake(_writerSleeping, _dataPopped);
+		}
+
+	private:
+		bool HasData(size_t dataSize)
+		{ return GetDataSize() >= dataSize || (AtomicU32::Load(_readerWoken, MemoryOrderRelaxed) && AtomicU32::CompareAndExchange(_readerWoken, 1, 0) == 1); }
+
+		bool HasFreeSpace(size_t freeSize)
+		{ return GetFreeSize() >= freeSize; }
+
+		size_t GetDataSize(size_t pushed, size_t popped) const
+		{ return pushed >= popped ? pushed - popped : pushed + 2 * _size - popped; }
+
+		size_t ToOffset(size_t position) const
+		{ return position >= _size ? position - _size : position; }
+
+		size_t Advance(size_t position, size_t size) const
+		{ return position + size >= 2 * _size ? position + size - 2 * _size : position + size; }
+
+		ConditionWaitResult Wait(AtomicU32::Type& sleeping, ConditionVariable& cv, bool (Impl::*ready)(size_t), size_t size, const ICancellationToken& token)
+		{
+			// Other side usually makes progress within its time slice, going to sleep right away makes it pay for a wakeup per chunk
+			for (size_t i = 0; i < YieldsBeforeSleep; ++i)
+			{
+				if ((this->*ready)(size))
+					return ConditionWaitResult::Broadcasted;
+
+				Thread::Yield();
+			}
+
+			MutexLock l(_waitMutex);
+
+			ConditionWaitResult result = ConditionWaitResult::Broadcasted;
+			while (result == ConditionWaitResult::Broadcasted)
+			{
+				// Pairs with the fence in Wake: the other side publishes its position, then checks the flag, and both fences
+				// forbid store-load reordering on either side, so either we see its progress here or it sees us sleeping
+				AtomicU32::Store(sleeping, 1, MemoryOrderRelaxed);
+				AtomicThreadFence(MemoryOrderSeqCst);
+				if ((this->*ready)(size))
+					break;
+
+				result = cv.Wait(_waitMutex, token);
+			}
+
+			AtomicU32::Store(sleeping, 0);
+			return result;
+		}
+
+		void Wake(AtomicU32::Type& sleeping, ConditionVariable& cv)
+		{
+			// Keeps the position store of the caller from being reordered after the flag load, see Wait
+			AtomicThreadFence(MemoryOrderSeqCst);
+
+			// Only the first wakeup after the other side went to sleep pays for the lock
+			if (!AtomicU32::Load(sleeping, MemoryOrderRelaxed) || AtomicU32::CompareAndExchange(sleeping, 1, 0) != 1)
+				return;
+
+			MutexLock l(_waitMutex);
+			cv.Broadcast();
 		}
 	};
 
 
-	BithreadCircularBuffer::BithreadCircularBuffer(size_t size) : _impl(new Impl(BytesOwner::Create(size)))
+	BithreadCircularBuffer::BithreadCircularBuffer(size_t size) : _impl(new Impl(BytesOwner::Create(size), false))
 	{ }
 
 
-	BithreadCircularBuffer::BithreadCircularBuffer(const BytesOwner& storage) : _impl(new Impl(storage))
+	BithreadCircularBuffer::BithreadCircularBuffer(const BytesOwner& storage) : _impl(new Impl(storage, false))
 	{ }
 
 
+	BithreadCircularBuffer::BithreadCircularBuffer(const BytesOwner& storage, MirroredStorageTag) : _impl(new Impl(storage, true))
+	{ STINGRAYKIT_CHECK(storage.size() % 2 == 0, ArgumentException("storage.size()", storage.size())); }
+
+
 	BithreadCircularBuffer::~BithreadCircularBuffer()
 	{ }
 
@@ -125,6 +235,100 @@ namespace stingray
 	{ return Writer(_impl); }
 
 
+	size_t BithreadCircularBuffer::ReadV(ByteDataSpan data)
+	{
+		size_t result = 0;
+		ByteDataSpan::const_iterator it = data.begin();
+		size_t offset = 0;
+
+		// Data may wrap around the end of non-mirrored storage
+		for (size_t region = 0; region < 2 && it != data.end(); ++region)
+		{
+			const ConstByteData src = _impl->Read();
+
+			size_t copied = 0;
+			while (it != data.end() && copied != src.size())
+			{
+				const size_t size = std::min(it->size() - offset, src.size() - copied);
+				::memcpy(it->data() + offset, src.data() + copied, size);
+				copied += size;
+				offset += size;
+
+				if (offset == it->size())
+				{
+					++it;
+					offset = 0;
+				}
+			}
+
+			if (copied == 0)
+				break;
+
+			_impl->Pop(copied);
+			result += copied;
+		}
+
+		return result;
+	}
+
+
+	size_t BithreadCircularBuffer::WriteV(ConstByteDataSpan data)
+	{
+		size_t result = 0;
+		ConstByteDataSpan::const_iterator it = data.begin();
+		size_t offset = 0;
+
+		// Free space may wrap around the end of non-mirrored storage
+		for (size_t region = 0; region < 2 && it != data.end(); ++region)
+		{
+			const ByteData dst = _impl->Write();
+
+			size_t copied = 0;
+			while (it != data.end() && copied != dst.size())
+			{
+				const size_t size = std::min(it->size() - offset, dst.size() - copied);
+				::memcpy(dst.data() + copied, it->data() + offset, size);
+				copied += size;
+				offset += size;
+
+				if (offset == it->size())
+				{
+					++it;
+					offset = 0;
+				}
+			}
+
+			if (copied == 0)
+				break;
+
+			_impl->Push(copied);
+			result += copied;
+		}
+
+		return result;
+	}
+
+
+	ConditionWaitResult BithreadCircularBuffer::WaitEmpty(const ICancellationToken& token)
+	{ return _impl->WaitEmpty(1, token); }
+
+
+	ConditionWaitResult BithreadCircularBuffer::WaitEmpty(size_t dataSize, const ICancellationToken& token)
+	{ return _impl->WaitEmpty(dataSize, token); }
+
+
+	ConditionWaitResult BithreadCircularBuffer::WaitFull(const ICancellationToken& token)
+	{ return _impl->WaitFull(1, token); }
+
+
+	ConditionWaitResult BithreadCircularBuffer::WaitFull(size_t freeSize, const ICancellationToken& token)
+	{ return _impl->WaitFull(freeSize, token); }
+
+
+	void BithreadCircularBuffer::WakeReader()
+	{ _impl->WakeReader(); }
+
+
 	void BithreadCircularBuffer::Clear()
 	{ _impl->Clear(); }
 
@@ -10,11 +10,27 @@
 
 #include <stingraykit/collection/ByteData.h>
 #include <stingraykit/collection/BytesOwner.h>
+#include <stingraykit/thread/ConditionVariable.h>
 #include <stingraykit/self_counter.h>
 
 namespace stingray
 {
 
+	/**
+	 * @brief Marks storage, which consists of two back to back mappings of the same memory (see MirroredMemory)
+	 * @details Circular buffer over such storage returns all available data or free space from Read and Write, not only the part up to
+	 * the wrap point.
+	 */
+	struct MirroredStorageTag
+	{ };
+
+
+	/**
+	 * @brief Circular buffer for one reader and one writer thread
+	 * @details Reader and writer may work simultaneously without any external locking: positions are kept in atomic counters on
+	 * separate cache lines. WaitEmpty and WaitFull block the calling side, the other side takes a lock to wake it only if it is
+	 * actually sleeping, so Push and Pop do not touch any mutex on the fast path.
+	 */
 	struct BithreadCircularBuffer
 	{
 		STINGRAYKIT_NONCOPYABLE(BithreadCircularBuffer);
@@ -79,6 +95,9 @@ namespace stingray
 	public:
 		BithreadCircularBuffer(size_t size);
 		BithreadCircularBuffer(const BytesOwner& storage);
+
+		/// @param storage Mirrored storage, buffer size is half of its size
+		BithreadCircularBuffer(const BytesOwner& storage, MirroredStorageTag);
 		~BithreadCircularBuffer();
 
 		size_t GetDataSize() const;
@@ -89,6 +108,29 @@ namespace stingray
 		Reader Read();
 		Writer Write();
 
+		/// @brief Copies available data into regions without blocking. Must only be called from reader thread
+		/// @returns Number of bytes read
+		size_t ReadV(ByteDataSpan data);
+
+		/// @brief Copies as much of regions as fits into free space without blocking. Must only be called from writer thread
+		/// @returns Number of bytes written
+		size_t WriteV(ConstByteDataSpan data);
+
+		/// @brief Blocks reader until buffer has some data or WakeReader is called. Must not be called from more than one thread simultaneously
+		ConditionWaitResult WaitEmpty(const ICancellationToken& token);
+
+		/// @brief Blocks reader until buffer has at least dataSize bytes of data or WakeReader is called
+		ConditionWaitResult WaitEmpty(size_t dataSize, const ICancellationToken& token);
+
+		/// @brief Blocks writer until buffer has some free space. Must not be called from more than one thread simultaneously
+		ConditionWaitResult WaitFull(const ICancellationToken& token);
+
+		/// @brief Blocks writer until buffer has at least freeSize bytes of free space
+		ConditionWaitResult WaitFull(size_t freeSize, const ICancellationToken& token);
+
+		/// @brief Makes current or next WaitEmpty return even without new data, so that reader notices state kept outside of buffer, e.g. end of data
+		void WakeReader();
+
 		/// @brief: Clears buffer completely. Warning: can't be called simultaneously with Read(...) or Write(...)
 		void Clear();
 	};
@@ -15,42 +15,45 @@ namespace stingray
 	STINGRAYKIT_DEFINE_NAMED_LOGGER(BufferedDataConsumer);
 
 
-	size_t BufferedDataConsumer::Process(ConstByteData data, const ICancellationToken& token)
+	size_t BufferedDataConsumer::ProcessV(ConstByteDataSpan data, const ICancellationToken& token)
 	{
-		if (data.size() % _inputPacketSize != 0)
+		const size_t dataSize = data.GetTotalSize();
+		if (dataSize % _inputPacketSize != 0)
 		{
-			s_logger.Error() << "Data size: " << data.size() << " is not a multiple of input packet size: " << _inputPacketSize;
-			return data.size();
+			s_logger.Error() << "Data size: " << dataSize << " is not a multiple of input packet size: " << _inputPacketSize;
+			return dataSize;
 		}
 
-		SharedCircularBuffer::BufferLock bl(*_buffer);
-		SharedCircularBuffer::WriteLock wl(bl);
+		SharedCircularBuffer::WriteLock wl(*_buffer);
 
-		STINGRAYKIT_CHECK(!bl.IsEndOfData(), InvalidOperationException("Already got EOD!"));
-		STINGRAYKIT_CHECK(!bl.HasException(), InvalidOperationException("Already got exception!"));
+		STINGRAYKIT_CHECK(!wl.IsEndOfData(), InvalidOperationException("Already got EOD!"));
+		STINGRAYKIT_CHECK(!wl.HasException(), InvalidOperationException("Already got exception!"));
 
 		BithreadCircularBuffer::Writer w = wl.Write();
 		const size_t packetizedSize = w.size() / _inputPacketSize * _inputPacketSize;
-		if (packetizedSize == 0 || bl.GetFreeSize() < _requiredFreeSpace)
+		if (packetizedSize == 0 || wl.GetFreeSize() < _requiredFreeSpace)
 		{
 			if (_discardOnOverflow)
 			{
-				_onOverflow(data.size());
-				return data.size();
+				_onOverflow(dataSize);
+				return dataSize;
 			}
 
-			wl.WaitFull(token);
+			wl.WaitFull(std::max(_inputPacketSize, _requiredFreeSpace), token);
 			return 0;
 		}
 
-		size_t writeSize = std::min(data.size(), packetizedSize);
+		const size_t writeSize = std::min(dataSize, packetizedSize);
+
+		size_t copied = 0;
+		for (ConstByteDataSpan::const_iterator it = data.begin(); copied != writeSize; ++it)
 		{
-			SharedCircularBuffer::BufferUnlock bul(bl);
-			::memcpy(w.data(), data.data(), writeSize);
+			const size_t size = std::min(it->size(), writeSize - copied);
+			::memcpy(w.data() + copied, it->data(), size);
+			copied += size;
 		}
 
 		w.Push(writeSize);
-		wl.BroadcastEmpty();
 
 		return writeSize;
 	}
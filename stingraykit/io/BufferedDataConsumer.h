@@ -45,7 +45,12 @@ namespace stingray
 			STINGRAYKIT_CHECK(totalSize >= requiredFreeSpace, "Buffer size less then required free space!");
 		}
 
-		size_t Process(ConstByteData data, const ICancellationToken& token) override;
+		size_t Process(ConstByteData data, const ICancellationToken& token) override
+		{ return ProcessV(ConstByteDataSpan(&data, 1), token); }
+
+		/// @brief Copies regions into buffer and publishes them with single push, total size must be a multiple of input packet size
+		/// @note Buffer has single writer, so simultaneous calls must be serialized by caller, e.g. with SharedWriteSynchronizer
+		size_t ProcessV(ConstByteDataSpan data, const ICancellationToken& token) override;
 
 		void EndOfData(const ICancellationToken&) override
 		{ SharedCircularBuffer::BufferLock(*_buffer).SetEndOfData(); }
@@ -15,16 +15,21 @@ namespace stingray
 
 	void BufferedDataSource::Read(IDataConsumer& consumer, const ICancellationToken& token)
 	{
-		SharedCircularBuffer::BufferLock bl(*_buffer);
-		SharedCircularBuffer::ReadLock rl(bl);
+		SharedCircularBuffer::ReadLock rl(*_buffer);
+
+		// Writer sets end of data or exception after its last push, so checking them first ensures no data is left behind
+		const bool eod = rl.IsEndOfData();
+		const bool failed = rl.HasException();
 
 		BithreadCircularBuffer::Reader r = rl.Read();
 
 		const size_t packetizedSize = r.size() / _outputPacketSize * _outputPacketSize;
 		if (packetizedSize == 0)
 		{
-			bl.RethrowExceptionIfAny(STINGRAYKIT_WHERE);
-			if (bl.IsEndOfData())
+			if (failed)
+				rl.RethrowExceptionIfAny(STINGRAYKIT_WHERE);
+
+			if (eod)
 			{
 				if (r.size() != 0)
 					s_logger.Warning() << "Ending data size: " << r.size() << " is lesser than output packet size: " << _outputPacketSize;
@@ -33,16 +38,11 @@ namespace stingray
 				return;
 			}
 
-			rl.WaitEmpty(token);
+			rl.WaitEmpty(_outputPacketSize, token);
 			return;
 		}
 
-		size_t processedSize = 0;
-		{
-			SharedCircularBuffer::BufferUnlock ul(bl);
-			processedSize = consumer.Process(ConstByteData(r.GetData(), 0, packetizedSize), token);
-		}
-
+		size_t processedSize = consumer.Process(ConstByteData(r.GetData(), 0, packetizedSize), token);
 		if (processedSize == 0)
 			return;
 
@@ -53,7 +53,6 @@ namespace stingray
 		}
 
 		r.Pop(processedSize);
-		rl.BroadcastFull();
 	}
 
 }
@@ -35,10 +35,37 @@ namespace stingray
 	}
 
 
+	u64 BufferedPipe::ReadV(ByteDataSpan data, const ICancellationToken& token)
+	{
+		// Large reads bypass the buffer and go straight into the caller's regions
+		if (_bufferOffset == _bufferSize && data.GetTotalSize() >= _buffer.size())
+			return _pipe->ReadV(data, token);
+
+		u64 result = 0;
+		for (ByteDataSpan::const_iterator it = data.begin(); it != data.end(); ++it)
+		{
+			if (_bufferOffset == _bufferSize && result != 0)
+				break;
+
+			const size_t size = Read(*it, token);
+			result += size;
+
+			if (size != it->size())
+				break;
+		}
+
+		return result;
+	}
+
+
 	u64 BufferedPipe::Write(ConstByteData data, const ICancellationToken& token)
 	{ return _pipe->Write(data, token); }
 
 
+	u64 BufferedPipe::WriteV(ConstByteDataSpan data, const ICancellationToken& token)
+	{ return _pipe->WriteV(data, token); }
+
+
 	bool BufferedPipe::Peek(const ICancellationToken& token)
 	{ return _bufferOffset != _bufferSize || _pipe->Peek(token); }
 
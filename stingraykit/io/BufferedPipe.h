@@ -29,8 +29,10 @@ namespace stingray
 		explicit BufferedPipe(const IPipePtr& pipe, size_t bufferSize = DefaultBufferSize);
 
 		virtual u64 Read(ByteData data, const ICancellationToken& token);
+		virtual u64 ReadV(ByteDataSpan data, const ICancellationToken& token);
 
 		virtual u64 Write(ConstByteData data, const ICancellationToken& token);
+		virtual u64 WriteV(ConstByteDataSpan data, const ICancellationToken& token);
 
 		virtual bool Peek(const ICancellationToken& token);
 	};
@@ -9,6 +9,7 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #include <stingraykit/collection/ByteData.h>
+#include <stingraykit/io/IPositionalByteStream.h>
 #include <stingraykit/io/SeekMode.h>
 #include <stingraykit/string/ToString.h>
 #include <stingraykit/thread/DummyCancellationToken.h>
@@ -70,7 +71,7 @@ namespace stingray
 		STINGRAYKIT_CHECK(initialSize, ArgumentException("initialSize"));
 
 		size_t offset = 0;
-		ByteArray buffer(initialSize);
+		ByteArray buffer(ByteArray::CreateUninitialized(initialSize));
 
 		while (token)
 		{
@@ -89,9 +90,79 @@ namespace stingray
 	}
 
 
+	namespace Detail
+	{
+		template < typename StreamType, typename EnableIf<IsInherited<StreamType, IInputByteStream>::Value, int>::ValueT = 0 >
+		IPositionalByteStream* ToPositionalByteStream(StreamType& stream)
+		{ return dynamic_cast<IPositionalByteStream*>(&stream); }
+
+		template < typename StreamType, typename EnableIf<!IsInherited<StreamType, IInputByteStream>::Value, int>::ValueT = 0 >
+		IPositionalByteStream* ToPositionalByteStream(StreamType& stream)
+		{ return NULL; }
+
+
+		inline optional<std::string> ReadLineAt(IPositionalByteStream& stream, const ICancellationToken& token)
+		{
+			optional<std::string> result;
+			u8 buffer[256];
+			u64 offset = stream.Tell();
+
+			while (token)
+			{
+				const size_t read = (size_t)stream.ReadAt(offset, ByteData(buffer, sizeof(buffer)), token);
+				if (read == 0)
+					break;
+
+				if (!result)
+					result.emplace();
+
+				const u8* const begin = buffer;
+				const u8* const end = begin + read;
+				const u8* const eol = std::find_if(begin, end, [](u8 byte) { return byte == '\n' || byte == '\r'; });
+				result->append(begin, eol);
+				offset += eol - begin;
+
+				if (eol == end)
+					continue;
+
+				++offset;
+				if (*eol == '\r')
+				{
+					// \n of \r\n may be in next block
+					u8 next = 0;
+					if (eol + 1 != end)
+						next = eol[1];
+					else
+						stream.ReadAt(offset, ByteData(&next, sizeof(next)), token);
+
+					if (next == '\n')
+						++offset;
+				}
+				break;
+			}
+
+			stream.Seek((s64)offset);
+			return result;
+		}
+	}
+
+
+	/**
+	 * @brief Reads line terminated by \n, \r\n or \r
+	 * @details IPositionalByteStream is read in small blocks with ReadAt and then positioned right after the line.
+	 * Other streams are read byte by byte, so that no data after the line is consumed, and are only sought back by one byte after single \r.
+	 * Use RecordReader to read many lines at once.
+	 */
 	template < typename StreamType >
 	optional<std::string> ReadLine(StreamType&& stream, const ICancellationToken& token = DummyCancellationToken())
 	{
+		if (IPositionalByteStream* const positional = Detail::ToPositionalByteStream(stream))
+		{
+			optional<std::string> result = Detail::ReadLineAt(*positional, token);
+			STINGRAYKIT_CHECK_CANCELLATION(token);
+			return result;
+		}
+
 		optional<string_ostream> result;
 
 		while (token)
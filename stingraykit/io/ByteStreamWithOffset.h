@@ -8,27 +8,33 @@
 // IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
-#include <stingraykit/io/IByteStream.h>
+#include <stingraykit/io/IPositionalByteStream.h>
 #include <stingraykit/string/ToString.h>
 
 namespace stingray
 {
 
+	/// @brief Shifts all offsets of underlying stream, uses ReadAt/WriteAt instead of Seek if underlying stream is IPositionalByteStream
 	class ByteStreamWithOffset : public IByteStream
 	{
-		IByteStreamPtr	_stream;
-		const s64		_offset;
-		s64				_position;
+		IByteStreamPtr				_stream;
+		IPositionalByteStreamPtr	_positional;
+		const s64					_offset;
+		s64							_position;
 
 	public:
-		ByteStreamWithOffset(const IByteStreamPtr & stream, s64 offset) : _stream(stream), _offset(offset), _position(0)
+		ByteStreamWithOffset(const IByteStreamPtr & stream, s64 offset) : _stream(stream), _positional(dynamic_caster(stream)), _offset(offset), _position(0)
 		{
 			STINGRAYKIT_CHECK(offset >= 0, ArgumentException("offset", offset));
-			_stream->Seek(offset + _position);
+			if (!_positional)
+				_stream->Seek(offset + _position);
 		}
 
 		virtual u64 Tell() const
 		{
+			if (_positional)
+				return _position;
+
 			u64 tell = _stream->Tell();
 			STINGRAYKIT_CHECK(tell >= (u64)_offset, IndexOutOfRangeException(tell, _offset, 0));
 			u64 position = tell - _offset;
@@ -65,12 +71,20 @@ namespace stingray
 			}
 
 			STINGRAYKIT_CHECK(newPosition >= _offset, IndexOutOfRangeException(newPosition, _offset, 0));
-			_stream->Seek(newPosition);
+			if (!_positional)
+				_stream->Seek(newPosition);
 			_position = newPosition - _offset;
 		}
 
 		virtual u64 Read(ByteData data, const ICancellationToken& token)
 		{
+			if (_positional)
+			{
+				const u64 readed = _positional->ReadAt(_offset + _position, data, token);
+				_position += (s64)readed;
+				return readed;
+			}
+
 			_stream->Seek(_offset + _position);
 			u64 readed = _stream->Read(data, token);
 			_position += (s64)readed;
@@ -79,6 +93,13 @@ namespace stingray
 
 		virtual u64 Write(ConstByteData data, const ICancellationToken& token)
 		{
+			if (_positional)
+			{
+				const u64 written = _positional->WriteAt(_offset + _position, data, token);
+				_position += (s64)written;
+				return written;
+			}
+
 			_stream->Seek(_offset + _position);
 			u64 written = _stream->Write(data, token);
 			_position += (s64)written;
@@ -45,23 +45,35 @@ namespace stingray
 		Mutex				_mutex;
 		bool 				_loggingEnabled;
 
-		ConstByteData CheckDataSize(ConstByteData data)
+		/// @returns Number of leading bytes to be discarded
+		size_t CheckDataSize(size_t size)
 		{
 			const size_t totalCapacity = GetFreeSize();
-			if (data.size() > totalCapacity)
+			if (size > totalCapacity)
 			{
 				if (DiscardOnOverflow)
 				{
 					STINGRAYKIT_CHECK(_lockedDataSize == 0, "Previous data was not freed");
-					const size_t resultSize = std::min(data.size(), GetStorageSize());
-					ConstByteData croppedData(data, data.size() - resultSize, resultSize);
+					const size_t resultSize = std::min(size, GetStorageSize());
 					ReleaseData(resultSize - totalCapacity);
-					return croppedData;
+					return size - resultSize;
 				}
 
 				STINGRAYKIT_THROW(BufferIsFullException());
 			}
-			return data;
+			return 0;
+		}
+
+		void DoPushWrapped(ConstByteData data)
+		{
+			const size_t tailCapacity = GetStorageSize() - _writeOffset;
+			if (_dataIsContiguous && data.size() > tailCapacity)
+			{
+				DoPush(ConstByteData(data, 0, tailCapacity));
+				DoPush(ConstByteData(data, tailCapacity, data.size() - tailCapacity));
+			}
+			else
+				DoPush(data);
 		}
 
 		void DoPush(ConstByteData data)
@@ -184,20 +196,41 @@ namespace stingray
 				s_logger.Warning() << "Push started";
 				s_logger.Warning() << "ro: " << _readOffset << ", wo: " << _writeOffset << ", ls: " << _lockedDataSize;
 			}
-			const ConstByteData dataToPush(CheckDataSize(data));
-			const size_t tailCapacity = GetStorageSize() - _writeOffset;
-			if (_dataIsContiguous && dataToPush.size() > tailCapacity)
+			DoPushWrapped(ConstByteData(data, CheckDataSize(data.size())));
+
+			if (_loggingEnabled)
 			{
-				DoPush(ConstByteData(dataToPush, 0, tailCapacity));
-				DoPush(ConstByteData(dataToPush, tailCapacity, dataToPush.size() - tailCapacity));
+				s_logger.Warning() << "ro: " << _readOffset << ", wo: " << _writeOffset << ", ls: " << _lockedDataSize;
+				s_logger.Warning() << "Push finished";
 			}
-			else
-				DoPush(dataToPush);
+		}
 
+		void PushV(ConstByteDataSpan data)
+		{
+			MutexLock l(_mutex);
 			if (_loggingEnabled)
 			{
+				s_logger.Warning() << "PushV started";
 				s_logger.Warning() << "ro: " << _readOffset << ", wo: " << _writeOffset << ", ls: " << _lockedDataSize;
-				s_logger.Warning() << "Push finished";
+			}
+
+			size_t discardSize = CheckDataSize(data.GetTotalSize());
+			for (ConstByteDataSpan::const_iterator it = data.begin(); it != data.end(); ++it)
+			{
+				if (it->size() <= discardSize)
+				{
+					discardSize -= it->size();
+					continue;
+				}
+
+				DoPushWrapped(ConstByteData(*it, discardSize));
+				discardSize = 0;
+			}
+
+			if (_loggingEnabled)
+			{
+				s_logger.Warning() << "ro: " << _readOffset << ", wo: " << _writeOffset << ", ls: " << _lockedDataSize;
+				s_logger.Warning() << "PushV finished";
 			}
 		}
 
@@ -51,6 +51,13 @@ namespace stingray
 				_source(_buffer, parameters.OutputPacketSize)
 		{ }
 
+		/// @param storage Mirrored storage (see MirroredMemory), buffer size is half of its size
+		DataBuffer(bool discardOnOverflow, const BytesOwner& storage, MirroredStorageTag tag, Parameters parameters = Parameters())
+			:	_buffer(make_shared_ptr<SharedCircularBuffer>(storage, tag)),
+				_consumer(_buffer, discardOnOverflow, parameters.InputPacketSize, parameters.RequiredFreeSpace),
+				_source(_buffer, parameters.OutputPacketSize)
+		{ }
+
 		void Read(IDataConsumer& consumer, const ICancellationToken& token) override
 		{ _source.Read(consumer, token); }
 
@@ -63,6 +70,15 @@ namespace stingray
 			return _consumer.Process(data, token);
 		}
 
+		size_t ProcessV(ConstByteDataSpan data, const ICancellationToken& token) override
+		{
+			SharedWriteSynchronizer::WriteGuard g(_writeSync);
+			if (g.Wait(token) != ConditionWaitResult::Broadcasted)
+				return 0;
+
+			return _consumer.ProcessV(data, token);
+		}
+
 		void EndOfData(const ICancellationToken& token) override
 		{ _consumer.EndOfData(token); }
 
@@ -83,15 +99,13 @@ namespace stingray
 
 		void WaitForData(size_t threshold, const ICancellationToken& token) override
 		{
-			SharedCircularBuffer::BufferLock bl(*_buffer);
-
-			STINGRAYKIT_CHECK(threshold > 0 && threshold % _source.GetOutputPacketSize() == 0 && threshold < bl.GetStorageSize(),
+			STINGRAYKIT_CHECK(threshold > 0 && threshold % _source.GetOutputPacketSize() == 0 && threshold < GetStorageSize(),
 					ArgumentException("threshold", threshold));
 
-			SharedCircularBuffer::ReadLock rl(bl);
+			SharedCircularBuffer::ReadLock rl(*_buffer);
 
-			while (bl.GetDataSize() < threshold && !bl.IsEndOfData() && !bl.HasException())
-				if (rl.WaitEmpty(token) != ConditionWaitResult::Broadcasted)
+			while (rl.GetDataSize() < threshold && !rl.IsEndOfData() && !rl.HasException())
+				if (rl.WaitEmpty(threshold, token) != ConditionWaitResult::Broadcasted)
 					break;
 		}
 
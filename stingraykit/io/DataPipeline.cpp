@@ -0,0 +1,386 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/DataPipeline.h>
+
+#include <stingraykit/function/bind.h>
+#include <stingraykit/io/DataSources.h>
+
+namespace stingray
+{
+
+	namespace
+	{
+
+		class FedDataPipeline final : public virtual IDataSource
+		{
+		private:
+			DataPipelinePtr			_pipeline;
+			IDataSourcePtr			_source;
+
+			ThreadPtr				_worker;
+
+		public:
+			FedDataPipeline(const std::string& threadName, const DataPipelinePtr& pipeline, const IDataSourcePtr& source)
+				:	_pipeline(STINGRAYKIT_REQUIRE_NOT_NULL(pipeline)),
+					_source(STINGRAYKIT_REQUIRE_NOT_NULL(source)),
+					_worker(make_shared_ptr<Thread>(threadName, Bind(&FedDataPipeline::ThreadFunc, this, _1)))
+			{ }
+
+			void Read(IDataConsumer& consumer, const ICancellationToken& token) override
+			{ _pipeline->Read(consumer, token); }
+
+		private:
+			void ThreadFunc(const ICancellationToken& token)
+			{
+				try
+				{ ReactiveDataSource(_source).Read(*_pipeline, token); }
+				catch (const std::exception& ex)
+				{ _pipeline->SetException(ex); }
+			}
+		};
+
+	}
+
+
+	void DataPipeline::ChunkQueue::Push(const ConstBytesOwner& chunk)
+	{
+		Chunks.push_back(chunk);
+		Size += chunk.size();
+	}
+
+
+	void DataPipeline::ChunkQueue::Pop(size_t size)
+	{
+		STINGRAYKIT_CHECK(size <= Size, IndexOutOfRangeException(size, Size));
+
+		while (size != 0)
+		{
+			ConstBytesOwner& front = Chunks.front();
+			if (size < front.size())
+			{
+				front = ConstBytesOwner(front, size);
+				Size -= size;
+				return;
+			}
+
+			size -= front.size();
+			Size -= front.size();
+			Chunks.pop_front();
+		}
+	}
+
+
+	struct DataPipeline::Stage
+	{
+		std::string				Name;
+		IDataMediatorPtr		Mediator;
+		bool					Scheduled;
+
+		BandwidthReporterPtr	Reporter;
+
+		Stage(const std::string& name, const IDataMediatorPtr& mediator)
+			: Name(name), Mediator(STINGRAYKIT_REQUIRE_NOT_NULL(mediator)), Scheduled(false)
+		{ }
+	};
+
+
+	class DataPipeline::StageConsumer final : public virtual IDataConsumer
+	{
+	private:
+		const ConstBytesOwner&				_input;
+		std::vector<ConstBytesOwner>&		_output;
+
+	public:
+		StageConsumer(const ConstBytesOwner& input, std::vector<ConstBytesOwner>& output)
+			: _input(input), _output(output)
+		{ }
+
+		size_t Process(ConstByteData data, const ICancellationToken&) override
+		{
+			if (data.empty())
+				return 0;
+
+			// Input chunk is immutable and stays alive as long as its owner, so slices of it can be passed downstream as is
+			if (data.data() >= _input.data() && data.data() + data.size() <= _input.data() + _input.size())
+				_output.push_back(ConstBytesOwner(_input, data.data() - _input.data(), data.size()));
+			else
+				_output.push_back(ConstBytesOwner::Create(data));
+
+			return data.size();
+		}
+
+		void EndOfData(const ICancellationToken&) override
+		{ }
+	};
+
+
+	const size_t DataPipeline::DefaultCapacity;
+
+	STINGRAYKIT_DEFINE_NAMED_LOGGER(DataPipeline);
+
+
+	DataPipeline::DataPipeline(const std::string& name, const ITaskExecutorPtr& executor, size_t inputCapacity, const StageConfigs& stages, const ITimerPtr& reportTimer)
+		:	_name(name),
+			_executor(STINGRAYKIT_REQUIRE_NOT_NULL(executor))
+	{
+		STINGRAYKIT_CHECK(inputCapacity != 0, ArgumentException("inputCapacity"));
+
+		_queues.push_back(ChunkQueue(inputCapacity));
+
+		for (const StageConfig& config : stages)
+		{
+			STINGRAYKIT_CHECK(config.OutputCapacity != 0, ArgumentException("outputCapacity", config.Name));
+
+			const size_t index = _stages.size();
+			_queues.push_back(ChunkQueue(config.OutputCapacity));
+			_stages.push_back(make_unique_ptr<Stage>(config.Name, config.Mediator));
+
+			if (reportTimer)
+				_stages.back()->Reporter = make_shared_ptr<BandwidthReporter>(StringBuilder() % _name % "/" % config.Name, reportTimer, Bind(&DataPipeline::GetQueueSize, this, index + 1));
+		}
+
+		s_logger.Debug() << "[" << _name << "] Created with " << _stages.size() << " stage(s)";
+	}
+
+
+	DataPipeline::~DataPipeline()
+	{
+		_stopToken.Cancel();
+		_lifeToken.Release();
+	}
+
+
+	size_t DataPipeline::Process(ConstByteData data, const ICancellationToken& token)
+	{
+		if (data.empty())
+			return 0;
+
+		MutexLock l(_mutex);
+
+		ChunkQueue& input = _queues.front();
+		STINGRAYKIT_CHECK(!input.EndOfData, InvalidOperationException("Process after EndOfData"));
+
+		while (!input.HasCredit() && !_exception)
+			if (_cond.Wait(_mutex, token) != ConditionWaitResult::Broadcasted)
+				return 0;
+
+		if (_exception)
+			STINGRAYKIT_RETHROW_EXCEPTION(_exception);
+
+		const size_t size = std::min(data.size(), input.Capacity - input.Size);
+
+		ConstBytesOwner chunk;
+		{
+			MutexUnlock ul(l);
+			chunk = ConstBytesOwner::Create(ConstByteData(data, 0, size));
+		}
+
+		input.Push(chunk);
+		TrySchedule(0);
+		return size;
+	}
+
+
+	void DataPipeline::EndOfData(const ICancellationToken& token)
+	{
+		MutexLock l(_mutex);
+
+		_queues.front().EndOfData = true;
+		TrySchedule(0);
+	}
+
+
+	void DataPipeline::Read(IDataConsumer& consumer, const ICancellationToken& token)
+	{
+		MutexLock l(_mutex);
+
+		ChunkQueue& output = _queues.back();
+		while (output.Chunks.empty() && !output.EndOfData && !_exception)
+			if (_cond.Wait(_mutex, token) != ConditionWaitResult::Broadcasted)
+				return;
+
+		if (_exception)
+			STINGRAYKIT_RETHROW_EXCEPTION(_exception);
+
+		if (output.Chunks.empty())
+		{
+			MutexUnlock ul(l);
+			consumer.EndOfData(token);
+			return;
+		}
+
+		const ConstBytesOwner chunk = output.Chunks.front();
+
+		size_t processed = 0;
+		{
+			MutexUnlock ul(l);
+			processed = consumer.Process(chunk, token);
+		}
+
+		STINGRAYKIT_CHECK(processed <= chunk.size(), IndexOutOfRangeException(processed, chunk.size()));
+		if (processed == 0)
+			return;
+
+		output.Pop(processed);
+		QueueProcessed(_queues.size() - 1);
+	}
+
+
+	void DataPipeline::SetException(const std::exception& ex)
+	{
+		MutexLock l(_mutex);
+
+		if (!_exception)
+			_exception = MakeExceptionPtr(ex);
+
+		_cond.Broadcast();
+	}
+
+
+	void DataPipeline::TrySchedule(size_t stageIndex)
+	{
+		if (stageIndex == _stages.size())
+		{
+			_cond.Broadcast();
+			return;
+		}
+
+		Stage& stage = *_stages[stageIndex];
+		const ChunkQueue& input = _queues[stageIndex];
+		const ChunkQueue& output = _queues[stageIndex + 1];
+
+		if (stage.Scheduled || _exception || output.EndOfData || !output.HasCredit() || (input.Chunks.empty() && !input.EndOfData))
+			return;
+
+		stage.Scheduled = true;
+		_executor->AddTask(Bind(&DataPipeline::RunStage, this, stageIndex), _lifeToken.GetExecutionTester());
+	}
+
+
+	void DataPipeline::RunStage(size_t stageIndex)
+	{
+		Stage& stage = *_stages[stageIndex];
+		ChunkQueue& input = _queues[stageIndex];
+		ChunkQueue& output = _queues[stageIndex + 1];
+
+		ConstBytesOwner chunk;
+		{
+			MutexLock l(_mutex);
+			if (!input.Chunks.empty())
+				chunk = input.Chunks.front();
+		}
+
+		std::vector<ConstBytesOwner> produced;
+		size_t processed = 0;
+
+		try
+		{
+			StageConsumer consumer(chunk, produced);
+
+			if (!chunk.empty())
+				processed = stage.Mediator->Process(chunk, _stopToken);
+			else
+				stage.Mediator->EndOfData(_stopToken);
+
+			for (size_t count = 0; _stopToken; count = produced.size())
+			{
+				stage.Mediator->Read(consumer, _stopToken);
+				if (produced.size() == count)
+					break;
+			}
+
+			STINGRAYKIT_CHECK(processed <= chunk.size(), IndexOutOfRangeException(processed, chunk.size()));
+			STINGRAYKIT_CHECK(chunk.empty() || processed != 0 || !produced.empty(), LogicException(StringBuilder() % "Stage '" % stage.Name % "' made no progress"));
+		}
+		catch (const std::exception& ex)
+		{
+			if (!_stopToken)
+				return;
+
+			s_logger.Warning() << "[" << _name << "] Stage '" << stage.Name << "' failed: " << ex;
+
+			MutexLock l(_mutex);
+			stage.Scheduled = false;
+
+			if (!_exception)
+				_exception = MakeExceptionPtr(ex);
+
+			_cond.Broadcast();
+			return;
+		}
+
+		if (!_stopToken)
+			return;
+
+		if (stage.Reporter)
+			stage.Reporter->BytesProcessed(processed);
+
+		MutexLock l(_mutex);
+		stage.Scheduled = false;
+
+		for (const ConstBytesOwner& data : produced)
+			output.Push(data);
+
+		if (chunk.empty())
+			output.EndOfData = true;
+		else if (processed != 0)
+		{
+			input.Pop(processed);
+			QueueProcessed(stageIndex);
+		}
+
+		TrySchedule(stageIndex);
+		TrySchedule(stageIndex + 1);
+	}
+
+
+	void DataPipeline::QueueProcessed(size_t queueIndex)
+	{
+		if (queueIndex == 0)
+			_cond.Broadcast();
+		else
+			TrySchedule(queueIndex - 1);
+	}
+
+
+	size_t DataPipeline::GetQueueSize(size_t queueIndex) const
+	{
+		MutexLock l(_mutex);
+		return _queues[queueIndex].Size;
+	}
+
+
+	DataPipeline::Builder::Builder(const std::string& name, const ITaskExecutorPtr& executor, size_t inputCapacity)
+		:	_name(name),
+			_executor(executor),
+			_inputCapacity(inputCapacity)
+	{ }
+
+
+	DataPipeline::Builder& DataPipeline::Builder::AddStage(const std::string& name, const IDataMediatorPtr& mediator, size_t outputCapacity)
+	{
+		_stages.push_back(StageConfig(name, mediator, outputCapacity));
+		return *this;
+	}
+
+
+	DataPipeline::Builder& DataPipeline::Builder::ReportBandwidth(const ITimerPtr& timer)
+	{
+		_reportTimer = timer;
+		return *this;
+	}
+
+
+	DataPipelinePtr DataPipeline::Builder::Build() const
+	{ return make_shared_ptr<DataPipeline>(_name, _executor, _inputCapacity, _stages, _reportTimer); }
+
+
+	IDataSourcePtr DataPipeline::Builder::Build(const std::string& threadName, const IDataSourcePtr& source) const
+	{ return make_shared_ptr<FedDataPipeline>(threadName, Build(), source); }
+
+}
@@ -0,0 +1,150 @@
+#ifndef STINGRAYKIT_IO_DATAPIPELINE_H
+#define STINGRAYKIT_IO_DATAPIPELINE_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/BandwidthReporter.h>
+#include <stingraykit/ExceptionPtr.h>
+#include <stingraykit/collection/BytesOwner.h>
+#include <stingraykit/executor/ITaskExecutor.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/thread/CancellationToken.h>
+#include <stingraykit/thread/ConditionVariable.h>
+
+#include <deque>
+
+namespace stingray
+{
+
+	/**
+	 * @brief Chain of IDataMediator stages, which are run as tasks on a shared executor instead of a thread per stage
+	 * @details Data pushed by Process passes through the stages in order and is read from the pipeline by Read.
+	 * Every queue between stages has a capacity in bytes: a stage is scheduled only when its input queue has data and its output queue
+	 * has free space, so a slow stage stalls its upstream, and eventually the producer, which is blocked in Process.
+	 * Capacity is a soft limit: one run of a stage may overfill its output queue by the amount of data produced from a single input chunk.
+	 *
+	 * A stage is fed one chunk per run and then drained by calling its Read until it returns no data, so its Read must not block when it has
+	 * nothing to output (e.g. BufferedDataMediator). Output, which points into the chunk the stage was fed with, is passed downstream without copying.
+	 *
+	 * Exceptions thrown by stages are rethrown from Process and Read. Supports one producer and one reader.
+	 * @par Example:
+	 * @code
+	 * const IDataSourcePtr pipeline = DataPipeline::Builder("demux", executor)
+	 *         .AddStage("aligner", aligner)
+	 *         .AddStage("descrambler", descrambler, 1024 * 1024)
+	 *         .ReportBandwidth(timer)
+	 *         .Build("demuxReader", source);
+	 * @endcode
+	 */
+	class DataPipeline final : public virtual IDataMediator
+	{
+		STINGRAYKIT_NONCOPYABLE(DataPipeline);
+
+	public:
+		class Builder;
+
+		struct StageConfig
+		{
+			std::string				Name;
+			IDataMediatorPtr		Mediator;
+			size_t					OutputCapacity;
+
+			StageConfig(const std::string& name, const IDataMediatorPtr& mediator, size_t outputCapacity)
+				: Name(name), Mediator(mediator), OutputCapacity(outputCapacity)
+			{ }
+		};
+
+		using StageConfigs = std::vector<StageConfig>;
+
+	private:
+		struct ChunkQueue
+		{
+			std::deque<ConstBytesOwner>	Chunks;
+			size_t						Size;
+			size_t						Capacity;
+			bool						EndOfData;
+
+			explicit ChunkQueue(size_t capacity) : Size(0), Capacity(capacity), EndOfData(false) { }
+
+			bool HasCredit() const		{ return Size < Capacity; }
+
+			void Push(const ConstBytesOwner& chunk);
+			void Pop(size_t size);
+		};
+
+		struct Stage;
+		STINGRAYKIT_DECLARE_UNIQ_PTR(Stage);
+
+		class StageConsumer;
+
+	public:
+		static const size_t DefaultCapacity = 256 * 1024;
+
+	private:
+		static NamedLogger				s_logger;
+
+		std::string						_name;
+		ITaskExecutorPtr				_executor;
+
+		Mutex							_mutex;
+		ConditionVariable				_cond;
+		ExceptionPtr					_exception;
+
+		std::vector<ChunkQueue>			_queues;
+		std::vector<StageUniqPtr>		_stages;
+
+		CancellationToken				_stopToken;
+		TaskLifeToken					_lifeToken;
+
+	public:
+		DataPipeline(const std::string& name, const ITaskExecutorPtr& executor, size_t inputCapacity, const StageConfigs& stages, const ITimerPtr& reportTimer = null);
+		~DataPipeline() override;
+
+		size_t Process(ConstByteData data, const ICancellationToken& token) override;
+		void EndOfData(const ICancellationToken& token) override;
+
+		void Read(IDataConsumer& consumer, const ICancellationToken& token) override;
+
+		void SetException(const std::exception& ex);
+
+	private:
+		void TrySchedule(size_t stageIndex);
+		void RunStage(size_t stageIndex);
+		void QueueProcessed(size_t queueIndex);
+
+		size_t GetQueueSize(size_t queueIndex) const;
+	};
+	STINGRAYKIT_DECLARE_PTR(DataPipeline);
+
+
+	class DataPipeline::Builder
+	{
+	private:
+		std::string						_name;
+		ITaskExecutorPtr				_executor;
+		size_t							_inputCapacity;
+		StageConfigs					_stages;
+		ITimerPtr						_reportTimer;
+
+	public:
+		Builder(const std::string& name, const ITaskExecutorPtr& executor, size_t inputCapacity = DefaultCapacity);
+
+		Builder& AddStage(const std::string& name, const IDataMediatorPtr& mediator, size_t outputCapacity = DefaultCapacity);
+
+		/// @brief Enables periodical logging of throughput and output queue occupancy of every stage
+		Builder& ReportBandwidth(const ITimerPtr& timer);
+
+		DataPipelinePtr Build() const;
+
+		/// @brief Builds pipeline, which is fed from source on a dedicated thread
+		IDataSourcePtr Build(const std::string& threadName, const IDataSourcePtr& source) const;
+	};
+
+}
+
+#endif
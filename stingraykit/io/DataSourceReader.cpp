@@ -21,6 +21,8 @@ namespace stingray
 			ByteArray	_data;
 
 		public:
+			DataStorage() : _data(ByteArray::CreateUninitialized(0)) { }
+
 			size_t Process(ConstByteData data, const ICancellationToken&) override
 			{
 				_data.append(data.begin(), data.end());
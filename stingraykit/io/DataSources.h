@@ -140,6 +140,7 @@ namespace stingray
 
 	private:
 		using PacketConsumer = IPacketConsumer<MetadataType>;
+		using PacketVector = typename PacketConsumer::PacketVector;
 
 	private:
 		PacketConsumer&					_consumer;
@@ -160,6 +161,14 @@ namespace stingray
 			return true;
 		}
 
+		size_t ProcessBatch(const PacketVector& packets, const ICancellationToken& token) override
+		{
+			const size_t processed = _consumer.ProcessBatch(packets, token);
+			for (size_t i = 0; i < processed; ++i)
+				_processFunc(packets[i], token);
+			return processed;
+		}
+
 		void EndOfData() override
 		{
 			_consumer.EndOfData();
@@ -0,0 +1,41 @@
+#ifndef STINGRAYKIT_IO_IASYNCIOENGINE_H
+#define STINGRAYKIT_IO_IASYNCIOENGINE_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/function/function.h>
+#include <stingraykit/io/IByteStream.h>
+#include <stingraykit/ExceptionPtr.h>
+
+namespace stingray
+{
+
+	/**
+	 * @brief Executes stream operations in the background, so that many streams may share a few threads
+	 * @details Completion handlers are invoked from engine threads, never from within Submit* calls, and may submit next operations right away.
+	 * Operations of one stream are not ordered relative to each other, so users must keep at most one of them in flight.
+	 */
+	struct IAsyncIoEngine
+	{
+		/// @param written Number of bytes written, may be less than requested
+		/// @param exception Set if operation has failed
+		using CompletionHandler = function<void (u64 written, const ExceptionPtr& exception)>;
+
+		virtual ~IAsyncIoEngine() { }
+
+		/// @brief Writes data at given offset of stream, data must stay valid until handler is invoked
+		virtual void SubmitWrite(const IByteStreamPtr& stream, u64 offset, ConstByteData data, const CompletionHandler& handler) = 0;
+
+		/// @brief Flushes stream if it is ISyncableByteStream, completes immediately otherwise
+		virtual void SubmitSync(const IByteStreamPtr& stream, const CompletionHandler& handler) = 0;
+	};
+	STINGRAYKIT_DECLARE_PTR(IAsyncIoEngine);
+
+}
+
+#endif
@@ -57,6 +57,18 @@ namespace stingray
 		virtual size_t GetStorageSize() const = 0;
 		virtual CircularDataReserverPtr Pop(size_t size = std::numeric_limits<size_t>::max()) = 0;
 		virtual void Push(ConstByteData data) = 0;
+
+		/**
+		 * @brief Pushes regions in order as one piece of data
+		 * @details Default implementation pushes regions one by one, so the other side may see a part of them. Implementations should
+		 * override it to push all regions under single lock.
+		 */
+		virtual void PushV(ConstByteDataSpan data)
+		{
+			for (ConstByteDataSpan::const_iterator it = data.begin(); it != data.end(); ++it)
+				Push(*it);
+		}
+
 		virtual bool CanPush(size_t size) = 0;
 		virtual void Clear() = 0;
 	};
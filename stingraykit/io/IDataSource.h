@@ -20,6 +20,25 @@ namespace stingray
 
 		virtual size_t Process(ConstByteData data, const ICancellationToken& token) = 0;
 		virtual void EndOfData(const ICancellationToken& token) = 0;
+
+		/**
+		 * @brief Processes regions in order as one contiguous piece of data
+		 * @details Default implementation calls Process for each region and stops after the first one, which was not processed completely
+		 * @returns Total number of bytes processed
+		 */
+		virtual size_t ProcessV(ConstByteDataSpan data, const ICancellationToken& token)
+		{
+			size_t result = 0;
+			for (ConstByteDataSpan::const_iterator it = data.begin(); it != data.end(); ++it)
+			{
+				const size_t processed = Process(*it, token);
+				result += processed;
+
+				if (processed != it->size())
+					break;
+			}
+			return result;
+		}
 	};
 	STINGRAYKIT_DECLARE_PTR(IDataConsumer);
 
@@ -112,10 +131,26 @@ namespace stingray
 	template < typename MetadataType >
 	struct IPacketConsumer
 	{
+		using PacketVector = std::vector<Packet<MetadataType>>;
+
 		virtual ~IPacketConsumer() { }
 
 		virtual bool Process(const Packet<MetadataType>& packet, const ICancellationToken& token) = 0;
 		virtual void EndOfData() = 0;
+
+		/**
+		 * @brief Processes packets in order
+		 * @details Default implementation calls Process for each packet and stops at the first one, which was not processed
+		 * @returns Number of processed packets
+		 */
+		virtual size_t ProcessBatch(const PacketVector& packets, const ICancellationToken& token)
+		{
+			size_t result = 0;
+			for (; result < packets.size(); ++result)
+				if (!Process(packets[result], token))
+					break;
+			return result;
+		}
 	};
 
 
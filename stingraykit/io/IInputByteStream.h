@@ -19,6 +19,25 @@ namespace stingray
 		virtual ~IInputByteStream() { }
 
 		virtual u64 Read(ByteData data, const ICancellationToken& token = DummyCancellationToken()) = 0;
+
+		/**
+		 * @brief Scatter read, fills regions in order
+		 * @details Default implementation calls Read for each region and stops after the first one, which was not filled completely
+		 * @returns Total number of bytes read
+		 */
+		virtual u64 ReadV(ByteDataSpan data, const ICancellationToken& token = DummyCancellationToken())
+		{
+			u64 result = 0;
+			for (ByteDataSpan::const_iterator it = data.begin(); it != data.end(); ++it)
+			{
+				const u64 read = Read(*it, token);
+				result += read;
+
+				if (read != it->size())
+					break;
+			}
+			return result;
+		}
 	};
 	STINGRAYKIT_DECLARE_PTR(IInputByteStream);
 
@@ -19,6 +19,25 @@ namespace stingray
 		virtual ~IOutputByteStream() { }
 
 		virtual u64 Write(ConstByteData data, const ICancellationToken& token = DummyCancellationToken()) = 0;
+
+		/**
+		 * @brief Gather write, writes regions in order as one contiguous piece of data
+		 * @details Default implementation calls Write for each region and stops after the first one, which was not written completely
+		 * @returns Total number of bytes written
+		 */
+		virtual u64 WriteV(ConstByteDataSpan data, const ICancellationToken& token = DummyCancellationToken())
+		{
+			u64 result = 0;
+			for (ConstByteDataSpan::const_iterator it = data.begin(); it != data.end(); ++it)
+			{
+				const u64 written = Write(*it, token);
+				result += written;
+
+				if (written != it->size())
+					break;
+			}
+			return result;
+		}
 	};
 	STINGRAYKIT_DECLARE_PTR(IOutputByteStream);
 
@@ -0,0 +1,26 @@
+#ifndef STINGRAYKIT_IO_IPOSITIONALBYTESTREAM_H
+#define STINGRAYKIT_IO_IPOSITIONALBYTESTREAM_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/IByteStream.h>
+
+namespace stingray
+{
+
+	/// @brief Stream, which can read and write at arbitrary offset without moving its position (like pread/pwrite)
+	struct IPositionalByteStream : public virtual IByteStream
+	{
+		virtual u64 ReadAt(u64 offset, ByteData data, const ICancellationToken& token = DummyCancellationToken()) = 0;
+		virtual u64 WriteAt(u64 offset, ConstByteData data, const ICancellationToken& token = DummyCancellationToken()) = 0;
+	};
+	STINGRAYKIT_DECLARE_PTR(IPositionalByteStream);
+
+}
+
+#endif
@@ -45,6 +45,26 @@ namespace stingray
 				offset += count;
 				return count;
 			}
+
+			static u64 WriteV(ContainerType& container, u64& offset, ConstByteDataSpan data)
+			{
+				const size_t totalSize = data.GetTotalSize();
+				if (container.size() - offset < totalSize)
+					Detail::MemoryByteStreamContainerResizer<ContainerType>::RequireSize(container, offset + totalSize);
+
+				u64 result = 0;
+				for (ConstByteDataSpan::const_iterator it = data.begin(); it != data.end(); ++it)
+				{
+					const size_t count = std::min<size_t>(it->size(), container.size() - offset);
+					std::copy(it->data(), it->data() + count, container.begin() + offset);
+					offset += count;
+					result += count;
+
+					if (count != it->size())
+						break;
+				}
+				return result;
+			}
 		};
 
 		template < typename ContainerType >
@@ -52,6 +72,9 @@ namespace stingray
 		{
 			static u64 Write(ContainerType& container, u64& offset, ConstByteData data)
 			{ STINGRAYKIT_THROW("Cannot write data to a const container!"); }
+
+			static u64 WriteV(ContainerType& container, u64& offset, ConstByteDataSpan data)
+			{ STINGRAYKIT_THROW("Cannot write data to a const container!"); }
 		};
 	}
 
@@ -78,9 +101,20 @@ namespace stingray
 			return count;
 		}
 
+		virtual u64 ReadV(ByteDataSpan data, const ICancellationToken& token)
+		{
+			u64 result = 0;
+			for (ByteDataSpan::const_iterator it = data.begin(); it != data.end() && _offset != _data.size(); ++it)
+				result += Read(*it, token);
+			return result;
+		}
+
 		virtual u64 Write(ConstByteData data, const ICancellationToken& token)
 		{ return Detail::MemoryByteStreamWriter<ContainerType>::Write(_data, _offset, data); }
 
+		virtual u64 WriteV(ConstByteDataSpan data, const ICancellationToken& token)
+		{ return Detail::MemoryByteStreamWriter<ContainerType>::WriteV(_data, _offset, data); }
+
 		virtual void Seek(s64 offset, SeekMode mode = SeekMode::Begin)
 		{
 			s64 new_ofs = _offset;
@@ -19,11 +19,18 @@
 namespace stingray
 {
 
+	/**
+	 * @brief Circular buffer of packets with metadata
+	 * @details Read passes all packets, which are available in one piece of the buffer (up to MaxBatchSize), to IPacketConsumer::ProcessBatch at once
+	 */
 	template < typename MetadataType >
 	class PacketBuffer final : public virtual IPacketBuffer<MetadataType>
 	{
 	public:
 		using OnOverflowSignature = typename IPacketBuffer<MetadataType>::OnOverflowSignature;
+		using PacketVector = typename IPacketBuffer<MetadataType>::PacketVector;
+
+		static const size_t MaxBatchSize = 256;
 
 	private:
 		struct PacketInfo
@@ -44,6 +51,7 @@ namespace stingray
 
 		std::deque<PacketInfo>				_packetQueue;
 		size_t								_paddingSize;
+		PacketVector						_batch;
 		SharedCircularBuffer				_buffer;
 		SharedWriteSynchronizer				_writeSync;
 
@@ -56,8 +64,8 @@ namespace stingray
 
 		void Read(IPacketConsumer<MetadataType>& consumer, const ICancellationToken& token) override
 		{
+			SharedCircularBuffer::ReadLock rl(_buffer);
 			SharedCircularBuffer::BufferLock bl(_buffer);
-			SharedCircularBuffer::ReadLock rl(bl);
 
 			if (_packetQueue.empty())
 			{
@@ -68,7 +76,7 @@ namespace stingray
 					return;
 				}
 
-				rl.WaitEmpty(token);
+				WaitForPush(rl, bl, token);
 				return;
 			}
 
@@ -81,22 +89,37 @@ namespace stingray
 				reader = rl.Read();
 			}
 
-			const PacketInfo& packet = _packetQueue.front();
-			STINGRAYKIT_CHECK(packet.Size <= reader.size(), LogicException(StringBuilder() % "Reader size " % reader.size() % " is lesser than packet size: " % packet.Size));
+			// Packets are contiguous up to the buffer end, so all of them, which are in the reader, are passed in one batch
+			size_t batchSize = 0;
+			_batch.clear();
+
+			for (typename std::deque<PacketInfo>::const_iterator it = _packetQueue.begin(); it != _packetQueue.end() && _batch.size() < MaxBatchSize; ++it)
+			{
+				if (batchSize + it->Size > reader.size())
+					break;
+
+				_batch.push_back(Packet<MetadataType>(ConstByteData(reader.GetData(), batchSize, it->Size), it->Metadata));
+				batchSize += it->Size;
+			}
+
+			STINGRAYKIT_CHECK(!_batch.empty(), LogicException(StringBuilder() % "Reader size " % reader.size() % " is lesser than packet size: " % _packetQueue.front().Size));
 
-			bool processed = false;
+			size_t processed = 0;
 			{
 				SharedCircularBuffer::BufferUnlock ul(bl);
-				processed = consumer.Process(Packet<MetadataType>(ConstByteData(reader.GetData(), 0, packet.Size), packet.Metadata), token);
+				processed = consumer.ProcessBatch(_batch, token);
 			}
 
-			if (!processed)
+			STINGRAYKIT_CHECK(processed <= _batch.size(), IndexOutOfRangeException(processed, _batch.size()));
+			if (processed == 0)
 				return;
 
-			reader.Pop(packet.Size);
-			_packetQueue.pop_front();
+			size_t processedSize = 0;
+			for (size_t i = 0; i < processed; ++i)
+				processedSize += _batch[i].GetSize();
 
-			rl.BroadcastFull();
+			reader.Pop(processedSize);
+			_packetQueue.erase(_packetQueue.begin(), _packetQueue.begin() + processed);
 		}
 
 		bool Process(const Packet<MetadataType>& packet, const ICancellationToken& token) override
@@ -105,19 +128,18 @@ namespace stingray
 			if (g.Wait(token) != ConditionWaitResult::Broadcasted)
 				return false;
 
-			SharedCircularBuffer::BufferLock bl(_buffer);
-			SharedCircularBuffer::WriteLock wl(bl);
+			SharedCircularBuffer::WriteLock wl(_buffer);
 
-			STINGRAYKIT_CHECK(packet.GetSize() <= bl.GetStorageSize(), ArgumentException("packet.GetSize()", packet.GetSize()));
-			STINGRAYKIT_CHECK(!bl.IsEndOfData(), InvalidOperationException("Already got EOD"));
-			STINGRAYKIT_CHECK(!bl.HasException(), InvalidOperationException("Already got exception"));
+			STINGRAYKIT_CHECK(packet.GetSize() <= wl.GetStorageSize(), ArgumentException("packet.GetSize()", packet.GetSize()));
+			STINGRAYKIT_CHECK(!wl.IsEndOfData(), InvalidOperationException("Already got EOD"));
+			STINGRAYKIT_CHECK(!wl.HasException(), InvalidOperationException("Already got exception"));
 
 			BithreadCircularBuffer::Writer writer = wl.Write();
 
 			const ConstByteData data(packet.GetData());
 			const size_t paddingSize = writer.size() < data.size() && writer.IsBufferEnd() ? writer.size() : 0;
 
-			if (bl.GetFreeSize() < paddingSize + data.size())
+			if (wl.GetFreeSize() < paddingSize + data.size())
 			{
 				if (_discardOnOverflow)
 				{
@@ -127,27 +149,28 @@ namespace stingray
 					return true;
 				}
 
-				wl.WaitFull(token);
+				wl.WaitFull(paddingSize + data.size(), token);
 				return false;
 			}
 
 			if (paddingSize)
 			{
-				_paddingSize = paddingSize;
-				writer.Push(paddingSize);
+				{
+					SharedCircularBuffer::BufferLock bl(_buffer);
+					_paddingSize = paddingSize;
+					writer.Push(paddingSize);
+				}
 
 				writer = wl.Write();
 			}
 
-			{
-				SharedCircularBuffer::BufferUnlock ul(bl);
-				::memcpy(writer.data(), data.data(), data.size());
-			}
+			::memcpy(writer.data(), data.data(), data.size());
 
+			// Packet is published along with its queue entry, so reader never sees data without packet info
+			SharedCircularBuffer::BufferLock bl(_buffer);
 			_packetQueue.emplace_back(data.size(), packet.GetMetadata());
 			writer.Push(data.size());
 
-			wl.BroadcastEmpty();
 			return true;
 		}
 
@@ -171,15 +194,15 @@ namespace stingray
 
 		optional<MetadataType> WaitForPacket(const ICancellationToken& token) override
 		{
+			SharedCircularBuffer::ReadLock rl(_buffer);
 			SharedCircularBuffer::BufferLock bl(_buffer);
-			SharedCircularBuffer::ReadLock rl(bl);
 
 			while (!bl.IsEndOfData() && !bl.HasException())
 			{
 				if (!_packetQueue.empty())
 					return _packetQueue.front().Metadata;
 
-				if (rl.WaitEmpty(token) != ConditionWaitResult::Broadcasted)
+				if (WaitForPush(rl, bl, token) != ConditionWaitResult::Broadcasted)
 					break;
 			}
 
@@ -193,16 +216,29 @@ namespace stingray
 		{
 			SharedCircularBuffer::BufferLock bl(_buffer);
 
+			bl.Clear();
+
 			_packetQueue.clear();
 			_paddingSize = 0;
-
-			bl.Clear();
 		}
 
 		signal_connector<OnOverflowSignature> OnOverflow() const override
 		{ return _onOverflow.connector(); }
+
+	private:
+		ConditionWaitResult WaitForPush(SharedCircularBuffer::ReadLock& rl, SharedCircularBuffer::BufferLock& bl, const ICancellationToken& token)
+		{
+			// With empty queue buffer may only hold padding, so any push after that is waited for rather than some data
+			const size_t dataSize = rl.GetDataSize();
+
+			SharedCircularBuffer::BufferUnlock ul(bl);
+			return rl.WaitEmpty(dataSize + 1, token);
+		}
 	};
 
+	template < typename MetadataType >
+	const size_t PacketBuffer<MetadataType>::MaxBatchSize;
+
 	template < typename MetadataType >
 	STINGRAYKIT_DEFINE_NAMED_LOGGER(PacketBuffer<MetadataType>, "PacketBuffer");
 
@@ -7,9 +7,59 @@
 
 #include <stingraykit/io/PagedBuffer.h>
 
+#include <stingraykit/math.h>
+#include <stingraykit/ObjectToken.h>
+
+#include <string.h>
+
 namespace stingray
 {
 
+	PagedBuffer::MemoryPage::MemoryPage(const BytesOwner& data, size_t chunkSize, size_t used)
+		:	_data(data),
+			_chunkSize(chunkSize),
+			_used(used)
+	{
+		STINGRAYKIT_CHECK(chunkSize > 0, ArgumentException("chunkSize"));
+		STINGRAYKIT_CHECK(used <= data.size(), IndexOutOfRangeException(used, data.size()));
+	}
+
+
+	size_t PagedBuffer::MemoryPage::Read(u64 offset, IDataConsumer& consumer, const ICancellationToken& token)
+	{
+		const size_t used = _used;
+		if (offset >= used)
+			return 0;
+
+		const size_t size = AlignDown<size_t>(used - (size_t)offset, _chunkSize);
+		return size != 0 ? consumer.Process(ConstByteData(GetData(), (size_t)offset, size), token) : 0;
+	}
+
+
+	size_t PagedBuffer::MemoryPage::Write(u64 offset, ConstByteData data, const ICancellationToken& token)
+	{
+		STINGRAYKIT_CHECK(offset <= _data.size(), IndexOutOfRangeException(offset, _data.size()));
+
+		const size_t size = std::min(data.size(), _data.size() - (size_t)offset);
+		::memcpy(_data.data() + offset, data.data(), size);
+
+		_used = std::max<size_t>(_used, (size_t)offset + size);
+		return size;
+	}
+
+
+	void PagedBuffer::MemoryPage::Recycle()
+	{ _used = 0; }
+
+
+	class PagedBuffer::DonatedPage final : public MemoryPage
+	{
+	public:
+		DonatedPage(const BytesOwner& data, size_t chunkSize) : MemoryPage(data, chunkSize, data.size())
+		{ }
+	};
+
+
 	class PagedBuffer::ReadLock
 	{
 	private:
@@ -36,6 +86,16 @@ namespace stingray
 	public:
 		WriteGuard(PagedBuffer& parent) : _parent(parent), _locked(false) { }
 
+		void Lock(const ICancellationToken& token)
+		{
+			switch (Wait(token))
+			{
+			case ConditionWaitResult::Broadcasted:	break;
+			case ConditionWaitResult::Cancelled:	STINGRAYKIT_THROW(OperationCancelledException());
+			case ConditionWaitResult::TimedOut:		STINGRAYKIT_THROW(TimeoutException());
+			}
+		}
+
 		ConditionWaitResult Wait(const ICancellationToken& token)
 		{
 			{
@@ -114,6 +174,36 @@ namespace stingray
 	}
 
 
+	ConstBytesOwner PagedBuffer::ReadBytes(const ICancellationToken& token)
+	{
+		MutexLock l(_mutex);
+		ReadLock rl(*this);
+
+		const u64 unreadSize = _pageSize * _pages.size() - _currentOffset - _tailSize;
+		if (unreadSize < _chunkSize)
+		{
+			_dataPushed.Wait(_mutex, token);
+			return ConstBytesOwner();
+		}
+
+		const u64 pageIndex = _currentOffset / _pageSize;
+		STINGRAYKIT_CHECK(pageIndex < _pages.size(),
+				LogicException(StringBuilder() % "Broken invariant: current offset " % _currentOffset % " gives page index " % pageIndex % " that is out of range " % _pages.size()));
+
+		const IPagePtr page = _pages[pageIndex];
+		const MemoryPagePtr memoryPage = dynamic_caster(page);
+		STINGRAYKIT_CHECK(memoryPage, NotSupportedException("Page is not in memory"));
+
+		const u64 offset = _currentOffset % _pageSize;
+		const size_t size = AlignDown<u64>(std::min(unreadSize, _pageSize - offset), _chunkSize);
+
+		_logger.Trace() << "ReadBytes: current offset: " << _currentOffset << " --> page: " << pageIndex << "/" << _pages.size() << ", offset: " << offset << ", size: " << size;
+
+		_currentOffset += size;
+		return ConstBytesOwner(ConstByteData(memoryPage->GetData(), (size_t)offset, size), MakeObjectToken(page));
+	}
+
+
 	u64 PagedBuffer::GetStorageSize() const
 	{
 		MutexLock l(_mutex);
@@ -124,14 +214,39 @@ namespace stingray
 	void PagedBuffer::Push(ConstByteData data, const ICancellationToken& token)
 	{
 		WriteGuard g(*this);
+		g.Lock(token);
 
-		switch (g.Wait(token))
+		DoPush(data, token);
+	}
+
+
+	void PagedBuffer::PushPage(const BytesOwner& page, const ICancellationToken& token)
+	{
+		STINGRAYKIT_CHECK(page.size() == _pageSize, ArgumentException("page.size()", page.size()));
+
+		WriteGuard g(*this);
+		g.Lock(token);
+
+		MutexLock l(_mutex);
+
+		if (_tailSize != 0)
 		{
-		case ConditionWaitResult::Broadcasted:	break;
-		case ConditionWaitResult::Cancelled:	STINGRAYKIT_THROW(OperationCancelledException());
-		case ConditionWaitResult::TimedOut:		STINGRAYKIT_THROW(TimeoutException());
+			_logger.Debug() << "PushPage: tail size " << _tailSize << " is non-zero, copying";
+
+			MutexUnlock ul(l);
+			DoPush(page, token);
+			return;
 		}
 
+		_logger.Debug() << "PushPage: appending page (previous total: " << _pages.size() << ")";
+
+		_pages.push_back(make_shared_ptr<DonatedPage>(page, _chunkSize));
+		_dataPushed.Broadcast();
+	}
+
+
+	void PagedBuffer::DoPush(ConstByteData data, const ICancellationToken& token)
+	{
 		_logger.Debug() << "Push(" << data.size() << ")";
 
 		MutexLock l(_mutex);
@@ -161,18 +276,23 @@ namespace stingray
 			_dataPushed.Broadcast();
 		}
 
-		std::vector<IPagePtr> newPages;
+		PagesVector newPages = TakeFreePages((data.size() - offset + _pageSize - 1) / _pageSize);
+		const size_t recycledCount = newPages.size();
 		u64 newTailSize = _tailSize;
 
 		{
 			MutexUnlock ul(l);
 
-			while (offset < data.size())
+			for (size_t index = 0; index < recycledCount; ++index)
+				newPages[index]->Recycle();
+
+			for (size_t index = 0; offset < data.size(); ++index)
 			{
-				newPages.push_back(CreatePage(_chunkSize));
+				if (index == newPages.size())
+					newPages.push_back(CreatePage(_chunkSize));
 
 				const size_t toWrite = std::min(_pageSize, (u64)data.size() - offset);
-				const size_t written = newPages.back()->Write(0, ConstByteData(data, offset, toWrite), token);
+				const size_t written = newPages[index]->Write(0, ConstByteData(data, offset, toWrite), token);
 				STINGRAYKIT_CHECK(written == toWrite, InputOutputException(StringBuilder() % "Written only " % written % " of " % toWrite));
 
 				newTailSize = _pageSize - toWrite;
@@ -182,7 +302,7 @@ namespace stingray
 
 		if (!newPages.empty())
 		{
-			_logger.Debug() << "Push: written " << newPages.size() << " new page(s) (previous total: " << _pages.size() << "), tail size: " << _tailSize << " --> " << newTailSize;
+			_logger.Debug() << "Push: written " << newPages.size() << " new page(s), " << recycledCount << " recycled (previous total: " << _pages.size() << "), tail size: " << _tailSize << " --> " << newTailSize;
 
 			_pages.insert(_pages.end(), newPages.begin(), newPages.end());
 			_tailSize = newTailSize;
@@ -194,6 +314,7 @@ namespace stingray
 
 	void PagedBuffer::Pop(u64 size)
 	{
+		PagesVector released; // destroyed after unlocking
 		MutexLock l(_mutex);
 
 		const u64 storageSize = GetStorageSize();
@@ -220,6 +341,15 @@ namespace stingray
 				logStream << ", drop " << toDrop << " of " << _pages.size() << " page(s)";
 		}
 
+		for (PagesContainer::const_iterator it = _pages.begin(); it != newBeginIt; ++it)
+		{
+			// Pages referenced by readers or owned by producer must not be overwritten
+			if (_freePages.size() < _maxFreePages && it->unique() && !dynamic_cast<const DonatedPage*>(it->get()))
+				_freePages.push_back(*it);
+			else
+				released.push_back(*it);
+		}
+
 		_pages.erase(_pages.begin(), newBeginIt);
 		_startOffset = newStartOffset;
 		_currentOffset = newCurrentOffset;
@@ -242,10 +372,11 @@ namespace stingray
 	}
 
 
-	PagedBuffer::PagedBuffer(const std::string& name, u64 pageSize, size_t chunkSize)
+	PagedBuffer::PagedBuffer(const std::string& name, u64 pageSize, size_t chunkSize, size_t maxFreePages)
 		:	_logger(s_logger, name),
 			_pageSize(pageSize),
 			_chunkSize(chunkSize),
+			_maxFreePages(maxFreePages),
 			_startOffset(0),
 			_currentOffset(0),
 			_tailSize(0),
@@ -258,4 +389,23 @@ namespace stingray
 		STINGRAYKIT_CHECK(pageSize % chunkSize == 0, ArgumentException("(pageSize, chunkSize)", MakeTuple(pageSize, chunkSize)));
 	}
 
+
+	PagedBuffer::PagesVector PagedBuffer::TakeFreePages(size_t count)
+	{
+		const size_t taken = std::min(count, _freePages.size());
+
+		PagesVector result(_freePages.end() - taken, _freePages.end());
+		_freePages.resize(_freePages.size() - taken);
+		return result;
+	}
+
+
+	MemoryPagedBuffer::MemoryPagedBuffer(const std::string& name, u64 pageSize, size_t chunkSize, size_t maxFreePages)
+		:	PagedBuffer(name, pageSize, chunkSize, maxFreePages)
+	{ }
+
+
+	MemoryPagedBuffer::IPagePtr MemoryPagedBuffer::CreatePage(size_t chunkSize)
+	{ return make_shared_ptr<MemoryPage>(BytesOwner::Create((size_t)GetPageSize()), chunkSize); }
+
 }
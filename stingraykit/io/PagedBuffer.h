@@ -8,14 +8,21 @@
 // IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
+#include <stingraykit/collection/BytesOwner.h>
 #include <stingraykit/io/IDataSource.h>
 #include <stingraykit/log/Logger.h>
+#include <stingraykit/thread/atomic.h>
 
 #include <deque>
 
 namespace stingray
 {
 
+	/**
+	 * @brief Buffer of fixed-size pages, which are created by subclass
+	 * @details If maxFreePages is not zero, pages released by Pop are kept in freelist for reuse unless some reader still references them.
+	 * Freelist is disabled by default, because reused page must be reset by IPage::Recycle, which subclass pages have to implement.
+	 */
 	class PagedBuffer : public virtual IDataSource
 	{
 	protected:
@@ -25,14 +32,39 @@ namespace stingray
 
 			virtual size_t Read(u64 offset, IDataConsumer& consumer, const ICancellationToken& token) = 0;
 			virtual size_t Write(u64 offset, ConstByteData data, const ICancellationToken& token) = 0;
+
+			/// @brief Called before page is taken from freelist to be written from the beginning again, must be overridden if freelist is enabled
+			virtual void Recycle() { }
 		};
 		STINGRAYKIT_DECLARE_PTR(IPage);
 
+		/// @brief Page in memory, which may be handed to readers without copying by ReadBytes
+		class MemoryPage : public virtual IPage
+		{
+		private:
+			const BytesOwner		_data;
+			const size_t			_chunkSize;
+			atomic<size_t>			_used;
+
+		public:
+			MemoryPage(const BytesOwner& data, size_t chunkSize, size_t used = 0);
+
+			ConstByteData GetData() const { return _data; }
+
+			size_t Read(u64 offset, IDataConsumer& consumer, const ICancellationToken& token) override;
+			size_t Write(u64 offset, ConstByteData data, const ICancellationToken& token) override;
+
+			void Recycle() override;
+		};
+		STINGRAYKIT_DECLARE_PTR(MemoryPage);
+
 	private:
 		class ReadLock;
 		class WriteGuard;
+		class DonatedPage;
 
 		using PagesContainer = std::deque<IPagePtr>;
+		using PagesVector = std::vector<IPagePtr>;
 
 	private:
 		static NamedLogger			s_logger;
@@ -41,8 +73,10 @@ namespace stingray
 
 		const u64					_pageSize;
 		const size_t				_chunkSize;
+		const size_t				_maxFreePages;
 
 		PagesContainer				_pages;
+		PagesVector					_freePages;
 
 		u64							_startOffset;
 		u64							_currentOffset;
@@ -59,17 +93,51 @@ namespace stingray
 	public:
 		void Read(IDataConsumer& consumer, const ICancellationToken& token) override;
 
+		/**
+		 * @brief Zero-copy counterpart of Read for buffers of MemoryPage pages
+		 * @details Returns all data available up to the end of current page and moves current offset past it.
+		 * Returned bytes reference the page, so they stay valid after Pop and the page is not recycled until they are released.
+		 * @returns Empty bytes if there is not a single chunk to read
+		 */
+		ConstBytesOwner ReadBytes(const ICancellationToken& token);
+
 		u64 GetStorageSize() const;
 
 		void Push(ConstByteData data, const ICancellationToken& token);
+
+		/**
+		 * @brief Appends producer's buffer as a whole page without copying
+		 * @details Page must be exactly page size, buffer is referenced until the page is popped and released by all readers.
+		 * Data is copied as with Push if previous page is not full.
+		 */
+		void PushPage(const BytesOwner& page, const ICancellationToken& token);
+
 		void Pop(u64 size);
 
 		void Seek(u64 offset);
 
 	protected:
-		PagedBuffer(const std::string& name, u64 pageSize, size_t chunkSize);
+		/// @param maxFreePages Number of popped pages kept for reuse, their IPage::Recycle must reset them
+		PagedBuffer(const std::string& name, u64 pageSize, size_t chunkSize, size_t maxFreePages = 0);
+
+		u64 GetPageSize() const { return _pageSize; }
 
 		virtual IPagePtr CreatePage(size_t chunkSize) = 0;
+
+	private:
+		void DoPush(ConstByteData data, const ICancellationToken& token);
+		PagesVector TakeFreePages(size_t count);
+	};
+
+
+	/// @brief PagedBuffer with pages allocated on heap
+	class MemoryPagedBuffer : public PagedBuffer
+	{
+	public:
+		MemoryPagedBuffer(const std::string& name, u64 pageSize, size_t chunkSize, size_t maxFreePages = 0);
+
+	protected:
+		IPagePtr CreatePage(size_t chunkSize) override;
 	};
 
 }
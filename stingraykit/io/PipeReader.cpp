@@ -11,7 +11,8 @@ namespace stingray
 {
 
 	PipeReader::PipeReader(const IPipePtr& pipe)
-		: _pipe(STINGRAYKIT_REQUIRE_NOT_NULL(pipe))
+		:	_pipe(STINGRAYKIT_REQUIRE_NOT_NULL(pipe)),
+			_reader(_pipe)
 	{ }
 
 
@@ -26,33 +27,27 @@ namespace stingray
 
 	std::string PipeReader::ReadLine(const ICancellationToken& token)
 	{
-		std::string result;
+		optional<string_view> line;
 
 		try
-		{
-			for (u8 byte = ReadByte(token); ; byte = ReadByte(token))
-			{
-				if (byte == '\n')
-					return result;
-
-				if (byte == '\r')
-				{
-					const u8 next = ReadByte(token);
-					if (next == '\n')
-						return result;
-					STINGRAYKIT_THROW(NotSupportedException());
-				}
-
-				result.push_back(byte);
-			}
-		}
+		{ line = _reader.ReadRecord("\n", token); }
 		catch (const PipeClosedException&)
 		{
-			if (result.empty())
+			const ConstByteData rest = _reader.ReadBuffered();
+			if (rest.empty())
 				throw;
+
+			line = string_view(reinterpret_cast<const char*>(rest.data()), rest.size());
 		}
 
-		return result;
+		STINGRAYKIT_CHECK(line, PipeClosedException());
+
+		string_view result = *line;
+		if (!result.empty() && result.back() == '\r')
+			result = result.substr(0, result.size() - 1);
+
+		STINGRAYKIT_CHECK(result.find('\r') == string_view::npos, NotSupportedException());
+		return result.copy();
 	}
 
 }
@@ -9,20 +9,27 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #include <stingraykit/io/IPipe.h>
+#include <stingraykit/io/RecordReader.h>
 
 namespace stingray
 {
 
+	/**
+	 * @brief Reads lines and bytes from a pipe
+	 * @details Pipe is read in blocks through RecordReader, so data, which is read ahead while looking for the end of line,
+	 * is returned by subsequent calls of any method.
+	 */
 	class PipeReader
 	{
 	private:
-		IPipePtr	_pipe;
+		IPipePtr		_pipe;
+		RecordReader	_reader;
 
 	public:
 		explicit PipeReader(const IPipePtr& pipe);
 
 		size_t Read(ByteData data, const ICancellationToken& token)
-		{ return _pipe->Read(data, token); }
+		{ return _reader.Read(data, token); }
 
 		u8 ReadByte(const ICancellationToken& token);
 
@@ -0,0 +1,148 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/RecordReader.h>
+
+#include <string.h>
+
+namespace stingray
+{
+
+	namespace
+	{
+
+		const u8* FindDelimiter(const u8* begin, const u8* end, string_view delimiter)
+		{
+			const u8 first = (u8)delimiter[0];
+			const size_t tailSize = delimiter.size() - 1;
+
+			while ((size_t)(end - begin) > tailSize)
+			{
+				const u8* const found = static_cast<const u8*>(memchr(begin, first, end - begin - tailSize));
+				if (!found)
+					return NULL;
+
+				if (memcmp(found + 1, delimiter.data() + 1, tailSize) == 0)
+					return found;
+
+				begin = found + 1;
+			}
+
+			return NULL;
+		}
+
+
+		string_view ToStringView(const u8* begin, const u8* end)
+		{ return string_view(reinterpret_cast<const char*>(begin), end - begin); }
+
+	}
+
+
+	const size_t RecordReader::DefaultBufferSize;
+
+
+	RecordReader::RecordReader(const IInputByteStreamPtr& stream, size_t bufferSize)
+		:	_stream(STINGRAYKIT_REQUIRE_NOT_NULL(stream)),
+			_buffer(ByteArray::CreateUninitialized(bufferSize)),
+			_begin(0),
+			_end(0),
+			_endOfStream(false)
+	{ STINGRAYKIT_CHECK(bufferSize != 0, ArgumentException("bufferSize")); }
+
+
+	optional<string_view> RecordReader::ReadRecord(string_view delimiter, const ICancellationToken& token)
+	{
+		STINGRAYKIT_CHECK(!delimiter.empty(), ArgumentException("delimiter"));
+
+		// Number of buffered bytes, which are known not to start the delimiter
+		size_t scanned = 0;
+
+		while (true)
+		{
+			const u8* const data = _buffer.data();
+			if (const u8* const found = FindDelimiter(data + _begin + scanned, data + _end, delimiter))
+			{
+				const string_view result = ToStringView(data + _begin, found);
+				_begin = found - data + delimiter.size();
+				return result;
+			}
+
+			// Delimiter may be split between buffered and incoming data
+			scanned = _end - _begin - std::min(_end - _begin, delimiter.size() - 1);
+
+			if (!Fill(token))
+			{
+				if (_begin == _end)
+					return null;
+
+				const string_view result = ToStringView(_buffer.data() + _begin, _buffer.data() + _end);
+				_begin = _end;
+				return result;
+			}
+		}
+	}
+
+
+	optional<string_view> RecordReader::ReadLine(const ICancellationToken& token)
+	{
+		const optional<string_view> result = ReadRecord("\n", token);
+		if (result && !result->empty() && result->back() == '\r')
+			return result->substr(0, result->size() - 1);
+		return result;
+	}
+
+
+	size_t RecordReader::Read(ByteData data, const ICancellationToken& token)
+	{
+		if (_begin == _end)
+			return _stream->Read(data, token);
+
+		const size_t count = std::min(data.size(), _end - _begin);
+		std::copy(_buffer.data() + _begin, _buffer.data() + _begin + count, data.data());
+		_begin += count;
+		return count;
+	}
+
+
+	ConstByteData RecordReader::ReadBuffered()
+	{
+		const ConstByteData result(_buffer, _begin, _end - _begin);
+		_begin = _end;
+		return result;
+	}
+
+
+	bool RecordReader::Fill(const ICancellationToken& token)
+	{
+		if (_endOfStream)
+			return false;
+
+		if (_end == _buffer.size())
+		{
+			if (_begin != 0)
+			{
+				std::copy(_buffer.data() + _begin, _buffer.data() + _end, _buffer.data());
+				_end -= _begin;
+				_begin = 0;
+			}
+			else
+				_buffer.RequireSize(2 * _buffer.size());
+		}
+
+		const size_t read = _stream->Read(ByteData(_buffer, _end), token);
+		if (read == 0)
+		{
+			STINGRAYKIT_CHECK_CANCELLATION(token);
+			_endOfStream = true;
+			return false;
+		}
+
+		_end += read;
+		return true;
+	}
+
+}
@@ -0,0 +1,70 @@
+#ifndef STINGRAYKIT_IO_RECORDREADER_H
+#define STINGRAYKIT_IO_RECORDREADER_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/IInputByteStream.h>
+#include <stingraykit/optional.h>
+#include <stingraykit/string/string_view.h>
+
+namespace stingray
+{
+
+	/**
+	 * @brief Buffered reader of delimited records, e.g. lines, from IInputByteStream
+	 * @details Stream is read in blocks of the buffer size, and delimiters are searched for in the buffer with memchr instead of reading
+	 * the stream byte by byte. Returned records point into the buffer and stay valid until the next call to the reader.
+	 * Buffer grows to fit records, which are longer than it. Stream returning no data is treated as the end of it.
+	 * @par Example:
+	 * @code
+	 * RecordReader reader(stream);
+	 * for (optional<string_view> line = reader.ReadLine(token); line; line = reader.ReadLine(token))
+	 *     Parse(*line);
+	 * @endcode
+	 */
+	class RecordReader
+	{
+		STINGRAYKIT_NONCOPYABLE(RecordReader);
+
+	public:
+		static const size_t DefaultBufferSize = 64 * 1024;
+
+	private:
+		IInputByteStreamPtr		_stream;
+		ByteArray				_buffer;
+		size_t					_begin;
+		size_t					_end;
+		bool					_endOfStream;
+
+	public:
+		explicit RecordReader(const IInputByteStreamPtr& stream, size_t bufferSize = DefaultBufferSize);
+
+		/**
+		 * @brief Reads record terminated by delimiter, which may be longer than one byte
+		 * @details Delimiter is consumed, but not included into the record. The last record of the stream may lack delimiter.
+		 * @returns Record or null at the end of the stream
+		 */
+		optional<string_view> ReadRecord(string_view delimiter, const ICancellationToken& token = DummyCancellationToken());
+
+		/** Only \n and \r\n line endings are supported */
+		optional<string_view> ReadLine(const ICancellationToken& token = DummyCancellationToken());
+
+		/// @brief Reads raw data, buffered data is returned first
+		size_t Read(ByteData data, const ICancellationToken& token = DummyCancellationToken());
+
+		/// @brief Consumes and returns data, which is already buffered, without reading the stream
+		ConstByteData ReadBuffered();
+
+	private:
+		bool Fill(const ICancellationToken& token);
+	};
+	STINGRAYKIT_DECLARE_PTR(RecordReader);
+
+}
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef STINGRAYKIT_IO_ROPEBYTESTREAM_H
+#define STINGRAYKIT_IO_ROPEBYTESTREAM_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/ByteRope.h>
+#include <stingraykit/io/IByteStream.h>
+
+namespace stingray
+{
+
+	/**
+	 * @brief IByteStream over ByteRope
+	 * @details Unlike ChunkedMemoryByteStream, seeking is O(1) and reading looks the position up in O(log n) of the number of segments.
+	 * Segments are immutable and may be shared, so data can be written at the end of the stream only: Write appends a copy of data,
+	 * Append appends a segment without copying it.
+	 */
+	class RopeByteStream final : public virtual IByteStream
+	{
+	private:
+		ByteRope		_data;
+		u64				_offset;
+
+	public:
+		explicit RopeByteStream(const ByteRope& data = ByteRope())
+			: _data(data), _offset(0)
+		{ }
+
+		const ByteRope& GetData() const { return _data; }
+
+		/// @brief Appends segment to the end of the stream without copying it, doesn't move current position
+		void Append(const ConstByteArray& segment)
+		{ _data.Append(segment); }
+
+		u64 Read(ByteData data, const ICancellationToken& token = DummyCancellationToken()) override
+		{
+			const size_t count = _data.CopyTo(_offset, data);
+			_offset += count;
+			return count;
+		}
+
+		u64 Write(ConstByteData data, const ICancellationToken& token = DummyCancellationToken()) override
+		{
+			STINGRAYKIT_CHECK(_offset == _data.size(), NotImplementedException());
+
+			ByteArray segment(ByteArray::CreateUninitialized(data.size()));
+			std::copy(data.data(), data.data() + data.size(), segment.data());
+
+			_data.Append(segment);
+			_offset += data.size();
+			return data.size();
+		}
+
+		void Seek(s64 offset, SeekMode mode = SeekMode::Begin) override
+		{
+			switch (mode)
+			{
+			case SeekMode::Begin:	break;
+			case SeekMode::Current:	offset += static_cast<s64>(_offset); break;
+			case SeekMode::End:		offset += static_cast<s64>(_data.size()); break;
+			default:				STINGRAYKIT_THROW(ArgumentException("mode")); break;
+			}
+
+			STINGRAYKIT_CHECK(offset >= 0 && (u64)offset <= _data.size(), IndexOutOfRangeException(offset, _data.size()));
+			_offset = offset;
+		}
+
+		u64 Tell() const override
+		{ return _offset; }
+	};
+	STINGRAYKIT_DECLARE_PTR(RopeByteStream);
+
+}
+
+#endif
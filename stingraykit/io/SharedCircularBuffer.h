@@ -10,11 +10,18 @@
 #include <stingraykit/io/BithreadCircularBuffer.h>
 
 #include <stingraykit/thread/ConditionVariable.h>
+#include <stingraykit/thread/atomic/AtomicInt.h>
 #include <stingraykit/ExceptionPtr.h>
 
 namespace stingray
 {
 
+	/**
+	 * @brief Circular buffer shared between one reader and one writer, which also carries end of data and exception
+	 * @details Data goes through BithreadCircularBuffer positions without locking: ReadLock and WriteLock only mark the
+	 * side as active and wait on the buffer itself. End of data and exception are published after the last data and are
+	 * readable without lock too, the mutex only guards the exception object and state of the users, e.g. packet queue.
+	 */
 	class SharedCircularBuffer
 	{
 	public:
@@ -26,30 +33,44 @@ namespace stingray
 
 	private:
 		BithreadCircularBuffer	_buffer;
-		bool					_eod;
-		ExceptionPtr			_exception;
+
+		mutable AtomicU32::Type	_eod;
+		mutable AtomicU32::Type	_failed;
 
 		Mutex					_bufferMutex;
-		ConditionVariable		_bufferEmpty;
-		ConditionVariable		_bufferFull;
+		ExceptionPtr			_exception;
 
-		bool					_activeRead;
-		size_t					_activeWrites;
+		AtomicU32::Type			_activeRead;
+		AtomicU32::Type			_activeWrite;
 
 	public:
 		explicit SharedCircularBuffer(size_t size)
 			:	_buffer(size),
-				_eod(false),
-				_activeRead(false),
-				_activeWrites(0)
+				_eod(0),
+				_failed(0),
+				_activeRead(0),
+				_activeWrite(0)
 		{ }
 
 		explicit SharedCircularBuffer(const BytesOwner& storage)
 			:	_buffer(storage),
-				_eod(false),
-				_activeRead(false),
-				_activeWrites(0)
+				_eod(0),
+				_failed(0),
+				_activeRead(0),
+				_activeWrite(0)
 		{ }
+
+		SharedCircularBuffer(const BytesOwner& storage, MirroredStorageTag tag)
+			:	_buffer(storage, tag),
+				_eod(0),
+				_failed(0),
+				_activeRead(0),
+				_activeWrite(0)
+		{ }
+
+	private:
+		bool IsEndOfData() const	{ return AtomicU32::Load(_eod, MemoryOrderAcquire); }
+		bool HasException() const	{ return AtomicU32::Load(_failed, MemoryOrderAcquire); }
 	};
 	STINGRAYKIT_DECLARE_PTR(SharedCircularBuffer);
 
@@ -69,8 +90,8 @@ namespace stingray
 		size_t GetFreeSize() const		{ return _parent._buffer.GetFreeSize(); }
 		size_t GetStorageSize() const	{ return _parent._buffer.GetTotalSize(); }
 
-		bool IsEndOfData() const				{ return _parent._eod; }
-		bool HasException() const				{ return _parent._exception.is_initialized(); }
+		bool IsEndOfData() const				{ return _parent.IsEndOfData(); }
+		bool HasException() const				{ return _parent.HasException(); }
 
 		void RethrowExceptionIfAny(ToolkitWhere where) const
 		{
@@ -82,9 +103,6 @@ namespace stingray
 
 	class SharedCircularBuffer::BufferLock : public ConstBufferLock
 	{
-		friend class SharedCircularBuffer::ReadLock;
-		friend class SharedCircularBuffer::WriteLock;
-
 	private:
 		SharedCircularBuffer&	_parent;
 
@@ -93,30 +111,38 @@ namespace stingray
 
 		void SetEndOfData()
 		{
-			STINGRAYKIT_CHECK(!_parent._exception, InvalidOperationException("Already got exception!"));
+			STINGRAYKIT_CHECK(!_parent.HasException(), InvalidOperationException("Already got exception!"));
 
-			_parent._eod = true;
-			_parent._bufferEmpty.Broadcast();
+			AtomicU32::Store(_parent._eod, 1, MemoryOrderRelease);
+			_parent._buffer.WakeReader();
 		}
 
 		void SetException(const std::exception& ex, const ICancellationToken& token)
 		{
-			STINGRAYKIT_CHECK(!_parent._eod, InvalidOperationException("Already got EOD!"));
+			STINGRAYKIT_CHECK(!_parent.IsEndOfData(), InvalidOperationException("Already got EOD!"));
 
 			_parent._exception = MakeExceptionPtr(ex);
-			_parent._bufferEmpty.Broadcast();
+			AtomicU32::Store(_parent._failed, 1, MemoryOrderRelease);
+			_parent._buffer.WakeReader();
 		}
 
 		void Clear()
 		{
-			STINGRAYKIT_CHECK(!_parent._activeRead, InvalidOperationException("Simultaneous Read() and Clear()!"));
-			STINGRAYKIT_CHECK(_parent._activeWrites == 0, InvalidOperationException("Simultaneous Process() and Clear()!"));
+			// Both sides are taken for the time of clearing, so that reader or writer started meanwhile fails instead of using stale positions
+			STINGRAYKIT_CHECK(AtomicU32::CompareAndExchange(_parent._activeRead, 0, 1) == 0, InvalidOperationException("Simultaneous Read() and Clear()!"));
+			if (AtomicU32::CompareAndExchange(_parent._activeWrite, 0, 1) != 0)
+			{
+				AtomicU32::Store(_parent._activeRead, 0);
+				STINGRAYKIT_THROW(InvalidOperationException("Simultaneous Process() and Clear()!"));
+			}
 
 			_parent._buffer.Clear();
-			_parent._eod = false;
+			AtomicU32::Store(_parent._eod, 0);
+			AtomicU32::Store(_parent._failed, 0);
 			_parent._exception.reset();
 
-			_parent._bufferFull.Broadcast();
+			AtomicU32::Store(_parent._activeWrite, 0);
+			AtomicU32::Store(_parent._activeRead, 0);
 		}
 	};
 
@@ -131,52 +157,66 @@ namespace stingray
 	};
 
 
+	/// @brief Marks the only reader of buffer, does not lock
 	class SharedCircularBuffer::ReadLock
 	{
 	private:
 		SharedCircularBuffer&	_parent;
 
 	public:
-		ReadLock(BufferLock& lock) : _parent(lock._parent)
+		ReadLock(SharedCircularBuffer& parent) : _parent(parent)
+		{ STINGRAYKIT_CHECK(AtomicU32::CompareAndExchange(_parent._activeRead, 0, 1) == 0, InvalidOperationException("Simultaneous Read()!")); }
+
+		~ReadLock()
+		{ AtomicU32::Store(_parent._activeRead, 0); }
+
+		/// @note Check it before Read(): data is pushed before end of data is set, so all of it is visible then
+		bool IsEndOfData() const	{ return _parent.IsEndOfData(); }
+		bool HasException() const	{ return _parent.HasException(); }
+
+		void RethrowExceptionIfAny(ToolkitWhere where) const
 		{
-			STINGRAYKIT_CHECK(!_parent._activeRead, InvalidOperationException("Simultaneous Read()!"));
-			_parent._activeRead = true;
+			if (HasException())
+				ConstBufferLock(_parent).RethrowExceptionIfAny(where);
 		}
 
-		~ReadLock()
-		{ _parent._activeRead = false; }
+		size_t GetDataSize() const
+		{ return _parent._buffer.GetDataSize(); }
 
 		BithreadCircularBuffer::Reader Read()
 		{ return _parent._buffer.Read(); }
 
-		ConditionWaitResult WaitEmpty(const ICancellationToken& token) const
-		{ return _parent._bufferEmpty.Wait(_parent._bufferMutex, token); }
-
-		void BroadcastFull()
-		{ _parent._bufferFull.Broadcast(); }
+		/// @brief Waits for at least dataSize bytes of data, end of data or exception
+		ConditionWaitResult WaitEmpty(size_t dataSize, const ICancellationToken& token)
+		{ return _parent._buffer.WaitEmpty(dataSize, token); }
 	};
 
 
+	/// @brief Marks the only writer of buffer, does not lock
 	class SharedCircularBuffer::WriteLock
 	{
 	private:
 		SharedCircularBuffer&	_parent;
 
 	public:
-		WriteLock(BufferLock& lock) : _parent(lock._parent)
-		{ ++_parent._activeWrites; }
+		WriteLock(SharedCircularBuffer& parent) : _parent(parent)
+		{ STINGRAYKIT_CHECK(AtomicU32::CompareAndExchange(_parent._activeWrite, 0, 1) == 0, InvalidOperationException("Simultaneous Process()!")); }
 
 		~WriteLock()
-		{ --_parent._activeWrites; }
+		{ AtomicU32::Store(_parent._activeWrite, 0); }
+
+		bool IsEndOfData() const	{ return _parent.IsEndOfData(); }
+		bool HasException() const	{ return _parent.HasException(); }
+
+		size_t GetFreeSize() const		{ return _parent._buffer.GetFreeSize(); }
+		size_t GetStorageSize() const	{ return _parent._buffer.GetTotalSize(); }
 
 		BithreadCircularBuffer::Writer Write()
 		{ return _parent._buffer.Write(); }
 
-		ConditionWaitResult WaitFull(const ICancellationToken& token) const
-		{ return _parent._bufferFull.Wait(_parent._bufferMutex, token); }
-
-		void BroadcastEmpty()
-		{ _parent._bufferEmpty.Broadcast(); }
+		/// @brief Waits for at least freeSize bytes of free space
+		ConditionWaitResult WaitFull(size_t freeSize, const ICancellationToken& token)
+		{ return _parent._buffer.WaitFull(freeSize, token); }
 	};
 
 
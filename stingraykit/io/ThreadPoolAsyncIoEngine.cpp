@@ -0,0 +1,109 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/ThreadPoolAsyncIoEngine.h>
+
+#include <stingraykit/function/bind.h>
+#include <stingraykit/io/IPositionalByteStream.h>
+#include <stingraykit/io/ISyncableByteStream.h>
+#include <stingraykit/string/ToString.h>
+
+namespace stingray
+{
+
+	STINGRAYKIT_DEFINE_NAMED_LOGGER(ThreadPoolAsyncIoEngine);
+
+	const size_t ThreadPoolAsyncIoEngine::DefaultThreadsCount;
+
+
+	ThreadPoolAsyncIoEngine::ThreadPoolAsyncIoEngine(const std::string& name, size_t threadsCount)
+	{
+		STINGRAYKIT_CHECK(threadsCount != 0, ArgumentException("threadsCount", threadsCount));
+
+		for (size_t i = 0; i < threadsCount; ++i)
+			_threads.push_back(make_shared_ptr<Thread>(StringBuilder() % name % "_" % i, Bind(&ThreadPoolAsyncIoEngine::ThreadFunc, this, _1)));
+	}
+
+
+	ThreadPoolAsyncIoEngine::~ThreadPoolAsyncIoEngine()
+	{
+		_threads.clear();
+
+		if (_requests.empty())
+			return;
+
+		s_logger.Warning() << "Destroying with " << _requests.size() << " requests pending, cancelling them";
+
+		const ExceptionPtr exception = MakeExceptionPtr(OperationCancelledException());
+		for (Requests::const_iterator it = _requests.begin(); it != _requests.end(); ++it)
+			STINGRAYKIT_TRY_TO_LOGGER(s_logger, "Completion handler failed", it->Handler(0, exception));
+	}
+
+
+	void ThreadPoolAsyncIoEngine::SubmitWrite(const IByteStreamPtr& stream, u64 offset, ConstByteData data, const CompletionHandler& handler)
+	{ Submit(Request(stream, offset, data, handler)); }
+
+
+	void ThreadPoolAsyncIoEngine::SubmitSync(const IByteStreamPtr& stream, const CompletionHandler& handler)
+	{ Submit(Request(stream, null, ConstByteData(), handler)); }
+
+
+	void ThreadPoolAsyncIoEngine::Submit(const Request& request)
+	{
+		MutexLock l(_mutex);
+		_requests.push_back(request);
+		_cond.Broadcast();
+	}
+
+
+	void ThreadPoolAsyncIoEngine::ThreadFunc(const ICancellationToken& token)
+	{
+		MutexLock l(_mutex);
+		while (token)
+		{
+			if (_requests.empty())
+			{
+				_cond.Wait(_mutex, token);
+				continue;
+			}
+
+			const Request request = _requests.front();
+			_requests.pop_front();
+
+			MutexUnlock ul(l);
+			Execute(request, token);
+		}
+	}
+
+
+	void ThreadPoolAsyncIoEngine::Execute(const Request& request, const ICancellationToken& token)
+	{
+		u64 written = 0;
+		ExceptionPtr exception;
+
+		try
+		{
+			if (!request.Offset)
+			{
+				if (const ISyncableByteStreamPtr syncable = dynamic_caster(request.Stream))
+					syncable->Sync();
+			}
+			else if (const IPositionalByteStreamPtr positional = dynamic_caster(request.Stream))
+				written = positional->WriteAt(*request.Offset, request.Data, token);
+			else
+			{
+				request.Stream->Seek((s64)*request.Offset, SeekMode::Begin);
+				written = request.Stream->Write(request.Data, token);
+			}
+		}
+		catch (const std::exception& ex)
+		{ exception = MakeExceptionPtr(ex); }
+
+		STINGRAYKIT_TRY_TO_LOGGER(s_logger, "Completion handler failed", request.Handler(written, exception));
+	}
+
+}
@@ -0,0 +1,76 @@
+#ifndef STINGRAYKIT_IO_THREADPOOLASYNCIOENGINE_H
+#define STINGRAYKIT_IO_THREADPOOLASYNCIOENGINE_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/IAsyncIoEngine.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/thread/ConditionVariable.h>
+#include <stingraykit/thread/Thread.h>
+#include <stingraykit/optional.h>
+
+#include <deque>
+#include <vector>
+
+namespace stingray
+{
+
+	/**
+	 * @brief Executes blocking stream operations on a fixed number of threads
+	 * @details Positional streams are written with WriteAt, others are seeked before writing.
+	 */
+	class ThreadPoolAsyncIoEngine : public virtual IAsyncIoEngine
+	{
+		STINGRAYKIT_NONCOPYABLE(ThreadPoolAsyncIoEngine);
+
+	private:
+		struct Request
+		{
+			IByteStreamPtr			Stream;
+			optional<u64>			Offset;		// not set for sync
+			ConstByteData			Data;
+			CompletionHandler		Handler;
+
+			Request(const IByteStreamPtr& stream, const optional<u64>& offset, ConstByteData data, const CompletionHandler& handler)
+				: Stream(stream), Offset(offset), Data(data), Handler(handler)
+			{ }
+		};
+
+		using Requests = std::deque<Request>;
+		using Threads = std::vector<ThreadPtr>;
+
+	public:
+		static const size_t			DefaultThreadsCount = 4;
+
+	private:
+		static NamedLogger			s_logger;
+
+		Mutex						_mutex;
+		ConditionVariable			_cond;
+		Requests					_requests;
+
+		Threads						_threads;
+
+	public:
+		explicit ThreadPoolAsyncIoEngine(const std::string& name, size_t threadsCount = DefaultThreadsCount);
+		~ThreadPoolAsyncIoEngine() override;
+
+		void SubmitWrite(const IByteStreamPtr& stream, u64 offset, ConstByteData data, const CompletionHandler& handler) override;
+		void SubmitSync(const IByteStreamPtr& stream, const CompletionHandler& handler) override;
+
+	private:
+		void Submit(const Request& request);
+
+		void ThreadFunc(const ICancellationToken& token);
+		static void Execute(const Request& request, const ICancellationToken& token);
+	};
+	STINGRAYKIT_DECLARE_PTR(ThreadPoolAsyncIoEngine);
+
+}
+
+#endif
@@ -0,0 +1,194 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/posix/FdPipe.h>
+
+#include <stingraykit/string/ToString.h>
+#include <stingraykit/thread/CancellationRegistrator.h>
+#include <stingraykit/SystemException.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace stingray
+{
+
+	namespace
+	{
+
+		void SetNonBlocking(int fd)
+		{
+			const int flags = ::fcntl(fd, F_GETFL);
+			STINGRAYKIT_CHECK(flags >= 0, SystemException("fcntl"));
+			STINGRAYKIT_CHECK(::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0, SystemException("fcntl"));
+		}
+
+	}
+
+
+	class FdPipe::Waker final : public ICancellationHandler
+	{
+		STINGRAYKIT_NONCOPYABLE(Waker);
+
+	private:
+		int		_fds[2];
+
+	public:
+		Waker()
+		{
+			STINGRAYKIT_CHECK(::pipe(_fds) == 0, SystemException("pipe"));
+
+			for (size_t i = 0; i < 2; ++i)
+				try
+				{
+					SetNonBlocking(_fds[i]);
+					STINGRAYKIT_CHECK(::fcntl(_fds[i], F_SETFD, FD_CLOEXEC) == 0, SystemException("fcntl"));
+				}
+				catch (...)
+				{
+					::close(_fds[0]);
+					::close(_fds[1]);
+					throw;
+				}
+		}
+
+		~Waker() override
+		{
+			::close(_fds[0]);
+			::close(_fds[1]);
+		}
+
+		int GetFd() const { return _fds[0]; }
+
+		void Cancel() override
+		{
+			const u8 byte = 0;
+			// Pipe is full only if it was already woken up
+			while (::write(_fds[1], &byte, sizeof(byte)) < 0 && errno == EINTR)
+				;
+		}
+
+		void Reset() override
+		{
+			u8 buffer[64];
+			while (true)
+			{
+				const ssize_t res = ::read(_fds[0], buffer, sizeof(buffer));
+				if (res <= 0 && (res == 0 || errno != EINTR))
+					break;
+			}
+		}
+	};
+
+
+	FdPipe::FdPipe(int fd, bool ownsFd)
+		:	_fd(fd),
+			_ownsFd(ownsFd)
+	{
+		try
+		{
+			STINGRAYKIT_CHECK(fd >= 0, ArgumentException("fd", fd));
+			SetNonBlocking(fd);
+
+			_readWaker.reset(new Waker());
+			_writeWaker.reset(new Waker());
+		}
+		catch (...)
+		{
+			if (ownsFd && fd >= 0)
+				::close(fd);
+			throw;
+		}
+	}
+
+
+	FdPipe::~FdPipe()
+	{
+		if (_ownsFd)
+			::close(_fd);
+	}
+
+
+	u64 FdPipe::Read(ByteData data, const ICancellationToken& token)
+	{
+		if (data.empty())
+			return 0;
+
+		while (true)
+		{
+			const ssize_t res = ::read(_fd, data.data(), data.size());
+			if (res > 0)
+				return (u64)res;
+
+			STINGRAYKIT_CHECK(res != 0, PipeClosedException());
+
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				Wait(POLLIN, *_readWaker, token);
+			else if (errno != EINTR)
+				STINGRAYKIT_THROW(SystemException("read"));
+		}
+	}
+
+
+	u64 FdPipe::Write(ConstByteData data, const ICancellationToken& token)
+	{
+		if (data.empty())
+			return 0;
+
+		while (true)
+		{
+			const ssize_t res = ::write(_fd, data.data(), data.size());
+			if (res >= 0)
+				return (u64)res;
+
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				Wait(POLLOUT, *_writeWaker, token);
+			else if (errno == EPIPE)
+				STINGRAYKIT_THROW(PipeClosedException());
+			else if (errno != EINTR)
+				STINGRAYKIT_THROW(SystemException("write"));
+		}
+	}
+
+
+	bool FdPipe::Peek(const ICancellationToken& token)
+	{
+		pollfd pfd = { _fd, POLLIN, 0 };
+		while (true)
+		{
+			const int res = ::poll(&pfd, 1, 0);
+			if (res >= 0)
+				return res != 0;
+
+			STINGRAYKIT_CHECK(errno == EINTR, SystemException("poll"));
+		}
+	}
+
+
+	void FdPipe::Wait(short events, Waker& waker, const ICancellationToken& token)
+	{
+		const CancellationRegistrator registrator(token, waker);
+		STINGRAYKIT_CHECK_CANCELLATION(token);
+
+		pollfd pfds[2] = { { _fd, events, 0 }, { waker.GetFd(), POLLIN, 0 } };
+
+		const optional<TimeDuration> timeout = token.GetTimeout();
+		const int timeoutMs = timeout ? (int)std::min<s64>(std::max<s64>(timeout->GetMilliseconds(), 0) + 1, std::numeric_limits<int>::max()) : -1;
+
+		int res;
+		while ((res = ::poll(pfds, 2, timeoutMs)) < 0)
+			STINGRAYKIT_CHECK(errno == EINTR, SystemException("poll"));
+
+		if (pfds[1].revents)
+			waker.Reset();
+
+		STINGRAYKIT_CHECK_CANCELLATION(token);
+	}
+
+}
@@ -0,0 +1,58 @@
+#ifndef STINGRAYKIT_IO_POSIX_FDPIPE_H
+#define STINGRAYKIT_IO_POSIX_FDPIPE_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/IPipe.h>
+#include <stingraykit/unique_ptr.h>
+
+namespace stingray
+{
+
+	/**
+	 * @brief IPipe over file descriptor of a pipe, socket or character device
+	 * @details Descriptor is switched to non-blocking mode, Read and Write wait for it with poll, which is woken up by cancellation of the token.
+	 * One thread may read while another one writes. Read throws PipeClosedException on end of file. Writing to a pipe without readers
+	 * raises SIGPIPE unless it is ignored by the application, then PipeClosedException is thrown.
+	 */
+	class FdPipe : public virtual IPipe
+	{
+		STINGRAYKIT_NONCOPYABLE(FdPipe);
+
+	private:
+		class Waker;
+		STINGRAYKIT_DECLARE_UNIQ_PTR(Waker);
+
+	private:
+		const int			_fd;
+		const bool			_ownsFd;
+
+		WakerUniqPtr		_readWaker;
+		WakerUniqPtr		_writeWaker;
+
+	public:
+		/// @param ownsFd Closes descriptor on destruction
+		explicit FdPipe(int fd, bool ownsFd = true);
+		~FdPipe() override;
+
+		int GetFd() const { return _fd; }
+
+		u64 Read(ByteData data, const ICancellationToken& token = DummyCancellationToken()) override;
+		u64 Write(ConstByteData data, const ICancellationToken& token = DummyCancellationToken()) override;
+
+		/// @returns True if Read would not block
+		bool Peek(const ICancellationToken& token = DummyCancellationToken()) override;
+
+	private:
+		void Wait(short events, Waker& waker, const ICancellationToken& token);
+	};
+	STINGRAYKIT_DECLARE_PTR(FdPipe);
+
+}
+
+#endif
@@ -0,0 +1,397 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/posix/FileByteStream.h>
+
+#include <stingraykit/function/bind.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/ScopeExit.h>
+#include <stingraykit/SystemException.h>
+#include <stingraykit/math.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace stingray
+{
+
+	namespace
+	{
+
+		int ToAdvice(FileAccessHint hint)
+		{
+			switch (hint)
+			{
+			case FileAccessHint::Normal:		return POSIX_FADV_NORMAL;
+			case FileAccessHint::Sequential:	return POSIX_FADV_SEQUENTIAL;
+			case FileAccessHint::Random:		return POSIX_FADV_RANDOM;
+			case FileAccessHint::WillNeed:		return POSIX_FADV_WILLNEED;
+			case FileAccessHint::DontNeed:		return POSIX_FADV_DONTNEED;
+			case FileAccessHint::NoReuse:		return POSIX_FADV_NOREUSE;
+			}
+
+			STINGRAYKIT_THROW(ArgumentException("hint", hint));
+		}
+
+	}
+
+
+	FileByteStream::Config::Config()
+		:	_write(false),
+			_create(false),
+			_truncate(false),
+			_mmapRead(false),
+			_directIo(false),
+			_directIoAlignment(0),
+			_directIoBufferSize(0),
+			_accessHint(FileAccessHint::Normal)
+	{ }
+
+
+	FileByteStream::Config& FileByteStream::Config::EnableWrite()
+	{
+		STINGRAYKIT_CHECK(!_mmapRead, "Mmap read mode is available only for read-only files!");
+		_write = true;
+		return *this;
+	}
+
+
+	FileByteStream::Config& FileByteStream::Config::EnableCreate()
+	{
+		EnableWrite();
+		_create = true;
+		return *this;
+	}
+
+
+	FileByteStream::Config& FileByteStream::Config::EnableTruncate()
+	{
+		EnableWrite();
+		_truncate = true;
+		return *this;
+	}
+
+
+	FileByteStream::Config& FileByteStream::Config::EnableMmapRead()
+	{
+		STINGRAYKIT_CHECK(!_write, "Mmap read mode is available only for read-only files!");
+		STINGRAYKIT_CHECK(!_directIo, "Mmap read mode can't be combined with direct I/O!");
+		_mmapRead = true;
+		return *this;
+	}
+
+
+	FileByteStream::Config& FileByteStream::Config::EnableDirectIo(size_t alignment, size_t bufferSize)
+	{
+		STINGRAYKIT_CHECK(!_mmapRead, "Mmap read mode can't be combined with direct I/O!");
+		STINGRAYKIT_CHECK(alignment != 0 && (alignment & (alignment - 1)) == 0, ArgumentException("alignment", alignment));
+		STINGRAYKIT_CHECK(bufferSize != 0 && bufferSize % alignment == 0, ArgumentException("bufferSize", bufferSize));
+		_directIo = true;
+		_directIoAlignment = alignment;
+		_directIoBufferSize = bufferSize;
+		return *this;
+	}
+
+
+	FileByteStream::Config& FileByteStream::Config::AccessHint(FileAccessHint accessHint)
+	{ _accessHint = accessHint; return *this; }
+
+
+	std::string FileByteStream::Config::ToString() const
+	{
+		return StringBuilder() % "FileByteStream::Config { " % (_write ? "ReadWrite" : "ReadOnly") % (_create ? ", Create" : "") % (_truncate ? ", Truncate" : "")
+				% (_mmapRead ? ", MmapRead" : "") % (_directIo ? StringBuilder() % ", DirectIo: " % _directIoAlignment % "/" % _directIoBufferSize : std::string())
+				% ", AccessHint: " % _accessHint % " }";
+	}
+
+
+	FileByteStream::FileByteStream(const std::string& path, const Config& config)
+		:	_path(path),
+			_config(config),
+			_fd(-1),
+			_position(0),
+			_mapping(null),
+			_mappingSize(0),
+			_staging(null),
+			_stagingOffset(0),
+			_stagingSize(0)
+	{
+		int flags = O_CLOEXEC | (config.WriteEnabled() ? O_RDWR : O_RDONLY);
+		if (config.CreateEnabled())
+			flags |= O_CREAT;
+		if (config.TruncateEnabled())
+			flags |= O_TRUNC;
+		if (config.DirectIoEnabled())
+			flags |= O_DIRECT;
+
+		_fd = ::open(path.c_str(), flags, 0644);
+		if (_fd < 0)
+			STINGRAYKIT_THROW_SYSTEM_EXCEPTION("open", path, errno);
+
+		try
+		{
+			if (config.AccessHint() != FileAccessHint::Normal)
+				Advise(0, 0, config.AccessHint());
+
+			if (config.MmapReadEnabled())
+			{
+				const u64 size = GetSize();
+				STINGRAYKIT_CHECK(size <= std::numeric_limits<size_t>::max(), NotSupportedException("File is too large to be mapped"));
+
+				if (size != 0)
+				{
+					void* const mapping = ::mmap(NULL, (size_t)size, PROT_READ, MAP_SHARED, _fd, 0);
+					STINGRAYKIT_CHECK(mapping != MAP_FAILED, SystemException("mmap", path, errno));
+					_mapping = static_cast<const u8*>(mapping);
+					_mappingSize = (size_t)size;
+				}
+			}
+
+			if (config.DirectIoEnabled())
+			{
+				void* staging = null;
+				const int res = ::posix_memalign(&staging, config.DirectIoAlignment(), config.DirectIoBufferSize());
+				STINGRAYKIT_CHECK(res == 0, SystemException("posix_memalign", res));
+				_staging = static_cast<u8*>(staging);
+			}
+		}
+		catch (...)
+		{
+			Close();
+			throw;
+		}
+	}
+
+
+	FileByteStream::~FileByteStream()
+	{
+		STINGRAYKIT_TRY("Can't flush staged data of " + _path, FlushStaging());
+		Close();
+	}
+
+
+	u64 FileByteStream::Read(ByteData data, const ICancellationToken& token)
+	{
+		const u64 read = DoRead(_position, data);
+		_position += read;
+		return read;
+	}
+
+
+	u64 FileByteStream::Write(ConstByteData data, const ICancellationToken& token)
+	{
+		const u64 written = DoWrite(_position, data);
+		_position += written;
+		return written;
+	}
+
+
+	u64 FileByteStream::ReadAt(u64 offset, ByteData data, const ICancellationToken& token)
+	{ return DoRead(offset, data); }
+
+
+	u64 FileByteStream::WriteAt(u64 offset, ConstByteData data, const ICancellationToken& token)
+	{ return DoWrite(offset, data); }
+
+
+	void FileByteStream::Seek(s64 offset, SeekMode mode)
+	{
+		s64 newPosition;
+
+		switch (mode)
+		{
+		case SeekMode::Begin:
+			newPosition = offset;
+			break;
+
+		case SeekMode::Current:
+			newPosition = (s64)_position + offset;
+			break;
+
+		case SeekMode::End:
+			newPosition = (s64)GetSize() + offset;
+			break;
+
+		default:
+			STINGRAYKIT_THROW(NotImplementedException());
+		}
+
+		STINGRAYKIT_CHECK(newPosition >= 0, IndexOutOfRangeException(newPosition, 0, 0));
+		_position = (u64)newPosition;
+	}
+
+
+	u64 FileByteStream::Tell() const
+	{ return _position; }
+
+
+	void FileByteStream::Sync()
+	{
+		FlushStaging();
+
+		while (::fdatasync(_fd) != 0)
+			if (errno != EINTR)
+				STINGRAYKIT_THROW_SYSTEM_EXCEPTION("fdatasync", _path, errno);
+	}
+
+
+	u64 FileByteStream::GetSize() const
+	{
+		struct stat st;
+		STINGRAYKIT_CHECK(::fstat(_fd, &st) == 0, SystemException("fstat", _path, errno));
+		return _stagingSize != 0 ? std::max<u64>(st.st_size, _stagingOffset + _stagingSize) : st.st_size;
+	}
+
+
+	void FileByteStream::Advise(u64 offset, u64 length, FileAccessHint hint)
+	{
+		const int res = ::posix_fadvise(_fd, (off_t)offset, (off_t)length, ToAdvice(hint));
+		STINGRAYKIT_CHECK(res == 0, SystemException("posix_fadvise", _path, res));
+	}
+
+
+	void FileByteStream::Close()
+	{
+		if (_staging)
+			::free(_staging);
+
+		if (_mapping)
+			::munmap(const_cast<u8*>(_mapping), _mappingSize);
+
+		::close(_fd);
+	}
+
+
+	u64 FileByteStream::DoRead(u64 offset, ByteData data)
+	{
+		if (offset < _mappingSize)
+		{
+			const size_t size = std::min<size_t>(data.size(), _mappingSize - offset);
+			::memcpy(data.data(), _mapping + offset, size);
+			return size;
+		}
+
+		if (!_staging)
+			return ReadFile(offset, data);
+
+		// Buffers of callers are generally not aligned, so reading goes through page cache
+		FlushStaging();
+		SetDirectIo(false);
+		const ScopeExitInvoker sei(Bind(&FileByteStream::SetDirectIo, this, true));
+
+		return ReadFile(offset, data);
+	}
+
+
+	u64 FileByteStream::DoWrite(u64 offset, ConstByteData data)
+	{
+		if (!_staging)
+			return WriteFile(offset, data);
+
+		if (_stagingSize != 0 && offset != _stagingOffset + _stagingSize)
+			FlushStaging();
+
+		if (_stagingSize == 0)
+		{
+			const size_t alignment = _config.DirectIoAlignment();
+			if (offset % alignment != 0)
+			{
+				const size_t headSize = std::min<u64>(data.size(), AlignUp<u64>(offset, alignment) - offset);
+				WriteThroughCache(offset, ConstByteData(data, 0, headSize));
+				return headSize;
+			}
+
+			_stagingOffset = offset;
+		}
+
+		const size_t size = std::min(data.size(), _config.DirectIoBufferSize() - _stagingSize);
+		::memcpy(_staging + _stagingSize, data.data(), size);
+		_stagingSize += size;
+
+		if (_stagingSize == _config.DirectIoBufferSize())
+			FlushStaging();
+
+		return size;
+	}
+
+
+	size_t FileByteStream::ReadFile(u64 offset, ByteData data)
+	{
+		while (true)
+		{
+			const ssize_t res = ::pread(_fd, data.data(), data.size(), (off_t)offset);
+			if (res >= 0)
+				return (size_t)res;
+
+			if (errno != EINTR)
+				STINGRAYKIT_THROW_SYSTEM_EXCEPTION("pread", _path, errno);
+		}
+	}
+
+
+	size_t FileByteStream::WriteFile(u64 offset, ConstByteData data)
+	{
+		while (true)
+		{
+			const ssize_t res = ::pwrite(_fd, data.data(), data.size(), (off_t)offset);
+			if (res >= 0)
+				return (size_t)res;
+
+			if (errno != EINTR)
+				STINGRAYKIT_THROW_SYSTEM_EXCEPTION("pwrite", _path, errno);
+		}
+	}
+
+
+	void FileByteStream::WriteFileFully(u64 offset, ConstByteData data)
+	{
+		for (size_t written = 0; written < data.size(); )
+		{
+			const size_t size = WriteFile(offset + written, ConstByteData(data, written));
+			STINGRAYKIT_CHECK(size != 0, InputOutputException("pwrite returned 0"));
+			written += size;
+		}
+	}
+
+
+	void FileByteStream::WriteThroughCache(u64 offset, ConstByteData data)
+	{
+		SetDirectIo(false);
+		const ScopeExitInvoker sei(Bind(&FileByteStream::SetDirectIo, this, true));
+
+		WriteFileFully(offset, data);
+	}
+
+
+	void FileByteStream::FlushStaging()
+	{
+		if (_stagingSize == 0)
+			return;
+
+		const size_t alignedSize = AlignDown(_stagingSize, _config.DirectIoAlignment());
+		WriteFileFully(_stagingOffset, ConstByteData(_staging, alignedSize));
+
+		if (alignedSize != _stagingSize)
+			WriteThroughCache(_stagingOffset + alignedSize, ConstByteData(_staging + alignedSize, _stagingSize - alignedSize));
+
+		_stagingSize = 0;
+	}
+
+
+	void FileByteStream::SetDirectIo(bool enabled)
+	{
+		const int flags = ::fcntl(_fd, F_GETFL);
+		STINGRAYKIT_CHECK(flags >= 0, SystemException("fcntl", _path, errno));
+		STINGRAYKIT_CHECK(::fcntl(_fd, F_SETFL, enabled ? flags | O_DIRECT : flags & ~O_DIRECT) == 0, SystemException("fcntl", _path, errno));
+	}
+
+}
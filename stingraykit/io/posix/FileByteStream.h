@@ -0,0 +1,155 @@
+#ifndef STINGRAYKIT_IO_POSIX_FILEBYTESTREAM_H
+#define STINGRAYKIT_IO_POSIX_FILEBYTESTREAM_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/IPositionalByteStream.h>
+#include <stingraykit/io/ISyncableByteStream.h>
+#include <stingraykit/Enum.h>
+
+namespace stingray
+{
+
+	struct FileAccessHint
+	{
+		STINGRAYKIT_ENUM_VALUES(
+			Normal,
+			Sequential,
+			Random,
+			WillNeed,
+			DontNeed,
+			NoReuse
+		);
+
+		STINGRAYKIT_DECLARE_ENUM_CLASS(FileAccessHint);
+	};
+
+
+	/**
+	 * @brief IByteStream over a regular file
+	 * @details Position is kept by the stream itself and all I/O goes through pread/pwrite, so ReadAt/WriteAt never move it.
+	 * Read-only file may be mapped into memory (Config::EnableMmapRead), then reads within the mapped size are plain copies from the mapping.
+	 * With Config::EnableDirectIo the file is opened with O_DIRECT: sequential writes are staged in an aligned buffer and go to the disk
+	 * in aligned blocks, while unaligned leftovers and reads go through the page cache.
+	 */
+	class FileByteStream : public virtual ISyncableByteStream, public virtual IPositionalByteStream
+	{
+		STINGRAYKIT_NONCOPYABLE(FileByteStream);
+
+	public:
+		class Config
+		{
+			bool					_write;
+			bool					_create;
+			bool					_truncate;
+			bool					_mmapRead;
+			bool					_directIo;
+			size_t					_directIoAlignment;
+			size_t					_directIoBufferSize;
+			FileAccessHint			_accessHint;
+
+		public:
+			Config();
+
+			Config& EnableWrite();
+			bool WriteEnabled() const
+			{ return _write; }
+
+			/// @brief Creates file if it does not exist, implies EnableWrite
+			Config& EnableCreate();
+			bool CreateEnabled() const
+			{ return _create; }
+
+			/// @brief Implies EnableWrite
+			Config& EnableTruncate();
+			bool TruncateEnabled() const
+			{ return _truncate; }
+
+			/// @brief Maps read-only file into memory on open
+			Config& EnableMmapRead();
+			bool MmapReadEnabled() const
+			{ return _mmapRead; }
+
+			/// @param alignment Required alignment of offsets, sizes and memory for O_DIRECT, usually logical block size of the device
+			/// @param bufferSize Size of staging buffer, multiple of alignment
+			Config& EnableDirectIo(size_t alignment = 4096, size_t bufferSize = 1024 * 1024);
+			bool DirectIoEnabled() const
+			{ return _directIo; }
+			size_t DirectIoAlignment() const
+			{ return _directIoAlignment; }
+			size_t DirectIoBufferSize() const
+			{ return _directIoBufferSize; }
+
+			/// @brief Hint passed to posix_fadvise for the whole file on open
+			Config& AccessHint(FileAccessHint accessHint);
+			FileAccessHint AccessHint() const
+			{ return _accessHint; }
+
+			std::string ToString() const;
+		};
+
+	private:
+		const std::string			_path;
+		const Config				_config;
+
+		int							_fd;
+		u64							_position;
+
+		const u8*					_mapping;
+		size_t						_mappingSize;
+
+		u8*							_staging;
+		u64							_stagingOffset;
+		size_t						_stagingSize;
+
+	public:
+		explicit FileByteStream(const std::string& path, const Config& config = Config());
+		~FileByteStream() override;
+
+		u64 Read(ByteData data, const ICancellationToken& token = DummyCancellationToken()) override;
+		u64 Write(ConstByteData data, const ICancellationToken& token = DummyCancellationToken()) override;
+
+		u64 ReadAt(u64 offset, ByteData data, const ICancellationToken& token = DummyCancellationToken()) override;
+		u64 WriteAt(u64 offset, ConstByteData data, const ICancellationToken& token = DummyCancellationToken()) override;
+
+		void Seek(s64 offset, SeekMode mode = SeekMode::Begin) override;
+		u64 Tell() const override;
+
+		/// @brief Writes out staged data and flushes file data to the device
+		void Sync() override;
+
+		u64 GetSize() const;
+
+		/// @brief Hints kernel about expected access to part of the file, e.g. FileAccessHint::WillNeed starts readahead
+		/// @param length Zero means up to the end of the file
+		void Advise(u64 offset, u64 length, FileAccessHint hint);
+
+		/// @brief Descriptor for writing and syncing the file bypassing the stream, e.g. through io_uring
+		/// @returns -1 if writes must go through the stream, as they are staged for direct I/O
+		int GetAsyncIoDescriptor() const
+		{ return _staging ? -1 : _fd; }
+
+	private:
+		void Close();
+
+		u64 DoRead(u64 offset, ByteData data);
+		u64 DoWrite(u64 offset, ConstByteData data);
+
+		size_t ReadFile(u64 offset, ByteData data);
+		size_t WriteFile(u64 offset, ConstByteData data);
+		void WriteFileFully(u64 offset, ConstByteData data);
+
+		void WriteThroughCache(u64 offset, ConstByteData data);
+		void FlushStaging();
+		void SetDirectIo(bool enabled);
+	};
+	STINGRAYKIT_DECLARE_PTR(FileByteStream);
+
+}
+
+#endif
@@ -0,0 +1,471 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/posix/IoUringAsyncIoEngine.h>
+
+#include <stingraykit/function/bind.h>
+#include <stingraykit/io/posix/FileByteStream.h>
+#include <stingraykit/string/ToString.h>
+#include <stingraykit/SystemException.h>
+
+#include <limits>
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef HAVE_IO_URING
+#	include <linux/io_uring.h>
+#	include <sys/mman.h>
+#	include <sys/syscall.h>
+#endif
+
+namespace stingray
+{
+
+	namespace
+	{
+
+		const u64 StopUserData = std::numeric_limits<u64>::max();
+		const TimeDuration StopRetryTimeout = TimeDuration::FromMilliseconds(100);
+
+	}
+
+
+#ifdef HAVE_IO_URING
+
+	class IoUringAsyncIoEngine::Ring
+	{
+		STINGRAYKIT_NONCOPYABLE(Ring);
+
+	private:
+		int					_fd;
+
+		void*				_sqRing;
+		size_t				_sqRingSize;
+		void*				_cqRing;
+		size_t				_cqRingSize;
+		void*				_sqesMapping;
+		size_t				_sqesSize;
+
+		u32					_sqEntries;
+		u32*				_sqTail;
+		u32					_sqMask;
+		u32*				_sqArray;
+		io_uring_sqe*		_sqes;
+
+		u32*				_cqHead;
+		u32*				_cqTail;
+		u32					_cqMask;
+		io_uring_cqe*		_cqes;
+
+	public:
+		explicit Ring(u32 entries)
+			:	_fd(-1),
+				_sqRing(MAP_FAILED), _sqRingSize(),
+				_cqRing(MAP_FAILED), _cqRingSize(),
+				_sqesMapping(MAP_FAILED), _sqesSize()
+		{
+			io_uring_params params;
+			::memset(&params, 0, sizeof(params));
+
+			_fd = (int)::syscall(__NR_io_uring_setup, entries, &params);
+			STINGRAYKIT_CHECK(_fd >= 0, SystemException("io_uring_setup"));
+
+			try
+			{
+				const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+
+				_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(u32);
+				_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+				if (singleMmap)
+					_sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+
+				_sqRing = Map(_sqRingSize, IORING_OFF_SQ_RING);
+				_cqRing = singleMmap ? _sqRing : Map(_cqRingSize, IORING_OFF_CQ_RING);
+
+				_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+				_sqesMapping = Map(_sqesSize, IORING_OFF_SQES);
+			}
+			catch (...)
+			{
+				Close();
+				throw;
+			}
+
+			u8* const sqRing = static_cast<u8*>(_sqRing);
+			_sqEntries = params.sq_entries;
+			_sqTail = reinterpret_cast<u32*>(sqRing + params.sq_off.tail);
+			_sqMask = *reinterpret_cast<u32*>(sqRing + params.sq_off.ring_mask);
+			_sqArray = reinterpret_cast<u32*>(sqRing + params.sq_off.array);
+			_sqes = static_cast<io_uring_sqe*>(_sqesMapping);
+
+			u8* const cqRing = static_cast<u8*>(_cqRing);
+			_cqHead = reinterpret_cast<u32*>(cqRing + params.cq_off.head);
+			_cqTail = reinterpret_cast<u32*>(cqRing + params.cq_off.tail);
+			_cqMask = *reinterpret_cast<u32*>(cqRing + params.cq_off.ring_mask);
+			_cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+		}
+
+		~Ring()
+		{ Close(); }
+
+		u32 GetCapacity() const
+		{ return _sqEntries; }
+
+		void PushWrite(int fd, u64 offset, ConstByteData data, u64 userData)
+		{
+			io_uring_sqe entry = MakeEntry(IORING_OP_WRITE, fd, userData);
+			entry.off = offset;
+			entry.addr = reinterpret_cast<uintptr_t>(data.data());
+			entry.len = data.size();
+			Push(entry);
+		}
+
+		void PushSync(int fd, u64 userData)
+		{
+			io_uring_sqe entry = MakeEntry(IORING_OP_FSYNC, fd, userData);
+			entry.fsync_flags = IORING_FSYNC_DATASYNC;
+			Push(entry);
+		}
+
+		void PushNop(u64 userData)
+		{ Push(MakeEntry(IORING_OP_NOP, -1, userData)); }
+
+		void Wait()
+		{
+			while (Enter(0, 1, IORING_ENTER_GETEVENTS) < 0)
+				STINGRAYKIT_CHECK(errno == EINTR, SystemException("io_uring_enter"));
+		}
+
+		bool PopCompletion(u64& userData, s32& result)
+		{
+			const u32 head = *_cqHead;
+			if (head == __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE))
+				return false;
+
+			const io_uring_cqe& completion = _cqes[head & _cqMask];
+			userData = completion.user_data;
+			result = completion.res;
+
+			__atomic_store_n(_cqHead, head + 1, __ATOMIC_RELEASE);
+			return true;
+		}
+
+	private:
+		static io_uring_sqe MakeEntry(u8 opcode, int fd, u64 userData)
+		{
+			io_uring_sqe entry;
+			::memset(&entry, 0, sizeof(entry));
+			entry.opcode = opcode;
+			entry.fd = fd;
+			entry.user_data = userData;
+			return entry;
+		}
+
+		void Push(const io_uring_sqe& entry)
+		{
+			const u32 tail = *_sqTail;
+			const u32 index = tail & _sqMask;
+
+			_sqes[index] = entry;
+			_sqArray[index] = index;
+			__atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+
+			int res;
+			while ((res = Enter(1, 0, 0)) < 0 && errno == EINTR)
+				;
+
+			if (res == 1)
+				return;
+
+			// Entry was not consumed, so it may be taken back
+			const int error = res < 0 ? errno : EAGAIN;
+			__atomic_store_n(_sqTail, tail, __ATOMIC_RELEASE);
+			STINGRAYKIT_THROW(SystemException("io_uring_enter", error));
+		}
+
+		int Enter(u32 toSubmit, u32 minComplete, u32 flags)
+		{ return (int)::syscall(__NR_io_uring_enter, _fd, toSubmit, minComplete, flags, NULL, 0); }
+
+		void* Map(size_t size, off_t offset)
+		{
+			void* const result = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, offset);
+			STINGRAYKIT_CHECK(result != MAP_FAILED, SystemException("mmap"));
+			return result;
+		}
+
+		void Close()
+		{
+			if (_sqesMapping != MAP_FAILED)
+				::munmap(_sqesMapping, _sqesSize);
+
+			if (_cqRing != MAP_FAILED && _cqRing != _sqRing)
+				::munmap(_cqRing, _cqRingSize);
+
+			if (_sqRing != MAP_FAILED)
+				::munmap(_sqRing, _sqRingSize);
+
+			::close(_fd);
+		}
+	};
+
+#else
+
+	class IoUringAsyncIoEngine::Ring
+	{
+	public:
+		explicit Ring(u32 entries)
+		{ STINGRAYKIT_THROW(NotSupportedException()); }
+
+		u32 GetCapacity() const										{ return 0; }
+
+		void PushWrite(int fd, u64 offset, ConstByteData data, u64 userData)	{ }
+		void PushSync(int fd, u64 userData)							{ }
+		void PushNop(u64 userData)									{ }
+
+		void Wait()													{ }
+		bool PopCompletion(u64& userData, s32& result)				{ return false; }
+	};
+
+#endif
+
+
+	STINGRAYKIT_DEFINE_NAMED_LOGGER(IoUringAsyncIoEngine);
+
+	const size_t IoUringAsyncIoEngine::DefaultQueueDepth;
+
+
+	IoUringAsyncIoEngine::IoUringAsyncIoEngine(const std::string& name, size_t queueDepth)
+		:	_name(name),
+			_stopping(false)
+	{
+		STINGRAYKIT_CHECK(queueDepth != 0 && queueDepth < std::numeric_limits<u32>::max(), ArgumentException("queueDepth", queueDepth));
+
+		// One more entry is reserved for waking up completion thread on destruction
+		_ring = make_unique_ptr<Ring>((u32)queueDepth + 1);
+
+		const u32 slots = _ring->GetCapacity() - 1;
+		_inFlight.resize(slots);
+		for (u32 slot = slots; slot != 0; --slot)
+			_freeSlots.push_back(slot - 1);
+
+		_thread = make_shared_ptr<Thread>(StringBuilder() % "ioUring(" % _name % ")", Bind(&IoUringAsyncIoEngine::ThreadFunc, this, _1));
+		s_logger.Info() << "Created " << _name << " with queue depth " << slots;
+	}
+
+
+	IoUringAsyncIoEngine::~IoUringAsyncIoEngine()
+	{
+		for (bool logged = false; ; logged = true)
+		{
+			{
+				MutexLock l(_mutex);
+				_stopping = true;
+
+				// Failed completion thread has already exited, and one with operations in flight stops after handling them
+				if (_failure || (logged && _freeSlots.size() != _inFlight.size()))
+					break;
+
+				try
+				{
+					_ring->PushNop(StopUserData);
+					break;
+				}
+				catch (const std::exception& ex)
+				{
+					if (!logged)
+						s_logger.Error() << _name << ": can't wake completion thread up, retrying: " << ex;
+				}
+			}
+
+			Thread::Sleep(StopRetryTimeout);
+		}
+
+		_thread.reset();
+		_fallback.reset();
+
+		if (!_failure && (!_pending.empty() || _freeSlots.size() != _inFlight.size()))
+			s_logger.Warning() << "Destroying " << _name << " with requests pending";
+	}
+
+
+	IAsyncIoEnginePtr IoUringAsyncIoEngine::Create(const std::string& name, size_t queueDepth)
+	{
+		try
+		{ return make_shared_ptr<IoUringAsyncIoEngine>(name, queueDepth); }
+		catch (const std::exception& ex)
+		{ s_logger.Warning() << "io_uring is not available for " << name << ", falling back to thread pool: " << ex; }
+
+		return make_shared_ptr<ThreadPoolAsyncIoEngine>(name);
+	}
+
+
+	void IoUringAsyncIoEngine::SubmitWrite(const IByteStreamPtr& stream, u64 offset, ConstByteData data, const CompletionHandler& handler)
+	{
+		const FileByteStreamPtr file = dynamic_caster(stream);
+		const int fd = file ? file->GetAsyncIoDescriptor() : -1;
+
+		if (fd >= 0)
+			Submit(Request(stream, fd, offset, data, handler));
+		else
+			GetFallback().SubmitWrite(stream, offset, data, handler);
+	}
+
+
+	void IoUringAsyncIoEngine::SubmitSync(const IByteStreamPtr& stream, const CompletionHandler& handler)
+	{
+		const FileByteStreamPtr file = dynamic_caster(stream);
+		const int fd = file ? file->GetAsyncIoDescriptor() : -1;
+
+		if (fd >= 0)
+			Submit(Request(stream, fd, null, ConstByteData(), handler));
+		else
+			GetFallback().SubmitSync(stream, handler);
+	}
+
+
+	IAsyncIoEngine& IoUringAsyncIoEngine::GetFallback()
+	{
+		MutexLock l(_mutex);
+
+		if (!_fallback)
+		{
+			s_logger.Info() << _name << ": creating thread pool for streams without descriptor";
+			_fallback = make_shared_ptr<ThreadPoolAsyncIoEngine>(StringBuilder() % _name % "Fallback");
+		}
+
+		return *_fallback;
+	}
+
+
+	void IoUringAsyncIoEngine::Submit(const Request& request)
+	{
+		MutexLock l(_mutex);
+		STINGRAYKIT_RETHROW_EXCEPTION(_failure);
+
+		if (_freeSlots.empty())
+			_pending.push_back(request);
+		else
+			DoSubmit(request);
+	}
+
+
+	void IoUringAsyncIoEngine::DoSubmit(const Request& request)
+	{
+		const u32 slot = _freeSlots.back();
+
+		if (request.Offset)
+			_ring->PushWrite(request.Fd, *request.Offset, request.Data, slot);
+		else
+			_ring->PushSync(request.Fd, slot);
+
+		_freeSlots.pop_back();
+		_inFlight[slot] = request;
+	}
+
+
+	void IoUringAsyncIoEngine::SubmitPending(Completions& failed)
+	{
+		while (!_freeSlots.empty() && !_pending.empty())
+		{
+			const Request request = _pending.front();
+			_pending.pop_front();
+
+			try
+			{ DoSubmit(request); }
+			catch (const std::exception& ex)
+			{ failed.push_back(Completion(request.Handler, 0, MakeExceptionPtr(ex))); }
+		}
+	}
+
+
+	void IoUringAsyncIoEngine::FailRequests(Completions& completions, const ExceptionPtr& exception)
+	{
+		{
+			MutexLock l(_mutex);
+			_failure = exception;
+
+			for (InFlightRequests::iterator it = _inFlight.begin(); it != _inFlight.end(); ++it)
+			{
+				if (!*it)
+					continue;
+
+				completions.push_back(Completion((*it)->Handler, 0, exception));
+				it->reset();
+			}
+
+			for (Requests::const_iterator it = _pending.begin(); it != _pending.end(); ++it)
+				completions.push_back(Completion(it->Handler, 0, exception));
+			_pending.clear();
+		}
+
+		for (Completions::const_iterator it = completions.begin(); it != completions.end(); ++it)
+			STINGRAYKIT_TRY_TO_LOGGER(s_logger, "Completion handler failed", it->Handler(it->Written, it->Exception));
+
+		completions.clear();
+	}
+
+
+	void IoUringAsyncIoEngine::ThreadFunc(const ICancellationToken& token)
+	{
+		// Completions, which were reaped but not handled yet, are handled on failure along with the requests left
+		Completions completions;
+
+		try
+		{
+			bool active = true;
+
+			while (active)
+			{
+				_ring->Wait();
+
+				{
+					MutexLock l(_mutex);
+
+					u64 userData;
+					s32 result;
+					while (_ring->PopCompletion(userData, result))
+					{
+						if (userData == StopUserData)
+						{
+							active = false;
+							continue;
+						}
+
+						const u32 slot = (u32)userData;
+						const CompletionHandler handler = _inFlight[slot]->Handler;
+						const bool isWrite = _inFlight[slot]->Offset.is_initialized();
+						_inFlight[slot].reset();
+						_freeSlots.push_back(slot);
+
+						if (result >= 0)
+							completions.push_back(Completion(handler, (u64)result, ExceptionPtr()));
+						else
+							completions.push_back(Completion(handler, 0, MakeExceptionPtr(SystemException(isWrite ? "io_uring write" : "io_uring fdatasync", -result))));
+					}
+
+					SubmitPending(completions);
+
+					if (_stopping && _pending.empty() && _freeSlots.size() == _inFlight.size())
+						active = false;
+				}
+
+				for (Completions::const_iterator it = completions.begin(); it != completions.end(); ++it)
+					STINGRAYKIT_TRY_TO_LOGGER(s_logger, "Completion handler failed", it->Handler(it->Written, it->Exception));
+
+				completions.clear();
+			}
+		}
+		catch (const std::exception& ex)
+		{
+			s_logger.Error() << _name << ": completion thread failed: " << ex;
+			FailRequests(completions, MakeExceptionPtr(ex));
+		}
+	}
+
+}
@@ -0,0 +1,109 @@
+#ifndef STINGRAYKIT_IO_POSIX_IOURINGASYNCIOENGINE_H
+#define STINGRAYKIT_IO_POSIX_IOURINGASYNCIOENGINE_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/ThreadPoolAsyncIoEngine.h>
+#include <stingraykit/unique_ptr.h>
+
+namespace stingray
+{
+
+	/**
+	 * @brief Submits writes and syncs of FileByteStream through io_uring, completions of all streams are handled by single thread
+	 * @details Other streams and FileByteStream with direct I/O enabled are served by ThreadPoolAsyncIoEngine created on demand.
+	 * Up to queueDepth operations are in flight at once, the rest wait in queue. If completion thread fails, operations in flight and in queue
+	 * are completed with its exception, and further submissions throw it.
+	 * @par Example:
+	 * @code
+	 * const IAsyncIoEnginePtr engine = IoUringAsyncIoEngine::Create("recordsIo");
+	 * const AsyncByteStreamPtr stream = make_shared_ptr<AsyncByteStream>("record", make_shared_ptr<FileByteStream>(path, FileByteStream::Config().EnableWrite()), engine);
+	 * @endcode
+	 */
+	class IoUringAsyncIoEngine : public virtual IAsyncIoEngine
+	{
+		STINGRAYKIT_NONCOPYABLE(IoUringAsyncIoEngine);
+
+	private:
+		class Ring;
+		STINGRAYKIT_DECLARE_UNIQ_PTR(Ring);
+
+		struct Request
+		{
+			IByteStreamPtr			Stream;
+			int						Fd;
+			optional<u64>			Offset;		// not set for sync
+			ConstByteData			Data;
+			CompletionHandler		Handler;
+
+			Request(const IByteStreamPtr& stream, int fd, const optional<u64>& offset, ConstByteData data, const CompletionHandler& handler)
+				: Stream(stream), Fd(fd), Offset(offset), Data(data), Handler(handler)
+			{ }
+		};
+
+		struct Completion
+		{
+			CompletionHandler		Handler;
+			u64						Written;
+			ExceptionPtr			Exception;
+
+			Completion(const CompletionHandler& handler, u64 written, const ExceptionPtr& exception)
+				: Handler(handler), Written(written), Exception(exception)
+			{ }
+		};
+
+		using Requests = std::deque<Request>;
+		using InFlightRequests = std::vector<optional<Request>>;
+		using Slots = std::vector<u32>;
+		using Completions = std::vector<Completion>;
+
+	public:
+		static const size_t				DefaultQueueDepth = 64;
+
+	private:
+		static NamedLogger				s_logger;
+
+		const std::string				_name;
+		RingUniqPtr						_ring;
+
+		Mutex							_mutex;
+		Requests						_pending;
+		InFlightRequests				_inFlight;
+		Slots							_freeSlots;
+		ThreadPoolAsyncIoEnginePtr		_fallback;
+		ExceptionPtr					_failure;
+		bool							_stopping;
+
+		ThreadPtr						_thread;
+
+	public:
+		/// @throws SystemException or NotSupportedException if io_uring is not available
+		explicit IoUringAsyncIoEngine(const std::string& name, size_t queueDepth = DefaultQueueDepth);
+		~IoUringAsyncIoEngine() override;
+
+		/// @brief Creates IoUringAsyncIoEngine, falls back to ThreadPoolAsyncIoEngine if io_uring is not available
+		static IAsyncIoEnginePtr Create(const std::string& name, size_t queueDepth = DefaultQueueDepth);
+
+		void SubmitWrite(const IByteStreamPtr& stream, u64 offset, ConstByteData data, const CompletionHandler& handler) override;
+		void SubmitSync(const IByteStreamPtr& stream, const CompletionHandler& handler) override;
+
+	private:
+		IAsyncIoEngine& GetFallback();
+
+		void Submit(const Request& request);
+		void DoSubmit(const Request& request);
+		void SubmitPending(Completions& failed);
+		void FailRequests(Completions& completions, const ExceptionPtr& exception);
+
+		void ThreadFunc(const ICancellationToken& token);
+	};
+	STINGRAYKIT_DECLARE_PTR(IoUringAsyncIoEngine);
+
+}
+
+#endif
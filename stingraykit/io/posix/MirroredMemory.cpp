@@ -0,0 +1,101 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/posix/MirroredMemory.h>
+
+#include <stingraykit/ScopeExit.h>
+#include <stingraykit/SystemException.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace stingray
+{
+
+	namespace
+	{
+
+		class MirroredMapping final : public virtual IToken
+		{
+		private:
+			void*		_area;
+			size_t		_size;
+
+		public:
+			MirroredMapping(void* area, size_t size) : _area(area), _size(size)
+			{ }
+
+			~MirroredMapping() override
+			{ ::munmap(_area, _size); }
+		};
+
+
+		int CreateSharedFile()
+		{
+#if HAVE_MEMFD_CREATE
+			const int fd = ::memfd_create("stingraykit-mirrored", MFD_CLOEXEC);
+			STINGRAYKIT_CHECK(fd >= 0, SystemException("memfd_create"));
+			return fd;
+#else
+			char path[] = "/dev/shm/stingraykit-mirrored-XXXXXX";
+			const int fd = ::mkostemp(path, O_CLOEXEC);
+			STINGRAYKIT_CHECK(fd >= 0, SystemException("mkostemp", path, errno));
+			::unlink(path);
+			return fd;
+#endif
+		}
+
+	}
+
+
+	size_t MirroredMemory::GetGranularity()
+	{
+		static const size_t pageSize = ::sysconf(_SC_PAGESIZE);
+		return pageSize;
+	}
+
+
+	size_t MirroredMemory::RoundUp(size_t size)
+	{
+		const size_t granularity = GetGranularity();
+		return (size + granularity - 1) / granularity * granularity;
+	}
+
+
+	BytesOwner MirroredMemory::Allocate(size_t size)
+	{
+		STINGRAYKIT_CHECK(size != 0 && size % GetGranularity() == 0, ArgumentException("size", size));
+
+		const int fd = CreateSharedFile();
+		STINGRAYKIT_SCOPE_EXIT(MK_PARAM(int, fd))
+			::close(fd);
+		STINGRAYKIT_SCOPE_EXIT_END;
+
+		STINGRAYKIT_CHECK(::ftruncate(fd, size) == 0, SystemException("ftruncate"));
+
+		// Reserving address space for both halves first, so that nobody can take the second half in between
+		u8* const area = static_cast<u8*>(::mmap(NULL, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+		STINGRAYKIT_CHECK(area != MAP_FAILED, SystemException("mmap"));
+
+		Token mapping;
+		try
+		{ mapping = MakeToken<MirroredMapping>(area, 2 * size); }
+		catch (...)
+		{
+			::munmap(area, 2 * size);
+			throw;
+		}
+
+		for (size_t offset = 0; offset < 2 * size; offset += size)
+			STINGRAYKIT_CHECK(::mmap(area + offset, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED, SystemException("mmap"));
+
+		return BytesOwner(ByteData(area, 2 * size), std::move(mapping));
+	}
+
+}
@@ -0,0 +1,36 @@
+#ifndef STINGRAYKIT_IO_POSIX_MIRROREDMEMORY_H
+#define STINGRAYKIT_IO_POSIX_MIRROREDMEMORY_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/BytesOwner.h>
+
+namespace stingray
+{
+
+	/**
+	 * @brief Memory, which is mapped twice back to back, so that byte at [i + size] is the same as byte at [i]
+	 * @details Intended as storage for circular buffers (see MirroredStorageTag): any region of such buffer, even crossing the wrap point,
+	 * is contiguous in memory.
+	 */
+	struct MirroredMemory
+	{
+		/// @returns Required alignment of the size, i.e. page size
+		static size_t GetGranularity();
+
+		/// @returns Size rounded up to the granularity
+		static size_t RoundUp(size_t size);
+
+		/// @param size Size of the mirrored region, must be a non-zero multiple of the granularity
+		/// @returns Storage of 2 * size bytes, which is released when the last copy of BytesOwner is gone
+		static BytesOwner Allocate(size_t size);
+	};
+
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef STINGRAYKIT_LOCAL_SHARED_PTR_H
+#define STINGRAYKIT_LOCAL_SHARED_PTR_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/shared_ptr.h>
+
+namespace stingray
+{
+
+#define STINGRAYKIT_DECLARE_LOCAL_PTR(ClassName) \
+		using ClassName##LocalPtr = stingray::local_shared_ptr<ClassName>; \
+		using ClassName##LocalWeakPtr = stingray::local_weak_ptr<ClassName>
+
+
+	/**
+	 * @brief shared_ptr with non-atomic reference counters
+	 * @details Must not be copied, destroyed or locked outside of the thread it was created in, debug builds check it
+	 */
+	template < typename T >
+	using local_shared_ptr = shared_ptr<T, LocalRefCountPolicy>;
+
+
+	/** @brief weak_ptr counterpart for local_shared_ptr */
+	template < typename T >
+	using local_weak_ptr = weak_ptr<T, LocalRefCountPolicy>;
+
+
+	template < typename ObjType, typename... Ts >
+	local_shared_ptr<ObjType> make_local_shared_ptr(Ts&&... args)
+	{ return MakeShared<ObjType, LocalRefCountPolicy>()(std::forward<Ts>(args)...); }
+
+}
+
+#endif
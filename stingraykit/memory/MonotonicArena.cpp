@@ -0,0 +1,146 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/memory/MonotonicArena.h>
+
+#include <stingraykit/string/ToString.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace stingray
+{
+
+	namespace
+	{
+
+		const size_t MaxAlignment = alignof(std::max_align_t);
+
+		u8* AlignUp(u8* ptr, size_t alignment)
+		{ return reinterpret_cast<u8*>((reinterpret_cast<uintptr_t>(ptr) + alignment - 1) & ~(uintptr_t)(alignment - 1)); }
+
+		void CheckAlignment(size_t alignment)
+		{ STINGRAYKIT_CHECK(alignment != 0 && (alignment & (alignment - 1)) == 0 && alignment <= MaxAlignment, ArgumentException("alignment", alignment)); }
+
+	}
+
+
+	NewDeleteMemoryResource& NewDeleteMemoryResource::Instance()
+	{
+		static NewDeleteMemoryResource instance;
+		return instance;
+	}
+
+
+	void* NewDeleteMemoryResource::Allocate(size_t size, size_t alignment)
+	{
+		CheckAlignment(alignment);
+		return ::operator new(size);
+	}
+
+
+	void NewDeleteMemoryResource::Deallocate(void* ptr, size_t size, size_t alignment)
+	{ ::operator delete(ptr); }
+
+
+	struct MonotonicArena::BlockHeader
+	{
+		BlockHeader*	Next;
+		size_t			Size;
+	};
+
+
+	const size_t MonotonicArena::DefaultBlockSize;
+
+
+	MonotonicArena::MonotonicArena(size_t initialBlockSize, IMemoryResource& upstream)
+		:	_upstream(&upstream),
+			_nextBlockSize(initialBlockSize),
+			_blocks(),
+			_current(),
+			_end(),
+			_initialBuffer(),
+			_initialBufferSize(),
+			_initialBlockSize(initialBlockSize)
+	{ STINGRAYKIT_CHECK(initialBlockSize != 0, ArgumentException("initialBlockSize", initialBlockSize)); }
+
+
+	MonotonicArena::MonotonicArena(void* buffer, size_t size, IMemoryResource& upstream)
+		:	_upstream(&upstream),
+			_nextBlockSize(std::max(size, DefaultBlockSize)),
+			_blocks(),
+			_current(static_cast<u8*>(buffer)),
+			_end(static_cast<u8*>(buffer) + size),
+			_initialBuffer(static_cast<u8*>(buffer)),
+			_initialBufferSize(size),
+			_initialBlockSize(std::max(size, DefaultBlockSize))
+	{ STINGRAYKIT_REQUIRE_NOT_NULL(buffer); }
+
+
+	MonotonicArena::~MonotonicArena()
+	{ Release(); }
+
+
+	void* MonotonicArena::Allocate(size_t size, size_t alignment)
+	{
+		CheckAlignment(alignment);
+
+		u8* result = AlignUp(_current, alignment);
+		if (!_current || (size_t)(_end - _current) < size + (result - _current))
+		{
+			AllocateBlock(size, alignment);
+			result = AlignUp(_current, alignment);
+		}
+
+		_current = result + size;
+		return result;
+	}
+
+
+	void MonotonicArena::Release()
+	{
+		while (_blocks)
+		{
+			BlockHeader* const block = _blocks;
+			_blocks = block->Next;
+			_upstream->Deallocate(block, block->Size, MaxAlignment);
+		}
+
+		_current = _initialBuffer;
+		_end = _initialBuffer + _initialBufferSize;
+		_nextBlockSize = _initialBlockSize;
+	}
+
+
+	size_t MonotonicArena::GetReservedSize() const
+	{
+		size_t result = 0;
+		for (const BlockHeader* block = _blocks; block; block = block->Next)
+			result += block->Size;
+		return result;
+	}
+
+
+	void MonotonicArena::AllocateBlock(size_t minSize, size_t alignment)
+	{
+		STINGRAYKIT_CHECK(minSize <= std::numeric_limits<size_t>::max() - sizeof(BlockHeader) - alignment, std::bad_alloc());
+
+		const size_t size = std::max(_nextBlockSize, sizeof(BlockHeader) + minSize + alignment);
+		BlockHeader* const block = static_cast<BlockHeader*>(_upstream->Allocate(size, MaxAlignment));
+
+		block->Next = _blocks;
+		block->Size = size;
+		_blocks = block;
+
+		_current = reinterpret_cast<u8*>(block) + sizeof(BlockHeader);
+		_end = reinterpret_cast<u8*>(block) + size;
+
+		if (_nextBlockSize <= std::numeric_limits<size_t>::max() / 2)
+			_nextBlockSize *= 2;
+	}
+
+}
@@ -0,0 +1,162 @@
+#ifndef STINGRAYKIT_MEMORY_MONOTONICARENA_H
+#define STINGRAYKIT_MEMORY_MONOTONICARENA_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/Exception.h>
+
+#include <limits>
+#include <new>
+
+namespace stingray
+{
+
+	/**
+	 * @addtogroup toolkit_memory
+	 * @{
+	 */
+
+	struct IMemoryResource
+	{
+		virtual ~IMemoryResource() { }
+
+		virtual void* Allocate(size_t size, size_t alignment) = 0;
+		virtual void Deallocate(void* ptr, size_t size, size_t alignment) = 0;
+	};
+
+
+	/** @brief Forwards to ::operator new and ::operator delete */
+	class NewDeleteMemoryResource : public virtual IMemoryResource
+	{
+	public:
+		static NewDeleteMemoryResource& Instance();
+
+		void* Allocate(size_t size, size_t alignment) override;
+		void Deallocate(void* ptr, size_t size, size_t alignment) override;
+	};
+
+
+	/**
+	 * @brief Bump allocator, which frees all its memory at once
+	 * @details Memory is taken from upstream resource in blocks of geometrically growing size, Deallocate does nothing.
+	 * All memory is returned to upstream on Release or destruction, so objects allocated in the arena must be destroyed before that.
+	 * Not thread-safe.
+	 * @par Example:
+	 * @code
+	 * MonotonicArena arena;
+	 * ordered_map<int, std::string, std::less<int>, ArenaAllocator<std::pair<const int, std::string>>> map(&arena);
+	 * @endcode
+	 */
+	class MonotonicArena : public virtual IMemoryResource
+	{
+		STINGRAYKIT_NONCOPYABLE(MonotonicArena);
+
+	private:
+		struct BlockHeader;
+
+	private:
+		IMemoryResource*	_upstream;
+		size_t				_nextBlockSize;
+
+		BlockHeader*		_blocks;
+		u8*					_current;
+		u8*					_end;
+
+		u8* const			_initialBuffer;
+		const size_t		_initialBufferSize;
+		const size_t		_initialBlockSize;
+
+	public:
+		static const size_t DefaultBlockSize = 4096;
+
+	public:
+		explicit MonotonicArena(size_t initialBlockSize = DefaultBlockSize, IMemoryResource& upstream = NewDeleteMemoryResource::Instance());
+
+		/// @brief Serves allocations from external buffer first, falls back to upstream when it is exhausted
+		MonotonicArena(void* buffer, size_t size, IMemoryResource& upstream = NewDeleteMemoryResource::Instance());
+
+		~MonotonicArena() override;
+
+		void* Allocate(size_t size, size_t alignment) override;
+		void Deallocate(void* ptr, size_t size, size_t alignment) override { }
+
+		/// @brief Returns all blocks to upstream, arena may be reused afterwards
+		void Release();
+
+		/// @returns Total size of blocks taken from upstream
+		size_t GetReservedSize() const;
+
+	private:
+		void AllocateBlock(size_t minSize, size_t alignment);
+	};
+
+
+	/**
+	 * @brief polymorphic_allocator-style adapter, which makes any IMemoryResource usable by std and stingraykit containers
+	 * @details Default-constructed allocator uses NewDeleteMemoryResource. The resource is propagated on container copy construction.
+	 */
+	template < typename T >
+	class ArenaAllocator
+	{
+		template < typename U >
+		friend class ArenaAllocator;
+
+	public:
+		using value_type = T;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using reference = T&;
+		using const_reference = const T&;
+		using size_type = size_t;
+		using difference_type = ptrdiff_t;
+
+		template < typename U >
+		struct rebind
+		{ using other = ArenaAllocator<U>; };
+
+	private:
+		IMemoryResource*	_resource;
+
+	public:
+		ArenaAllocator() : _resource(&NewDeleteMemoryResource::Instance())
+		{ }
+
+		ArenaAllocator(IMemoryResource* resource) : _resource(STINGRAYKIT_REQUIRE_NOT_NULL(resource))
+		{ }
+
+		template < typename U >
+		ArenaAllocator(const ArenaAllocator<U>& other) : _resource(other._resource)
+		{ }
+
+		IMemoryResource* GetResource() const		{ return _resource; }
+
+		T* allocate(size_t n)
+		{
+			if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+				throw std::bad_alloc();
+
+			return static_cast<T*>(_resource->Allocate(n * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* ptr, size_t n)
+		{ _resource->Deallocate(ptr, n * sizeof(T), alignof(T)); }
+
+		template < typename U >
+		bool operator == (const ArenaAllocator<U>& other) const
+		{ return _resource == other._resource; }
+
+		template < typename U >
+		bool operator != (const ArenaAllocator<U>& other) const
+		{ return !(*this == other); }
+	};
+
+	/** @} */
+
+}
+
+#endif
@@ -0,0 +1,335 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/memory/PoolAllocator.h>
+
+#include <stingraykit/thread/Thread.h>
+#include <stingraykit/thread/posix/ThreadLocal.h>
+
+#include <algorithm>
+
+namespace stingray
+{
+
+	const size_t SizeClassPool::Granularity;
+	const size_t SizeClassPool::MaxPooledSize;
+
+	const size_t ByteBufferPool::MaxPooledSize;
+	const size_t ByteBufferPool::MaxCachedBytes;
+
+	namespace
+	{
+
+		const size_t SizeClassesCount = SizeClassPool::MaxPooledSize / SizeClassPool::Granularity;
+		const size_t ChunkSize = 64 * 1024;
+		const size_t BatchBytes = 4096;
+		const size_t MinBatchSize = 8;
+
+
+		struct FreeBlock
+		{
+			FreeBlock*		Next;
+		};
+
+
+		struct FreeList
+		{
+			FreeBlock*		Head;
+			size_t			Count;
+
+			FreeList() : Head(), Count()
+			{ }
+
+			void Push(FreeBlock* block)
+			{
+				block->Next = Head;
+				Head = block;
+				++Count;
+			}
+
+			FreeBlock* Pop()
+			{
+				FreeBlock* const result = Head;
+				Head = result->Next;
+				--Count;
+				return result;
+			}
+
+			FreeList Detach(size_t count)
+			{
+				FreeList result;
+				while (Head && result.Count < count)
+					result.Push(Pop());
+				return result;
+			}
+
+			void Append(FreeList& other)
+			{
+				while (other.Head)
+					Push(other.Pop());
+			}
+		};
+
+
+		size_t GetSizeClass(size_t size)
+		{ return size ? (size - 1) / SizeClassPool::Granularity : 0; }
+
+		size_t GetBlockSize(size_t sizeClass)
+		{ return (sizeClass + 1) * SizeClassPool::Granularity; }
+
+		size_t GetBatchSize(size_t sizeClass)
+		{ return std::max(MinBatchSize, BatchBytes / GetBlockSize(sizeClass)); }
+
+
+		class GlobalPool
+		{
+			STINGRAYKIT_NONCOPYABLE(GlobalPool);
+
+		private:
+			struct SizeClass
+			{
+				Mutex			Guard;
+				FreeList		Blocks;
+			};
+
+		private:
+			SizeClass			_classes[SizeClassesCount];
+
+		public:
+			GlobalPool()
+			{ }
+
+			static GlobalPool& Instance()
+			{
+				// Deliberately leaked: blocks may be freed by threads that outlive static destruction
+				static GlobalPool* const instance = new GlobalPool();
+				return *instance;
+			}
+
+			FreeList Fetch(size_t sizeClass, size_t count)
+			{
+				SizeClass& cls = _classes[sizeClass];
+				MutexLock l(cls.Guard);
+
+				if (!cls.Blocks.Head)
+					Carve(sizeClass, cls.Blocks);
+
+				return cls.Blocks.Detach(count);
+			}
+
+			void Release(size_t sizeClass, FreeList& blocks)
+			{
+				SizeClass& cls = _classes[sizeClass];
+				MutexLock l(cls.Guard);
+				cls.Blocks.Append(blocks);
+			}
+
+		private:
+			static void Carve(size_t sizeClass, FreeList& blocks)
+			{
+				const size_t blockSize = GetBlockSize(sizeClass);
+				u8* const chunk = static_cast<u8*>(::operator new(ChunkSize));
+
+				for (size_t offset = 0; offset + blockSize <= ChunkSize; offset += blockSize)
+					blocks.Push(reinterpret_cast<FreeBlock*>(chunk + offset));
+			}
+		};
+
+
+		class ThreadCache
+		{
+			STINGRAYKIT_NONCOPYABLE(ThreadCache);
+
+		private:
+			FreeList			_lists[SizeClassesCount];
+
+		public:
+			ThreadCache()
+			{ }
+
+			~ThreadCache()
+			{
+				for (size_t sizeClass = 0; sizeClass < SizeClassesCount; ++sizeClass)
+					if (_lists[sizeClass].Head)
+						GlobalPool::Instance().Release(sizeClass, _lists[sizeClass]);
+			}
+
+			void* Allocate(size_t sizeClass)
+			{
+				FreeList& list = _lists[sizeClass];
+				if (!list.Head)
+					list = GlobalPool::Instance().Fetch(sizeClass, GetBatchSize(sizeClass));
+
+				return list.Pop();
+			}
+
+			void Deallocate(void* ptr, size_t sizeClass)
+			{
+				FreeList& list = _lists[sizeClass];
+				list.Push(static_cast<FreeBlock*>(ptr));
+
+				const size_t batchSize = GetBatchSize(sizeClass);
+				if (list.Count < 2 * batchSize)
+					return;
+
+				FreeList surplus = list.Detach(batchSize);
+				GlobalPool::Instance().Release(sizeClass, surplus);
+			}
+		};
+
+
+		class BufferFreeLists
+		{
+			STINGRAYKIT_NONCOPYABLE(BufferFreeLists);
+
+		public:
+			static const size_t MinBufferSize = 2 * SizeClassPool::MaxPooledSize;
+
+		private:
+			struct SizeClass
+			{
+				Mutex			Guard;
+				FreeList		Buffers;
+			};
+
+			static const size_t ClassesCount = 8;
+			static_assert(MinBufferSize << (ClassesCount - 1) == ByteBufferPool::MaxPooledSize, "Invalid buffer size classes");
+
+		private:
+			SizeClass			_classes[ClassesCount];
+
+		public:
+			BufferFreeLists()
+			{ }
+
+			static BufferFreeLists& Instance()
+			{
+				// Leaked for the same reason as GlobalPool
+				static BufferFreeLists* const instance = new BufferFreeLists();
+				return *instance;
+			}
+
+			void* Allocate(size_t capacity)
+			{
+				{
+					SizeClass& cls = _classes[GetSizeClass(capacity)];
+					MutexLock l(cls.Guard);
+
+					if (cls.Buffers.Head)
+						return cls.Buffers.Pop();
+				}
+
+				return ::operator new(capacity);
+			}
+
+			void Deallocate(void* ptr, size_t capacity)
+			{
+				{
+					SizeClass& cls = _classes[GetSizeClass(capacity)];
+					MutexLock l(cls.Guard);
+
+					if ((cls.Buffers.Count + 1) * capacity <= ByteBufferPool::MaxCachedBytes)
+						return cls.Buffers.Push(static_cast<FreeBlock*>(ptr));
+				}
+
+				::operator delete(ptr);
+			}
+
+		private:
+			static size_t GetSizeClass(size_t capacity)
+			{
+				size_t result = 0;
+				for (size_t size = MinBufferSize; size < capacity; size <<= 1)
+					++result;
+				return result;
+			}
+		};
+
+
+		STINGRAYKIT_DECLARE_THREAD_LOCAL(ThreadCache, ThreadCacheHolder);
+		STINGRAYKIT_DEFINE_THREAD_LOCAL(ThreadCache, ThreadCacheHolder);
+
+	}
+
+
+	void* SizeClassPool::Allocate(size_t size)
+	{
+		if (size > MaxPooledSize)
+			return ::operator new(size);
+
+		const size_t sizeClass = GetSizeClass(size);
+		if (ThreadCache* cache = ThreadCacheHolder::TryGet())
+			return cache->Allocate(sizeClass);
+
+		FreeList blocks = GlobalPool::Instance().Fetch(sizeClass, 1);
+		return blocks.Pop();
+	}
+
+
+	void SizeClassPool::Deallocate(void* ptr, size_t size)
+	{
+		if (!ptr)
+			return;
+
+		if (size > MaxPooledSize)
+			return ::operator delete(ptr);
+
+		const size_t sizeClass = GetSizeClass(size);
+		if (ThreadCache* cache = ThreadCacheHolder::TryGet())
+			return cache->Deallocate(ptr, sizeClass);
+
+		FreeList blocks;
+		blocks.Push(static_cast<FreeBlock*>(ptr));
+		GlobalPool::Instance().Release(sizeClass, blocks);
+	}
+
+
+
+	size_t ByteBufferPool::GetCapacity(size_t size)
+	{
+		if (size <= SizeClassPool::MaxPooledSize)
+			return std::max<size_t>((size + SizeClassPool::Granularity - 1) / SizeClassPool::Granularity, 1) * SizeClassPool::Granularity;
+
+		if (size > MaxPooledSize)
+			return size;
+
+		size_t result = BufferFreeLists::MinBufferSize;
+		while (result < size)
+			result <<= 1;
+		return result;
+	}
+
+
+	void* ByteBufferPool::Allocate(size_t size)
+	{
+		const size_t capacity = GetCapacity(size);
+
+		if (capacity <= SizeClassPool::MaxPooledSize)
+			return SizeClassPool::Allocate(capacity);
+
+		if (capacity > MaxPooledSize)
+			return ::operator new(capacity);
+
+		return BufferFreeLists::Instance().Allocate(capacity);
+	}
+
+
+	void ByteBufferPool::Deallocate(void* ptr, size_t capacity)
+	{
+		if (!ptr)
+			return;
+
+		if (capacity <= SizeClassPool::MaxPooledSize)
+			return SizeClassPool::Deallocate(ptr, capacity);
+
+		if (capacity > MaxPooledSize)
+			return ::operator delete(ptr);
+
+		BufferFreeLists::Instance().Deallocate(ptr, capacity);
+	}
+
+}
@@ -0,0 +1,110 @@
+#ifndef STINGRAYKIT_MEMORY_POOLALLOCATOR_H
+#define STINGRAYKIT_MEMORY_POOLALLOCATOR_H
+
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/Types.h>
+
+#include <limits>
+#include <new>
+
+namespace stingray
+{
+
+	/**
+	 * @addtogroup toolkit_memory
+	 * @{
+	 */
+
+	/**
+	 * @brief Size-class pool for small objects
+	 * @details Blocks up to MaxPooledSize bytes are rounded up to a multiple of Granularity and served from per-thread free lists.
+	 * Per-thread lists are refilled from and drained to a global per-class list in batches, so the global lock is rarely taken.
+	 * A block may be freed from any thread, it just goes to the cache of the freeing thread. Bigger blocks are forwarded to ::operator new.
+	 * Memory of pooled blocks is never returned to the system.
+	 */
+	struct SizeClassPool
+	{
+		static const size_t Granularity = 16;
+		static const size_t MaxPooledSize = 256;
+
+		static void* Allocate(size_t size);
+		static void Deallocate(void* ptr, size_t size);
+	};
+
+
+	/**
+	 * @brief Size-class pool of byte buffers
+	 * @details Buffers up to SizeClassPool::MaxPooledSize bytes are served by SizeClassPool. Bigger ones up to MaxPooledSize bytes are rounded up
+	 * to a power of two and recycled through global per-class free lists, each of which keeps at most MaxCachedBytes of spare buffers.
+	 * Even bigger buffers are forwarded to ::operator new.
+	 */
+	struct ByteBufferPool
+	{
+		static const size_t MaxPooledSize = 64 * 1024;
+		static const size_t MaxCachedBytes = 1024 * 1024;
+
+		/// @returns Size of the buffer, which is actually allocated for given size
+		static size_t GetCapacity(size_t size);
+
+		/// @brief Allocates buffer of GetCapacity(size) bytes
+		static void* Allocate(size_t size);
+
+		/// @param capacity Value of GetCapacity for the size the buffer was allocated with
+		static void Deallocate(void* ptr, size_t capacity);
+	};
+
+
+	/** @brief Stateless std-compatible allocator over SizeClassPool, suitable for allocate_shared_ptr and std containers */
+	template < typename T >
+	class PoolAllocator
+	{
+	public:
+		using value_type = T;
+
+		template < typename U >
+		struct rebind
+		{ using other = PoolAllocator<U>; };
+
+	public:
+		PoolAllocator()
+		{ }
+
+		template < typename U >
+		PoolAllocator(const PoolAllocator<U>&)
+		{ }
+
+		T* allocate(size_t n)
+		{
+			static_assert(alignof(T) <= SizeClassPool::Granularity, "Overaligned types are not supported");
+
+			if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+				throw std::bad_alloc();
+
+			return static_cast<T*>(SizeClassPool::Allocate(n * sizeof(T)));
+		}
+
+		void deallocate(T* ptr, size_t n)
+		{ SizeClassPool::Deallocate(ptr, n * sizeof(T)); }
+	};
+
+
+	template < typename T, typename U >
+	bool operator == (const PoolAllocator<T>&, const PoolAllocator<U>&)
+	{ return true; }
+
+
+	template < typename T, typename U >
+	bool operator != (const PoolAllocator<T>&, const PoolAllocator<U>&)
+	{ return false; }
+
+	/** @} */
+
+}
+
+#endif
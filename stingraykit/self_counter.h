@@ -9,7 +9,7 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #include <stingraykit/dynamic_caster.h>
-#include <stingraykit/thread/atomic/AtomicInt.h>
+#include <stingraykit/RefCountPolicies.h>
 
 #define STINGRAYKIT_DECLARE_SELF_COUNT_PTR(ClassName) \
 		using ClassName##SelfCountPtr = stingray::self_count_ptr<ClassName>
@@ -189,7 +189,11 @@ namespace stingray
 	STINGRAYKIT_GENERATE_NON_MEMBER_EQUALITY_OPERATORS_FROM_EQUAL(MK_PARAM(template < typename T, typename U >), self_count_ptr<T>, self_count_ptr<U>);
 
 
-	template < typename T >
+	/**
+	 * @brief Intrusive reference counter for self_count_ptr
+	 * @tparam RefCountPolicy_ AtomicRefCountPolicy (default) or LocalRefCountPolicy for objects confined to a single thread
+	 */
+	template < typename T, typename RefCountPolicy_ = AtomicRefCountPolicy >
 	class self_counter
 	{
 		STINGRAYKIT_NONCOPYABLE(self_counter);
@@ -198,7 +202,7 @@ namespace stingray
 		friend class self_count_ptr;
 
 	private:
-		mutable AtomicS32::Type		_value;
+		typename RefCountPolicy_::template Counter<s32>		_value;
 
 	public:
 		self_count_ptr<T> self_count_ptr_from_this()
@@ -214,7 +218,7 @@ namespace stingray
 		}
 
 		int use_count() const
-		{ return _value; }
+		{ return _value.Load(); }
 
 	protected:
 		self_counter()
@@ -227,13 +231,13 @@ namespace stingray
 	private:
 		void add_ref() const
 		{
-			const s32 count = AtomicS32::Inc(_value); (void)count;
+			const s32 count = _value.Inc(); (void)count;
 			STINGRAYKIT_DEBUG_ONLY(Detail::SelfCounterHelper::CheckAddRef(count));
 		}
 
 		void release_ref() const
 		{
-			const s32 count = AtomicS32::Dec(_value);
+			const s32 count = _value.Dec();
 			if (count == 0)
 			{
 				STINGRAYKIT_ANNOTATE_HAPPENS_AFTER(&_value);
@@ -247,6 +251,11 @@ namespace stingray
 	};
 
 
+	/// @brief self_counter with plain integer counter, self_count_ptr works with it as usual
+	template < typename T >
+	using local_self_counter = self_counter<T, LocalRefCountPolicy>;
+
+
 	template < typename SelfCountPtrT >
 	struct IsSelfCountPtr : FalseType { };
 
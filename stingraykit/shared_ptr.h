@@ -11,7 +11,7 @@
 #include <stingraykit/aligned_storage.h>
 #include <stingraykit/core/Dummy.h>
 #include <stingraykit/dynamic_caster.h>
-#include <stingraykit/thread/atomic/AtomicInt.h>
+#include <stingraykit/RefCountPolicies.h>
 #include <stingraykit/TypeErasure.h>
 #include <stingraykit/unique_ptr.h>
 
@@ -47,17 +47,22 @@ namespace stingray
 	namespace Detail
 	{
 
-		struct ISharedPtrData : public TypeErasureBase
+		template < typename RefCountPolicy_ >
+		struct BasicSharedPtrData : public TypeErasureBase
 		{
-			AtomicU32::Type			_strongReferences;
-			AtomicU32::Type			_weakReferences;
+			using CounterType = typename RefCountPolicy_::template Counter<u32>;
 
-			ISharedPtrData() : _strongReferences(1), _weakReferences(1)
+			CounterType				_strongReferences;
+			CounterType				_weakReferences;
+
+			BasicSharedPtrData() : _strongReferences(1), _weakReferences(1)
 			{ }
 		};
 
-		template < typename T >
-		class DefaultSharedPtrData : public ISharedPtrData
+		using ISharedPtrData = BasicSharedPtrData<AtomicRefCountPolicy>;
+
+		template < typename T, typename Base_ = ISharedPtrData >
+		class DefaultSharedPtrData : public Base_
 		{
 		private:
 			T*						_ptr;
@@ -70,8 +75,8 @@ namespace stingray
 			{ CheckedDelete(_ptr); }
 		};
 
-		template < typename T, typename Deleter >
-		class DeleterSharedPtrData : public ISharedPtrData
+		template < typename T, typename Deleter, typename Base_ = ISharedPtrData >
+		class DeleterSharedPtrData : public Base_
 		{
 			using DeleterType = typename Decay<Deleter>::ValueT;
 
@@ -87,8 +92,8 @@ namespace stingray
 			{ _deleter(_ptr); }
 		};
 
-		template < typename T >
-		class InplaceSharedPtrData : public ISharedPtrData
+		template < typename T, typename Base_ = ISharedPtrData >
+		class InplaceSharedPtrData : public Base_
 		{
 		private:
 			StorageFor<T>			_storage;
@@ -112,26 +117,34 @@ namespace stingray
 			{ t.Dispose(); }
 		};
 
-		class SharedPtrImpl
+		template < typename RefCountPolicy_ >
+		class BasicSharedPtrImpl
 		{
-			STINGRAYKIT_DEFAULTCOPYABLE(SharedPtrImpl);
-			STINGRAYKIT_DEFAULTMOVABLE(SharedPtrImpl);
+			STINGRAYKIT_DEFAULTCOPYABLE(BasicSharedPtrImpl);
+			STINGRAYKIT_DEFAULTMOVABLE(BasicSharedPtrImpl);
+
+		public:
+			using DataType = BasicSharedPtrData<RefCountPolicy_>;
 
 		private:
-			TypeErasure<TypeList<DisposeConcept>, ISharedPtrData>	_value;
+			TypeErasure<TypeList<DisposeConcept>, DataType>		_value;
 
 		public:
-			SharedPtrImpl()
+			BasicSharedPtrImpl()
 			{ }
 
 			template < typename DataImpl_, typename... Ts >
 			DataImpl_* Allocate(Ts&&... args)
-			{ return _value.Allocate<DataImpl_>(std::forward<Ts>(args)...); }
+			{ return _value.template Allocate<DataImpl_>(std::forward<Ts>(args)...); }
+
+			template < typename DataImpl_, typename Allocator_, typename... Ts >
+			DataImpl_* AllocateUsing(const Allocator_& allocator, Ts&&... args)
+			{ return _value.template AllocateUsing<DataImpl_>(allocator, std::forward<Ts>(args)...); }
 
 			void AddWeakReference()
 			{
 				if (_value.Get())
-					AtomicU32::Inc(_value.Get()->_weakReferences);
+					_value.Get()->_weakReferences.Inc();
 			}
 
 			void ReleaseWeakReference()
@@ -139,7 +152,7 @@ namespace stingray
 				if (!_value.Get())
 					return;
 
-				u32 result = AtomicU32::Dec(_value.Get()->_weakReferences);
+				u32 result = _value.Get()->_weakReferences.Dec();
 				if (result == 0)
 				{
 					STINGRAYKIT_ANNOTATE_HAPPENS_AFTER(&_value.Get()->_weakReferences);
@@ -152,13 +165,13 @@ namespace stingray
 			}
 
 			u32 GetStrongReferences() const
-			{ return _value.Get() ? AtomicU32::Load(_value.Get()->_strongReferences) : 0; }
+			{ return _value.Get() ? _value.Get()->_strongReferences.Load() : 0; }
 
 			u32 AddStrongReference()
 			{
 				if (!_value.Get())
 					return 0;
-				return AtomicU32::Inc(_value.Get()->_strongReferences);
+				return _value.Get()->_strongReferences.Inc();
 			}
 
 			u32 ReleaseStrongReference()
@@ -166,7 +179,7 @@ namespace stingray
 				if (!_value.Get())
 					return 0;
 
-				u32 result = AtomicU32::Dec(_value.Get()->_strongReferences);
+				u32 result = _value.Get()->_strongReferences.Dec();
 				if (result == 0)
 				{
 					STINGRAYKIT_ANNOTATE_HAPPENS_AFTER(&_value.Get()->_strongReferences);
@@ -184,7 +197,7 @@ namespace stingray
 				if (!_value.Get())
 					return false;
 
-				u32 c = AtomicU32::CompareAndExchange(_value.Get()->_strongReferences, 1, 0);
+				u32 c = _value.Get()->_strongReferences.CompareAndExchange(1, 0);
 				if (c != 1)
 					return false;
 
@@ -199,10 +212,10 @@ namespace stingray
 				if (!_value.Get())
 					return 0;
 
-				u32 c = AtomicU32::Load(_value.Get()->_strongReferences);
+				u32 c = _value.Get()->_strongReferences.Load();
 				while (c != 0)
 				{
-					u32 newc = AtomicU32::CompareAndExchange(_value.Get()->_strongReferences, c, c + 1);
+					u32 newc = _value.Get()->_strongReferences.CompareAndExchange(c, c + 1);
 					if (newc == c)
 						return newc;
 					c = newc;
@@ -210,17 +223,19 @@ namespace stingray
 				return 0;
 			}
 
-			bool Before(const SharedPtrImpl& other) const
+			bool Before(const BasicSharedPtrImpl& other) const
 			{ return _value.Get() < other._value.Get(); }
 
 		private:
 			void Dispose()
 			{
-				_value.Call<DisposeConcept>();
+				_value.template Call<DisposeConcept>();
 				ReleaseWeakReference();
 			}
 		};
 
+		using SharedPtrImpl = BasicSharedPtrImpl<AtomicRefCountPolicy>;
+
 		void DoLogAddRef(const char* className, u32 refs, const void* objPtrVal, const void* sharedPtrPtrVal);
 
 		void DoLogReleaseRef(const char* className, u32 refs, const void* objPtrVal, const void* sharedPtrPtrVal);
@@ -244,40 +259,50 @@ namespace stingray
 	}
 
 
-	template < typename T >
+	template < typename T, typename RefCountPolicy_ = AtomicRefCountPolicy >
 	class weak_ptr;
 
 
-	template < typename T >
+	template < typename T, typename RefCountPolicy_ = AtomicRefCountPolicy >
 	struct MakeShared;
 
 
-	/** @brief Simple shared_ptr implementation */
-	template < typename T >
+	/**
+	 * @brief Simple shared_ptr implementation
+	 * @tparam RefCountPolicy_ AtomicRefCountPolicy (default) or LocalRefCountPolicy for objects confined to a single thread, see local_shared_ptr
+	 */
+	template < typename T, typename RefCountPolicy_ >
 	class shared_ptr
 	{
-		template < typename U >
+		template < typename U, typename RefCountPolicy__ >
 		friend class weak_ptr;
 
-		template < typename U >
+		template < typename U, typename RefCountPolicy__ >
 		friend class shared_ptr;
 
-		template < typename U >
+		template < typename U, typename RefCountPolicy__ >
 		friend struct MakeShared;
 
+		template < typename U >
+		friend struct AllocateShared;
+
 	public:
 		using ValueType = T;
 
+	private:
+		using Impl = Detail::BasicSharedPtrImpl<RefCountPolicy_>;
+		using Data = typename Impl::DataType;
+
 	private:
 		T*							_rawPtr;
-		Detail::SharedPtrImpl		_impl;
+		Impl						_impl;
 
 	private:
-		shared_ptr(T* rawPtr, const Detail::SharedPtrImpl& impl, const Dummy&)
+		shared_ptr(T* rawPtr, const Impl& impl, const Dummy&)
 			: _rawPtr(rawPtr), _impl(impl)
 		{ }
 
-		shared_ptr(T* rawPtr, Detail::SharedPtrImpl&& impl, const Dummy&)
+		shared_ptr(T* rawPtr, Impl&& impl, const Dummy&)
 			: _rawPtr(rawPtr), _impl(std::move(impl))
 		{ }
 
@@ -288,7 +313,7 @@ namespace stingray
 				return;
 
 			try
-			{ _impl.Allocate<Detail::DefaultSharedPtrData<T>>(_rawPtr); }
+			{ _impl.template Allocate<Detail::DefaultSharedPtrData<T, Data>>(_rawPtr); }
 			catch (...)
 			{
 				CheckedDelete(_rawPtr);
@@ -302,7 +327,22 @@ namespace stingray
 		shared_ptr(T* rawPtr, Deleter&& deleter) : _rawPtr(rawPtr)
 		{
 			try
-			{ _impl.Allocate<Detail::DeleterSharedPtrData<T, Deleter>>(_rawPtr, std::forward<Deleter>(deleter)); }
+			{ _impl.template Allocate<Detail::DeleterSharedPtrData<T, Deleter, Data>>(_rawPtr, std::forward<Deleter>(deleter)); }
+			catch (...)
+			{
+				deleter(_rawPtr);
+				throw;
+			}
+
+			LogAddRef(1);
+		}
+
+		/// @brief: Same as deleter constructor, but control block is allocated via given std-compatible allocator
+		template < typename Deleter, typename Allocator, typename EnableIf<!IsSame<Allocator, Dummy>::Value, int>::ValueT = 0 >
+		shared_ptr(T* rawPtr, Deleter&& deleter, const Allocator& allocator) : _rawPtr(rawPtr)
+		{
+			try
+			{ _impl.template AllocateUsing<Detail::DeleterSharedPtrData<T, Deleter, Data>>(allocator, _rawPtr, std::forward<Deleter>(deleter)); }
 			catch (...)
 			{
 				deleter(_rawPtr);
@@ -319,7 +359,7 @@ namespace stingray
 			if (!_rawPtr)
 				return;
 
-			_impl.Allocate<Detail::DefaultSharedPtrData<T>>(_rawPtr);
+			_impl.template Allocate<Detail::DefaultSharedPtrData<T, Data>>(_rawPtr);
 			other.release();
 
 			LogAddRef(1);
@@ -340,24 +380,24 @@ namespace stingray
 		{ other._rawPtr = null; }
 
 		template < typename U >
-		shared_ptr(const shared_ptr<U>& other, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0)
+		shared_ptr(const shared_ptr<U, RefCountPolicy_>& other, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0)
 			: _rawPtr(other._rawPtr), _impl(other._impl)
 		{ LogAddRef(_impl.AddStrongReference()); }
 
 		template < typename U >
-		shared_ptr(shared_ptr<U>&& other, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0)
+		shared_ptr(shared_ptr<U, RefCountPolicy_>&& other, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0)
 			: _rawPtr(other._rawPtr), _impl(std::move(other._impl))
 		{ other._rawPtr = null; }
 
 		/// @brief: Aliasing constuctor - similar to standard one
 		template < typename U >
-		shared_ptr(const shared_ptr<U>& other, T* ptr)
+		shared_ptr(const shared_ptr<U, RefCountPolicy_>& other, T* ptr)
 			: _rawPtr(ptr), _impl(other._impl)
 		{ LogAddRef(_impl.AddStrongReference()); }
 
 		/// @brief: Aliasing constuctor - similar to standard one from C++20
 		template < typename U >
-		shared_ptr(shared_ptr<U>&& other, T* ptr)
+		shared_ptr(shared_ptr<U, RefCountPolicy_>&& other, T* ptr)
 			: _rawPtr(ptr), _impl(std::move(other._impl))
 		{ other._rawPtr = null; }
 
@@ -387,7 +427,7 @@ namespace stingray
 		}
 
 		template < typename U >
-		typename EnableIf<IsConvertible<U*, T*>::Value, shared_ptr&>::ValueT operator = (const shared_ptr<U>& other)
+		typename EnableIf<IsConvertible<U*, T*>::Value, shared_ptr&>::ValueT operator = (const shared_ptr<U, RefCountPolicy_>& other)
 		{
 			shared_ptr tmp(other);
 			swap(tmp);
@@ -395,7 +435,7 @@ namespace stingray
 		}
 
 		template < typename U >
-		typename EnableIf<IsConvertible<U*, T*>::Value, shared_ptr&>::ValueT operator = (shared_ptr<U>&& other)
+		typename EnableIf<IsConvertible<U*, T*>::Value, shared_ptr&>::ValueT operator = (shared_ptr<U, RefCountPolicy_>&& other)
 		{
 			shared_ptr tmp(std::move(other));
 			swap(tmp);
@@ -413,7 +453,7 @@ namespace stingray
 		bool is_initialized() const								{ return _rawPtr != 0; }
 		explicit operator bool () const							{ return is_initialized(); }
 
-		weak_ptr<T> weak() const								{ return weak_ptr<T>(*this); }
+		weak_ptr<T, RefCountPolicy_> weak() const				{ return weak_ptr<T, RefCountPolicy_>(*this); }
 
 		bool release_if_unique()
 		{
@@ -422,7 +462,7 @@ namespace stingray
 
 			LogReleaseRef(0);
 			_rawPtr = null;
-			_impl = Detail::SharedPtrImpl();
+			_impl = Impl();
 			return true;
 		}
 
@@ -463,11 +503,11 @@ namespace stingray
 		}
 
 		template < typename U >
-		bool owner_before(const shared_ptr<U>& other) const
+		bool owner_before(const shared_ptr<U, RefCountPolicy_>& other) const
 		{ return _impl.Before(other._impl); }
 
 		template < typename U >
-		bool owner_before(const weak_ptr<U>& other) const
+		bool owner_before(const weak_ptr<U, RefCountPolicy_>& other) const
 		{ return _impl.Before(other._impl); }
 
 	private:
@@ -488,36 +528,39 @@ namespace stingray
 	};
 
 
-	template < typename T >
-	bool operator == (const shared_ptr<T>& lhs, NullPtrType)
+	template < typename T, typename P >
+	bool operator == (const shared_ptr<T, P>& lhs, NullPtrType)
 	{ return !lhs.is_initialized(); }
-	STINGRAYKIT_GENERATE_NON_MEMBER_COMMUTATIVE_EQUALITY_OPERATORS_FROM_EQUAL(MK_PARAM(template < typename T >), shared_ptr<T>, NullPtrType);
+	STINGRAYKIT_GENERATE_NON_MEMBER_COMMUTATIVE_EQUALITY_OPERATORS_FROM_EQUAL(MK_PARAM(template < typename T, typename P >), MK_PARAM(shared_ptr<T, P>), NullPtrType);
 
 
-	template < typename T, typename U >
-	bool operator == (const shared_ptr<T>& lhs, const shared_ptr<U>& rhs)
+	template < typename T, typename U, typename P >
+	bool operator == (const shared_ptr<T, P>& lhs, const shared_ptr<U, P>& rhs)
 	{ return lhs.get() == rhs.get(); }
-	STINGRAYKIT_GENERATE_NON_MEMBER_EQUALITY_OPERATORS_FROM_EQUAL(MK_PARAM(template < typename T, typename U >), shared_ptr<T>, shared_ptr<U>);
+	STINGRAYKIT_GENERATE_NON_MEMBER_EQUALITY_OPERATORS_FROM_EQUAL(MK_PARAM(template < typename T, typename U, typename P >), MK_PARAM(shared_ptr<T, P>), MK_PARAM(shared_ptr<U, P>));
 
 
-	template < typename T >
-	void swap(shared_ptr<T>& lhs, shared_ptr<T>& rhs)
+	template < typename T, typename P >
+	void swap(shared_ptr<T, P>& lhs, shared_ptr<T, P>& rhs)
 	{ lhs.swap(rhs); }
 
 
 	/** @brief Simple weak_ptr implementation */
-	template < typename T >
+	template < typename T, typename RefCountPolicy_ >
 	class weak_ptr
 	{
-		template < typename U >
+		template < typename U, typename RefCountPolicy__ >
 		friend class weak_ptr;
 
-		template < typename U >
+		template < typename U, typename RefCountPolicy__ >
 		friend class shared_ptr;
 
 	private:
-		T*									_rawPtr;
-		mutable Detail::SharedPtrImpl		_impl;
+		using Impl = Detail::BasicSharedPtrImpl<RefCountPolicy_>;
+
+	private:
+		T*							_rawPtr;
+		mutable Impl				_impl;
 
 	public:
 		weak_ptr() : _rawPtr()
@@ -527,7 +570,7 @@ namespace stingray
 		{ }
 
 		template < typename U >
-		weak_ptr(const shared_ptr<U>& other, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0)
+		weak_ptr(const shared_ptr<U, RefCountPolicy_>& other, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0)
 			: _rawPtr(other._rawPtr), _impl(other._impl)
 		{ _impl.AddWeakReference(); }
 
@@ -540,12 +583,12 @@ namespace stingray
 		{ other._rawPtr = null; }
 
 		template < typename U >
-		weak_ptr(const weak_ptr<U>& other, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0)
+		weak_ptr(const weak_ptr<U, RefCountPolicy_>& other, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0)
 			: _rawPtr(other._rawPtr), _impl(other._impl)
 		{ _impl.AddWeakReference(); }
 
 		template < typename U >
-		weak_ptr(weak_ptr<U>&& other, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0)
+		weak_ptr(weak_ptr<U, RefCountPolicy_>&& other, typename EnableIf<IsConvertible<U*, T*>::Value, int>::ValueT = 0)
 			: _rawPtr(other._rawPtr), _impl(std::move(other._impl))
 		{ other._rawPtr = null; }
 
@@ -567,7 +610,7 @@ namespace stingray
 		}
 
 		template < typename U >
-		typename EnableIf<IsConvertible<U*, T*>::Value, weak_ptr&>::ValueT operator = (const shared_ptr<U>& other)
+		typename EnableIf<IsConvertible<U*, T*>::Value, weak_ptr&>::ValueT operator = (const shared_ptr<U, RefCountPolicy_>& other)
 		{
 			weak_ptr tmp(other);
 			swap(tmp);
@@ -575,7 +618,7 @@ namespace stingray
 		}
 
 		template < typename U >
-		typename EnableIf<IsConvertible<U*, T*>::Value, weak_ptr&>::ValueT operator = (const weak_ptr<U>& other)
+		typename EnableIf<IsConvertible<U*, T*>::Value, weak_ptr&>::ValueT operator = (const weak_ptr<U, RefCountPolicy_>& other)
 		{
 			weak_ptr tmp(other);
 			swap(tmp);
@@ -583,14 +626,14 @@ namespace stingray
 		}
 
 		template < typename U >
-		typename EnableIf<IsConvertible<U*, T*>::Value, weak_ptr&>::ValueT operator = (weak_ptr<U>&& other)
+		typename EnableIf<IsConvertible<U*, T*>::Value, weak_ptr&>::ValueT operator = (weak_ptr<U, RefCountPolicy_>&& other)
 		{
 			weak_ptr tmp(std::move(other));
 			swap(tmp);
 			return *this;
 		}
 
-		shared_ptr<T> lock() const
+		shared_ptr<T, RefCountPolicy_> lock() const
 		{
 			const u32 sc = _impl.TryAddStrongReference();
 			if (sc == 0)
@@ -599,7 +642,7 @@ namespace stingray
 			if (_rawPtr)
 				Detail::SharedPtrRefCounter<T>::LogAddRef(sc, _rawPtr, this);
 
-			return shared_ptr<T>(_rawPtr, _impl, Dummy());
+			return shared_ptr<T, RefCountPolicy_>(_rawPtr, _impl, Dummy());
 		}
 
 		void reset()
@@ -621,17 +664,17 @@ namespace stingray
 		{ return use_count() == 0; }
 
 		template < typename U >
-		bool owner_before(const shared_ptr<U>& other) const
+		bool owner_before(const shared_ptr<U, RefCountPolicy_>& other) const
 		{ return _impl.Before(other._impl); }
 
 		template < typename U >
-		bool owner_before(const weak_ptr<U>& other) const
+		bool owner_before(const weak_ptr<U, RefCountPolicy_>& other) const
 		{ return _impl.Before(other._impl); }
 	};
 
 
-	template < typename T >
-	void swap(weak_ptr<T>& lhs, weak_ptr<T>& rhs)
+	template < typename T, typename P >
+	void swap(weak_ptr<T, P>& lhs, weak_ptr<T, P>& rhs)
 	{ lhs.swap(rhs); }
 
 
@@ -778,20 +821,22 @@ namespace stingray
 	};
 
 
-	template < typename ObjType >
+	template < typename ObjType, typename RefCountPolicy_ >
 	struct MakeShared
 	{
-		using RetType = shared_ptr<ObjType>;
+		using RetType = shared_ptr<ObjType, RefCountPolicy_>;
 
 		template < typename... Ts >
-		shared_ptr<ObjType> operator () (Ts&&... args) const
+		RetType operator () (Ts&&... args) const
 		{
 			(void)sizeof(new ObjType(std::forward<Ts>(args)...)); // Testing the type for being abstract
 
-			Detail::SharedPtrImpl impl;
-			Detail::InplaceSharedPtrData<ObjType>* data = impl.Allocate<Detail::InplaceSharedPtrData<ObjType>>(std::forward<Ts>(args)...);
+			using Data = Detail::InplaceSharedPtrData<ObjType, Detail::BasicSharedPtrData<RefCountPolicy_>>;
 
-			const shared_ptr<ObjType> result(data->Get(), std::move(impl), Dummy());
+			Detail::BasicSharedPtrImpl<RefCountPolicy_> impl;
+			Data* data = impl.template Allocate<Data>(std::forward<Ts>(args)...);
+
+			const RetType result(data->Get(), std::move(impl), Dummy());
 			Detail::SharedPtrRefCounter<ObjType>::LogAddRef(1, result.get(), &result);
 
 			return result;
@@ -804,11 +849,38 @@ namespace stingray
 	{ return MakeShared<ObjType>()(std::forward<Ts>(args)...); }
 
 
-	template < typename T >
-	struct IsNullable<shared_ptr<T>> : public TrueType { };
+	/// @brief Same as MakeShared, but the object and its control block are placed in a single block obtained from given std-compatible allocator
+	template < typename ObjType >
+	struct AllocateShared
+	{
+		using RetType = shared_ptr<ObjType>;
 
-	template < typename T >
-	struct IsNullable<weak_ptr<T>> : public TrueType { };
+		template < typename Allocator, typename... Ts >
+		shared_ptr<ObjType> operator () (const Allocator& allocator, Ts&&... args) const
+		{
+			(void)sizeof(new ObjType(std::forward<Ts>(args)...)); // Testing the type for being abstract
+
+			Detail::SharedPtrImpl impl;
+			Detail::InplaceSharedPtrData<ObjType>* data = impl.AllocateUsing<Detail::InplaceSharedPtrData<ObjType>>(allocator, std::forward<Ts>(args)...);
+
+			const shared_ptr<ObjType> result(data->Get(), std::move(impl), Dummy());
+			Detail::SharedPtrRefCounter<ObjType>::LogAddRef(1, result.get(), &result);
+
+			return result;
+		}
+	};
+
+
+	template < typename ObjType, typename Allocator, typename... Ts >
+	shared_ptr<ObjType> allocate_shared_ptr(const Allocator& allocator, Ts&&... args)
+	{ return AllocateShared<ObjType>()(allocator, std::forward<Ts>(args)...); }
+
+
+	template < typename T, typename P >
+	struct IsNullable<shared_ptr<T, P>> : public TrueType { };
+
+	template < typename T, typename P >
+	struct IsNullable<weak_ptr<T, P>> : public TrueType { };
 
 }
 
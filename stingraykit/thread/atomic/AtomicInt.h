@@ -76,6 +76,9 @@ namespace stingray
 			{ return __sync_val_compare_and_swap(&atomic, oldVal, newVal); }
 		};
 
+		inline void AtomicThreadFenceImpl(MemoryOrderImpl::Enum order)
+		{ __sync_synchronize(); }
+
 #elif HAVE_ATOMIC_BUILTINS
 
 		struct MemoryOrderImpl
@@ -106,6 +109,9 @@ namespace stingray
 #error "No CompareAndExchange implemented"
 		};
 
+		inline void AtomicThreadFenceImpl(MemoryOrderImpl::Enum order)
+		{ __atomic_thread_fence(order); }
+
 #elif HAVE_SYNC_EAA || HAVE_SYNC_EAA_EXT
 
 		typedef FallbackMemoryOrderImpl MemoryOrderImpl;
@@ -132,6 +138,9 @@ namespace stingray
 			}
 		};
 
+		inline void AtomicThreadFenceImpl(MemoryOrderImpl::Enum order)
+		{ __sync_synchronize(); }
+
 #elif HAVE_ATOMIC_H
 
 		typedef FallbackMemoryOrderImpl MemoryOrderImpl;
@@ -151,6 +160,9 @@ namespace stingray
 			static inline IntType CompareAndExchange(Type& atomic, IntType oldVal, IntType newVal) { return atomic_compare_and_exchange_val_acq(&atomic, newVal, oldVal); }
 		};
 
+		inline void AtomicThreadFenceImpl(MemoryOrderImpl::Enum order)
+		{ atomic_full_barrier(); }
+
 #else
 #	error "No atomics implemented!"
 #endif
@@ -234,6 +246,11 @@ namespace stingray
 		{ return Detail::AtomicIntImpl<IntType>::CompareAndExchange(atomic, oldVal, newVal); }
 	};
 
+	/// @brief Orders memory accesses around the fence, e.g. MemoryOrderSeqCst keeps a store before the fence from being reordered with a load after it
+	inline void AtomicThreadFence(MemoryOrder order = MemoryOrderSeqCst)
+	{ Detail::AtomicThreadFenceImpl((Detail::MemoryOrderImpl::Enum)order); }
+
+
 	typedef BasicAtomicInt<u32> AtomicU32;
 	typedef BasicAtomicInt<s32> AtomicS32;
 	typedef BasicAtomicInt<u64> AtomicU64;
@@ -55,6 +55,7 @@
 			{ } \
 		}; \
 		static __thread Type_* s_value; \
+		static __thread bool s_destroyed; \
 	public: \
 		DETAIL_STINGRAYKIT_TLS_GET_ATTR static Type_& Get() \
 		{ \
@@ -71,12 +72,20 @@
 			} \
 			return *s_value; \
 		} \
+		/* Returns null once the value of the calling thread is destroyed on its exit, so that later thread exit destructors do not recreate it */ \
+		DETAIL_STINGRAYKIT_TLS_GET_ATTR static Type_* TryGet() \
+		{ return s_destroyed ? NULL : &Get(); } \
 	private: \
 		static void Dtor(void* val) \
-		{ ValueHolder* holder = static_cast<ValueHolder*>(val); stingray::CheckedDelete(holder); } \
+		{ \
+			s_value = NULL; \
+			s_destroyed = true; \
+			ValueHolder* holder = static_cast<ValueHolder*>(val); \
+			stingray::CheckedDelete(holder); \
+		} \
 	};
 
-#	define STINGRAYKIT_DEFINE_THREAD_LOCAL(Type_, Name_) __thread Type_* Name_::s_value = NULL
+#	define STINGRAYKIT_DEFINE_THREAD_LOCAL(Type_, Name_) __thread Type_* Name_::s_value = NULL; __thread bool Name_::s_destroyed = false
 #else
 #	error "No thread local storage!"
 #endif
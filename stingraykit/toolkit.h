@@ -118,7 +118,9 @@ namespace stingray
 	{ return InstanceOfTester<SrcType>::template Test<DestType>(obj); }
 
 
-	template < typename T >
+	struct AtomicRefCountPolicy;
+
+	template < typename T, typename RefCountPolicy_ = AtomicRefCountPolicy >
 	class shared_ptr;
 
 
@@ -7,7 +7,7 @@
 
 #include <unittests/Dummy.h>
 
-#include <stingraykit/shared_ptr.h>
+#include <stingraykit/local_shared_ptr.h>
 #include <stingraykit/self_counter.h>
 
 #include <gtest/gtest.h>
@@ -27,6 +27,13 @@ protected:
 		EvilDummy(FireRange *parent, bool verbose = false): Dummy(parent, verbose) {}
 	};
 	STINGRAYKIT_DECLARE_SELF_COUNT_PTR(EvilDummy);
+	STINGRAYKIT_DECLARE_LOCAL_PTR(Dummy);
+
+	struct LocalEvilDummy : public Dummy, public local_self_counter<LocalEvilDummy>
+	{
+		LocalEvilDummy(FireRange *parent, bool verbose = false): Dummy(parent, verbose) {}
+	};
+	STINGRAYKIT_DECLARE_SELF_COUNT_PTR(LocalEvilDummy);
 
 	struct DeleterTester
 	{
@@ -171,3 +178,60 @@ TEST_F(PointersTest, SelfCount)
 	}
 	ASSERT_EQ(Counter, 0);
 }
+
+
+TEST_F(PointersTest, LocalSharedPtr)
+{
+	Counter = 0;
+	{
+		DummyLocalPtr ptr(new Dummy(this));
+		ASSERT_EQ(Counter, 1);
+		ASSERT_EQ(ptr.use_count(), 1u);
+
+		DummyLocalPtr ptr2 = ptr;
+		ASSERT_EQ(ptr.use_count(), 2u);
+
+		DummyLocalWeakPtr weak = ptr;
+		ptr.reset();
+		ASSERT_EQ(Counter, 1);
+		ASSERT_EQ(weak.lock(), ptr2);
+
+		ptr2.reset();
+		ASSERT_EQ(Counter, 0);
+		ASSERT_TRUE(weak.expired());
+		ASSERT_FALSE(weak.lock());
+
+		ptr = make_local_shared_ptr<Dummy>(this);
+		ASSERT_EQ(Counter, 1);
+		ASSERT_TRUE(ptr.unique());
+	}
+	ASSERT_EQ(Counter, 0);
+}
+
+
+TEST_F(PointersTest, LocalSharedPtrDeleter)
+{
+	int dtor_invokations = 0;
+	int deleter_invokations = 0;
+	local_shared_ptr<DeleterTester> tester(new DeleterTester(dtor_invokations, deleter_invokations), &DoDelete);
+	tester.reset();
+	ASSERT_EQ(dtor_invokations, 1);
+	ASSERT_EQ(deleter_invokations, 1);
+}
+
+
+TEST_F(PointersTest, LocalSelfCount)
+{
+	Counter = 0;
+	{
+		LocalEvilDummySelfCountPtr x;
+		LocalEvilDummySelfCountPtr y(new LocalEvilDummy(this));
+		ASSERT_EQ(Counter, 1);
+		x = y;
+		ASSERT_EQ(x.use_count(), 2u);
+		y.reset();
+		ASSERT_EQ(Counter, 1);
+		ASSERT_TRUE(x.unique());
+	}
+	ASSERT_EQ(Counter, 0);
+}
@@ -0,0 +1,259 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/RecyclingObjectPool.h>
+
+#include <stingraykit/collection/ByteData.h>
+#include <stingraykit/function/bind.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/time/ElapsedTime.h>
+
+#include <gtest/gtest.h>
+
+using namespace stingray;
+
+namespace
+{
+
+	struct Counted
+	{
+		static int		Constructions;
+		static int		Destructions;
+
+		int				Value;
+
+		Counted() : Value()
+		{ ++Constructions; }
+
+		Counted(const Counted& other) : Value(other.Value)
+		{ ++Constructions; }
+
+		~Counted()
+		{ ++Destructions; }
+	};
+
+	int Counted::Constructions = 0;
+	int Counted::Destructions = 0;
+
+
+	struct Throwing
+	{
+		Throwing()
+		{ throw std::runtime_error("ctor"); }
+	};
+
+
+	void ResetCounted(Counted& counted)
+	{ counted.Value = 0; }
+
+	ByteArray MakePacket()
+	{ return ByteArray(1500); }
+
+
+	using IntPool = RecyclingObjectPool<int>;
+
+	void AcquireRelease(IntPool& pool, size_t iterations)
+	{
+		std::vector<IntPool::Handle> window(16);
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			IntPool::Handle& handle = window[i % window.size()];
+			handle = pool.Acquire();
+			*handle = i;
+		}
+	}
+
+	void ReleaseAll(std::vector<IntPool::Handle>& handles)
+	{ handles.clear(); }
+
+
+	const size_t ChurnIterations = 1000000;
+	const size_t ChurnThreads = 4;
+
+	void ChurnPooled(RecyclingObjectPool<ByteArray>& pool)
+	{
+		for (size_t i = 0; i < ChurnIterations; ++i)
+			pool.Acquire()->data()[0] = i;
+	}
+
+	void ChurnAllocated()
+	{
+		for (size_t i = 0; i < ChurnIterations; ++i)
+			MakePacket().data()[0] = i;
+	}
+
+	template < typename Func >
+	s64 MeasureChurn(const Func& func)
+	{
+		ElapsedTime elapsed;
+		{
+			std::vector<ThreadPtr> threads;
+			for (size_t i = 0; i < ChurnThreads; ++i)
+				threads.push_back(make_shared_ptr<Thread>(StringBuilder() % "churn" % i, func));
+		}
+		return elapsed.ElapsedMilliseconds();
+	}
+
+}
+
+
+TEST(RecyclingObjectPoolTest, Reuse)
+{
+	Counted::Constructions = Counted::Destructions = 0;
+
+	{
+		RecyclingObjectPool<Counted> pool;
+
+		Counted* first;
+		{
+			const RecyclingObjectPool<Counted>::Handle handle = pool.Acquire();
+			first = handle.get();
+			handle->Value = 42;
+		}
+
+		const RecyclingObjectPool<Counted>::Handle handle = pool.Acquire();
+		ASSERT_EQ(handle.get(), first);
+		ASSERT_EQ(handle->Value, 42);
+		ASSERT_EQ(pool.GetAllocatedCount(), 1u);
+
+		const RecyclingObjectPool<Counted>::Handle other = pool.Acquire();
+		ASSERT_NE(other.get(), first);
+		ASSERT_EQ(pool.GetAllocatedCount(), 2u);
+		ASSERT_EQ(Counted::Destructions, 0);
+	}
+
+	ASSERT_EQ(Counted::Constructions, 2);
+	ASSERT_EQ(Counted::Destructions, 2);
+}
+
+
+TEST(RecyclingObjectPoolTest, ResetHook)
+{
+	RecyclingObjectPool<Counted> pool(null, &ResetCounted);
+
+	pool.Acquire()->Value = 42;
+	ASSERT_EQ(pool.Acquire()->Value, 0);
+}
+
+
+TEST(RecyclingObjectPoolTest, Factory)
+{
+	RecyclingObjectPool<ByteArray> pool(&MakePacket);
+
+	const RecyclingObjectPool<ByteArray>::Handle packet = pool.Acquire();
+	ASSERT_EQ(packet->size(), 1500u);
+}
+
+
+TEST(RecyclingObjectPoolTest, Shared)
+{
+	Counted::Constructions = Counted::Destructions = 0;
+
+	{
+		RecyclingObjectPool<Counted> pool;
+
+		Counted* first;
+		{
+			const shared_ptr<Counted> ptr = pool.AcquireShared();
+			const shared_ptr<Counted> copy = ptr;
+			first = ptr.get();
+		}
+
+		ASSERT_EQ(Counted::Destructions, 0);
+		ASSERT_EQ(pool.Acquire().get(), first);
+	}
+
+	ASSERT_EQ(Counted::Destructions, 1);
+}
+
+
+TEST(RecyclingObjectPoolTest, ThrowingConstructor)
+{
+	RecyclingObjectPool<Throwing> pool;
+
+	ASSERT_ANY_THROW(pool.Acquire());
+	ASSERT_EQ(pool.GetAllocatedCount(), 0u);
+}
+
+
+TEST(RecyclingObjectPoolTest, Handle)
+{
+	IntPool pool;
+
+	IntPool::Handle handle;
+	ASSERT_FALSE(handle);
+	ASSERT_ANY_THROW(*handle);
+
+	handle = pool.Acquire();
+	ASSERT_TRUE(handle);
+
+	IntPool::Handle moved(std::move(handle));
+	ASSERT_FALSE(handle);
+	ASSERT_TRUE(moved);
+
+	moved.reset();
+	ASSERT_FALSE(moved);
+}
+
+
+TEST(RecyclingObjectPoolTest, ManyObjects)
+{
+	IntPool pool;
+
+	std::vector<IntPool::Handle> handles;
+	for (size_t i = 0; i < 10000; ++i)
+	{
+		handles.push_back(pool.Acquire());
+		*handles.back() = i;
+	}
+
+	for (size_t i = 0; i < handles.size(); ++i)
+		ASSERT_EQ(*handles[i], (int)i);
+
+	handles.clear();
+
+	for (size_t i = 0; i < 10000; ++i)
+		handles.push_back(pool.Acquire());
+
+	ASSERT_EQ(pool.GetAllocatedCount(), 10000u);
+}
+
+
+TEST(RecyclingObjectPoolTest, CrossThread)
+{
+	IntPool pool;
+
+	std::vector<IntPool::Handle> handles;
+	for (size_t i = 0; i < 1000; ++i)
+		handles.push_back(pool.Acquire());
+
+	{
+		const Thread thread("poolRelease", Bind(&ReleaseAll, wrap_ref(handles)));
+	}
+
+	for (size_t i = 0; i < 1000; ++i)
+		handles.push_back(pool.Acquire());
+
+	ASSERT_EQ(pool.GetAllocatedCount(), 1000u);
+
+	{
+		std::vector<ThreadPtr> threads;
+		for (size_t i = 0; i < 4; ++i)
+			threads.push_back(make_shared_ptr<Thread>(StringBuilder() % "poolChurn" % i, Bind(&AcquireRelease, wrap_ref(pool), 100000)));
+	}
+}
+
+
+TEST(RecyclingObjectPoolTest, DISABLED_PacketChurnBenchmark)
+{
+	RecyclingObjectPool<ByteArray> pool(&MakePacket);
+
+	const s64 allocatedMs = MeasureChurn(Bind(&ChurnAllocated));
+	const s64 pooledMs = MeasureChurn(Bind(&ChurnPooled, wrap_ref(pool)));
+
+	Logger::Info() << "1500 byte packet churn, " << ChurnThreads << " threads x " << ChurnIterations << " iterations: allocated " << allocatedMs << " ms, pooled " << pooledMs << " ms";
+}
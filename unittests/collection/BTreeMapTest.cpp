@@ -0,0 +1,375 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/btree_map.h>
+
+#include <stingraykit/collection/BTreeMapDictionary.h>
+#include <stingraykit/collection/ForEach.h>
+#include <stingraykit/collection/MapDictionary.h>
+#include <stingraykit/collection/btree_set.h>
+#include <stingraykit/collection/dense_ordered_map.h>
+#include <stingraykit/collection/ordered_map.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/string/ToString.h>
+#include <stingraykit/time/ElapsedTime.h>
+
+#include <gmock/gmock-matchers.h>
+
+#include <map>
+#include <set>
+
+using namespace stingray;
+
+using ::testing::ElementsAre;
+
+namespace
+{
+
+	using BTreeMap = btree_map<std::string, std::string>;
+
+	using TransparentBTreeMap = btree_map<std::string, int, std::less<>>;
+
+	using Dictionary = BTreeMapDictionary<int, std::string>;
+
+	bool IsOdd(int key, const std::string&)
+	{ return key % 2 != 0; }
+
+	template < typename Map_ >
+	std::map<typename Map_::key_type, typename Map_::mapped_type> ToMap(const Map_& map)
+	{ return std::map<typename Map_::key_type, typename Map_::mapped_type>(map.begin(), map.end()); }
+
+	template < typename Map_ >
+	std::map<typename Map_::key_type, typename Map_::mapped_type> ToMapReversed(const Map_& map)
+	{ return std::map<typename Map_::key_type, typename Map_::mapped_type>(map.rbegin(), map.rend()); }
+
+}
+
+
+TEST(BTreeMapTest, Construction)
+{
+	{
+		BTreeMap testee;
+		EXPECT_TRUE(testee.empty());
+		EXPECT_EQ(testee.begin(), testee.end());
+		EXPECT_EQ(testee.rbegin(), testee.rend());
+	}
+	{
+		const std::vector<std::pair<std::string, std::string>> vec = { { "one", "jaws" }, { "two", "bite" }, { "three", "claws" }, { "two", "dup" } };
+
+		const BTreeMap testee(vec.begin(), vec.end());
+		EXPECT_EQ(testee.size(), 3u);
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("one", "jaws"), std::make_pair("three", "claws"), std::make_pair("two", "bite")));
+	}
+	{
+		const BTreeMap testee = { { "one", "jaws" }, { "two", "bite" } };
+
+		BTreeMap copy(testee);
+		ASSERT_EQ(copy, testee);
+
+		const BTreeMap moved(std::move(copy));
+		ASSERT_EQ(moved, testee);
+		ASSERT_TRUE(copy.empty());
+
+		copy = moved;
+		ASSERT_EQ(copy, testee);
+
+		copy = { { "three", "claws" } };
+		ASSERT_NE(copy, testee);
+		ASSERT_GT(copy, testee);
+		ASSERT_THAT(copy, ElementsAre(std::make_pair("three", "claws")));
+	}
+	{
+		btree_map<int, int> testee;
+		for (int i = 0; i < 10000; ++i)
+			testee.emplace_hint(testee.end(), i, i);
+
+		const btree_map<int, int> copy(testee);
+		ASSERT_EQ(copy, testee);
+		ASSERT_EQ(ToMap(copy), ToMap(testee));
+	}
+}
+
+
+TEST(BTreeMapTest, Modification)
+{
+	BTreeMap testee;
+
+	ASSERT_TRUE(testee.insert(std::make_pair("one", "jaws")).second);
+	ASSERT_FALSE(testee.insert(std::make_pair("one", "dup")).second);
+	ASSERT_TRUE(testee.emplace("two", "bite").second);
+	ASSERT_FALSE(testee.emplace("two", "dup").second);
+	ASSERT_TRUE(testee.try_emplace("three", "claws").second);
+	ASSERT_FALSE(testee.try_emplace("three", "dup").second);
+	ASSERT_EQ(testee.size(), 3u);
+
+	ASSERT_FALSE(testee.insert_or_assign("three", "catch").second);
+	ASSERT_TRUE(testee.insert_or_assign("four", "blow").second);
+	testee["five"] = "job";
+	testee["one"] = "two";
+
+	ASSERT_THAT(testee, ElementsAre(std::make_pair("five", "job"), std::make_pair("four", "blow"), std::make_pair("one", "two"),
+			std::make_pair("three", "catch"), std::make_pair("two", "bite")));
+
+	ASSERT_EQ(testee.at("four"), "blow");
+	ASSERT_THROW(testee.at("six"), KeyNotFoundException);
+
+	ASSERT_EQ(testee.lower_bound("o")->first, "one");
+	ASSERT_EQ(testee.upper_bound("one")->first, "three");
+	ASSERT_EQ(testee.upper_bound("two"), testee.end());
+
+	ASSERT_EQ(testee.erase("four"), 1u);
+	ASSERT_EQ(testee.erase("four"), 0u);
+	ASSERT_EQ(testee.find("four"), testee.end());
+
+	for (BTreeMap::iterator it = testee.begin(); it != testee.end(); )
+		if (it->first.size() == 3)
+			it = testee.erase(it);
+		else
+			++it;
+
+	ASSERT_THAT(testee, ElementsAre(std::make_pair("five", "job"), std::make_pair("three", "catch")));
+
+	testee.clear();
+	ASSERT_TRUE(testee.empty());
+	ASSERT_EQ(testee.begin(), testee.end());
+}
+
+
+TEST(BTreeMapTest, TransparentLookup)
+{
+	const TransparentBTreeMap testee = { { "one", 1 }, { "two", 2 } };
+
+	ASSERT_EQ(testee.find("one")->second, 1);
+	ASSERT_EQ(testee.find("three"), testee.end());
+	ASSERT_EQ(testee.count("two"), 1u);
+	ASSERT_EQ(testee.at("two"), 2);
+	ASSERT_EQ(testee.lower_bound("p")->first, "two");
+
+	const std::pair<TransparentBTreeMap::const_iterator, TransparentBTreeMap::const_iterator> range = testee.equal_range("one");
+	ASSERT_EQ(std::distance(range.first, range.second), 1);
+	ASSERT_EQ(range.first->first, "one");
+}
+
+
+TEST(BTreeMapTest, Sequential)
+{
+	btree_map<int, std::string> testee;
+	std::map<int, std::string> expected;
+
+	for (int i = 0; i < 5000; ++i)
+	{
+		testee.emplace(i, ToString(i));
+		expected.emplace(i, ToString(i));
+	}
+	for (int i = -1; i > -5000; --i)
+	{
+		testee.emplace(i, ToString(i));
+		expected.emplace(i, ToString(i));
+	}
+	ASSERT_EQ(ToMap(testee), expected);
+	ASSERT_EQ(ToMapReversed(testee), expected);
+
+	for (int i = -4999; i < 5000; i += 3)
+		ASSERT_EQ(testee.erase(i), 1u);
+	for (int i = 4999; i > -5000; --i)
+		testee.erase(i);
+
+	ASSERT_TRUE(testee.empty());
+	ASSERT_EQ(testee.begin(), testee.end());
+}
+
+
+TEST(BTreeMapTest, Random)
+{
+	btree_map<int, int> testee;
+	std::map<int, int> expected;
+
+	u32 random = 1;
+	for (int i = 0; i < 200000; ++i)
+	{
+		random = random * 1103515245 + 12345;
+		const int key = (int)((random >> 8) % 5000) - 2500;
+
+		switch ((random >> 4) % 4)
+		{
+		case 0:
+			ASSERT_EQ(testee.erase(key), expected.erase(key));
+			break;
+		case 1:
+			{
+				const btree_map<int, int>::iterator it = testee.lower_bound(key);
+				const std::map<int, int>::iterator expectedIt = expected.lower_bound(key);
+				ASSERT_EQ(it == testee.end(), expectedIt == expected.end());
+				if (it != testee.end())
+				{
+					ASSERT_EQ(*it, *expectedIt);
+
+					const btree_map<int, int>::iterator next = testee.erase(it);
+					const std::map<int, int>::iterator expectedNext = expected.erase(expectedIt);
+					ASSERT_EQ(next == testee.end(), expectedNext == expected.end());
+					if (next != testee.end())
+					{
+						ASSERT_EQ(*next, *expectedNext);
+					}
+				}
+			}
+			break;
+		default:
+			testee[key] = i;
+			expected[key] = i;
+		}
+
+		if (i % 20000 == 0)
+		{
+			ASSERT_EQ(ToMap(testee), expected);
+			ASSERT_EQ(ToMapReversed(testee), expected);
+			ASSERT_EQ(testee.size(), expected.size());
+		}
+	}
+
+	ASSERT_EQ(ToMap(testee), expected);
+
+	const std::map<int, int>::const_iterator expectedIt = expected.upper_bound(0);
+	ASSERT_EQ(std::distance(testee.upper_bound(0), testee.end()), std::distance(expectedIt, expected.cend()));
+
+	testee.erase(testee.lower_bound(-1000), testee.upper_bound(1000));
+	expected.erase(expected.lower_bound(-1000), expected.upper_bound(1000));
+	ASSERT_EQ(ToMap(testee), expected);
+}
+
+
+TEST(BTreeMapTest, Dictionary)
+{
+	const auto testee = make_shared_ptr<Dictionary>();
+	for (int i = 0; i < 1000; ++i)
+		ASSERT_TRUE(testee->Add(i, ToString(i)));
+	ASSERT_FALSE(testee->Add(5, "five"));
+	testee->Set(5, "five");
+
+	const auto enumerator = testee->GetEnumerator();
+	testee->Set(6, "six");
+
+	ASSERT_EQ(testee->Get(5), "five");
+	ASSERT_EQ(testee->Get(6), "six");
+	ASSERT_EQ(testee->GetCount(), 1000u);
+
+	int expected = 0;
+	FOR_EACH(const Dictionary::PairType pair IN enumerator)
+	{
+		ASSERT_EQ(pair.Key, expected++);
+		ASSERT_EQ(pair.Value, pair.Key == 5 ? "five" : ToString(pair.Key));
+	}
+	ASSERT_EQ(expected, 1000);
+
+	ASSERT_EQ(testee->RemoveWhere(&IsOdd), 500u);
+	ASSERT_TRUE(testee->ContainsKey(998));
+	ASSERT_FALSE(testee->ContainsKey(999));
+	ASSERT_TRUE(testee->Remove(0));
+	ASSERT_EQ(testee->GetCount(), 499u);
+}
+
+
+TEST(BTreeMapTest, DISABLED_Benchmark)
+{
+	const size_t Count = 1000000;
+	const size_t Lookups = 10000000;
+
+	std::vector<u32> keys(Count);
+	u32 random = 1;
+	for (u32& key : keys)
+		key = random = random * 1103515245 + 12345;
+
+	const auto measure = [&](const std::string& name, auto& map)
+	{
+		{
+			ElapsedTime elapsed;
+			for (u32 key : keys)
+				map.emplace(key, key);
+			Logger::Info() << name << ": random insertion " << elapsed.ElapsedMilliseconds() << " ms";
+		}
+		{
+			ElapsedTime elapsed;
+			size_t found = 0;
+			u32 missing = 7;
+			for (size_t i = 0; i < Lookups; ++i)
+			{
+				found += map.count(keys[(i * 7919) % Count]);
+				found += map.count(missing = missing * 1664525 + 1013904223);
+			}
+			Logger::Info() << name << ": lookup " << elapsed.ElapsedMilliseconds() << " ms, found " << found;
+		}
+		{
+			ElapsedTime elapsed;
+			u64 sum = 0;
+			for (size_t i = 0; i < 20; ++i)
+				for (const auto& pair : map)
+					sum += pair.second;
+			Logger::Info() << name << ": iteration " << elapsed.ElapsedMilliseconds() << " ms, sum " << sum;
+		}
+		{
+			ElapsedTime elapsed;
+			for (size_t i = 0; i < Count; i += 2)
+				map.erase(keys[i]);
+			Logger::Info() << name << ": erasure " << elapsed.ElapsedMilliseconds() << " ms, left " << map.size();
+		}
+		{
+			map.clear();
+			ElapsedTime elapsed;
+			for (u32 key = 0; key < Count; ++key)
+				map.emplace_hint(map.end(), key, key);
+			Logger::Info() << name << ": sorted insertion " << elapsed.ElapsedMilliseconds() << " ms";
+		}
+	};
+
+	{
+		std::map<u32, u32> map;
+		measure("std::map", map);
+	}
+	{
+		btree_map<u32, u32> map;
+		measure("btree_map", map);
+	}
+	{
+		std::map<u64, u64> map;
+		measure("std::map<u64>", map);
+	}
+	{
+		btree_map<u64, u64> map;
+		measure("btree_map<u64>", map);
+	}
+	{
+		ordered_map<u32, u32> map;
+		measure("ordered_map", map);
+	}
+	{
+		ordered_map<u32, u32, std::less<u32>, std::allocator<std::pair<const u32, u32>>, btree_set> map;
+		measure("ordered_map with btree_set index", map);
+	}
+	{
+		dense_ordered_map<u32, u32> map;
+		measure("dense_ordered_map", map);
+	}
+	{
+		dense_ordered_map<u32, u32, std::less<u32>, std::allocator<std::pair<const u32, u32>>, std::set> map;
+		measure("dense_ordered_map with std::set index", map);
+	}
+
+	const auto measureDictionary = [&](const std::string& name, auto dictionary)
+	{
+		ElapsedTime elapsed;
+		for (u32 key : keys)
+			dictionary->Set(key, key);
+
+		size_t found = 0;
+		for (size_t i = 0; i < Count; ++i)
+			found += dictionary->ContainsKey(keys[(i * 7919) % Count]);
+		Logger::Info() << name << ": " << elapsed.ElapsedMilliseconds() << " ms, found " << found;
+	};
+
+	measureDictionary("MapDictionary", make_shared_ptr<MapDictionary<u32, u32>>());
+	measureDictionary("BTreeMapDictionary", make_shared_ptr<BTreeMapDictionary<u32, u32>>());
+}
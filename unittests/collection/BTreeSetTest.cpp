@@ -0,0 +1,231 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/btree_set.h>
+
+#include <stingraykit/collection/BTreeSortedSet.h>
+#include <stingraykit/collection/ForEach.h>
+#include <stingraykit/collection/SortedSet.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/string/ToString.h>
+#include <stingraykit/time/ElapsedTime.h>
+
+#include <gmock/gmock-matchers.h>
+
+#include <set>
+
+using namespace stingray;
+
+using ::testing::ElementsAre;
+
+namespace
+{
+
+	using BTreeSet = btree_set<std::string>;
+
+	using TransparentBTreeSet = btree_set<std::string, std::less<>>;
+
+	bool IsEven(const int& value)
+	{ return value % 2 == 0; }
+
+	template < typename Set_, typename Random_ >
+	void TestRandom(Random_ random)
+	{
+		using Value = typename Set_::value_type;
+		using ExpectedSet = std::set<Value, typename Set_::key_compare>;
+
+		Set_ testee;
+		ExpectedSet expected;
+
+		u32 seed = 1;
+		for (int i = 0; i < 100000; ++i)
+		{
+			seed = seed * 1103515245 + 12345;
+			const Value value = random(seed >> 8);
+
+			switch ((seed >> 4) % 3)
+			{
+			case 0:
+				ASSERT_EQ(testee.erase(value), expected.erase(value));
+				break;
+			case 1:
+				ASSERT_EQ(*testee.insert(testee.upper_bound(value), value), value);
+				expected.insert(value);
+				break;
+			default:
+				ASSERT_EQ(testee.insert(value).second, expected.insert(value).second);
+			}
+
+			ASSERT_EQ(testee.lower_bound(value) == testee.end(), expected.lower_bound(value) == expected.end());
+		}
+
+		ASSERT_EQ(ExpectedSet(testee.begin(), testee.end()), expected);
+		ASSERT_EQ(ExpectedSet(testee.rbegin(), testee.rend()), expected);
+		ASSERT_EQ(testee.size(), expected.size());
+
+		for (const Value& value : expected)
+		{
+			ASSERT_EQ(*testee.lower_bound(value), value);
+			ASSERT_EQ(testee.upper_bound(value) == testee.end(), expected.upper_bound(value) == expected.end());
+		}
+	}
+
+	s32 MakeSigned(u32 seed)				{ return (s32)(seed % 20000) - 10000; }
+	u32 MakeUnsigned(u32 seed)				{ return seed % 20000 + 0x7FFFF000u; }
+	u64 MakeWide(u32 seed)					{ return (u64)(seed % 20000) << 32; }
+	std::string MakeString(u32 seed)		{ return ToString(seed % 3000); }
+
+}
+
+
+TEST(BTreeSetTest, Construction)
+{
+	{
+		BTreeSet testee;
+		EXPECT_TRUE(testee.empty());
+		EXPECT_EQ(testee.begin(), testee.end());
+	}
+	{
+		const std::vector<std::string> vec = { "one", "two", "three", "two" };
+
+		const BTreeSet testee(vec.begin(), vec.end());
+		EXPECT_EQ(testee.size(), 3u);
+		ASSERT_THAT(testee, ElementsAre("one", "three", "two"));
+	}
+	{
+		const BTreeSet testee = { "one", "two" };
+
+		BTreeSet copy(testee);
+		ASSERT_EQ(copy, testee);
+
+		copy = { "three" };
+		ASSERT_NE(copy, testee);
+		ASSERT_THAT(copy, ElementsAre("three"));
+	}
+}
+
+
+TEST(BTreeSetTest, Modification)
+{
+	BTreeSet testee;
+
+	ASSERT_TRUE(testee.insert("one").second);
+	ASSERT_FALSE(testee.insert("one").second);
+	ASSERT_TRUE(testee.emplace("two").second);
+	ASSERT_FALSE(testee.emplace("two").second);
+	ASSERT_EQ(*testee.insert(testee.end(), "three"), "three");
+	ASSERT_EQ(*testee.emplace_hint(testee.begin(), "four"), "four");
+	ASSERT_EQ(testee.size(), 4u);
+	ASSERT_THAT(testee, ElementsAre("four", "one", "three", "two"));
+
+	ASSERT_EQ(testee.erase("two"), 1u);
+	ASSERT_EQ(testee.erase("two"), 0u);
+	ASSERT_EQ(testee.count("two"), 0u);
+
+	ASSERT_EQ(testee.erase(testee.begin(), testee.end()), testee.end());
+	ASSERT_TRUE(testee.empty());
+}
+
+
+TEST(BTreeSetTest, TransparentLookup)
+{
+	const TransparentBTreeSet testee = { "one", "two" };
+
+	ASSERT_EQ(*testee.find("one"), "one");
+	ASSERT_EQ(testee.find("three"), testee.end());
+	ASSERT_EQ(testee.count("two"), 1u);
+	ASSERT_EQ(*testee.upper_bound("one"), "two");
+}
+
+
+TEST(BTreeSetTest, Random)
+{
+	TestRandom<btree_set<s32>>(&MakeSigned);
+	TestRandom<btree_set<u32, comparers::Less>>(&MakeUnsigned);
+	TestRandom<btree_set<u64>>(&MakeWide);
+	TestRandom<btree_set<s32, std::greater<s32>>>(&MakeSigned);
+	TestRandom<BTreeSet>(&MakeString);
+}
+
+
+TEST(BTreeSetTest, Set)
+{
+	const auto testee = make_shared_ptr<BTreeSortedSet<int>>();
+	for (int i = 0; i < 1000; ++i)
+		ASSERT_TRUE(testee->Add(i));
+	ASSERT_FALSE(testee->Add(5));
+
+	const auto enumerator = testee->GetEnumerator();
+	ASSERT_EQ(testee->RemoveWhere(&IsEven), 500u);
+	ASSERT_EQ(testee->GetCount(), 500u);
+	ASSERT_TRUE(testee->Contains(5));
+	ASSERT_FALSE(testee->Contains(4));
+
+	int expected = 0;
+	FOR_EACH(const int value IN enumerator)
+	{
+		ASSERT_EQ(value, expected++);
+	}
+	ASSERT_EQ(expected, 1000);
+
+	ASSERT_EQ(testee->Find(3)->Get(), 3);
+	ASSERT_FALSE(testee->Find(4)->Valid());
+
+	const auto reversed = testee->ReverseFind(5);
+	ASSERT_EQ(reversed->Get(), 5);
+	reversed->Next();
+	ASSERT_EQ(reversed->Get(), 3);
+}
+
+
+TEST(BTreeSetTest, DISABLED_Benchmark)
+{
+	const size_t Count = 1000000;
+	const size_t Lookups = 10000000;
+
+	std::vector<s32> values(Count);
+	u32 random = 1;
+	for (s32& value : values)
+		value = (s32)(random = random * 1103515245 + 12345);
+
+	const auto measure = [&](const std::string& name, auto& set)
+	{
+		ElapsedTime elapsed;
+		for (s32 value : values)
+			set.insert(value);
+		const s64 insertion = elapsed.ElapsedMilliseconds();
+
+		size_t found = 0;
+		for (size_t i = 0; i < Lookups; ++i)
+			found += set.count(values[(i * 7919) % Count]);
+		Logger::Info() << name << ": insertion " << insertion << " ms, lookup " << elapsed.ElapsedMilliseconds() - insertion << " ms, found " << found;
+	};
+
+	{
+		std::set<s32> set;
+		measure("std::set", set);
+	}
+	{
+		btree_set<s32> set;
+		measure("btree_set", set);
+	}
+
+	const auto measureSet = [&](const std::string& name, auto set)
+	{
+		ElapsedTime elapsed;
+		for (s32 value : values)
+			set->Add(value);
+
+		size_t found = 0;
+		for (size_t i = 0; i < Count; ++i)
+			found += set->Contains(values[(i * 7919) % Count]);
+		Logger::Info() << name << ": " << elapsed.ElapsedMilliseconds() << " ms, found " << found;
+	};
+
+	measureSet("SortedSet", make_shared_ptr<SortedSet<s32>>());
+	measureSet("BTreeSortedSet", make_shared_ptr<BTreeSortedSet<s32>>());
+}
@@ -0,0 +1,181 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/ByteData.h>
+#include <stingraykit/io/ByteArrayDataSource.h>
+#include <stingraykit/io/DataSourceReader.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/time/ElapsedTime.h>
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <sstream>
+
+using namespace stingray;
+
+namespace
+{
+
+	ByteArray MakeSequence(ByteArray array)
+	{
+		for (size_t i = 0; i < array.size(); ++i)
+			array[i] = (u8)i;
+		return array;
+	}
+
+
+	bool IsSequence(ConstByteData data, size_t first = 0)
+	{
+		for (size_t i = 0; i < data.size(); ++i)
+			if (data[i] != (u8)(first + i))
+				return false;
+		return true;
+	}
+
+
+	const size_t BenchmarkIterations = 200000;
+
+	template < typename Factory >
+	s64 MeasureCopies(const Factory& factory, ConstByteData packet)
+	{
+		ElapsedTime elapsed;
+		for (size_t i = 0; i < BenchmarkIterations; ++i)
+		{
+			ByteArray copy(factory(packet.size()));
+			std::copy(packet.data(), packet.data() + packet.size(), copy.data());
+		}
+		return elapsed.ElapsedMicroseconds();
+	}
+
+	ByteArray MakeZeroed(size_t size)
+	{ return ByteArray(size); }
+
+	ByteArray MakeUninitialized(size_t size)
+	{ return ByteArray::CreateUninitialized(size); }
+
+}
+
+
+TEST(ByteArrayTest, Uninitialized)
+{
+	const ByteArray array = MakeSequence(ByteArray::CreateUninitialized(1000));
+	ASSERT_EQ(array.size(), 1000u);
+	ASSERT_TRUE(IsSequence(array));
+
+	const ByteArray copy = array;
+	copy[10] = 42;
+	ASSERT_EQ(array[10], 42);
+
+	const ConstByteArray sub(array, 100, 50);
+	ASSERT_EQ(sub.size(), 50u);
+	ASSERT_EQ(sub[0], 100);
+	ASSERT_EQ(sub.data(), array.data() + 100);
+
+	ASSERT_TRUE(ByteArray::CreateUninitialized(0).empty());
+	ASSERT_EQ(ByteArray::CreateUninitialized(0).data(), (u8*)NULL);
+}
+
+
+TEST(ByteArrayTest, UninitializedRequireSize)
+{
+	ByteArray array = MakeSequence(ByteArray::CreateUninitialized(10));
+	const ByteArray copy = array;
+
+	array.RequireSize(12);
+	ASSERT_EQ(array.size(), 12u);
+	ASSERT_EQ(copy.size(), 12u);
+
+	array.RequireSize(5);
+	ASSERT_EQ(array.size(), 12u);
+
+	array.RequireSize(100000);
+	ASSERT_EQ(array.size(), 100000u);
+	ASSERT_TRUE(IsSequence(ByteData(array, 0, 10)));
+	ASSERT_EQ(array.data(), copy.data());
+	ASSERT_EQ(copy.size(), 100000u);
+}
+
+
+TEST(ByteArrayTest, UninitializedGrowthIsShared)
+{
+	ByteArray array = MakeSequence(ByteArray::CreateUninitialized(100));
+	const ByteArray copy = array;
+	const ByteArray sub(array, 50, 10);
+
+	const ByteArray chunk = MakeSequence(ByteArray(100));
+	for (size_t i = 0; i < 100; ++i)
+		array.append(chunk);
+
+	ASSERT_EQ(copy.size(), 10100u);
+	ASSERT_EQ(copy.data(), array.data());
+	ASSERT_TRUE(IsSequence(ByteData(copy, 10000, 100)));
+
+	ASSERT_EQ(sub.size(), 10u);
+	ASSERT_EQ(sub.data(), array.data() + 50);
+	ASSERT_EQ(sub[0], 50);
+
+	copy[0] = 42;
+	ASSERT_EQ(array[0], 42);
+}
+
+
+TEST(ByteArrayTest, UninitializedAppend)
+{
+	ByteArray array = ByteArray::CreateUninitialized(0);
+
+	const ByteArray chunk = MakeSequence(ByteArray(100));
+	for (size_t i = 0; i < 1000; ++i)
+		array.append(chunk);
+	ASSERT_EQ(array.size(), 100000u);
+
+	for (size_t i = 0; i < 1000; ++i)
+		ASSERT_TRUE(IsSequence(ByteData(array, i * 100, 100)));
+
+	const std::list<u8> list(3, 7);
+	array.append(list);
+	ASSERT_EQ(array.size(), 100003u);
+	ASSERT_EQ(array[100002], 7);
+
+	std::istringstream stream("1 2 3");
+	array.append(std::istream_iterator<int>(stream), std::istream_iterator<int>());
+	ASSERT_EQ(array.size(), 100006u);
+	ASSERT_EQ(array[100005], 3);
+
+	array.clear();
+	ASSERT_TRUE(array.empty());
+
+	array.reserve(5000);
+	const u8* const data = array.data();
+	array.append(ByteArray(5000));
+	ASSERT_EQ(array.size(), 5000u);
+	ASSERT_TRUE(data == NULL || data == array.data());
+}
+
+
+TEST(ByteArrayTest, ReadToEnd)
+{
+	const ByteArray data = MakeSequence(ByteArray(300000));
+
+	const ByteArray result = DataSourceReader(make_shared_ptr<ByteArrayDataSource>(data)).ReadToEnd();
+	ASSERT_EQ(result, data);
+}
+
+
+TEST(ByteArrayTest, DISABLED_UninitializedBenchmark)
+{
+	const size_t sizes[] = { 188, 1500, 64 * 1024 };
+	for (size_t size : sizes)
+	{
+		const ByteArray packet = MakeSequence(ByteArray(size));
+
+		const s64 zeroedUs = MeasureCopies(&MakeZeroed, packet);
+		const s64 uninitializedUs = MeasureCopies(&MakeUninitialized, packet);
+
+		Logger::Info() << BenchmarkIterations << " copies of " << size << " bytes: ByteArray(size) " << zeroedUs / 1000 << " ms, CreateUninitialized " << uninitializedUs / 1000 << " ms";
+	}
+}
@@ -0,0 +1,188 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/ByteRope.h>
+#include <stingraykit/io/ChunkedMemoryByteStream.h>
+#include <stingraykit/io/RopeByteStream.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/time/ElapsedTime.h>
+
+#include <gtest/gtest.h>
+
+using namespace stingray;
+
+namespace
+{
+
+	ConstByteArray MakeSegment(size_t first, size_t size)
+	{
+		ByteArray result(size);
+		for (size_t i = 0; i < size; ++i)
+			result[i] = (u8)(first + i);
+		return result;
+	}
+
+
+	ByteRope MakeRope(size_t segments, size_t segmentSize)
+	{
+		ByteRope result;
+		for (size_t i = 0; i < segments; ++i)
+			result.Append(MakeSegment(i * segmentSize, segmentSize));
+		return result;
+	}
+
+
+	bool IsSequence(ConstByteData data, size_t first)
+	{
+		for (size_t i = 0; i < data.size(); ++i)
+			if (data[i] != (u8)(first + i))
+				return false;
+		return true;
+	}
+
+}
+
+
+TEST(ByteRopeTest, Append)
+{
+	const ConstByteArray segment = MakeSegment(0, 10);
+
+	ByteRope rope;
+	rope.Append(segment);
+	rope.Append(ConstByteArray());
+	rope.Append(MakeSegment(10, 5));
+
+	ASSERT_EQ(rope.size(), 15u);
+	ASSERT_EQ(rope.GetSegmentsCount(), 2u);
+	ASSERT_EQ(rope.begin()->data(), segment.data());
+
+	for (u64 i = 0; i < rope.size(); ++i)
+		ASSERT_EQ(rope[i], (u8)i);
+	ASSERT_ANY_THROW(rope[15]);
+
+	ByteRope other(MakeSegment(15, 5));
+	rope.Append(other);
+	ASSERT_EQ(rope.size(), 20u);
+	ASSERT_EQ(rope[19], 19);
+
+	const ConstByteArray flat = rope.ToByteArray();
+	ASSERT_EQ(flat.size(), 20u);
+	ASSERT_TRUE(IsSequence(flat, 0));
+
+	ASSERT_EQ(ByteRope(segment).ToByteArray().data(), segment.data());
+	ASSERT_EQ(ConstByteDataSpan(rope.ToByteDataVector()).GetTotalSize(), 20u);
+}
+
+
+TEST(ByteRopeTest, Slice)
+{
+	const ByteRope rope = MakeRope(10, 100);
+
+	const ByteRope slice = rope.Slice(150, 300);
+	ASSERT_EQ(slice.size(), 300u);
+	ASSERT_EQ(slice.GetSegmentsCount(), 4u);
+	ASSERT_EQ(slice.begin()->data(), rope.begin()[1].data() + 50);
+	ASSERT_TRUE(IsSequence(slice.ToByteArray(), 150));
+
+	const ByteRope inner = rope.Slice(210, 20);
+	ASSERT_EQ(inner.GetSegmentsCount(), 1u);
+	ASSERT_TRUE(IsSequence(inner.ToByteArray(), 210));
+
+	ASSERT_TRUE(rope.Slice(1000, 0).empty());
+	ASSERT_EQ(rope.Slice(0, 1000).size(), 1000u);
+	ASSERT_ANY_THROW(rope.Slice(900, 101));
+}
+
+
+TEST(ByteRopeTest, CopyTo)
+{
+	const ByteRope rope = MakeRope(10, 100);
+
+	ByteArray buffer(250);
+	ASSERT_EQ(rope.CopyTo(420, buffer), 250u);
+	ASSERT_TRUE(IsSequence(buffer, 420));
+
+	ASSERT_EQ(rope.CopyTo(900, buffer), 100u);
+	ASSERT_TRUE(IsSequence(ByteData(buffer, 0, 100), 900));
+
+	ASSERT_EQ(rope.CopyTo(1000, buffer), 0u);
+	ASSERT_ANY_THROW(rope.CopyTo(1001, buffer));
+}
+
+
+TEST(ByteRopeTest, Stream)
+{
+	RopeByteStream stream(MakeRope(4, 100));
+
+	ByteArray buffer(150);
+	ASSERT_EQ(stream.Read(buffer), 150u);
+	ASSERT_TRUE(IsSequence(buffer, 0));
+	ASSERT_EQ(stream.Tell(), 150u);
+
+	stream.Seek(-20, SeekMode::End);
+	ASSERT_EQ(stream.Read(buffer), 20u);
+	ASSERT_TRUE(IsSequence(ByteData(buffer, 0, 20), 380));
+
+	const ConstByteArray data = MakeSegment(400, 30);
+	ASSERT_EQ(stream.Write(data), 30u);
+	stream.Append(MakeSegment(430, 70));
+	ASSERT_EQ(stream.GetData().size(), 500u);
+	ASSERT_EQ(stream.Tell(), 430u);
+
+	stream.Seek(100);
+	ASSERT_ANY_THROW(stream.Write(data));
+	ASSERT_ANY_THROW(stream.Seek(501));
+
+	stream.Seek(390);
+	ASSERT_EQ(stream.Read(buffer), 110u);
+	ASSERT_TRUE(IsSequence(ByteData(buffer, 0, 110), 390));
+}
+
+
+TEST(ByteRopeTest, DISABLED_SeekBenchmark)
+{
+	const size_t Segments = 10000;
+	const size_t SegmentSize = 188;
+	const size_t Reads = 100000;
+
+	const shared_ptr<std::vector<ByteArray>> chunks = make_shared_ptr<std::vector<ByteArray>>();
+	ByteRope rope;
+	for (size_t i = 0; i < Segments; ++i)
+	{
+		chunks->push_back(ByteArray(SegmentSize));
+		rope.Append(chunks->back());
+	}
+
+	ChunkedMemoryByteStream<ByteArray> chunked(chunks);
+	RopeByteStream roped(rope);
+
+	ByteArray buffer(64);
+	s64 chunkedMs = 0;
+	s64 ropedMs = 0;
+
+	{
+		ElapsedTime elapsed;
+		for (size_t i = 0; i < Reads; ++i)
+		{
+			chunked.Seek((i * 7919) % (Segments * SegmentSize - buffer.size()));
+			chunked.Read(buffer);
+		}
+		chunkedMs = elapsed.ElapsedMilliseconds();
+	}
+
+	{
+		ElapsedTime elapsed;
+		for (size_t i = 0; i < Reads; ++i)
+		{
+			roped.Seek((i * 7919) % (Segments * SegmentSize - buffer.size()));
+			roped.Read(buffer);
+		}
+		ropedMs = elapsed.ElapsedMilliseconds();
+	}
+
+	Logger::Info() << Reads << " random reads over " << Segments << " segments: ChunkedMemoryByteStream " << chunkedMs << " ms, RopeByteStream " << ropedMs << " ms";
+}
@@ -0,0 +1,1259 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/dense_ordered_map.h>
+
+#include <stingraykit/string/ToString.h>
+
+#include <gmock/gmock-matchers.h>
+
+#include <map>
+#include <set>
+
+using namespace stingray;
+
+using ::testing::ElementsAre;
+
+namespace
+{
+
+	using Vector = std::vector<std::pair<std::string, std::string>>;
+	using Map = std::map<std::string, std::string>;
+	using DenseOrderedMap = dense_ordered_map<std::string, std::string>;
+	using TransparentDenseOrderedMap = dense_ordered_map<std::string, std::string, std::less<>>;
+	using SetIndexDenseOrderedMap = dense_ordered_map<std::string, std::string, std::less<>, std::allocator<std::pair<const std::string, std::string>>, std::set>;
+
+
+	template < typename T >
+	struct FailingAllocator
+	{
+		using value_type = T;
+
+		size_t*			AllocationsLeft;
+
+		explicit FailingAllocator(size_t* allocationsLeft) : AllocationsLeft(allocationsLeft) { }
+
+		template < typename U >
+		FailingAllocator(const FailingAllocator<U>& other) : AllocationsLeft(other.AllocationsLeft) { }
+
+		T* allocate(size_t n)
+		{
+			if (*AllocationsLeft == 0)
+				throw std::bad_alloc();
+
+			--*AllocationsLeft;
+			return std::allocator<T>().allocate(n);
+		}
+
+		void deallocate(T* p, size_t n)
+		{ std::allocator<T>().deallocate(p, n); }
+
+		template < typename U >
+		bool operator == (const FailingAllocator<U>& other) const { return AllocationsLeft == other.AllocationsLeft; }
+		template < typename U >
+		bool operator != (const FailingAllocator<U>& other) const { return AllocationsLeft != other.AllocationsLeft; }
+	};
+
+
+	struct ThrowingCopyable
+	{
+		static size_t	CopiesLeft;
+
+		std::string		Value;
+
+		ThrowingCopyable(const std::string& value) : Value(value) { }
+
+		ThrowingCopyable(const ThrowingCopyable& other)
+			:	Value(other.Value)
+		{
+			if (CopiesLeft == 0)
+				throw std::runtime_error("Copy failed");
+
+			--CopiesLeft;
+		}
+
+		// not noexcept, so values are copied when they are moved to other slots
+		ThrowingCopyable(ThrowingCopyable&& other) : Value(std::move(other.Value)) { }
+
+		ThrowingCopyable& operator = (const ThrowingCopyable&) = default;
+	};
+
+	size_t ThrowingCopyable::CopiesLeft = ~(size_t)0;
+
+
+	template < typename MapType >
+	std::vector<const typename MapType::mapped_type*> GetValueAddresses(const MapType& map)
+	{
+		std::vector<const typename MapType::mapped_type*> result;
+		for (const typename MapType::value_type& value : map)
+			result.push_back(&value.second);
+		return result;
+	}
+
+
+	template < typename MapType, typename InsertFunc >
+	void CheckFailedAllocations(MapType& testee, size_t& allocationsLeft, const InsertFunc& insert)
+	{
+		const Vector expected(testee.begin(), testee.end());
+		const auto addresses = GetValueAddresses(testee);
+
+		for (size_t allowed = 0; ; ++allowed)
+		{
+			allocationsLeft = allowed;
+			try
+			{
+				insert(testee);
+				break;
+			}
+			catch (const std::bad_alloc&)
+			{ }
+
+			ASSERT_EQ(Vector(testee.begin(), testee.end()), expected);
+			ASSERT_EQ(GetValueAddresses(testee), addresses);
+			for (const Vector::value_type& value : expected)
+				ASSERT_EQ(testee.at(value.first), value.second);
+		}
+
+		allocationsLeft = ~(size_t)0;
+	}
+
+}
+
+
+TEST(DenseOrderedMapTest, Construction)
+{
+	{
+		DenseOrderedMap testee;
+		ASSERT_TRUE(testee.empty());
+	}
+	{
+		DenseOrderedMap testee((DenseOrderedMap::key_compare()));
+		ASSERT_TRUE(testee.empty());
+	}
+	{
+		DenseOrderedMap testee((DenseOrderedMap::allocator_type()));
+		ASSERT_TRUE(testee.empty());
+	}
+	{
+		const Vector vec = { { "2", "22" }, { "4", "44" }, { "3", "33" }, { "1", "11" }, { "1", "111" }, { "3", "333" } };
+
+		DenseOrderedMap testee1(vec.begin(), vec.end());
+		DenseOrderedMap testee2(vec.begin(), vec.end(), DenseOrderedMap::allocator_type());
+
+		ASSERT_EQ(testee1.size(), (size_t)4);
+		ASSERT_EQ(testee2.size(), (size_t)4);
+
+		ASSERT_TRUE(!std::is_sorted(testee1.begin(), testee1.end(), testee1.value_comp()));
+		ASSERT_TRUE(!std::is_sorted(testee2.begin(), testee2.end(), testee2.value_comp()));
+
+		ASSERT_THAT(testee1, ElementsAre(std::make_pair("2", "22"), std::make_pair("4", "44"), std::make_pair("3", "33"), std::make_pair("1", "11")));
+		ASSERT_THAT(testee2, ElementsAre(std::make_pair("2", "22"), std::make_pair("4", "44"), std::make_pair("3", "33"), std::make_pair("1", "11")));
+	}
+	{
+		const Map map = { { "2", "22" }, { "4", "44" }, { "3", "33" }, { "1", "11" }, { "1", "111" }, { "3", "333" } };
+
+		DenseOrderedMap testee(map.begin(), map.end());
+
+		ASSERT_TRUE(std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+		ASSERT_TRUE(std::equal(map.begin(), map.end(), testee.begin(), testee.end()));
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("1", "11"), std::make_pair("2", "22"), std::make_pair("3", "33"), std::make_pair("4", "44")));
+	}
+	{
+		DenseOrderedMap testee1{ { "5", "55" }, { "1", "11" }, { "4", "44" }, { "2", "22" }, { "3", "33" } };
+
+		DenseOrderedMap testee2(testee1);
+		ASSERT_FALSE(testee1.empty());
+
+		DenseOrderedMap testee3(testee1, DenseOrderedMap::allocator_type());
+		ASSERT_FALSE(testee1.empty());
+
+		DenseOrderedMap testee4(std::move(testee1));
+		ASSERT_TRUE(testee1.empty());
+
+		DenseOrderedMap testee5(std::move(testee2), DenseOrderedMap::allocator_type());
+		ASSERT_TRUE(testee2.empty());
+
+		ASSERT_TRUE(!std::is_sorted(testee3.begin(), testee3.end(), testee3.value_comp()));
+
+		ASSERT_TRUE(std::equal(testee3.begin(), testee3.end(), testee4.begin(), testee4.end()));
+		ASSERT_TRUE(std::equal(testee3.begin(), testee3.end(), testee5.begin(), testee5.end()));
+
+		ASSERT_THAT(testee3, ElementsAre(std::make_pair("5", "55"), std::make_pair("1", "11"), std::make_pair("4", "44"), std::make_pair("2", "22"), std::make_pair("3", "33")));
+	}
+	{
+		const std::initializer_list<DenseOrderedMap::value_type> values{ { "2", "22" }, { "4", "44" }, { "3", "33" }, { "1", "11" }, { "1", "111" }, { "3", "333" } };
+
+		DenseOrderedMap testee1(values);
+		DenseOrderedMap testee2(values, DenseOrderedMap::allocator_type());
+
+		ASSERT_TRUE(!std::is_sorted(testee1.begin(), testee1.end(), testee1.value_comp()));
+
+		ASSERT_TRUE(std::equal(testee1.begin(), testee1.end(), testee2.begin(), testee2.end()));
+
+		ASSERT_THAT(testee1, ElementsAre(std::make_pair("2", "22"), std::make_pair("4", "44"), std::make_pair("3", "33"), std::make_pair("1", "11")));
+	}
+}
+
+
+TEST(DenseOrderedMapTest, Assignment)
+{
+	{
+		const DenseOrderedMap testee1{ { "5", "55" }, { "1", "11" }, { "4", "44" }, { "2", "22" }, { "3", "33" } };
+
+		DenseOrderedMap testee2;
+		testee2 = testee1;
+
+		ASSERT_TRUE(!std::is_sorted(testee2.begin(), testee2.end(), testee2.value_comp()));
+
+		ASSERT_THAT(testee2, ElementsAre(std::make_pair("5", "55"), std::make_pair("1", "11"), std::make_pair("4", "44"), std::make_pair("2", "22"), std::make_pair("3", "33")));
+	}
+	{
+		const std::initializer_list<DenseOrderedMap::value_type> values{ { "2", "22" }, { "4", "44" }, { "3", "33" }, { "1", "11" }, { "1", "111" }, { "3", "333" } };
+
+		DenseOrderedMap testee;
+		testee = values;
+
+		ASSERT_TRUE(!std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("2", "22"), std::make_pair("4", "44"), std::make_pair("3", "33"), std::make_pair("1", "11")));
+	}
+}
+
+
+TEST(DenseOrderedMapTest, Brackets)
+{
+	{
+		DenseOrderedMap testee;
+
+		DenseOrderedMap::key_type two("2");
+		DenseOrderedMap::mapped_type twoTwo("22");
+		DenseOrderedMap::mapped_type& twoRef = testee[two];
+		ASSERT_EQ(two, "2");
+		ASSERT_TRUE(twoRef.empty());
+		twoRef = twoTwo;
+		ASSERT_EQ(twoTwo, "22");
+
+		DenseOrderedMap::key_type four("4");
+		DenseOrderedMap::mapped_type fourFour("44");
+		DenseOrderedMap::mapped_type& fourRef = testee[four];
+		ASSERT_EQ(four, "4");
+		ASSERT_TRUE(fourRef.empty());
+		fourRef = fourFour;
+		ASSERT_EQ(fourFour, "44");
+
+		DenseOrderedMap::key_type three("3");
+		DenseOrderedMap::mapped_type threeThree("33");
+		DenseOrderedMap::mapped_type& threeRef = testee[three];
+		ASSERT_EQ(three, "3");
+		ASSERT_TRUE(threeRef.empty());
+		threeRef = threeThree;
+		ASSERT_EQ(threeThree, "33");
+
+		DenseOrderedMap::key_type one("1");
+		DenseOrderedMap::mapped_type oneOne("11");
+		DenseOrderedMap::mapped_type& oneRef = testee[one];
+		ASSERT_EQ(one, "1");
+		ASSERT_TRUE(oneRef.empty());
+		oneRef = oneOne;
+		ASSERT_EQ(oneOne, "11");
+
+		DenseOrderedMap::key_type one2("1");
+		DenseOrderedMap::mapped_type oneOne2("111");
+		DenseOrderedMap::mapped_type& one2Ref = testee[one2];
+		ASSERT_EQ(one2, "1");
+		ASSERT_EQ(one2Ref, "11");
+		one2Ref = oneOne2;
+		ASSERT_EQ(oneOne2, "111");
+
+		DenseOrderedMap::key_type three2("3");
+		DenseOrderedMap::mapped_type threeThree2("333");
+		DenseOrderedMap::mapped_type& three2Ref = testee[three2];
+		ASSERT_EQ(three2, "3");
+		ASSERT_EQ(three2Ref, "33");
+		three2Ref = threeThree2;
+		ASSERT_EQ(threeThree2, "333");
+
+		ASSERT_TRUE(!std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("2", "22"), std::make_pair("4", "44"), std::make_pair("3", "333"), std::make_pair("1", "111")));
+	}
+	{
+		DenseOrderedMap testee;
+
+		DenseOrderedMap::key_type two("2");
+		DenseOrderedMap::mapped_type twoTwo("22");
+		DenseOrderedMap::mapped_type& twoRef = testee[std::move(two)];
+		ASSERT_TRUE(two.empty());
+		ASSERT_TRUE(twoRef.empty());
+		twoRef = std::move(twoTwo);
+		ASSERT_TRUE(twoTwo.empty());
+
+		DenseOrderedMap::key_type four("4");
+		DenseOrderedMap::mapped_type fourFour("44");
+		DenseOrderedMap::mapped_type& fourRef = testee[std::move(four)];
+		ASSERT_TRUE(four.empty());
+		ASSERT_TRUE(fourRef.empty());
+		fourRef = std::move(fourFour);
+		ASSERT_TRUE(fourFour.empty());
+
+		DenseOrderedMap::key_type three("3");
+		DenseOrderedMap::mapped_type threeThree("33");
+		DenseOrderedMap::mapped_type& threeRef = testee[std::move(three)];
+		ASSERT_TRUE(three.empty());
+		ASSERT_TRUE(threeRef.empty());
+		threeRef = std::move(threeThree);
+		ASSERT_TRUE(threeThree.empty());
+
+		DenseOrderedMap::key_type one("1");
+		DenseOrderedMap::mapped_type oneOne("11");
+		DenseOrderedMap::mapped_type& oneRef = testee[std::move(one)];
+		ASSERT_TRUE(one.empty());
+		ASSERT_TRUE(oneRef.empty());
+		oneRef = std::move(oneOne);
+		ASSERT_TRUE(oneOne.empty());
+
+		DenseOrderedMap::key_type one2("1");
+		DenseOrderedMap::mapped_type oneOne2("111");
+		DenseOrderedMap::mapped_type& one2Ref = testee[std::move(one2)];
+		ASSERT_EQ(one2, "1");
+		ASSERT_EQ(one2Ref, "11");
+		one2Ref = std::move(oneOne2);
+		ASSERT_TRUE(oneOne2.empty());
+
+		DenseOrderedMap::key_type three2("3");
+		DenseOrderedMap::mapped_type threeThree2("333");
+		DenseOrderedMap::mapped_type& three2Ref = testee[std::move(three2)];
+		ASSERT_EQ(three2, "3");
+		ASSERT_EQ(three2Ref, "33");
+		three2Ref = std::move(threeThree2);
+		ASSERT_TRUE(threeThree2.empty());
+
+		ASSERT_TRUE(!std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("2", "22"), std::make_pair("4", "44"), std::make_pair("3", "333"), std::make_pair("1", "111")));
+	}
+}
+
+
+TEST(DenseOrderedMapTest, Insertion)
+{
+	{
+		DenseOrderedMap testee;
+
+		DenseOrderedMap::value_type two("2", "22");
+		auto twoResult = testee.insert(two);
+		ASSERT_EQ(two.first, "2");
+		ASSERT_EQ(two.second, "22");
+		ASSERT_TRUE(twoResult.second);
+		ASSERT_EQ(twoResult.first->first, "2");
+		ASSERT_EQ(twoResult.first->second, "22");
+
+		DenseOrderedMap::value_type four("4", "44");
+		auto fourResult = testee.insert(four);
+		ASSERT_EQ(four.first, "4");
+		ASSERT_EQ(four.second, "44");
+		ASSERT_TRUE(fourResult.second);
+		ASSERT_EQ(fourResult.first->first, "4");
+		ASSERT_EQ(fourResult.first->second, "44");
+
+		DenseOrderedMap::value_type three("3", "33");
+		auto threeResult = testee.insert(three);
+		ASSERT_EQ(three.first, "3");
+		ASSERT_EQ(three.second, "33");
+		ASSERT_TRUE(threeResult.second);
+		ASSERT_EQ(threeResult.first->first, "3");
+		ASSERT_EQ(threeResult.first->second, "33");
+
+		DenseOrderedMap::value_type one("1", "11");
+		auto oneResult = testee.insert(one);
+		ASSERT_EQ(one.first, "1");
+		ASSERT_EQ(one.second, "11");
+		ASSERT_TRUE(oneResult.second);
+		ASSERT_EQ(oneResult.first->first, "1");
+		ASSERT_EQ(oneResult.first->second, "11");
+
+		DenseOrderedMap::value_type one2("1", "111");
+		auto one2Result = testee.insert(one2);
+		ASSERT_EQ(one2.first, "1");
+		ASSERT_EQ(one2.second, "111");
+		ASSERT_FALSE(one2Result.second);
+		ASSERT_EQ(one2Result.first->first, "1");
+		ASSERT_EQ(one2Result.first->second, "11");
+
+		DenseOrderedMap::value_type three2("3", "333");
+		auto three2Result = testee.insert(three2);
+		ASSERT_EQ(three2.first, "3");
+		ASSERT_EQ(three2.second, "333");
+		ASSERT_FALSE(three2Result.second);
+		ASSERT_EQ(three2Result.first->first, "3");
+		ASSERT_EQ(three2Result.first->second, "33");
+
+		ASSERT_TRUE(!std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("2", "22"), std::make_pair("4", "44"), std::make_pair("3", "33"), std::make_pair("1", "11")));
+	}
+	{
+		DenseOrderedMap testee;
+
+		DenseOrderedMap::value_type two("2", "22");
+		auto twoResult = testee.insert(std::move(two));
+		ASSERT_EQ(two.first, "2");
+		ASSERT_TRUE(two.second.empty());
+		ASSERT_TRUE(twoResult.second);
+		ASSERT_EQ(twoResult.first->first, "2");
+		ASSERT_EQ(twoResult.first->second, "22");
+
+		DenseOrderedMap::value_type four("4", "44");
+		auto fourResult = testee.insert(std::move(four));
+		ASSERT_EQ(four.first, "4");
+		ASSERT_TRUE(four.second.empty());
+		ASSERT_TRUE(fourResult.second);
+		ASSERT_EQ(fourResult.first->first, "4");
+		ASSERT_EQ(fourResult.first->second, "44");
+
+		DenseOrderedMap::value_type three("3", "33");
+		auto threeResult = testee.insert(std::move(three));
+		ASSERT_EQ(three.first, "3");
+		ASSERT_TRUE(three.second.empty());
+		ASSERT_TRUE(threeResult.second);
+		ASSERT_EQ(threeResult.first->first, "3");
+		ASSERT_EQ(threeResult.first->second, "33");
+
+		DenseOrderedMap::value_type one("1", "11");
+		auto oneResult = testee.insert(std::move(one));
+		ASSERT_EQ(one.first, "1");
+		ASSERT_TRUE(one.second.empty());
+		ASSERT_TRUE(oneResult.second);
+		ASSERT_EQ(oneResult.first->first, "1");
+		ASSERT_EQ(oneResult.first->second, "11");
+
+		DenseOrderedMap::value_type one2("1", "111");
+		auto one2Result = testee.insert(std::move(one2));
+		ASSERT_EQ(one2.first, "1");
+		ASSERT_EQ(one2.second, "111");
+		ASSERT_FALSE(one2Result.second);
+		ASSERT_EQ(one2Result.first->first, "1");
+		ASSERT_EQ(one2Result.first->second, "11");
+
+		DenseOrderedMap::value_type three2("3", "333");
+		auto three2Result = testee.insert(std::move(three2));
+		ASSERT_EQ(three2.first, "3");
+		ASSERT_EQ(three2.second, "333");
+		ASSERT_FALSE(three2Result.second);
+		ASSERT_EQ(three2Result.first->first, "3");
+		ASSERT_EQ(three2Result.first->second, "33");
+
+		ASSERT_TRUE(!std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("2", "22"), std::make_pair("4", "44"), std::make_pair("3", "33"), std::make_pair("1", "11")));
+	}
+	{
+		DenseOrderedMap testee;
+
+		DenseOrderedMap::value_type two("2", "22");
+		auto twoIt = testee.insert(testee.end(), two);
+		ASSERT_EQ(two.first, "2");
+		ASSERT_EQ(two.second, "22");
+		ASSERT_EQ(twoIt->first, "2");
+		ASSERT_EQ(twoIt->second, "22");
+
+		DenseOrderedMap::value_type four("4", "44");
+		auto fourIt = testee.insert(testee.end(), four);
+		ASSERT_EQ(four.first, "4");
+		ASSERT_EQ(four.second, "44");
+		ASSERT_EQ(fourIt->first, "4");
+		ASSERT_EQ(fourIt->second, "44");
+
+		DenseOrderedMap::value_type three("3", "33");
+		auto threeIt = testee.insert(testee.begin(), three);
+		ASSERT_EQ(three.first, "3");
+		ASSERT_EQ(three.second, "33");
+		ASSERT_EQ(threeIt->first, "3");
+		ASSERT_EQ(threeIt->second, "33");
+
+		DenseOrderedMap::value_type one("1", "11");
+		auto oneIt = testee.insert(testee.begin(), one);
+		ASSERT_EQ(one.first, "1");
+		ASSERT_EQ(one.second, "11");
+		ASSERT_EQ(oneIt->first, "1");
+		ASSERT_EQ(oneIt->second, "11");
+
+		DenseOrderedMap::value_type one2("1", "111");
+		auto one2It = testee.insert(testee.end(), one2);
+		ASSERT_EQ(one2.first, "1");
+		ASSERT_EQ(one2.second, "111");
+		ASSERT_EQ(one2It->first, "1");
+		ASSERT_EQ(one2It->second, "11");
+
+		DenseOrderedMap::value_type three2("3", "333");
+		auto three2It = testee.insert(testee.end(), three2);
+		ASSERT_EQ(three2.first, "3");
+		ASSERT_EQ(three2.second, "333");
+		ASSERT_EQ(three2It->first, "3");
+		ASSERT_EQ(three2It->second, "33");
+
+		DenseOrderedMap::const_iterator twoIt2 = testee.find("2");
+		ASSERT_EQ(twoIt2->first, "2");
+		ASSERT_EQ(twoIt2->second, "22");
+		DenseOrderedMap::value_type five("5", "55");
+		auto fiveIt = testee.insert(twoIt2, five);
+		ASSERT_EQ(five.first, "5");
+		ASSERT_EQ(five.second, "55");
+		ASSERT_EQ(fiveIt->first, "5");
+		ASSERT_EQ(fiveIt->second, "55");
+
+		ASSERT_TRUE(!std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("1", "11"), std::make_pair("3", "33"), std::make_pair("5", "55"), std::make_pair("2", "22"), std::make_pair("4", "44")));
+	}
+	{
+		DenseOrderedMap testee;
+
+		DenseOrderedMap::value_type two("2", "22");
+		auto twoIt = testee.insert(testee.end(), std::move(two));
+		ASSERT_EQ(two.first, "2");
+		ASSERT_TRUE(two.second.empty());
+		ASSERT_EQ(twoIt->first, "2");
+		ASSERT_EQ(twoIt->second, "22");
+
+		DenseOrderedMap::value_type four("4", "44");
+		auto fourIt = testee.insert(testee.end(), std::move(four));
+		ASSERT_EQ(four.first, "4");
+		ASSERT_TRUE(four.second.empty());
+		ASSERT_EQ(fourIt->first, "4");
+		ASSERT_EQ(fourIt->second, "44");
+
+		DenseOrderedMap::value_type three("3", "33");
+		auto threeIt = testee.insert(testee.begin(), std::move(three));
+		ASSERT_EQ(three.first, "3");
+		ASSERT_TRUE(three.second.empty());
+		ASSERT_EQ(threeIt->first, "3");
+		ASSERT_EQ(threeIt->second, "33");
+
+		DenseOrderedMap::value_type one("1", "11");
+		auto oneIt = testee.insert(testee.begin(), std::move(one));
+		ASSERT_EQ(one.first, "1");
+		ASSERT_TRUE(one.second.empty());
+		ASSERT_EQ(oneIt->first, "1");
+		ASSERT_EQ(oneIt->second, "11");
+
+		DenseOrderedMap::value_type one2("1", "111");
+		auto one2It = testee.insert(testee.end(), std::move(one2));
+		ASSERT_EQ(one2.first, "1");
+		ASSERT_EQ(one2.second, "111");
+		ASSERT_EQ(one2It->first, "1");
+		ASSERT_EQ(one2It->second, "11");
+
+		DenseOrderedMap::value_type three2("3", "333");
+		auto three2It = testee.insert(testee.end(), std::move(three2));
+		ASSERT_EQ(three2.first, "3");
+		ASSERT_EQ(three2.second, "333");
+		ASSERT_EQ(three2It->first, "3");
+		ASSERT_EQ(three2It->second, "33");
+
+		DenseOrderedMap::const_iterator twoIt2 = testee.find("2");
+		ASSERT_EQ(twoIt2->first, "2");
+		ASSERT_EQ(twoIt2->second, "22");
+		DenseOrderedMap::value_type five("5", "55");
+		auto fiveIt = testee.insert(twoIt2, std::move(five));
+		ASSERT_EQ(five.first, "5");
+		ASSERT_TRUE(five.second.empty());
+		ASSERT_EQ(fiveIt->first, "5");
+		ASSERT_EQ(fiveIt->second, "55");
+
+		ASSERT_TRUE(!std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("1", "11"), std::make_pair("3", "33"), std::make_pair("5", "55"), std::make_pair("2", "22"), std::make_pair("4", "44")));
+	}
+}
+
+
+TEST(DenseOrderedMapTest, Emplacing)
+{
+	{
+		DenseOrderedMap testee;
+
+		DenseOrderedMap::key_type twoFirst("2");
+		DenseOrderedMap::mapped_type twoSecond("22");
+		auto twoResult = testee.emplace(std::move(twoFirst), std::move(twoSecond));
+		ASSERT_TRUE(twoFirst.empty());
+		ASSERT_TRUE(twoSecond.empty());
+		ASSERT_TRUE(twoResult.second);
+		ASSERT_EQ(twoResult.first->first, "2");
+		ASSERT_EQ(twoResult.first->second, "22");
+
+		DenseOrderedMap::key_type fourFirst("4");
+		DenseOrderedMap::mapped_type fourSecond("44");
+		auto fourResult = testee.emplace(std::move(fourFirst), std::move(fourSecond));
+		ASSERT_TRUE(fourFirst.empty());
+		ASSERT_TRUE(fourSecond.empty());
+		ASSERT_TRUE(fourResult.second);
+		ASSERT_EQ(fourResult.first->first, "4");
+		ASSERT_EQ(fourResult.first->second, "44");
+
+		DenseOrderedMap::key_type threeFirst("3");
+		DenseOrderedMap::mapped_type threeSecond("33");
+		auto threeResult = testee.emplace(std::move(threeFirst), std::move(threeSecond));
+		ASSERT_TRUE(threeFirst.empty());
+		ASSERT_TRUE(threeSecond.empty());
+		ASSERT_TRUE(threeResult.second);
+		ASSERT_EQ(threeResult.first->first, "3");
+		ASSERT_EQ(threeResult.first->second, "33");
+
+		DenseOrderedMap::key_type oneFirst("1");
+		DenseOrderedMap::mapped_type oneSecond("11");
+		auto oneResult = testee.emplace(std::move(oneFirst), std::move(oneSecond));
+		ASSERT_TRUE(oneFirst.empty());
+		ASSERT_TRUE(oneSecond.empty());
+		ASSERT_TRUE(oneResult.second);
+		ASSERT_EQ(oneResult.first->first, "1");
+		ASSERT_EQ(oneResult.first->second, "11");
+
+		DenseOrderedMap::key_type one2First("1");
+		DenseOrderedMap::mapped_type one2Second("111");
+		auto one2Result = testee.emplace(std::move(one2First), std::move(one2Second));
+		ASSERT_TRUE(one2First.empty());
+		ASSERT_TRUE(one2Second.empty());
+		ASSERT_FALSE(one2Result.second);
+		ASSERT_EQ(one2Result.first->first, "1");
+		ASSERT_EQ(one2Result.first->second, "11");
+
+		DenseOrderedMap::key_type three2First("3");
+		DenseOrderedMap::mapped_type three2Second("333");
+		auto three2Result = testee.emplace(std::move(three2First), std::move(three2Second));
+		ASSERT_TRUE(three2First.empty());
+		ASSERT_TRUE(three2Second.empty());
+		ASSERT_FALSE(three2Result.second);
+		ASSERT_EQ(three2Result.first->first, "3");
+		ASSERT_EQ(three2Result.first->second, "33");
+
+		ASSERT_TRUE(!std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("2", "22"), std::make_pair("4", "44"), std::make_pair("3", "33"), std::make_pair("1", "11")));
+	}
+	{
+		DenseOrderedMap testee;
+
+		DenseOrderedMap::key_type twoFirst("2");
+		DenseOrderedMap::mapped_type twoSecond("22");
+		auto twoIt = testee.emplace_hint(testee.end(), std::move(twoFirst), std::move(twoSecond));
+		ASSERT_TRUE(twoFirst.empty());
+		ASSERT_TRUE(twoSecond.empty());
+		ASSERT_EQ(twoIt->first, "2");
+		ASSERT_EQ(twoIt->second, "22");
+
+		DenseOrderedMap::key_type fourFirst("4");
+		DenseOrderedMap::mapped_type fourSecond("44");
+		auto fourIt = testee.emplace_hint(testee.end(), std::move(fourFirst), std::move(fourSecond));
+		ASSERT_TRUE(fourFirst.empty());
+		ASSERT_TRUE(fourSecond.empty());
+		ASSERT_EQ(fourIt->first, "4");
+		ASSERT_EQ(fourIt->second, "44");
+
+		DenseOrderedMap::key_type threeFirst("3");
+		DenseOrderedMap::mapped_type threeSecond("33");
+		auto threeIt = testee.emplace_hint(testee.begin(), std::move(threeFirst), std::move(threeSecond));
+		ASSERT_TRUE(threeFirst.empty());
+		ASSERT_TRUE(threeSecond.empty());
+		ASSERT_EQ(threeIt->first, "3");
+		ASSERT_EQ(threeIt->second, "33");
+
+		DenseOrderedMap::key_type oneFirst("1");
+		DenseOrderedMap::mapped_type oneSecond("11");
+		auto oneIt = testee.emplace_hint(testee.begin(), std::move(oneFirst), std::move(oneSecond));
+		ASSERT_TRUE(oneFirst.empty());
+		ASSERT_TRUE(oneSecond.empty());
+		ASSERT_EQ(oneIt->first, "1");
+		ASSERT_EQ(oneIt->second, "11");
+
+		DenseOrderedMap::key_type one2First("1");
+		DenseOrderedMap::mapped_type one2Second("111");
+		auto one2It = testee.emplace_hint(testee.end(), std::move(one2First), std::move(one2Second));
+		ASSERT_TRUE(one2First.empty());
+		ASSERT_TRUE(one2Second.empty());
+		ASSERT_EQ(one2It->first, "1");
+		ASSERT_EQ(one2It->second, "11");
+
+		DenseOrderedMap::key_type three2First("3");
+		DenseOrderedMap::mapped_type three2Second("333");
+		auto three2It = testee.emplace_hint(testee.end(), std::move(three2First), std::move(three2Second));
+		ASSERT_TRUE(three2First.empty());
+		ASSERT_TRUE(three2Second.empty());
+		ASSERT_EQ(three2It->first, "3");
+		ASSERT_EQ(three2It->second, "33");
+
+		DenseOrderedMap::const_iterator twoIt2 = testee.find("2");
+		ASSERT_EQ(twoIt2->first, "2");
+		ASSERT_EQ(twoIt2->second, "22");
+		DenseOrderedMap::key_type fiveFirst("5");
+		DenseOrderedMap::mapped_type fiveSecond("55");
+		auto fiveIt = testee.emplace_hint(twoIt2, std::move(fiveFirst), std::move(fiveSecond));
+		ASSERT_TRUE(fiveFirst.empty());
+		ASSERT_TRUE(fiveSecond.empty());
+		ASSERT_EQ(fiveIt->first, "5");
+		ASSERT_EQ(fiveIt->second, "55");
+
+		ASSERT_TRUE(!std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("1", "11"), std::make_pair("3", "33"), std::make_pair("5", "55"), std::make_pair("2", "22"), std::make_pair("4", "44")));
+	}
+
+	{
+		DenseOrderedMap testee;
+
+		auto twoResult = testee.emplace(std::piecewise_construct, std::make_tuple(1, '2'), std::make_tuple(2, '2'));
+		ASSERT_TRUE(twoResult.second);
+		ASSERT_EQ(twoResult.first->first, "2");
+		ASSERT_EQ(twoResult.first->second, "22");
+
+		auto emptyResult = testee.emplace(std::piecewise_construct, std::make_tuple(), std::make_tuple());
+		ASSERT_TRUE(emptyResult.second);
+		ASSERT_EQ(emptyResult.first->first, "");
+		ASSERT_EQ(emptyResult.first->second, "");
+
+		ASSERT_TRUE(!std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("2", "22"), std::make_pair("", "")));
+	}
+}
+
+
+TEST(DenseOrderedMapTest, EmplacingPresentKeyKeepsIterators)
+{
+	DenseOrderedMap testee;
+	for (int i = 0; i < 64; ++i)
+	{
+		testee.emplace(ToString(i), ToString(i));
+
+		const DenseOrderedMap::iterator first = testee.begin();
+		const DenseOrderedMap::mapped_type* const firstValue = &first->second;
+
+		const auto result = testee.emplace(std::make_pair(std::string("0"), std::string("duplicate")));
+		ASSERT_FALSE(result.second);
+		ASSERT_TRUE(result.first == first);
+		ASSERT_EQ(&result.first->second, firstValue);
+		ASSERT_EQ(first->second, "0");
+
+		ASSERT_EQ(testee.emplace_hint(testee.cbegin(), std::string("0"), std::string("duplicate")), first);
+		ASSERT_EQ(&first->second, firstValue);
+		ASSERT_EQ(testee.size(), size_t(i + 1));
+	}
+}
+
+
+TEST(DenseOrderedMapTest, Lookup)
+{
+	const Vector unsorted{ { "5", "55" }, { "4", "44" }, { "8", "88" }, { "9", "99" }, { "1", "11" }, { "6", "66" }, { "3", "33" }, { "2", "22" }, { "7", "77" }, { "0", "00" } };
+
+	{
+		DenseOrderedMap testee(unsorted.begin(), unsorted.end());
+		Map sample(unsorted.begin(), unsorted.end());
+
+		ASSERT_TRUE(!std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+
+		for (Map::iterator sampleIt = sample.begin(); sampleIt != sample.end(); ++sampleIt)
+		{
+			DenseOrderedMap::iterator testeeIt = testee.find(sampleIt->first);
+			ASSERT_NE(testeeIt, testee.end());
+			ASSERT_TRUE(*testeeIt == *sampleIt);
+		}
+
+		for (DenseOrderedMap::iterator testeeIt = testee.begin(); testeeIt != testee.end(); ++testeeIt)
+		{
+			Map::iterator sampleIt = sample.find(testeeIt->first);
+			ASSERT_NE(sampleIt, sample.end());
+			ASSERT_TRUE(*sampleIt == *testeeIt);
+		}
+
+		for (Map::reverse_iterator sampleIt = sample.rbegin(); sampleIt != sample.rend(); ++sampleIt)
+		{
+			DenseOrderedMap::iterator testeeIt = testee.find(sampleIt->first);
+			ASSERT_NE(testeeIt, testee.end());
+			ASSERT_TRUE(*testeeIt == *sampleIt);
+		}
+
+		for (DenseOrderedMap::reverse_iterator testeeIt = testee.rbegin(); testeeIt != testee.rend(); ++testeeIt)
+		{
+			Map::iterator sampleIt = sample.find(testeeIt->first);
+			ASSERT_NE(sampleIt, sample.end());
+			ASSERT_TRUE(*sampleIt == *testeeIt);
+		}
+
+		for (Map::iterator sampleIt = sample.begin(); sampleIt != sample.end(); ++sampleIt)
+		{
+			ASSERT_NO_THROW(EXPECT_EQ(testee.at(sampleIt->first), sampleIt->second));
+			ASSERT_THROW(testee.at(sampleIt->second), KeyNotFoundException);
+		}
+
+		for (DenseOrderedMap::iterator testeeIt = testee.begin(); testeeIt != testee.end(); ++testeeIt)
+		{
+			ASSERT_NO_THROW(EXPECT_EQ(sample.at(testeeIt->first), testeeIt->second));
+			ASSERT_ANY_THROW(testee.at(testeeIt->second));
+		}
+
+		for (Map::iterator sampleIt = sample.begin(); sampleIt != sample.end(); ++sampleIt)
+			ASSERT_EQ(testee.count(sampleIt->first), 1);
+
+		for (DenseOrderedMap::iterator testeeIt = testee.begin(); testeeIt != testee.end(); ++testeeIt)
+			ASSERT_EQ(sample.count(testeeIt->first), 1);
+	}
+
+	{
+		const DenseOrderedMap testee(unsorted.begin(), unsorted.end());
+		const Map sample(unsorted.begin(), unsorted.end());
+
+		ASSERT_TRUE(!std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+
+		for (Map::const_iterator sampleIt = sample.begin(); sampleIt != sample.end(); ++sampleIt)
+		{
+			DenseOrderedMap::const_iterator testeeIt = testee.find(sampleIt->first);
+			ASSERT_NE(testeeIt, testee.end());
+			ASSERT_TRUE(*testeeIt == *sampleIt);
+		}
+
+		for (DenseOrderedMap::const_iterator testeeIt = testee.begin(); testeeIt != testee.end(); ++testeeIt)
+		{
+			Map::const_iterator sampleIt = sample.find(testeeIt->first);
+			ASSERT_NE(sampleIt, sample.end());
+			ASSERT_TRUE(*sampleIt == *testeeIt);
+		}
+
+		for (Map::const_reverse_iterator sampleIt = sample.rbegin(); sampleIt != sample.rend(); ++sampleIt)
+		{
+			DenseOrderedMap::const_iterator testeeIt = testee.find(sampleIt->first);
+			ASSERT_NE(testeeIt, testee.end());
+			ASSERT_TRUE(*testeeIt == *sampleIt);
+		}
+
+		for (DenseOrderedMap::const_reverse_iterator testeeIt = testee.rbegin(); testeeIt != testee.rend(); ++testeeIt)
+		{
+			Map::const_iterator sampleIt = sample.find(testeeIt->first);
+			ASSERT_NE(sampleIt, sample.end());
+			ASSERT_TRUE(*sampleIt == *testeeIt);
+		}
+
+		for (Map::const_iterator sampleIt = sample.begin(); sampleIt != sample.end(); ++sampleIt)
+		{
+			ASSERT_NO_THROW(EXPECT_EQ(testee.at(sampleIt->first), sampleIt->second));
+			ASSERT_THROW(testee.at(sampleIt->second), KeyNotFoundException);
+		}
+
+		for (DenseOrderedMap::const_iterator testeeIt = testee.begin(); testeeIt != testee.end(); ++testeeIt)
+		{
+			ASSERT_NO_THROW(EXPECT_EQ(sample.at(testeeIt->first), testeeIt->second));
+			ASSERT_ANY_THROW(testee.at(testeeIt->second));
+		}
+
+		for (Map::const_iterator sampleIt = sample.begin(); sampleIt != sample.end(); ++sampleIt)
+			ASSERT_EQ(testee.count(sampleIt->first), 1);
+
+		for (DenseOrderedMap::const_iterator testeeIt = testee.begin(); testeeIt != testee.end(); ++testeeIt)
+			ASSERT_EQ(sample.count(testeeIt->first), 1);
+	}
+}
+
+
+TEST(DenseOrderedMapTest, TransparentLookup)
+{
+	const Vector unsorted{ { "5", "55" }, { "4", "44" }, { "8", "88" }, { "9", "99" }, { "1", "11" }, { "6", "66" }, { "3", "33" }, { "2", "22" }, { "7", "77" }, { "0", "00" } };
+
+	{
+		TransparentDenseOrderedMap testee(unsorted.begin(), unsorted.end());
+		Map sample(unsorted.begin(), unsorted.end());
+
+		ASSERT_TRUE(!std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+
+		for (Map::iterator sampleIt = sample.begin(); sampleIt != sample.end(); ++sampleIt)
+		{
+			TransparentDenseOrderedMap::iterator testeeIt = testee.find(string_view(sampleIt->first));
+			ASSERT_NE(testeeIt, testee.end());
+			ASSERT_TRUE(*testeeIt == *sampleIt);
+		}
+
+		for (Map::reverse_iterator sampleIt = sample.rbegin(); sampleIt != sample.rend(); ++sampleIt)
+		{
+			TransparentDenseOrderedMap::iterator testeeIt = testee.find(string_view(sampleIt->first));
+			ASSERT_NE(testeeIt, testee.end());
+			ASSERT_TRUE(*testeeIt == *sampleIt);
+		}
+
+		for (Map::iterator sampleIt = sample.begin(); sampleIt != sample.end(); ++sampleIt)
+		{
+			ASSERT_NO_THROW(EXPECT_EQ(testee.at(string_view(sampleIt->first)), sampleIt->second));
+			ASSERT_THROW(testee.at(string_view(sampleIt->second)), KeyNotFoundException);
+		}
+
+		for (Map::iterator sampleIt = sample.begin(); sampleIt != sample.end(); ++sampleIt)
+			ASSERT_EQ(testee.count(string_view(sampleIt->first)), 1);
+	}
+
+	{
+		const TransparentDenseOrderedMap testee(unsorted.begin(), unsorted.end());
+		const Map sample(unsorted.begin(), unsorted.end());
+
+		ASSERT_TRUE(!std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+
+		for (Map::const_iterator sampleIt = sample.begin(); sampleIt != sample.end(); ++sampleIt)
+		{
+			TransparentDenseOrderedMap::const_iterator testeeIt = testee.find(string_view(sampleIt->first));
+			ASSERT_NE(testeeIt, testee.end());
+			ASSERT_TRUE(*testeeIt == *sampleIt);
+		}
+
+		for (Map::const_reverse_iterator sampleIt = sample.rbegin(); sampleIt != sample.rend(); ++sampleIt)
+		{
+			TransparentDenseOrderedMap::const_iterator testeeIt = testee.find(string_view(sampleIt->first));
+			ASSERT_NE(testeeIt, testee.end());
+			ASSERT_TRUE(*testeeIt == *sampleIt);
+		}
+
+		for (Map::const_iterator sampleIt = sample.begin(); sampleIt != sample.end(); ++sampleIt)
+		{
+			ASSERT_NO_THROW(EXPECT_EQ(testee.at(string_view(sampleIt->first)), sampleIt->second));
+			ASSERT_THROW(testee.at(string_view(sampleIt->second)), KeyNotFoundException);
+		}
+
+		for (Map::const_iterator sampleIt = sample.begin(); sampleIt != sample.end(); ++sampleIt)
+			ASSERT_EQ(testee.count(string_view(sampleIt->first)), 1);
+	}
+}
+
+
+TEST(DenseOrderedMapTest, Swap)
+{
+	{
+		DenseOrderedMap testee1{ { "5", "55" }, { "1", "11" }, { "4", "44" }, { "2", "22" }, { "3", "33" } };
+		DenseOrderedMap testee2;
+
+		testee1.swap(testee2);
+
+		ASSERT_TRUE(testee1.empty());
+		ASSERT_THAT(testee2, ElementsAre(std::make_pair("5", "55"), std::make_pair("1", "11"), std::make_pair("4", "44"), std::make_pair("2", "22"), std::make_pair("3", "33")));
+	}
+}
+
+
+TEST(DenseOrderedMapTest, Removal)
+{
+	{
+		DenseOrderedMap testee{ { "5", "55" }, { "1", "11" }, { "4", "44" }, { "2", "22" }, { "3", "33" } };
+
+		ASSERT_TRUE(testee.count("4"));
+		ASSERT_TRUE(testee.erase("4"));
+		ASSERT_FALSE(testee.count("4"));
+		ASSERT_FALSE(testee.erase("4"));
+
+		ASSERT_TRUE(testee.count("5"));
+		ASSERT_TRUE(testee.erase("5"));
+		ASSERT_FALSE(testee.count("5"));
+		ASSERT_FALSE(testee.erase("5"));
+
+		ASSERT_TRUE(testee.count("3"));
+		ASSERT_TRUE(testee.erase("3"));
+		ASSERT_FALSE(testee.count("3"));
+		ASSERT_FALSE(testee.erase("3"));
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("1", "11"), std::make_pair("2", "22")));
+	}
+	{
+		DenseOrderedMap testee{ { "5", "55" }, { "1", "11" }, { "4", "44" }, { "2", "22" }, { "3", "33" } };
+
+		DenseOrderedMap::const_iterator fourIt = testee.find("4");
+		ASSERT_NE(fourIt, testee.end());
+		ASSERT_EQ(fourIt->first, "4");
+		ASSERT_EQ(fourIt->second, "44");
+		DenseOrderedMap::const_iterator twoIt = testee.erase(fourIt);
+		ASSERT_NE(twoIt, testee.end());
+		ASSERT_EQ(twoIt->first, "2");
+		ASSERT_EQ(twoIt->second, "22");
+		ASSERT_FALSE(testee.count("4"));
+
+		DenseOrderedMap::const_iterator fiveIt = testee.find("5");
+		ASSERT_NE(fiveIt, testee.end());
+		ASSERT_EQ(fiveIt->first, "5");
+		ASSERT_EQ(fiveIt->second, "55");
+		DenseOrderedMap::const_iterator oneIt = testee.erase(fiveIt);
+		ASSERT_NE(oneIt, testee.end());
+		ASSERT_EQ(oneIt->first, "1");
+		ASSERT_EQ(oneIt->second, "11");
+		ASSERT_FALSE(testee.count("5"));
+
+		DenseOrderedMap::const_iterator threeIt = testee.find("3");
+		ASSERT_NE(threeIt, testee.end());
+		ASSERT_EQ(threeIt->first, "3");
+		ASSERT_EQ(threeIt->second, "33");
+		DenseOrderedMap::const_iterator endIt = testee.erase(threeIt);
+		ASSERT_EQ(endIt, testee.end());
+		ASSERT_FALSE(testee.count("5"));
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("1", "11"), std::make_pair("2", "22")));
+	}
+	{
+		DenseOrderedMap testee{ { "5", "55" }, { "1", "11" }, { "4", "44" }, { "2", "22" }, { "3", "33" } };
+
+		DenseOrderedMap::const_iterator oneIt = testee.find("1");
+		ASSERT_NE(oneIt, testee.end());
+		ASSERT_EQ(oneIt->first, "1");
+		ASSERT_EQ(oneIt->second, "11");
+		DenseOrderedMap::const_iterator twoIt = testee.find("2");
+		ASSERT_NE(twoIt, testee.end());
+		ASSERT_EQ(twoIt->first, "2");
+		ASSERT_EQ(twoIt->second, "22");
+		DenseOrderedMap::const_iterator two2It = testee.erase(oneIt, twoIt);
+		ASSERT_NE(two2It, testee.end());
+		ASSERT_EQ(two2It->first, "2");
+		ASSERT_EQ(two2It->second, "22");
+		ASSERT_FALSE(testee.count("1"));
+		ASSERT_FALSE(testee.count("4"));
+		ASSERT_TRUE(testee.count("2"));
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("5", "55"), std::make_pair("2", "22"), std::make_pair("3", "33")));
+
+		DenseOrderedMap::const_iterator endIt = testee.erase(testee.begin(), testee.end());
+		ASSERT_EQ(endIt, testee.end());
+
+		ASSERT_TRUE(testee.empty());
+	}
+}
+
+
+TEST(DenseOrderedMapTest, Comparison)
+{
+	{
+		const DenseOrderedMap testee1{ { "5", "55" }, { "1", "11" }, { "4", "44" }, { "2", "22" }, { "3", "33" } };
+		const DenseOrderedMap testee2(testee1);
+
+		ASSERT_TRUE(testee1 == testee2);
+		ASSERT_FALSE(testee1 != testee2);
+		ASSERT_FALSE(testee1 < testee2);
+		ASSERT_FALSE(testee1 > testee2);
+		ASSERT_TRUE(testee1 <= testee2);
+		ASSERT_TRUE(testee1 >= testee2);
+	}
+	{
+		const DenseOrderedMap testee1{ { "5", "55" }, { "1", "11" }, { "4", "44" }, { "2", "22" }, { "3", "33" } };
+		const DenseOrderedMap testee2{ { "5", "55" }, { "1", "11" }, { "4", "44" }, { "2", "22" } };
+
+		ASSERT_FALSE(testee1 == testee2);
+		ASSERT_TRUE(testee1 != testee2);
+		ASSERT_FALSE(testee1 < testee2);
+		ASSERT_TRUE(testee1 > testee2);
+		ASSERT_FALSE(testee1 <= testee2);
+		ASSERT_TRUE(testee1 >= testee2);
+
+		ASSERT_FALSE(testee2 == testee1);
+		ASSERT_TRUE(testee2 != testee1);
+		ASSERT_TRUE(testee2 < testee1);
+		ASSERT_FALSE(testee2 > testee1);
+		ASSERT_TRUE(testee2 <= testee1);
+		ASSERT_FALSE(testee2 >= testee1);
+	}
+	{
+		const DenseOrderedMap testee1{ { "5", "55" }, { "4", "44" }, { "1", "11" }, { "2", "22" }, { "3", "33" } };
+		const DenseOrderedMap testee2{ { "5", "55" }, { "1", "11" }, { "4", "44" }, { "2", "22" }, { "3", "33" } };
+
+		ASSERT_FALSE(testee1 == testee2);
+		ASSERT_TRUE(testee1 != testee2);
+		ASSERT_FALSE(testee1 < testee2);
+		ASSERT_TRUE(testee1 > testee2);
+		ASSERT_FALSE(testee1 <= testee2);
+		ASSERT_TRUE(testee1 >= testee2);
+
+		ASSERT_FALSE(testee2 == testee1);
+		ASSERT_TRUE(testee2 != testee1);
+		ASSERT_TRUE(testee2 < testee1);
+		ASSERT_FALSE(testee2 > testee1);
+		ASSERT_TRUE(testee2 <= testee1);
+		ASSERT_FALSE(testee2 >= testee1);
+	}
+}
+
+
+TEST(DenseOrderedMapTest, SetIndex)
+{
+	SetIndexDenseOrderedMap testee;
+	DenseOrderedMap expected;
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		const std::string key = ToString((i * 7919) % 2000);
+		ASSERT_TRUE(testee.emplace(key, key).second);
+		expected.emplace(key, key);
+	}
+	ASSERT_FALSE(testee.emplace("5", "").second);
+
+	for (int i = 0; i < 2000; i += 3)
+	{
+		ASSERT_EQ(testee.erase(ToString(i)), 1u);
+		expected.erase(ToString(i));
+	}
+
+	ASSERT_EQ(testee.erase(testee.begin(), std::next(testee.begin(), 10))->first, expected.erase(expected.begin(), std::next(expected.begin(), 10))->first);
+
+	ASSERT_EQ(testee.size(), expected.size());
+	ASSERT_TRUE(std::equal(testee.begin(), testee.end(), expected.begin(), expected.end()));
+
+	for (int i = 0; i < 2000; ++i)
+		ASSERT_EQ(testee.count(ToString(i)), expected.count(ToString(i)));
+	ASSERT_EQ(testee.at(std::string("1")), "1");
+
+	SetIndexDenseOrderedMap moved(std::move(testee));
+	ASSERT_TRUE(std::equal(moved.begin(), moved.end(), expected.begin(), expected.end()));
+	ASSERT_EQ(moved.find("4")->second, "4");
+}
+
+
+TEST(DenseOrderedMapTest, Random)
+{
+	DenseOrderedMap testee;
+	Vector expected;
+
+	const auto findExpected = [&expected](const std::string& key)
+	{ return std::find_if(expected.begin(), expected.end(), [&key](const Vector::value_type& value) { return value.first == key; }); };
+
+	u32 seed = 1;
+	for (int i = 0; i < 20000; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		const std::string key = ToString((seed >> 8) % 300);
+		const size_t position = expected.empty() ? 0 : (seed >> 16) % (expected.size() + 1);
+
+		switch ((seed >> 4) % 4)
+		{
+		case 0:
+			{
+				const bool inserted = findExpected(key) == expected.end();
+				const auto result = testee.emplace(key, ToString(i));
+				ASSERT_EQ(result.second, inserted);
+				ASSERT_EQ(result.first->first, key);
+				if (inserted)
+					expected.emplace_back(key, ToString(i));
+			}
+			break;
+		case 1:
+			{
+				const bool inserted = findExpected(key) == expected.end();
+				const auto result = testee.insert(std::next(testee.begin(), position), std::make_pair(key, ToString(i)));
+				ASSERT_EQ(result->first, key);
+				if (inserted)
+				{
+					ASSERT_EQ(std::distance(testee.begin(), result), (std::ptrdiff_t)position);
+					expected.emplace(std::next(expected.begin(), position), key, ToString(i));
+				}
+			}
+			break;
+		case 2:
+			{
+				const Vector::iterator it = findExpected(key);
+				ASSERT_EQ(testee.erase(key), it != expected.end() ? 1u : 0u);
+				if (it != expected.end())
+					expected.erase(it);
+			}
+			break;
+		default:
+			if (expected.size() > 100)
+			{
+				const auto result = testee.erase(std::next(testee.begin(), position / 2), std::next(testee.begin(), position / 2 + 5));
+				ASSERT_EQ(std::distance(testee.begin(), result), (std::ptrdiff_t)position / 2);
+				expected.erase(std::next(expected.begin(), position / 2), std::next(expected.begin(), position / 2 + 5));
+			}
+		}
+
+		ASSERT_EQ(testee.size(), expected.size());
+	}
+
+	ASSERT_EQ(Vector(testee.begin(), testee.end()), expected);
+	ASSERT_EQ(Vector(testee.rbegin(), testee.rend()), Vector(expected.rbegin(), expected.rend()));
+
+	for (const Vector::value_type& value : expected)
+	{
+		ASSERT_EQ(testee.at(value.first), value.second);
+	}
+}
+
+
+TEST(DenseOrderedMapTest, EraseIf)
+{
+	DenseOrderedMap testee;
+	for (int i = 0; i < 100; ++i)
+		testee.emplace(ToString(i), ToString(i % 3));
+
+	ASSERT_EQ(erase_if(testee, [](const DenseOrderedMap::value_type& value) { return value.second != "0"; }), 66u);
+	ASSERT_EQ(testee.size(), 34u);
+	ASSERT_EQ(testee.begin()->first, "0");
+	ASSERT_EQ(std::next(testee.begin())->first, "3");
+	ASSERT_EQ(testee.count("1"), 0u);
+	ASSERT_EQ(testee.at("99"), "0");
+
+	testee.emplace_hint(testee.begin(), "first", "");
+	ASSERT_EQ(testee.begin()->first, "first");
+	ASSERT_EQ(testee.rbegin()->first, "99");
+}
+
+
+TEST(DenseOrderedMapTest, FailedAllocationKeepsContents)
+{
+	using FailingMap = dense_ordered_map<std::string, std::string, std::less<std::string>, FailingAllocator<std::pair<const std::string, std::string>>>;
+
+	size_t allocationsLeft = ~(size_t)0;
+	FailingMap testee((FailingAllocator<std::pair<const std::string, std::string>>(&allocationsLeft)));
+	for (int i = 0; i < 16; ++i)
+		testee.emplace(ToString(i), ToString(i));
+
+	// insertion into the full array grows it
+	CheckFailedAllocations(testee, allocationsLeft, [](FailingMap& map) { map.emplace("last", ""); });
+	ASSERT_EQ(testee.rbegin()->first, "last");
+
+	// insertion before the first value moves all of them
+	CheckFailedAllocations(testee, allocationsLeft, [](FailingMap& map) { map.emplace_hint(map.begin(), "first", ""); });
+	ASSERT_EQ(testee.begin()->first, "first");
+
+	testee.clear();
+	for (int i = 0; i < 16; ++i)
+		testee.emplace(ToString(i), ToString(i));
+
+	CheckFailedAllocations(testee, allocationsLeft, [](FailingMap& map) { map.insert(map.begin(), std::make_pair(std::string("first"), std::string())); });
+	ASSERT_EQ(testee.begin()->first, "first");
+	ASSERT_EQ(testee.size(), 17u);
+}
+
+
+TEST(DenseOrderedMapTest, FailedCopyKeepsContents)
+{
+	using CopyingMap = dense_ordered_map<std::string, ThrowingCopyable>;
+
+	CopyingMap testee;
+	for (int i = 0; i < 16; ++i)
+		testee.emplace(ToString(i), ToString(i));
+
+	const auto addresses = GetValueAddresses(testee);
+
+	for (ThrowingCopyable::CopiesLeft = 0; ThrowingCopyable::CopiesLeft < 16; ++ThrowingCopyable::CopiesLeft)
+	{
+		const size_t copiesLeft = ThrowingCopyable::CopiesLeft;
+		ASSERT_THROW(testee.emplace_hint(testee.begin(), "first", std::string()), std::runtime_error);
+		ThrowingCopyable::CopiesLeft = copiesLeft;
+
+		ASSERT_EQ(testee.size(), 16u);
+		ASSERT_EQ(testee.count("first"), 0u);
+		ASSERT_EQ(GetValueAddresses(testee), addresses);
+
+		int i = 0;
+		for (const CopyingMap::value_type& value : testee)
+		{
+			ASSERT_EQ(value.first, ToString(i));
+			ASSERT_EQ(value.second.Value, ToString(i++));
+		}
+	}
+
+	ThrowingCopyable::CopiesLeft = ~(size_t)0;
+	testee.emplace_hint(testee.begin(), "first", std::string());
+	ASSERT_EQ(testee.begin()->first, "first");
+	ASSERT_EQ(testee.size(), 17u);
+	ASSERT_EQ(testee.at("15").Value, "15");
+}
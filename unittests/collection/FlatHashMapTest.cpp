@@ -0,0 +1,280 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/flat_hash_map.h>
+
+#include <stingraykit/collection/ForEach.h>
+#include <stingraykit/collection/HashMapDictionary.h>
+#include <stingraykit/collection/flat_map.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/time/ElapsedTime.h>
+
+#include <gmock/gmock-matchers.h>
+
+#include <map>
+#include <unordered_map>
+
+using namespace stingray;
+
+using ::testing::UnorderedElementsAre;
+
+namespace
+{
+
+	using FlatHashMap = flat_hash_map<std::string, std::string>;
+
+	struct StringHash
+	{
+		using is_transparent = void;
+
+		size_t operator () (const char* str) const
+		{
+			size_t result = 14695981039346656037ull;
+			for (; *str; ++str)
+				result = (result ^ (u8)*str) * 1099511628211ull;
+			return result;
+		}
+
+		size_t operator () (const std::string& str) const
+		{ return (*this)(str.c_str()); }
+	};
+
+	using TransparentFlatHashMap = flat_hash_map<std::string, std::string, StringHash, std::equal_to<>>;
+
+	using Dictionary = HashMapDictionary<std::string, int>;
+
+	struct ConstantHash
+	{
+		size_t operator () (int) const { return 42; }
+	};
+
+	bool IsNotOne(const std::string& key, int)
+	{ return key != "one"; }
+
+	template < typename Map_ >
+	std::map<typename Map_::key_type, typename Map_::mapped_type> ToMap(const Map_& map)
+	{ return std::map<typename Map_::key_type, typename Map_::mapped_type>(map.begin(), map.end()); }
+
+}
+
+
+TEST(FlatHashMapTest, Construction)
+{
+	{
+		FlatHashMap testee;
+		EXPECT_TRUE(testee.empty());
+		EXPECT_EQ(testee.begin(), testee.end());
+		EXPECT_EQ(testee.bucket_count(), 0u);
+	}
+	{
+		FlatHashMap testee(100);
+		EXPECT_TRUE(testee.empty());
+		EXPECT_GE(testee.bucket_count() * 7 / 8, 100u);
+	}
+	{
+		const std::vector<std::pair<std::string, std::string>> vec = { { "one", "jaws" }, { "two", "bite" }, { "three", "claws" }, { "two", "dup" } };
+
+		FlatHashMap testee(vec.begin(), vec.end());
+		EXPECT_EQ(testee.size(), 3u);
+		ASSERT_THAT(testee, UnorderedElementsAre(std::make_pair("one", "jaws"), std::make_pair("two", "bite"), std::make_pair("three", "claws")));
+	}
+	{
+		const FlatHashMap testee = { { "one", "jaws" }, { "two", "bite" } };
+		ASSERT_THAT(testee, UnorderedElementsAre(std::make_pair("one", "jaws"), std::make_pair("two", "bite")));
+
+		FlatHashMap copy(testee);
+		ASSERT_EQ(copy, testee);
+
+		const FlatHashMap moved(std::move(copy));
+		ASSERT_EQ(moved, testee);
+		ASSERT_TRUE(copy.empty());
+
+		copy = moved;
+		ASSERT_EQ(copy, testee);
+
+		copy = { { "three", "claws" } };
+		ASSERT_NE(copy, testee);
+		ASSERT_THAT(copy, UnorderedElementsAre(std::make_pair("three", "claws")));
+	}
+}
+
+
+TEST(FlatHashMapTest, Modification)
+{
+	FlatHashMap testee;
+
+	ASSERT_TRUE(testee.insert(std::make_pair("one", "jaws")).second);
+	ASSERT_FALSE(testee.insert(std::make_pair("one", "dup")).second);
+	ASSERT_TRUE(testee.emplace("two", "bite").second);
+	ASSERT_FALSE(testee.emplace("two", "dup").second);
+	ASSERT_TRUE(testee.try_emplace("three", "claws").second);
+	ASSERT_FALSE(testee.try_emplace("three", "dup").second);
+	ASSERT_EQ(testee.size(), 3u);
+
+	ASSERT_FALSE(testee.insert_or_assign("three", "catch").second);
+	ASSERT_TRUE(testee.insert_or_assign("four", "blow").second);
+	testee["five"] = "job";
+	testee["one"] = "two";
+
+	ASSERT_THAT(testee, UnorderedElementsAre(std::make_pair("one", "two"), std::make_pair("two", "bite"), std::make_pair("three", "catch"),
+			std::make_pair("four", "blow"), std::make_pair("five", "job")));
+
+	ASSERT_EQ(testee.at("four"), "blow");
+	ASSERT_THROW(testee.at("six"), KeyNotFoundException);
+
+	ASSERT_EQ(testee.erase("four"), 1u);
+	ASSERT_EQ(testee.erase("four"), 0u);
+	ASSERT_EQ(testee.find("four"), testee.end());
+
+	for (FlatHashMap::iterator it = testee.begin(); it != testee.end(); )
+		if (it->first.size() == 3)
+			it = testee.erase(it);
+		else
+			++it;
+
+	ASSERT_THAT(testee, UnorderedElementsAre(std::make_pair("three", "catch"), std::make_pair("five", "job")));
+
+	testee.clear();
+	ASSERT_TRUE(testee.empty());
+	ASSERT_EQ(testee.begin(), testee.end());
+}
+
+
+TEST(FlatHashMapTest, TransparentLookup)
+{
+	TransparentFlatHashMap testee = { { "one", "jaws" }, { "two", "bite" } };
+
+	ASSERT_EQ(testee.find("one")->second, "jaws");
+	ASSERT_EQ(testee.find("three"), testee.end());
+	ASSERT_EQ(testee.count("two"), 1u);
+	ASSERT_EQ(testee.at("two"), "bite");
+
+	const std::pair<TransparentFlatHashMap::const_iterator, TransparentFlatHashMap::const_iterator> range = static_cast<const TransparentFlatHashMap&>(testee).equal_range("one");
+	ASSERT_EQ(std::distance(range.first, range.second), 1);
+	ASSERT_EQ(range.first->first, "one");
+}
+
+
+TEST(FlatHashMapTest, Collisions)
+{
+	flat_hash_map<int, int, ConstantHash> testee;
+	for (int i = 0; i < 100; ++i)
+		testee[i] = i;
+
+	for (int i = 0; i < 100; i += 2)
+		ASSERT_EQ(testee.erase(i), 1u);
+
+	ASSERT_EQ(testee.size(), 50u);
+	for (int i = 0; i < 100; ++i)
+		ASSERT_EQ(testee.count(i), (size_t)(i % 2));
+}
+
+
+TEST(FlatHashMapTest, Random)
+{
+	flat_hash_map<int, int> testee;
+	std::map<int, int> expected;
+
+	u32 random = 1;
+	for (int i = 0; i < 100000; ++i)
+	{
+		random = random * 1103515245 + 12345;
+		const int key = (random >> 8) % 2000;
+
+		if ((random >> 4) % 2 == 0)
+		{
+			ASSERT_EQ(testee.erase(key), expected.erase(key));
+		}
+		else
+		{
+			testee[key] = i;
+			expected[key] = i;
+		}
+
+		if (i % 10000 == 0)
+		{
+			ASSERT_EQ(ToMap(testee), expected);
+			ASSERT_EQ((size_t)std::distance(testee.rbegin(), testee.rend()), expected.size());
+		}
+	}
+
+	ASSERT_EQ(ToMap(testee), expected);
+	ASSERT_LE(testee.bucket_count(), 8192u);
+}
+
+
+TEST(FlatHashMapTest, Dictionary)
+{
+	const auto testee = make_shared_ptr<Dictionary>();
+	ASSERT_TRUE(testee->Add("one", 1));
+	ASSERT_FALSE(testee->Add("one", 2));
+	testee->Set("two", 2);
+	testee->Set("three", 3);
+
+	const auto enumerator = testee->GetEnumerator();
+	testee->Set("two", 22);
+
+	ASSERT_EQ(testee->Get("two"), 22);
+	ASSERT_EQ(testee->GetCount(), 3u);
+
+	size_t count = 0;
+	FOR_EACH(const Dictionary::PairType pair IN enumerator)
+	{
+		ASSERT_EQ(pair.Value, pair.Key == "one" ? 1 : pair.Key == "two" ? 2 : 3);
+		++count;
+	}
+	ASSERT_EQ(count, 3u);
+
+	ASSERT_EQ(testee->RemoveWhere(&IsNotOne), 2u);
+	ASSERT_TRUE(testee->ContainsKey("one"));
+	ASSERT_FALSE(testee->ContainsKey("two"));
+	ASSERT_TRUE(testee->Remove("one"));
+	ASSERT_TRUE(testee->IsEmpty());
+}
+
+
+TEST(FlatHashMapTest, DISABLED_LookupBenchmark)
+{
+	const size_t Count = 1000000;
+	const size_t Lookups = 10000000;
+
+	std::vector<u32> keys(Count);
+	u32 random = 1;
+	for (u32& key : keys)
+		key = random = random * 1103515245 + 12345;
+
+	std::map<u32, u32> stdMap;
+	std::unordered_map<u32, u32> unorderedMap;
+	flat_map<u32, u32> flatMap;
+	flat_hash_map<u32, u32> flatHashMap;
+
+	for (u32 key : keys)
+	{
+		stdMap.emplace(key, key);
+		unorderedMap.emplace(key, key);
+		flatHashMap.emplace(key, key);
+	}
+	flatMap.insert(stdMap.begin(), stdMap.end());
+
+	const auto measure = [&](const std::string& name, const auto& map)
+	{
+		ElapsedTime elapsed;
+		size_t found = 0;
+		u32 missing = 7;
+		for (size_t i = 0; i < Lookups; ++i)
+		{
+			found += map.count(keys[(i * 7919) % Count]);
+			found += map.count(missing = missing * 1664525 + 1013904223);
+		}
+		Logger::Info() << name << ": " << elapsed.ElapsedMilliseconds() << " ms, found " << found;
+	};
+
+	measure("std::map", stdMap);
+	measure("std::unordered_map", unorderedMap);
+	measure("flat_map", flatMap);
+	measure("flat_hash_map", flatHashMap);
+}
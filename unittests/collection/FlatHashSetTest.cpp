@@ -0,0 +1,157 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/flat_hash_set.h>
+
+#include <stingraykit/collection/ForEach.h>
+#include <stingraykit/collection/HashSet.h>
+
+#include <gmock/gmock-matchers.h>
+
+#include <set>
+
+using namespace stingray;
+
+using ::testing::UnorderedElementsAre;
+
+namespace
+{
+
+	using FlatHashSet = flat_hash_set<std::string>;
+
+	struct StringHash
+	{
+		using is_transparent = void;
+
+		size_t operator () (const char* str) const
+		{
+			size_t result = 14695981039346656037ull;
+			for (; *str; ++str)
+				result = (result ^ (u8)*str) * 1099511628211ull;
+			return result;
+		}
+
+		size_t operator () (const std::string& str) const
+		{ return (*this)(str.c_str()); }
+	};
+
+	using TransparentFlatHashSet = flat_hash_set<std::string, StringHash, std::equal_to<>>;
+
+	bool IsEven(int value)
+	{ return value % 2 == 0; }
+
+}
+
+
+TEST(FlatHashSetTest, Construction)
+{
+	{
+		FlatHashSet testee;
+		EXPECT_TRUE(testee.empty());
+		EXPECT_EQ(testee.begin(), testee.end());
+	}
+	{
+		const std::vector<std::string> vec = { "one", "two", "three", "two" };
+
+		FlatHashSet testee(vec.begin(), vec.end());
+		EXPECT_EQ(testee.size(), 3u);
+		ASSERT_THAT(testee, UnorderedElementsAre("one", "two", "three"));
+	}
+	{
+		const FlatHashSet testee = { "one", "two" };
+
+		FlatHashSet copy(testee);
+		ASSERT_EQ(copy, testee);
+
+		copy = { "three" };
+		ASSERT_NE(copy, testee);
+		ASSERT_THAT(copy, UnorderedElementsAre("three"));
+	}
+}
+
+
+TEST(FlatHashSetTest, Modification)
+{
+	FlatHashSet testee;
+
+	ASSERT_TRUE(testee.insert("one").second);
+	ASSERT_FALSE(testee.insert("one").second);
+	ASSERT_TRUE(testee.emplace("two").second);
+	ASSERT_FALSE(testee.emplace("two").second);
+	ASSERT_EQ(*testee.insert(testee.end(), "three"), "three");
+	ASSERT_EQ(testee.size(), 3u);
+
+	ASSERT_EQ(testee.erase("two"), 1u);
+	ASSERT_EQ(testee.erase("two"), 0u);
+	ASSERT_EQ(testee.count("two"), 0u);
+
+	ASSERT_EQ(testee.erase(testee.begin(), testee.end()), testee.end());
+	ASSERT_TRUE(testee.empty());
+}
+
+
+TEST(FlatHashSetTest, TransparentLookup)
+{
+	const TransparentFlatHashSet testee = { "one", "two" };
+
+	ASSERT_EQ(*testee.find("one"), "one");
+	ASSERT_EQ(testee.find("three"), testee.end());
+	ASSERT_EQ(testee.count("two"), 1u);
+}
+
+
+TEST(FlatHashSetTest, Random)
+{
+	flat_hash_set<u64> testee;
+	std::set<u64> expected;
+
+	u32 random = 1;
+	for (int i = 0; i < 100000; ++i)
+	{
+		random = random * 1103515245 + 12345;
+		const u64 value = (u64)((random >> 8) % 5000) << 32;
+
+		if ((random >> 4) % 3 == 0)
+		{
+			ASSERT_EQ(testee.erase(value), expected.erase(value));
+		}
+		else
+		{
+			ASSERT_EQ(testee.insert(value).second, expected.insert(value).second);
+		}
+	}
+
+	ASSERT_EQ(std::set<u64>(testee.begin(), testee.end()), expected);
+	ASSERT_EQ(std::set<u64>(testee.rbegin(), testee.rend()), expected);
+}
+
+
+TEST(FlatHashSetTest, Set)
+{
+	const auto testee = make_shared_ptr<HashSet<int>>();
+	for (int i = 0; i < 10; ++i)
+		ASSERT_TRUE(testee->Add(i));
+	ASSERT_FALSE(testee->Add(5));
+
+	const auto enumerator = testee->GetEnumerator();
+	ASSERT_EQ(testee->RemoveWhere(&IsEven), 5u);
+	ASSERT_EQ(testee->GetCount(), 5u);
+	ASSERT_TRUE(testee->Contains(5));
+	ASSERT_FALSE(testee->Contains(4));
+
+	size_t count = 0;
+	FOR_EACH(const int value IN enumerator)
+	{
+		(void)value;
+		++count;
+	}
+	ASSERT_EQ(count, 10u);
+
+	ASSERT_TRUE(testee->Find(3)->Valid());
+	ASSERT_FALSE(testee->Find(4)->Valid());
+	ASSERT_TRUE(testee->ReverseFind(3)->Valid());
+}
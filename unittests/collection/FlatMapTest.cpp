@@ -7,6 +7,11 @@
 
 #include <stingraykit/collection/flat_map.h>
 
+#include <stingraykit/collection/EnumerableFromStlContainer.h>
+#include <stingraykit/collection/FlatMapDictionary.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/time/ElapsedTime.h>
+
 #include <gmock/gmock-matchers.h>
 
 using namespace stingray;
@@ -33,6 +38,12 @@ namespace
 				{ "Russians", "Greatest nation in the world!" }, { "Ukrainians", "Salo Ukraine! Geroyam Salo!" } };
 	}
 
+	bool IsShortKey(const FlatMap::value_type& pair)
+	{ return pair.first.size() <= 3; }
+
+	bool IsOddKey(int key, int)
+	{ return key % 2 != 0; }
+
 	struct PairEquals
 	{
 		template < typename Lhs_, typename Rhs_ >
@@ -252,6 +263,121 @@ TEST(FlatMapTest, Insertion)
 }
 
 
+TEST(FlatMapTest, BulkInsertion)
+{
+	{
+		FlatMap testee = { { "one", "jaws" }, { "three", "claws" } };
+
+		const Vector vec = { { "two", "bite" }, { "three", "dup" }, { "four", "catch" }, { "two", "dup" }, { "five", "blow" } };
+		testee.insert(vec.begin(), vec.end());
+
+		EXPECT_TRUE(std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("five", "blow"), std::make_pair("four", "catch"), std::make_pair("one", "jaws"), std::make_pair("three", "claws"), std::make_pair("two", "bite")));
+
+		testee.insert(vec.begin(), vec.begin());
+		testee.insert({ { "zero", "nil" } });
+		ASSERT_EQ(testee.size(), 6u);
+		ASSERT_EQ(testee.rbegin()->first, "zero");
+	}
+	{
+		FlatMap testee = { { "one", "jaws" }, { "three", "claws" } };
+
+		const Map map = { { "four", "catch" }, { "one", "dup" }, { "two", "bite" } };
+		testee.insert(SortedUnique, map.begin(), map.end());
+
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("four", "catch"), std::make_pair("one", "jaws"), std::make_pair("three", "claws"), std::make_pair("two", "bite")));
+
+		testee.insert(SortedUnique, { { "five", "blow" }, { "zero", "nil" } });
+		ASSERT_EQ(testee.size(), 6u);
+		EXPECT_TRUE(std::is_sorted(testee.begin(), testee.end(), testee.value_comp()));
+	}
+	{
+		const FlatMap testee(SortedUnique, { { "four", "catch" }, { "one", "jaws" } });
+		ASSERT_THAT(testee, ElementsAre(std::make_pair("four", "catch"), std::make_pair("one", "jaws")));
+	}
+}
+
+
+TEST(FlatMapTest, EraseIf)
+{
+	const Vector vec = GetUnorderedVector();
+	FlatMap testee(vec.begin(), vec.end());
+	ASSERT_EQ(testee.size(), 10u);
+
+	ASSERT_EQ(erase_if(testee, &IsShortKey), 4u);
+	ASSERT_THAT(testee, ElementsAre(std::make_pair("eight", "girls"), std::make_pair("five", "blow"), std::make_pair("four", "catch"),
+			std::make_pair("nine", "one"), std::make_pair("seven", "two"), std::make_pair("three", "claws")));
+
+	ASSERT_EQ(erase_if(testee, &IsShortKey), 0u);
+}
+
+
+TEST(FlatMapTest, Dictionary)
+{
+	const std::vector<KeyValuePair<int, int>> pairs = { { 3, 1 }, { 1, 1 }, { 2, 1 }, { 3, 2 }, { 1, 2 } };
+
+	const FlatMapDictionary<int, int> testee(EnumerableFromStlContainer(pairs));
+	ASSERT_EQ(testee.GetCount(), 3u);
+	ASSERT_EQ(testee.Get(1), 2);
+	ASSERT_EQ(testee.Get(2), 1);
+	ASSERT_EQ(testee.Get(3), 2);
+
+	FlatMapDictionary<int, int> copy(testee.GetEnumerator());
+	ASSERT_EQ(copy.RemoveWhere(&IsOddKey), 2u);
+	ASSERT_EQ(copy.GetCount(), 1u);
+	ASSERT_TRUE(copy.ContainsKey(2));
+}
+
+
+TEST(FlatMapTest, DISABLED_BulkInsertionBenchmark)
+{
+	const size_t Count = 1000000;
+
+	std::vector<std::pair<int, int>> pairs;
+	pairs.reserve(Count);
+
+	u32 random = 1;
+	for (size_t i = 0; i < Count; ++i)
+	{
+		random = random * 1103515245 + 12345;
+		pairs.emplace_back((int)(random >> 1), (int)i);
+	}
+
+	{
+		ElapsedTime elapsed;
+		flat_map<int, int> map;
+		for (size_t i = 0; i < Count / 10; ++i)
+			map.insert(pairs[i]);
+		Logger::Info() << "Element by element insertion of " << Count / 10 << " pairs: " << elapsed.ElapsedMilliseconds() << " ms";
+	}
+
+	{
+		ElapsedTime elapsed;
+		const flat_map<int, int> map(pairs.begin(), pairs.end());
+		Logger::Info() << "Bulk insertion of " << map.size() << " pairs: " << elapsed.ElapsedMilliseconds() << " ms";
+
+		std::vector<std::pair<int, int>> sorted;
+		for (size_t i = 0; i < Count; ++i)
+			sorted.emplace_back((int)(i * 2 + 1), (int)i);
+
+		flat_map<int, int> copy(map);
+		elapsed.Restart();
+		copy.insert(SortedUnique, sorted.begin(), sorted.end());
+		Logger::Info() << "Sorted merge of " << sorted.size() << " pairs into " << map.size() << ": " << elapsed.ElapsedMilliseconds() << " ms";
+	}
+
+	{
+		std::vector<KeyValuePair<int, int>> kvPairs;
+		for (const std::pair<int, int>& pair : pairs)
+			kvPairs.emplace_back(pair.first, pair.second);
+
+		ElapsedTime elapsed;
+		const FlatMapDictionary<int, int> dictionary(EnumerableFromStlContainer(kvPairs));
+		Logger::Info() << "FlatMapDictionary construction from " << kvPairs.size() << " pairs: " << elapsed.ElapsedMilliseconds() << " ms";
+	}
+}
+
+
 TEST(FlatMapTest, Emplacing)
 {
 	{
@@ -6,6 +6,9 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #include <stingraykit/collection/flat_set.h>
+
+#include <stingraykit/collection/EnumerableFromStlContainer.h>
+#include <stingraykit/collection/FlatSortedSet.h>
 #include <stingraykit/string/string_view.h>
 
 #include <gmock/gmock-matchers.h>
@@ -28,6 +31,12 @@ namespace
 	FlatSet GetSampleFlatSet()
 	{ return { "Americans", "Australians", "Japaneses", "Russians", "Ukrainians" }; }
 
+	bool IsShort(const std::string& str)
+	{ return str.size() <= 3; }
+
+	bool IsOdd(const int& value)
+	{ return value % 2 != 0; }
+
 }
 
 
@@ -190,6 +199,69 @@ TEST(FlatSetTest, Insertion)
 }
 
 
+TEST(FlatSetTest, BulkInsertion)
+{
+	{
+		FlatSet testee = { "one", "three" };
+
+		const Vector vec = { "two", "three", "four", "two", "five" };
+		testee.insert(vec.begin(), vec.end());
+
+		EXPECT_TRUE(std::is_sorted(testee.begin(), testee.end(), testee.key_comp()));
+		ASSERT_THAT(testee, ElementsAre("five", "four", "one", "three", "two"));
+
+		testee.insert(vec.begin(), vec.begin());
+		testee.insert({ "zero" });
+		ASSERT_EQ(testee.size(), 6u);
+		ASSERT_EQ(*testee.rbegin(), "zero");
+	}
+	{
+		FlatSet testee = { "one", "three" };
+
+		const Set set = { "four", "one", "two" };
+		testee.insert(SortedUnique, set.begin(), set.end());
+
+		ASSERT_THAT(testee, ElementsAre("four", "one", "three", "two"));
+
+		testee.insert(SortedUnique, { "five", "zero" });
+		ASSERT_EQ(testee.size(), 6u);
+		EXPECT_TRUE(std::is_sorted(testee.begin(), testee.end(), testee.key_comp()));
+	}
+	{
+		const FlatSet testee(SortedUnique, { "four", "one" });
+		ASSERT_THAT(testee, ElementsAre("four", "one"));
+	}
+}
+
+
+TEST(FlatSetTest, EraseIf)
+{
+	const Vector vec = GetUnorderedVector();
+	FlatSet testee(vec.begin(), vec.end());
+	ASSERT_EQ(testee.size(), 10u);
+
+	ASSERT_EQ(erase_if(testee, &IsShort), 4u);
+	ASSERT_THAT(testee, ElementsAre("eight", "five", "four", "nine", "seven", "three"));
+
+	ASSERT_EQ(erase_if(testee, &IsShort), 0u);
+}
+
+
+TEST(FlatSetTest, SortedSet)
+{
+	const std::vector<int> values = { 3, 1, 2, 3, 5, 4, 1 };
+
+	FlatSortedSet<int> testee(EnumerableFromStlContainer(values));
+	ASSERT_EQ(testee.GetCount(), 5u);
+	ASSERT_TRUE(testee.Contains(4));
+
+	ASSERT_EQ(testee.RemoveWhere(&IsOdd), 3u);
+	ASSERT_EQ(testee.GetCount(), 2u);
+	ASSERT_FALSE(testee.Contains(3));
+	ASSERT_TRUE(testee.Contains(4));
+}
+
+
 TEST(FlatSetTest, Emplacing)
 {
 	{
@@ -6,9 +6,15 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #include <stingraykit/collection/QueueCache.h>
+#include <stingraykit/collection/TwoQueueCache.h>
+#include <stingraykit/function/bind.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/time/ElapsedTime.h>
 
 #include <gtest/gtest.h>
 
+#include <map>
+
 using namespace stingray;
 
 namespace
@@ -318,3 +324,172 @@ TEST(LruCacheTest, SizeMapping)
 	cache.Remove(9);
 	ASSERT_EQ(cache.GetSize(), size_t(0));
 }
+
+
+namespace
+{
+
+	void AppendEvicted(std::vector<std::pair<s32, std::string>>& evicted, s32 key, const std::string& value)
+	{ evicted.emplace_back(key, value); }
+
+
+	class MapLruCache
+	{
+		using Dictionary = std::map<s32, std::pair<s32, u64>>;
+		using Queue = std::map<u64, Dictionary::iterator>;
+
+	private:
+		size_t			_capacity;
+		u64				_monotonic;
+		Dictionary		_dictionary;
+		Queue			_queue;
+
+	public:
+		explicit MapLruCache(size_t capacity) : _capacity(capacity), _monotonic(0) { }
+
+		bool TryGet(s32 key, s32& out)
+		{
+			const Dictionary::iterator iter = _dictionary.find(key);
+			if (iter == _dictionary.end())
+				return false;
+
+			_queue.erase(iter->second.second);
+			iter->second.second = _monotonic++;
+			_queue.emplace(iter->second.second, iter);
+
+			out = iter->second.first;
+			return true;
+		}
+
+		void Set(s32 key, s32 value)
+		{
+			Dictionary::iterator iter = _dictionary.find(key);
+			if (iter != _dictionary.end())
+			{
+				_queue.erase(iter->second.second);
+				iter->second = std::make_pair(value, _monotonic++);
+			}
+			else
+				iter = _dictionary.emplace(key, std::make_pair(value, _monotonic++)).first;
+
+			_queue.emplace(iter->second.second, iter);
+
+			while (_dictionary.size() > _capacity)
+			{
+				_dictionary.erase(_queue.begin()->second);
+				_queue.erase(_queue.begin());
+			}
+		}
+	};
+
+
+	template < typename CacheType >
+	s64 MeasureLookups(CacheType& cache, size_t entries, size_t lookups)
+	{
+		for (size_t i = 0; i < entries; ++i)
+			cache.Set((s32)i, (s32)i);
+
+		ElapsedTime elapsed;
+		s32 out = 0;
+		for (size_t i = 0; i < lookups; ++i)
+		{
+			const s32 key = (s32)((i * 2654435761u) % (entries + entries / 10));
+			if (!cache.TryGet(key, out))
+				cache.Set(key, key);
+		}
+		return elapsed.ElapsedMilliseconds();
+	}
+
+}
+
+
+namespace
+{
+
+	struct UnhashableKey
+	{
+		s32		Value;
+
+	public:
+		UnhashableKey(s32 value) : Value(value) { }
+
+		bool operator < (const UnhashableKey& other) const { return Value < other.Value; }
+	};
+
+}
+
+
+TEST(LruCacheTest, OrderedDictionary)
+{
+	static_assert(IsSame<Detail::DefaultQueueCacheComparer<UnhashableKey>::ValueT, comparers::Less>::Value, "Expected comparers::Less for key without std::hash");
+	static_assert(IsSame<Detail::DefaultQueueCacheComparer<s32>::ValueT, comparers::Equals>::Value, "Expected comparers::Equals for key with std::hash");
+
+	LruCache<UnhashableKey, s32> unhashable(2);
+
+	unhashable.Set(1, 1);
+	unhashable.Set(2, 2);
+	ASSERT_EQ(CacheGet<UnhashableKey>(unhashable, 1), 1);
+
+	unhashable.Set(3, 3);
+	ASSERT_EQ(CacheGet<UnhashableKey>(unhashable, 1), 1);
+	ASSERT_FALSE(CacheGet<UnhashableKey>(unhashable, 2));
+	ASSERT_EQ(CacheGet<UnhashableKey>(unhashable, 3), 3);
+
+	TwoQueueCache<UnhashableKey, s32> twoQueue(1, 1, 1);
+	twoQueue.Set(1, 1);
+	ASSERT_EQ(CacheGet<UnhashableKey>(twoQueue, 1), 1);
+
+	FifoCache<s32, s32, DefaultCacheSizeMapper, comparers::Less> ordered(2);
+
+	ordered.Set(1, 1);
+	ordered.Set(2, 2);
+	ASSERT_EQ(CacheGet(ordered, 1), 1);
+
+	ordered.Set(3, 3);
+	ASSERT_FALSE(CacheGet(ordered, 1));
+	ASSERT_EQ(CacheGet(ordered, 2), 2);
+	ASSERT_EQ(CacheGet(ordered, 3), 3);
+}
+
+
+TEST(LruCacheTest, OnEvicted)
+{
+	using Cache = LruCache<s32, std::string, StringSizeMapper>;
+
+	Cache cache(10);
+
+	std::vector<std::pair<s32, std::string>> evicted;
+	const Token connection(cache.OnEvicted().connect(Bind(&AppendEvicted, wrap_ref(evicted), _1, _2)));
+
+	cache.Set(1, "aaa");
+	cache.Set(2, "bbb");
+	cache.Set(3, "ccc");
+	ASSERT_TRUE(CacheGet(cache, 1));
+
+	cache.Set(4, "ddddd");
+	ASSERT_EQ(evicted, (std::vector<std::pair<s32, std::string>>{ { 2, "bbb" }, { 3, "ccc" } }));
+
+	evicted.clear();
+	ASSERT_TRUE(cache.Remove(1));
+	cache.Clear();
+	ASSERT_TRUE(evicted.empty());
+	ASSERT_EQ(cache.GetSize(), 0u);
+	ASSERT_FALSE(CacheGet(cache, 4));
+}
+
+
+TEST(LruCacheTest, DISABLED_Benchmark)
+{
+	const size_t Lookups = 10000000;
+
+	for (size_t entries : { 1000, 100000, 10000000 })
+	{
+		MapLruCache mapCache(entries);
+		const s64 mapMs = MeasureLookups(mapCache, entries, Lookups);
+
+		LruCache<s32, s32> hashCache(entries);
+		const s64 hashMs = MeasureLookups(hashCache, entries, Lookups);
+
+		Logger::Info() << Lookups << " lookups over " << entries << " entries: map-based " << mapMs << " ms, hash-based " << hashMs << " ms";
+	}
+}
@@ -7,6 +7,9 @@
 
 #include <stingraykit/collection/ordered_map.h>
 
+#include <stingraykit/collection/btree_set.h>
+#include <stingraykit/string/ToString.h>
+
 #include <gmock/gmock-matchers.h>
 
 #include <map>
@@ -22,6 +25,7 @@ namespace
 	using Map = std::map<std::string, std::string>;
 	using OrderedMap = ordered_map<std::string, std::string>;
 	using TransparentOrderedMap = ordered_map<std::string, std::string, std::less<>>;
+	using BTreeOrderedMap = ordered_map<std::string, std::string, std::less<>, std::allocator<std::pair<const std::string, std::string>>, btree_set>;
 
 }
 
@@ -951,3 +955,37 @@ TEST(OrderedMapTest, Comparison)
 		ASSERT_FALSE(testee2 >= testee1);
 	}
 }
+
+
+TEST(OrderedMapTest, BTreeIndex)
+{
+	BTreeOrderedMap testee;
+	OrderedMap expected;
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		const std::string key = ToString((i * 7919) % 2000);
+		ASSERT_TRUE(testee.emplace(key, key).second);
+		expected.emplace(key, key);
+	}
+	ASSERT_FALSE(testee.emplace("5", "").second);
+
+	for (int i = 0; i < 2000; i += 3)
+	{
+		ASSERT_EQ(testee.erase(ToString(i)), 1u);
+		expected.erase(ToString(i));
+	}
+
+	ASSERT_EQ(testee.erase(testee.begin(), std::next(testee.begin(), 10))->first, expected.erase(expected.begin(), std::next(expected.begin(), 10))->first);
+
+	ASSERT_EQ(testee.size(), expected.size());
+	ASSERT_TRUE(std::equal(testee.begin(), testee.end(), expected.begin(), expected.end()));
+
+	for (int i = 0; i < 2000; ++i)
+		ASSERT_EQ(testee.count(ToString(i)), expected.count(ToString(i)));
+	ASSERT_EQ(testee.at(std::string("1")), "1");
+
+	BTreeOrderedMap moved(std::move(testee));
+	ASSERT_TRUE(std::equal(moved.begin(), moved.end(), expected.begin(), expected.end()));
+	ASSERT_EQ(moved.find("4")->second, "4");
+}
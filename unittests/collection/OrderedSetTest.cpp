@@ -7,6 +7,9 @@
 
 #include <stingraykit/collection/ordered_set.h>
 
+#include <stingraykit/collection/btree_set.h>
+#include <stingraykit/string/ToString.h>
+
 #include <gmock/gmock-matchers.h>
 
 using namespace stingray;
@@ -20,6 +23,7 @@ namespace
 	using Set = std::set<std::string>;
 	using OrderedSet = ordered_set<std::string>;
 	using TransparentOrderedSet = ordered_set<std::string, std::less<>>;
+	using BTreeOrderedSet = ordered_set<std::string, std::less<>, std::allocator<std::string>, btree_set>;
 
 }
 
@@ -608,3 +612,34 @@ TEST(OrderedSetTest, Comparison)
 		ASSERT_FALSE(testee2 >= testee1);
 	}
 }
+
+
+TEST(OrderedSetTest, BTreeIndex)
+{
+	BTreeOrderedSet testee;
+	OrderedSet expected;
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		const std::string value = ToString((i * 7919) % 2000);
+		ASSERT_TRUE(testee.insert(value).second);
+		expected.insert(value);
+	}
+	ASSERT_FALSE(testee.insert("5").second);
+
+	for (int i = 0; i < 2000; i += 3)
+	{
+		ASSERT_EQ(testee.erase(ToString(i)), 1u);
+		expected.erase(ToString(i));
+	}
+
+	ASSERT_EQ(testee.size(), expected.size());
+	ASSERT_TRUE(std::equal(testee.begin(), testee.end(), expected.begin(), expected.end()));
+
+	for (int i = 0; i < 2000; ++i)
+		ASSERT_EQ(testee.count(ToString(i)), expected.count(ToString(i)));
+	ASSERT_EQ(*testee.find("1"), "1");
+
+	BTreeOrderedSet moved(std::move(testee));
+	ASSERT_TRUE(std::equal(moved.begin(), moved.end(), expected.begin(), expected.end()));
+}
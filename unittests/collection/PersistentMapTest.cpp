@@ -0,0 +1,212 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/persistent_map.h>
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+using namespace stingray;
+
+namespace
+{
+
+	using Map = persistent_map<int, std::string>;
+	using StdMap = std::map<int, std::string>;
+
+	bool Equals(const Map& map, const StdMap& expected)
+	{
+		using Pairs = std::vector<Map::value_type>;
+
+		const Pairs pairs(expected.begin(), expected.end());
+		return map.size() == expected.size() && Pairs(map.begin(), map.end()) == pairs && Pairs(map.rbegin(), map.rend()) == Pairs(pairs.rbegin(), pairs.rend());
+	}
+
+}
+
+
+TEST(PersistentMapTest, Basic)
+{
+	Map map;
+	ASSERT_TRUE(map.empty());
+	ASSERT_EQ(map.begin(), map.end());
+	ASSERT_EQ(map.find(1), map.end());
+
+	ASSERT_TRUE(map.emplace(2, "2").second);
+	ASSERT_TRUE(map.emplace(1, "1").second);
+	ASSERT_FALSE(map.emplace(1, "one").second);
+	ASSERT_EQ(map.size(), 2u);
+	ASSERT_EQ(map.at(1), "1");
+
+	map.insert_or_assign(1, "one");
+	ASSERT_EQ(map.at(1), "one");
+	ASSERT_EQ(map.count(1), 1u);
+	ASSERT_EQ(map.count(3), 0u);
+
+	ASSERT_EQ(map.lower_bound(0)->first, 1);
+	ASSERT_EQ(map.lower_bound(2)->first, 2);
+	ASSERT_EQ(map.upper_bound(1)->first, 2);
+	ASSERT_EQ(map.lower_bound(3), map.end());
+
+	ASSERT_EQ(map.erase(1), 1u);
+	ASSERT_EQ(map.erase(1), 0u);
+	ASSERT_EQ(map.size(), 1u);
+
+	map.clear();
+	ASSERT_TRUE(map.empty());
+	ASSERT_THROW(map.at(2), std::out_of_range);
+}
+
+
+TEST(PersistentMapTest, Random)
+{
+	Map map;
+	StdMap expected;
+
+	u32 random = 1;
+	for (size_t i = 0; i < 20000; ++i)
+	{
+		random = random * 1103515245 + 12345;
+		const int key = (random >> 8) % 3000;
+
+		if ((random >> 4) % 3 == 0)
+		{
+			ASSERT_EQ(map.erase(key), expected.erase(key));
+		}
+		else
+		{
+			map.insert_or_assign(key, std::to_string(i));
+			expected[key] = std::to_string(i);
+		}
+
+		if (i % 1000 == 0)
+		{
+			ASSERT_TRUE(Equals(map, expected));
+		}
+	}
+
+	ASSERT_TRUE(Equals(map, expected));
+
+	for (int key = -1; key < 3001; ++key)
+	{
+		const Map::const_iterator it = map.lower_bound(key);
+		const StdMap::const_iterator expectedIt = expected.lower_bound(key);
+		ASSERT_EQ(std::distance(map.begin(), it), std::distance(expected.cbegin(), expectedIt));
+		ASSERT_EQ(map.find(key) != map.end(), expected.count(key) != 0);
+	}
+
+	while (!map.empty())
+		map.erase(map.begin());
+	ASSERT_EQ(map.begin(), map.end());
+}
+
+
+TEST(PersistentMapTest, Snapshots)
+{
+	Map map;
+	StdMap expected;
+
+	std::vector<std::pair<Map, StdMap>> snapshots;
+	for (int i = 0; i < 1000; ++i)
+	{
+		const int key = (i * 7919) % 1000;
+		if (i % 5 == 4)
+		{
+			map.erase((key + 500) % 1000);
+			expected.erase((key + 500) % 1000);
+		}
+		else
+		{
+			map.insert_or_assign(key, std::to_string(i));
+			expected[key] = std::to_string(i);
+		}
+
+		if (i % 50 == 0)
+			snapshots.emplace_back(map, expected);
+	}
+
+	for (const std::pair<Map, StdMap>& snapshot : snapshots)
+		ASSERT_TRUE(Equals(snapshot.first, snapshot.second));
+
+	Map copy = map;
+	copy.clear();
+	ASSERT_TRUE(Equals(map, expected));
+}
+
+
+TEST(PersistentMapTest, Diff)
+{
+	using DiffEnumerator = Map::diff_enumerator<>;
+	using DiffEntries = std::vector<std::pair<bool, Map::value_type>>;
+
+	Map from;
+	for (int i = 0; i < 5000; ++i)
+		from.insert_or_assign(i * 2, std::to_string(i));
+
+	u32 random = 1;
+	for (size_t changes : { 0, 1, 10, 100, 2000 })
+	{
+		Map to = from;
+		StdMap expected(from.begin(), from.end());
+
+		for (size_t i = 0; i < changes; ++i)
+		{
+			random = random * 1103515245 + 12345;
+			const int key = (random >> 8) % 10000;
+
+			if ((random >> 4) % 2 == 0)
+			{
+				to.erase(key);
+				expected.erase(key);
+			}
+			else
+			{
+				to.insert_or_assign(key, std::to_string(i % 3));
+				expected[key] = std::to_string(i % 3);
+			}
+		}
+
+		DiffEntries diff;
+		for (DiffEnumerator enumerator(from, to); enumerator.valid(); enumerator.next())
+			diff.emplace_back(enumerator.removed(), enumerator.get());
+
+		const Map unrelated(expected.begin(), expected.end());
+
+		DiffEntries fullDiff;
+		for (DiffEnumerator enumerator(from, unrelated); enumerator.valid(); enumerator.next())
+			fullDiff.emplace_back(enumerator.removed(), enumerator.get());
+
+		ASSERT_EQ(diff, fullDiff);
+
+		DiffEntries expectedDiff;
+		StdMap::const_iterator expectedIt = expected.begin();
+		for (const Map::value_type& entry : from)
+		{
+			for (; expectedIt != expected.end() && expectedIt->first < entry.first; ++expectedIt)
+				expectedDiff.emplace_back(false, *expectedIt);
+
+			if (expectedIt != expected.end() && expectedIt->first == entry.first)
+			{
+				if (expectedIt->second != entry.second)
+				{
+					expectedDiff.emplace_back(true, entry);
+					expectedDiff.emplace_back(false, *expectedIt);
+				}
+				++expectedIt;
+			}
+			else
+				expectedDiff.emplace_back(true, entry);
+		}
+		for (; expectedIt != expected.end(); ++expectedIt)
+			expectedDiff.emplace_back(false, *expectedIt);
+
+		ASSERT_EQ(diff, expectedDiff);
+	}
+
+	ASSERT_FALSE(DiffEnumerator(Map(), Map()).valid());
+}
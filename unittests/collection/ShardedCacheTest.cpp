@@ -0,0 +1,191 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/ShardedCache.h>
+
+#include <stingraykit/collection/TwoQueueCache.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/thread/Thread.h>
+#include <stingraykit/thread/atomic/AtomicInt.h>
+#include <stingraykit/time/ElapsedTime.h>
+
+#include <gtest/gtest.h>
+
+using namespace stingray;
+
+namespace
+{
+
+	template < typename Key_, typename Value_ >
+	optional<Value_> CacheGet(ICache<Key_, Value_>& cache, const Key_& key)
+	{
+		Value_ out;
+		return cache.TryGet(key, out) ? make_optional_value(out) : null;
+	}
+
+
+	void CountEvicted(size_t& count, s32, s32)
+	{ ++count; }
+
+
+	s32 SlowSquare(AtomicS32::Type& calls, s32 value)
+	{
+		AtomicS32::Inc(calls);
+		Thread::Sleep(TimeDuration::FromMilliseconds(100));
+		return value * value;
+	}
+
+
+	s32 Throw()
+	{ STINGRAYKIT_THROW(InvalidOperationException("Factory failed")); }
+
+
+	s32 ThrowNonStd()
+	{ throw 42; }
+
+
+	template < typename CacheType >
+	void ComputeSquare(CacheType& cache, s32 key, s32& result, AtomicS32::Type& calls)
+	{ result = cache.GetOrCompute(key, Bind(&SlowSquare, wrap_ref(calls), key)); }
+
+
+	class LockedCache
+	{
+	private:
+		Mutex				_guard;
+		LruCache<s32, s32>	_cache;
+
+	public:
+		explicit LockedCache(size_t capacity) : _cache(capacity) { }
+
+		bool TryGet(s32 key, s32& out)	{ MutexLock l(_guard); return _cache.TryGet(key, out); }
+		void Set(s32 key, s32 value)	{ MutexLock l(_guard); _cache.Set(key, value); }
+	};
+
+
+	const size_t BenchmarkThreads = 4;
+	const size_t BenchmarkLookups = 2000000;
+
+	template < typename CacheType >
+	void Lookup(CacheType& cache, size_t seed)
+	{
+		u32 random = seed;
+		s32 out = 0;
+		for (size_t i = 0; i < BenchmarkLookups; ++i)
+		{
+			random ^= random << 13;
+			random ^= random >> 17;
+			random ^= random << 5;
+
+			const s32 key = (s32)((random % (random & 0xE0000000 ? 50000 : 1000000)) * 2654435761u);
+			if (!cache.TryGet(key, out))
+				cache.Set(key, key);
+		}
+	}
+
+	template < typename CacheType >
+	s64 MeasureLookups(CacheType& cache)
+	{
+		ElapsedTime elapsed;
+		{
+			std::vector<ThreadPtr> threads;
+			for (size_t i = 0; i < BenchmarkThreads; ++i)
+				threads.push_back(make_shared_ptr<Thread>(StringBuilder() % "cacheLookup" % i, Bind(&Lookup<CacheType>, wrap_ref(cache), i + 1)));
+		}
+		return elapsed.ElapsedMilliseconds();
+	}
+
+}
+
+
+TEST(ShardedCacheTest, Basic)
+{
+	ShardedCache<s32, s32> cache(4, 100);
+	ASSERT_EQ(cache.GetSize(), 0u);
+
+	for (s32 i = 0; i < 100; ++i)
+		cache.Set(i, i * 10);
+	ASSERT_EQ(cache.GetSize(), 100u);
+
+	for (s32 i = 0; i < 100; ++i)
+		ASSERT_EQ(CacheGet(cache, i), i * 10);
+	ASSERT_FALSE(CacheGet(cache, 100));
+
+	ASSERT_TRUE(cache.Remove(10));
+	ASSERT_FALSE(cache.Remove(10));
+	ASSERT_FALSE(CacheGet(cache, 10));
+	ASSERT_EQ(cache.GetSize(), 99u);
+
+	cache.Clear();
+	ASSERT_EQ(cache.GetSize(), 0u);
+	ASSERT_FALSE(CacheGet(cache, 0));
+}
+
+
+TEST(ShardedCacheTest, Eviction)
+{
+	ShardedCache<s32, s32, TwoQueueCache<s32, s32>> cache(4, 2, 2, 4);
+
+	size_t evicted = 0;
+	const Token connection(cache.OnEvicted().connect(Bind(&CountEvicted, wrap_ref(evicted), _1, _2)));
+
+	for (s32 i = 0; i < 1000; ++i)
+		cache.Set(i, i);
+
+	ASSERT_LE(cache.GetSize(), 4u * 8u);
+	ASSERT_EQ(evicted + cache.GetSize(), 1000u);
+}
+
+
+TEST(ShardedCacheTest, GetOrCompute)
+{
+	ShardedCache<s32, s32> cache(4, 100);
+
+	AtomicS32::Type calls = 0;
+	ASSERT_EQ(cache.GetOrCompute(3, Bind(&SlowSquare, wrap_ref(calls), 3)), 9);
+	ASSERT_EQ(cache.GetOrCompute(3, Bind(&SlowSquare, wrap_ref(calls), 3)), 9);
+	ASSERT_EQ(calls, 1);
+	ASSERT_EQ(CacheGet(cache, 3), 9);
+
+	ASSERT_THROW(cache.GetOrCompute(4, &Throw), InvalidOperationException);
+	ASSERT_FALSE(CacheGet(cache, 4));
+	ASSERT_EQ(cache.GetOrCompute(4, Bind(&SlowSquare, wrap_ref(calls), 4)), 16);
+
+	ASSERT_THROW(cache.GetOrCompute(5, &ThrowNonStd), int);
+	ASSERT_FALSE(CacheGet(cache, 5));
+	ASSERT_EQ(cache.GetOrCompute(5, Bind(&SlowSquare, wrap_ref(calls), 5)), 25);
+}
+
+
+TEST(ShardedCacheTest, SingleFlight)
+{
+	ShardedCache<s32, s32> cache(4, 100);
+
+	AtomicS32::Type calls = 0;
+	std::vector<s32> results(8);
+	{
+		std::vector<ThreadPtr> threads;
+		for (size_t i = 0; i < results.size(); ++i)
+			threads.push_back(make_shared_ptr<Thread>(StringBuilder() % "compute" % i, Bind(&ComputeSquare<ShardedCache<s32, s32>>, wrap_ref(cache), 7, wrap_ref(results[i]), wrap_ref(calls))));
+	}
+
+	ASSERT_EQ(calls, 1);
+	ASSERT_EQ(results, std::vector<s32>(results.size(), 49));
+}
+
+
+// Sharding pays off only when threads run in parallel, on a single core it can only add per-operation overhead
+TEST(ShardedCacheTest, DISABLED_Benchmark)
+{
+	LockedCache lockedCache(100000);
+	const s64 lockedMs = MeasureLookups(lockedCache);
+
+	ShardedCache<s32, s32> shardedCache(16, 100000 / 16);
+	const s64 shardedMs = MeasureLookups(shardedCache);
+
+	Logger::Info() << BenchmarkThreads << " threads x " << BenchmarkLookups << " lookups: single mutex " << lockedMs << " ms, 16 shards " << shardedMs << " ms";
+}
@@ -0,0 +1,229 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/collection/TinyLfuCache.h>
+
+#include <stingraykit/collection/QueueCache.h>
+#include <stingraykit/collection/TwoQueueCache.h>
+#include <stingraykit/function/bind.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/time/ElapsedTime.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace stingray;
+
+namespace
+{
+
+	template < typename Key_, typename Value_ >
+	optional<Value_> CacheGet(ICache<Key_, Value_>& cache, const Key_& key)
+	{
+		Value_ out;
+		return cache.TryGet(key, out) ? make_optional_value(out) : null;
+	}
+
+
+	struct StringSizeMapper
+	{
+		size_t operator()(const std::string& str) const
+		{ return str.size(); }
+	};
+
+
+	void CountEvicted(size_t& count, s32, const std::string&)
+	{ ++count; }
+
+
+	size_t Access(ICache<s32, s32>& cache, s32 key)
+	{
+		s32 out;
+		if (cache.TryGet(key, out))
+			return 1;
+
+		cache.Set(key, key);
+		return 0;
+	}
+
+
+	class XorShift
+	{
+	private:
+		u32		_state;
+
+	public:
+		explicit XorShift(u32 seed) : _state(seed) { }
+
+		u32 Next()
+		{
+			_state ^= _state << 13;
+			_state ^= _state >> 17;
+			_state ^= _state << 5;
+			return _state;
+		}
+	};
+
+
+	std::vector<s32> MakeZipfTrace(size_t keys, double skew, size_t length, size_t scanPeriod, size_t scanLength)
+	{
+		std::vector<double> cumulative(keys);
+		double sum = 0;
+		for (size_t i = 0; i < keys; ++i)
+			cumulative[i] = sum += 1.0 / std::pow((double)(i + 1), skew);
+
+		XorShift random(12345);
+		std::vector<s32> result;
+		result.reserve(length + (scanPeriod == 0 ? 0 : length / scanPeriod * scanLength));
+
+		s32 scanKey = (s32)keys;
+		for (size_t i = 0; i < length; ++i)
+		{
+			const double point = sum * random.Next() / std::numeric_limits<u32>::max();
+			result.push_back((s32)(std::lower_bound(cumulative.begin(), cumulative.end(), point) - cumulative.begin()));
+
+			if (scanPeriod != 0 && i % scanPeriod == scanPeriod - 1)
+				for (size_t j = 0; j < scanLength; ++j)
+					result.push_back(scanKey++);
+		}
+
+		return result;
+	}
+
+
+	void Replay(const std::string& name, ICache<s32, s32>& cache, const std::vector<s32>& trace)
+	{
+		size_t hits = 0;
+		ElapsedTime elapsed;
+		for (s32 key : trace)
+			hits += Access(cache, key);
+		const s64 elapsedMs = elapsed.ElapsedMilliseconds();
+
+		Logger::Info() << name << ": hit ratio " << (100.0 * hits / trace.size()) << "%, " << elapsedMs << " ms";
+	}
+
+}
+
+
+TEST(TinyLfuCacheTest, Basic)
+{
+	TinyLfuCache<s32, s32> cache(10);
+	ASSERT_EQ(cache.GetSize(), 0u);
+
+	for (s32 i = 0; i < 10; ++i)
+		cache.Set(i, i * 10);
+	ASSERT_EQ(cache.GetSize(), 10u);
+
+	for (s32 i = 0; i < 10; ++i)
+		ASSERT_EQ(CacheGet(cache, i), i * 10);
+
+	cache.Set(5, 55);
+	ASSERT_EQ(CacheGet(cache, 5), 55);
+	ASSERT_EQ(cache.GetSize(), 10u);
+
+	for (s32 i = 10; i < 100; ++i)
+		cache.Set(i, i);
+	ASSERT_EQ(cache.GetSize(), 10u);
+
+	ASSERT_TRUE(cache.Remove(5));
+	ASSERT_FALSE(cache.Remove(5));
+	ASSERT_EQ(cache.GetSize(), 9u);
+
+	cache.Clear();
+	ASSERT_EQ(cache.GetSize(), 0u);
+	ASSERT_FALSE(CacheGet(cache, 0));
+
+	TinyLfuCache<s32, s32> empty(0);
+	empty.Set(1, 1);
+	ASSERT_EQ(empty.GetSize(), 0u);
+	ASSERT_FALSE(CacheGet(empty, 1));
+}
+
+
+TEST(TinyLfuCacheTest, SizeMapping)
+{
+	TinyLfuCache<s32, std::string, StringSizeMapper> cache(20, 10);
+
+	size_t evicted = 0;
+	const Token connection(cache.OnEvicted().connect(Bind(&CountEvicted, wrap_ref(evicted), _1, _2)));
+
+	cache.Set(1, "0123456789");
+	cache.Set(2, "01234");
+	ASSERT_EQ(cache.GetSize(), 15u);
+
+	cache.Set(2, "0123456789");
+	ASSERT_EQ(cache.GetSize(), 20u);
+	ASSERT_EQ(evicted, 0u);
+
+	cache.Set(3, "");
+	ASSERT_EQ(cache.GetSize(), 20u);
+
+	cache.Set(4, "0");
+	ASSERT_LE(cache.GetSize(), 20u);
+	ASSERT_EQ(evicted, 1u);
+}
+
+
+TEST(TinyLfuCacheTest, ScanResistance)
+{
+	const s32 HotKeys = 50;
+
+	TinyLfuCache<s32, s32> tinyLfu(100);
+	LruCache<s32, s32> lru(100);
+
+	for (size_t round = 0; round < 4; ++round)
+		for (s32 key = 0; key < HotKeys; ++key)
+		{
+			Access(tinyLfu, key);
+			Access(lru, key);
+		}
+
+	for (s32 key = 1000; key < 2000; ++key)
+	{
+		Access(tinyLfu, key);
+		Access(lru, key);
+	}
+
+	size_t tinyLfuHits = 0;
+	size_t lruHits = 0;
+	for (s32 key = 0; key < HotKeys; ++key)
+	{
+		tinyLfuHits += CacheGet(tinyLfu, key).is_initialized();
+		lruHits += CacheGet(lru, key).is_initialized();
+	}
+
+	ASSERT_GE(tinyLfuHits, (size_t)HotKeys * 9 / 10);
+	ASSERT_EQ(lruHits, 0u);
+}
+
+
+TEST(TinyLfuCacheTest, DISABLED_TraceBenchmark)
+{
+	const size_t Capacity = 10000;
+
+	const std::vector<std::pair<std::string, std::vector<s32>>> traces =
+	{
+		{ "zipf 0.9", MakeZipfTrace(1000000, 0.9, 5000000, 0, 0) },
+		{ "zipf 0.9 with scans", MakeZipfTrace(1000000, 0.9, 5000000, 100000, 50000) },
+		{ "zipf 0.7", MakeZipfTrace(1000000, 0.7, 5000000, 0, 0) }
+	};
+
+	for (const std::pair<std::string, std::vector<s32>>& trace : traces)
+	{
+		Logger::Info() << "Trace '" << trace.first << "', " << trace.second.size() << " accesses, capacity " << Capacity;
+
+		LruCache<s32, s32> lru(Capacity);
+		Replay("  LruCache", lru, trace.second);
+
+		TwoQueueCache<s32, s32> twoQueue(Capacity / 4, Capacity / 4, Capacity / 2);
+		Replay("  TwoQueueCache", twoQueue, trace.second);
+
+		TinyLfuCache<s32, s32> tinyLfu(Capacity);
+		Replay("  TinyLfuCache", tinyLfu, trace.second);
+	}
+}
@@ -7,7 +7,9 @@
 
 #include <stingraykit/collection/TransactionalDictionary.h>
 #include <stingraykit/function/functional.h>
+#include <stingraykit/log/Logger.h>
 #include <stingraykit/signal/ValueFromSignalObtainer.h>
+#include <stingraykit/time/ElapsedTime.h>
 
 #include <gtest/gtest.h>
 
@@ -910,3 +912,181 @@ TEST(TransactionalDictionaryTest, Test2)
 
 	// 27
 }
+
+
+namespace
+{
+
+	template < typename EnumeratorType >
+	std::map<int, int> ToMap(const shared_ptr<EnumeratorType>& enumerator)
+	{
+		std::map<int, int> result;
+		for (; enumerator->Valid(); enumerator->Next())
+			result.emplace(enumerator->Get().Key, enumerator->Get().Value);
+		return result;
+	}
+
+}
+
+
+TEST(TransactionalDictionaryTest, Snapshots)
+{
+	using DictionaryType = TransactionalDictionary<int, int>;
+	using EntryType = DictionaryType::PairType;
+
+	const shared_ptr<DictionaryType> s = make_shared_ptr<DictionaryType>();
+
+	std::vector<std::pair<shared_ptr<IEnumerator<EntryType>>, std::map<int, int>>> snapshots;
+	std::map<int, int> expected;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		const DictionaryType::TransactionTypePtr tr = s->StartTransaction();
+		const shared_ptr<IEnumerator<EntryType>> transactionSnapshot = tr->GetEnumerator();
+		const std::map<int, int> transactionExpected = expected;
+
+		for (int j = 0; j < 50; ++j)
+		{
+			const int key = (i * 50 + j) * 7919 % 1000;
+			if (j % 3 == 0)
+			{
+				tr->Remove(key);
+				expected.erase(key);
+			}
+			else
+			{
+				tr->Set(key, i);
+				expected[key] = i;
+			}
+		}
+
+		ASSERT_EQ(ToMap(transactionSnapshot), transactionExpected);
+		ASSERT_EQ(ToMap(tr->GetEnumerator()), expected);
+
+		tr->Commit();
+
+		snapshots.emplace_back(s->GetEnumerator(), expected);
+	}
+
+	for (const auto& snapshot : snapshots)
+		ASSERT_EQ(ToMap(snapshot.first), snapshot.second);
+}
+
+
+TEST(TransactionalDictionaryTest, SnapshotDiff)
+{
+	using DictionaryType = TransactionalDictionary<int, std::string>;
+	using EntryType = DictionaryType::PairType;
+
+	const shared_ptr<DictionaryType> s = make_shared_ptr<DictionaryType>();
+	const DictionaryType::SnapshotPtr empty = s->GetSnapshot();
+
+	{
+		const DictionaryType::TransactionTypePtr tr = s->StartTransaction();
+		for (int i = 0; i < 1000; ++i)
+			tr->Add(i, std::to_string(i));
+		tr->Commit();
+	}
+
+	const DictionaryType::SnapshotPtr first = s->GetSnapshot();
+	ASSERT_EQ(Enumerable::Count(first), 1000u);
+	ASSERT_EQ(Enumerable::Count(DictionaryType::Diff(empty, first)), 1000u);
+	ASSERT_EQ(Enumerable::Count(DictionaryType::Diff(first, first)), 0u);
+
+	{
+		const DictionaryType::TransactionTypePtr tr = s->StartTransaction();
+		tr->Remove(3);
+		tr->Set(5, "five");
+		tr->Add(1000, "1000");
+		tr->Commit();
+	}
+
+	{
+		const DictionaryType::TransactionTypePtr tr = s->StartTransaction();
+		tr->Set(500, "500");
+		tr->Set(7, "seven");
+		tr->Commit();
+	}
+
+	const DictionaryType::SnapshotPtr last = s->GetSnapshot();
+
+	const DiffEntry<EntryType> forward[] = {{CollectionOp::Removed, {3, "3"}}, {CollectionOp::Removed, {5, "5"}}, {CollectionOp::Added, {5, "five"}}, {CollectionOp::Removed, {7, "7"}}, {CollectionOp::Added, {7, "seven"}}, {CollectionOp::Added, {1000, "1000"}}};
+	ASSERT_TRUE(Enumerable::SequenceEqual(DictionaryType::Diff(first, last), EnumerableFromStlIterators(std::begin(forward), std::end(forward)), comparers::Equals()));
+
+	const DiffEntry<EntryType> backward[] = {{CollectionOp::Added, {3, "3"}}, {CollectionOp::Removed, {5, "five"}}, {CollectionOp::Added, {5, "5"}}, {CollectionOp::Removed, {7, "seven"}}, {CollectionOp::Added, {7, "7"}}, {CollectionOp::Removed, {1000, "1000"}}};
+	ASSERT_TRUE(Enumerable::SequenceEqual(DictionaryType::Diff(last, first), EnumerableFromStlIterators(std::begin(backward), std::end(backward)), comparers::Equals()));
+}
+
+
+TEST(TransactionalDictionaryTest, DISABLED_CommitWithSnapshotBenchmark)
+{
+	using DictionaryType = TransactionalDictionary<int, std::string>;
+	using EntryType = DictionaryType::PairType;
+
+	const int Size = 500000;
+	const int Commits = 1000;
+	const int ChangesPerCommit = 10;
+
+	const shared_ptr<DictionaryType> s = make_shared_ptr<DictionaryType>();
+	{
+		const DictionaryType::TransactionTypePtr tr = s->StartTransaction();
+		for (int i = 0; i < Size; ++i)
+			tr->Add(i, std::to_string(i));
+		tr->Commit();
+	}
+
+	ElapsedTime elapsed;
+	for (int i = 0; i < Commits; ++i)
+	{
+		const shared_ptr<IEnumerator<EntryType>> snapshot = s->GetEnumerator();
+
+		const DictionaryType::TransactionTypePtr tr = s->StartTransaction();
+		for (int j = 0; j < ChangesPerCommit; ++j)
+			tr->Set((i * ChangesPerCommit + j) * 7919 % Size, std::to_string(i));
+		tr->Commit();
+	}
+
+	Logger::Info() << Commits << " commits of " << ChangesPerCommit << " changes to " << Size << " entries with a snapshot held: " << elapsed.ElapsedMilliseconds() << " ms";
+}
+
+
+TEST(TransactionalDictionaryTest, DISABLED_SnapshotDiffBenchmark)
+{
+	using DictionaryType = TransactionalDictionary<int, std::string>;
+
+	const int Size = 500000;
+	const int Commits = 1000;
+	const int ChangesPerCommit = 10;
+
+	const shared_ptr<DictionaryType> s = make_shared_ptr<DictionaryType>();
+	{
+		const DictionaryType::TransactionTypePtr tr = s->StartTransaction();
+		for (int i = 0; i < Size; ++i)
+			tr->Add(i, std::to_string(i));
+		tr->Commit();
+	}
+
+	size_t changes = 0;
+	ElapsedTime elapsed;
+	for (int i = 0; i < Commits; ++i)
+	{
+		const DictionaryType::SnapshotPtr snapshot = s->GetSnapshot();
+
+		const DictionaryType::TransactionTypePtr tr = s->StartTransaction();
+		for (int j = 0; j < ChangesPerCommit; ++j)
+			tr->Set((i * ChangesPerCommit + j) * 7919 % Size, "v" + std::to_string(i));
+		tr->Commit();
+
+		changes += Enumerable::Count(DictionaryType::Diff(snapshot, s->GetSnapshot()));
+	}
+
+	const s64 diffsMs = elapsed.ElapsedMilliseconds();
+
+	ASSERT_EQ(changes, (size_t)Commits * ChangesPerCommit * 2);
+
+	elapsed.Restart();
+	ASSERT_EQ(Enumerable::Count(s->GetSnapshot()), (size_t)Size);
+	const s64 enumerationMs = elapsed.ElapsedMilliseconds();
+
+	Logger::Info() << Commits << " snapshot diffs of " << ChangesPerCommit << " changes in " << Size << " entries: " << diffsMs << " ms, single enumeration of all entries: " << enumerationMs << " ms";
+}
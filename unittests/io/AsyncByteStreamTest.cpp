@@ -6,8 +6,10 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #include <stingraykit/collection/ByteData.h>
+#include <stingraykit/function/bind.h>
 #include <stingraykit/io/AsyncByteStream.h>
 #include <stingraykit/io/MemoryByteStream.h>
+#include <stingraykit/io/ThreadPoolAsyncIoEngine.h>
 #include <stingraykit/log/Logger.h>
 #include <stingraykit/Random.h>
 
@@ -60,6 +62,22 @@ namespace
 		return randomData;
 	}
 
+	struct CompletionCounter
+	{
+		size_t		Completed;
+		size_t		Cancelled;
+
+		CompletionCounter() : Completed(0), Cancelled(0) { }
+
+		void OnCompleted(u64 written, const ExceptionPtr& exception)
+		{
+			++Completed;
+			if (exception)
+				++Cancelled;
+		}
+	};
+
+
 	void WriteWholeBlockToOffset(const IByteStreamPtr& stream, s64 offset, ConstByteData block, TimeDuration sleepOnBusy)
 	{
 		stream->Seek(offset);
@@ -168,3 +186,95 @@ TEST(AsyncByteStreamTest, OverlappedWriting)
 	ASSERT_EQ(dstData.size(), srcData.size()) << "Sizes mismatch";
 	ASSERT_EQ(dstData, srcData) << "Contents mismatch";
 }
+
+
+TEST(AsyncByteStreamTest, OverlappedWritingWithEngine)
+{
+	static const TimeDuration StreamDelay = TimeDuration::FromMilliseconds(3);
+
+	static const size_t AsyncPageSize = 587;
+	static const size_t WritePageSize = 921;
+	static const size_t GarbagePageSize = 432;
+	static const size_t GarbagingRate = 6;
+	static const size_t GarbagingOffset = 158;
+	static const size_t SrcSize = WritePageSize * 5831;
+
+	const IAsyncIoEnginePtr engine = make_shared_ptr<ThreadPoolAsyncIoEngine>("TestEngine", 2);
+
+	ByteArray srcData(GenerateRandomArray(SrcSize));
+	ByteArray garbageData(GenerateRandomArray(srcData.size()));
+	ByteArray dstData(srcData.size());
+	ISyncableByteStreamPtr asyncStream = make_shared_ptr<AsyncByteStream>("TestStream", make_shared_ptr<DelayedMemoryByteStream<ByteArray> >(dstData, StreamDelay), engine, AsyncByteStream::Config().PageSize(AsyncPageSize));
+
+	Logger::Info() << "Writing...";
+	for (size_t offset = 0; offset < SrcSize; offset += WritePageSize)
+	{
+		if ((offset != 0) && (((offset / WritePageSize) % GarbagingRate) == 0) && ((offset + GarbagingOffset) < SrcSize))
+		{
+			const size_t garbagingOffset = offset + GarbagingOffset;
+			WriteWholeBlockToOffset(asyncStream, (s64)garbagingOffset, ConstByteData(garbageData, garbagingOffset, std::min(GarbagePageSize, SrcSize - garbagingOffset)), StreamDelay);
+		}
+
+		WriteWholeBlockToOffset(asyncStream, (s64)offset, ConstByteData(srcData, offset, std::min(WritePageSize, SrcSize - offset)), StreamDelay);
+	}
+
+	Logger::Info() << "Writing done. Syncing...";
+	asyncStream->Sync();
+
+	ASSERT_EQ(dstData.size(), srcData.size()) << "Sizes mismatch";
+	ASSERT_EQ(dstData, srcData) << "Contents mismatch";
+}
+
+
+TEST(AsyncByteStreamTest, SharedEngine)
+{
+	static const size_t Streams = 8;
+	static const size_t StreamSize = 300000;
+	static const size_t WritePageSize = 1237;
+	static const TimeDuration StreamDelay = TimeDuration::FromMilliseconds(1);
+
+	const IAsyncIoEnginePtr engine = make_shared_ptr<ThreadPoolAsyncIoEngine>("TestEngine", 3);
+	const ByteArray srcData(GenerateRandomArray(Streams * StreamSize));
+
+	std::vector<ByteArray> dstData;
+	std::vector<ISyncableByteStreamPtr> streams;
+	for (size_t idx = 0; idx < Streams; idx++)
+	{
+		dstData.push_back(ByteArray(StreamSize));
+		streams.push_back(make_shared_ptr<AsyncByteStream>(StringBuilder() % "TestStream" % idx, make_shared_ptr<DelayedMemoryByteStream<ByteArray> >(dstData.back(), StreamDelay), engine));
+	}
+
+	for (size_t offset = 0; offset < StreamSize; offset += WritePageSize)
+		for (size_t idx = 0; idx < Streams; idx++)
+			WriteWholeBlockToOffset(streams[idx], (s64)offset, ConstByteData(srcData, idx * StreamSize + offset, std::min(WritePageSize, StreamSize - offset)), StreamDelay);
+
+	for (size_t idx = 0; idx < Streams; idx++)
+		streams[idx]->Sync();
+
+	streams.clear();
+
+	for (size_t idx = 0; idx < Streams; idx++)
+		ASSERT_TRUE(ConstByteData(dstData[idx]) == ConstByteData(srcData, idx * StreamSize, StreamSize)) << "Contents mismatch in stream " << idx;
+}
+
+
+TEST(AsyncByteStreamTest, EngineCancelsPendingOnDestruction)
+{
+	static const size_t Requests = 5;
+
+	ByteArray dstData(Requests);
+	const IByteStreamPtr stream = make_shared_ptr<DelayedMemoryByteStream<ByteArray> >(dstData, TimeDuration::FromMilliseconds(100));
+	const u8 data = 0x42;
+
+	CompletionCounter counter;
+
+	{
+		ThreadPoolAsyncIoEngine engine("TestEngine", 1);
+
+		for (size_t idx = 0; idx < Requests; idx++)
+			engine.SubmitWrite(stream, idx, ConstByteData(&data, 1), Bind(&CompletionCounter::OnCompleted, &counter, _1, _2));
+	}
+
+	ASSERT_EQ(counter.Completed, Requests);
+	ASSERT_GE(counter.Cancelled, Requests - 1);
+}
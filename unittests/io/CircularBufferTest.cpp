@@ -7,9 +7,13 @@
 
 #include <stingraykit/io/BithreadCircularBuffer.h>
 #include <stingraykit/io/MemoryCircularBuffer.h>
+#include <stingraykit/log/Logger.h>
 #include <stingraykit/shared_ptr.h>
 #include <stingraykit/string/Hex.h>
+#include <stingraykit/thread/CancellationToken.h>
 #include <stingraykit/thread/ConditionVariable.h>
+#include <stingraykit/thread/atomic/AtomicInt.h>
+#include <stingraykit/time/ElapsedTime.h>
 
 #include <limits>
 
@@ -91,6 +95,195 @@ namespace
 		}
 	}
 
+
+
+	static void LockFreeProducerFunc(const BithreadCircularBufferPtr& buf, size_t count, AtomicU32::Type& done, const ICancellationToken& token)
+	{
+		u32 sequence = 0;
+		for (size_t i = 0; i < count && token; )
+		{
+			BithreadCircularBuffer::Writer w = buf->Write();
+			if (w.size() == 0)
+			{
+				buf->WaitFull(token);
+				continue;
+			}
+
+			const size_t size = std::min((size_t)1009, std::min(w.size(), count - i));
+			for (size_t j = 0; j < size; ++i, ++j)
+			{
+				w.data()[j] = (u8)(sequence & 0xFF);
+				sequence = GeneratePseudoRandomSequence(sequence);
+			}
+			w.Push(size);
+		}
+
+		AtomicU32::Inc(done);
+	}
+
+
+	static void LockFreeConsumerFunc(const BithreadCircularBufferPtr& buf, size_t count, AtomicU32::Type& done, const ICancellationToken& token)
+	{
+		u32 sequence = 0;
+		for (size_t i = 0; i < count && token; )
+		{
+			BithreadCircularBuffer::Reader r = buf->Read();
+			if (r.size() == 0)
+			{
+				buf->WaitEmpty(token);
+				continue;
+			}
+
+			const size_t size = std::min((size_t)1013, r.size());
+			for (size_t j = 0; j < size; ++i, ++j)
+			{
+				ASSERT_EQ(r.data()[j], sequence & 0xFF);
+				sequence = GeneratePseudoRandomSequence(sequence);
+			}
+			r.Pop(size);
+		}
+
+		AtomicU32::Inc(done);
+	}
+
+
+	const size_t ThroughputBufferSize = 1024 * 1024;
+	const size_t ThroughputBytes = 256 * 1024 * 1024;
+
+	static void LockedThroughputProducer(const Mutex& m, ConditionVariable& emptyCv, ConditionVariable& fullCv, const BithreadCircularBufferPtr& buf, size_t chunkSize)
+	{
+		for (size_t i = 0; i < ThroughputBytes; )
+		{
+			MutexLock l(m);
+			BithreadCircularBuffer::Writer w = buf->Write();
+			if (w.size() == 0)
+			{
+				fullCv.Wait(m);
+				continue;
+			}
+
+			const size_t size = std::min(w.size(), chunkSize);
+			memset(w.data(), 0, size);
+			w.Push(size);
+			i += size;
+			emptyCv.Broadcast();
+		}
+	}
+
+
+	static void LockedThroughputConsumer(const Mutex& m, ConditionVariable& emptyCv, ConditionVariable& fullCv, const BithreadCircularBufferPtr& buf, size_t chunkSize)
+	{
+		for (size_t i = 0; i < ThroughputBytes; )
+		{
+			MutexLock l(m);
+			BithreadCircularBuffer::Reader r = buf->Read();
+			if (r.size() == 0)
+			{
+				emptyCv.Wait(m);
+				continue;
+			}
+
+			const size_t size = std::min(r.size(), chunkSize);
+			r.Pop(size);
+			i += size;
+			fullCv.Broadcast();
+		}
+	}
+
+
+	static void LockFreeThroughputProducer(const BithreadCircularBufferPtr& buf, size_t chunkSize, const ICancellationToken& token)
+	{
+		for (size_t i = 0; i < ThroughputBytes; )
+		{
+			BithreadCircularBuffer::Writer w = buf->Write();
+			if (w.size() == 0)
+			{
+				buf->WaitFull(token);
+				continue;
+			}
+
+			const size_t size = std::min(w.size(), chunkSize);
+			memset(w.data(), 0, size);
+			w.Push(size);
+			i += size;
+		}
+	}
+
+
+	static void LockFreeThroughputConsumer(const BithreadCircularBufferPtr& buf, size_t chunkSize, const ICancellationToken& token)
+	{
+		for (size_t i = 0; i < ThroughputBytes; )
+		{
+			BithreadCircularBuffer::Reader r = buf->Read();
+			if (r.size() == 0)
+			{
+				buf->WaitEmpty(token);
+				continue;
+			}
+
+			const size_t size = std::min(r.size(), chunkSize);
+			r.Pop(size);
+			i += size;
+		}
+	}
+
+
+	static void PaceSide(u32& sequence)
+	{
+		// Random pauses around the spin phase of the other side make it fall asleep right when this side publishes progress
+		sequence = GeneratePseudoRandomSequence(sequence);
+		if (sequence % 4 == 0)
+			Thread::Yield();
+		for (volatile u32 i = 0; i < (sequence >> 20) % 2048; ++i)
+			;
+	}
+
+
+	static void PacedProducerFunc(const BithreadCircularBufferPtr& buf, size_t count, AtomicU32::Type& done, const ICancellationToken& token)
+	{
+		u32 sequence = 1;
+		for (size_t i = 0; i < count && token; )
+		{
+			BithreadCircularBuffer::Writer w = buf->Write();
+			if (w.size() == 0)
+			{
+				buf->WaitFull(token);
+				continue;
+			}
+
+			w.data()[0] = (u8)(i & 0xFF);
+			w.Push(1);
+			++i;
+
+			PaceSide(sequence);
+		}
+
+		AtomicU32::Inc(done);
+	}
+
+
+	static void PacedConsumerFunc(const BithreadCircularBufferPtr& buf, size_t count, AtomicU32::Type& done, const ICancellationToken& token)
+	{
+		u32 sequence = 2;
+		for (size_t i = 0; i < count && token; )
+		{
+			BithreadCircularBuffer::Reader r = buf->Read();
+			if (r.size() == 0)
+			{
+				buf->WaitEmpty(token);
+				continue;
+			}
+
+			ASSERT_EQ(r.data()[0], i & 0xFF);
+			r.Pop(1);
+			++i;
+
+			PaceSide(sequence);
+		}
+
+		AtomicU32::Inc(done);
+	}
+
 }
 
 
@@ -240,3 +433,142 @@ TEST(CircularBufferTest, BithreadCircularBuffer)
 	producer.reset();
 	consumer.reset();
 }
+
+
+TEST(CircularBufferTest, BithreadCircularBufferLockFree)
+{
+	BithreadCircularBufferPtr buf = make_shared_ptr<BithreadCircularBuffer>(0x1000);
+	size_t count = 0x100000;
+	AtomicU32::Type done = 0;
+	ThreadPtr producer(new Thread("circularBufferProducer", Bind(&LockFreeProducerFunc, buf, count, wrap_ref(done), _1)));
+	ThreadPtr consumer(new Thread("circularBufferConsumer", Bind(&LockFreeConsumerFunc, buf, count, wrap_ref(done), _1)));
+
+	// Threads are cancelled on destruction, so both sides are let finish first
+	ElapsedTime elapsed;
+	while (AtomicU32::Load(done) != 2 && elapsed.ElapsedMilliseconds() < 60000)
+		Thread::Sleep(TimeDuration::FromMilliseconds(10));
+
+	producer.reset();
+	consumer.reset();
+
+	ASSERT_EQ(AtomicU32::Load(done), 2u);
+	ASSERT_EQ(buf->GetDataSize(), 0u);
+}
+
+
+TEST(CircularBufferTest, BithreadCircularBufferPacedWakeups)
+{
+	const size_t Count = 50000;
+	const s64 TimeoutMs = 60000;
+
+	BithreadCircularBufferPtr buf = make_shared_ptr<BithreadCircularBuffer>(4);
+	AtomicU32::Type done = 0;
+	ThreadPtr producer(new Thread("circularBufferProducer", Bind(&PacedProducerFunc, buf, Count, wrap_ref(done), _1)));
+	ThreadPtr consumer(new Thread("circularBufferConsumer", Bind(&PacedConsumerFunc, buf, Count, wrap_ref(done), _1)));
+
+	// A lost wakeup leaves both sides asleep, the threads are cancelled on destruction so it fails here instead of hanging
+	ElapsedTime elapsed;
+	while (AtomicU32::Load(done) != 2 && elapsed.ElapsedMilliseconds() < TimeoutMs)
+		Thread::Sleep(TimeDuration::FromMilliseconds(10));
+
+	producer.reset();
+	consumer.reset();
+
+	ASSERT_EQ(AtomicU32::Load(done), 2u);
+	ASSERT_EQ(buf->GetDataSize(), 0u);
+}
+
+
+TEST(CircularBufferTest, BithreadCircularBufferFull)
+{
+	BithreadCircularBuffer buf(10);
+
+	BithreadCircularBuffer::Writer w = buf.Write();
+	ASSERT_EQ(w.size(), 10u);
+	w.Push(10);
+
+	ASSERT_EQ(buf.GetDataSize(), 10u);
+	ASSERT_EQ(buf.GetFreeSize(), 0u);
+	ASSERT_EQ(buf.Write().size(), 0u);
+
+	BithreadCircularBuffer::Reader r = buf.Read();
+	ASSERT_EQ(r.size(), 10u);
+	r.Pop(7);
+
+	w = buf.Write();
+	ASSERT_EQ(w.size(), 7u);
+	w.Push(5);
+
+	r = buf.Read();
+	ASSERT_EQ(r.size(), 3u);
+	ASSERT_TRUE(r.IsBufferEnd());
+	r.Pop(3);
+
+	ASSERT_EQ(buf.Read().size(), 5u);
+	ASSERT_EQ(buf.Write().size(), 5u);
+
+	CancellationToken token;
+	token.Cancel();
+	buf.Read().Pop(5);
+	ASSERT_EQ(buf.WaitEmpty(token), ConditionWaitResult::Cancelled);
+	ASSERT_EQ(buf.WaitFull(token), ConditionWaitResult::Broadcasted);
+}
+
+
+TEST(CircularBufferTest, BithreadCircularBufferSizedWaits)
+{
+	BithreadCircularBuffer buf(10);
+
+	CancellationToken token;
+	token.Cancel();
+
+	buf.Write().Push(4);
+	ASSERT_EQ(buf.WaitEmpty(4, token), ConditionWaitResult::Broadcasted);
+	ASSERT_EQ(buf.WaitEmpty(5, token), ConditionWaitResult::Cancelled);
+	ASSERT_EQ(buf.WaitFull(6, token), ConditionWaitResult::Broadcasted);
+	ASSERT_EQ(buf.WaitFull(7, token), ConditionWaitResult::Cancelled);
+
+	buf.WakeReader();
+	ASSERT_EQ(buf.WaitEmpty(5, token), ConditionWaitResult::Broadcasted);
+	ASSERT_EQ(buf.WaitEmpty(5, token), ConditionWaitResult::Cancelled);
+
+	buf.Read().Pop(4);
+	ASSERT_EQ(buf.WaitEmpty(token), ConditionWaitResult::Cancelled);
+	ASSERT_EQ(buf.WaitFull(10, token), ConditionWaitResult::Broadcasted);
+}
+
+
+TEST(CircularBufferTest, DISABLED_BithreadCircularBufferThroughputBenchmark)
+{
+	for (size_t chunkSize = 64; chunkSize <= 64 * 1024; chunkSize *= 4)
+	{
+		s64 lockedMs = 0;
+		{
+			Mutex m;
+			ConditionVariable emptyCv;
+			ConditionVariable fullCv;
+			BithreadCircularBufferPtr buf = make_shared_ptr<BithreadCircularBuffer>(ThroughputBufferSize);
+
+			ElapsedTime elapsed;
+			{
+				Thread producer("throughputProducer", Bind(&LockedThroughputProducer, wrap_const_ref(m), wrap_ref(emptyCv), wrap_ref(fullCv), buf, chunkSize));
+				Thread consumer("throughputConsumer", Bind(&LockedThroughputConsumer, wrap_const_ref(m), wrap_ref(emptyCv), wrap_ref(fullCv), buf, chunkSize));
+			}
+			lockedMs = elapsed.ElapsedMilliseconds();
+		}
+
+		s64 lockFreeMs = 0;
+		{
+			BithreadCircularBufferPtr buf = make_shared_ptr<BithreadCircularBuffer>(ThroughputBufferSize);
+
+			ElapsedTime elapsed;
+			{
+				Thread producer("throughputProducer", Bind(&LockFreeThroughputProducer, buf, chunkSize, _1));
+				Thread consumer("throughputConsumer", Bind(&LockFreeThroughputConsumer, buf, chunkSize, _1));
+			}
+			lockFreeMs = elapsed.ElapsedMilliseconds();
+		}
+
+		Logger::Info() << ThroughputBytes / (1024 * 1024) << " MiB in " << chunkSize << " byte chunks: mutex " << lockedMs << " ms, lock-free " << lockFreeMs << " ms";
+	}
+}
@@ -9,7 +9,9 @@
 
 #include <stingraykit/collection/Range.h>
 #include <stingraykit/function/functional.h>
+#include <stingraykit/log/Logger.h>
 #include <stingraykit/thread/TimedCancellationToken.h>
+#include <stingraykit/time/ElapsedTime.h>
 
 #include <gtest/gtest.h>
 
@@ -63,6 +65,31 @@ namespace
 		void EndOfData(const ICancellationToken& token) override { }
 	};
 
+
+	const size_t ThroughputBufferSize = 1024 * 1024;
+	const size_t ThroughputBytes = 256 * 1024 * 1024;
+
+	class ThroughputConsumer final : public virtual IDataConsumer
+	{
+	public:
+		atomic<bool>	Finished;
+
+	public:
+		ThroughputConsumer() : Finished(false) { }
+
+		size_t Process(ConstByteData data, const ICancellationToken& token) override { return data.size(); }
+		void EndOfData(const ICancellationToken& token) override { Finished = true; }
+	};
+
+	void ProduceThroughputData(IDataBuffer& buffer, size_t chunkSize, const ICancellationToken& token)
+	{
+		ByteArray data(chunkSize);
+		for (size_t i = 0; i < ThroughputBytes && token; i += chunkSize)
+			ConsumeAll(buffer, data, token);
+
+		buffer.EndOfData(token);
+	}
+
 }
 
 TEST(DataBufferTest, Consistency)
@@ -281,3 +308,24 @@ TEST(DataBufferTest, Deadlock)
 	Thread::Sleep(TimeDuration::FromMilliseconds(10));
 	Thread writer2("writer2", Bind(&PushData, wrap_ref(buffer), 3, wrap_ref(finished), _1));
 }
+
+
+TEST(DataBufferTest, DISABLED_ThroughputBenchmark)
+{
+	for (size_t chunkSize = 64; chunkSize <= 64 * 1024; chunkSize *= 4)
+	{
+		DataBuffer buffer(false, ThroughputBufferSize);
+		ThroughputConsumer consumer;
+
+		ElapsedTime elapsed;
+		{
+			Thread writer("throughputWriter", Bind(&ProduceThroughputData, wrap_ref(buffer), chunkSize, _1));
+
+			TimedCancellationToken token(TimeDuration::Minute());
+			while (!consumer.Finished && token)
+				buffer.Read(consumer, token);
+		}
+
+		Logger::Info() << ThroughputBytes / (1024 * 1024) << " MiB in " << chunkSize << " byte chunks: " << elapsed.ElapsedMilliseconds() << " ms";
+	}
+}
@@ -0,0 +1,189 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/DataPipeline.h>
+
+#include <stingraykit/executor/AsyncTaskExecutor.h>
+#include <stingraykit/function/bind.h>
+#include <stingraykit/io/BufferedDataMediator.h>
+#include <stingraykit/io/ByteArrayDataSource.h>
+#include <stingraykit/thread/TimedCancellationToken.h>
+
+#include <gtest/gtest.h>
+
+using namespace stingray;
+
+namespace
+{
+
+	class PassThroughMediator : public virtual IDataMediator
+	{
+	private:
+		ConstByteData					_pending;
+		bool							_endOfData;
+
+	public:
+		std::vector<const u8*>			Received;
+
+	public:
+		PassThroughMediator() : _endOfData(false) { }
+
+		size_t Process(ConstByteData data, const ICancellationToken&) override
+		{
+			Received.push_back(data.data());
+			_pending = data;
+			return data.size();
+		}
+
+		void EndOfData(const ICancellationToken&) override
+		{ _endOfData = true; }
+
+		void Read(IDataConsumer& consumer, const ICancellationToken& token) override
+		{
+			if (!_pending.empty())
+			{
+				ConsumeAll(consumer, _pending, token);
+				_pending = ConstByteData();
+			}
+			else if (_endOfData)
+				consumer.EndOfData(token);
+		}
+	};
+	STINGRAYKIT_DECLARE_PTR(PassThroughMediator);
+
+
+	class ThrowingMediator : public virtual IDataMediator
+	{
+	public:
+		size_t Process(ConstByteData, const ICancellationToken&) override
+		{ STINGRAYKIT_THROW(InvalidOperationException("Broken stage")); }
+
+		void EndOfData(const ICancellationToken&) override { }
+		void Read(IDataConsumer&, const ICancellationToken&) override { }
+	};
+
+
+	ByteArray MakeSequence(size_t size)
+	{
+		ByteArray result(size);
+		for (size_t i = 0; i < size; ++i)
+			result[i] = (u8)(i * 7);
+		return result;
+	}
+
+
+	size_t Append(std::vector<u8>& result, ConstByteData data)
+	{
+		std::copy(data.begin(), data.end(), std::back_inserter(result));
+		return data.size();
+	}
+
+
+	void SetFlag(bool& flag)
+	{ flag = true; }
+
+
+	std::vector<u8> ReadAll(IDataSource& source)
+	{
+		std::vector<u8> result;
+		bool endOfData = false;
+
+		while (!endOfData)
+			source.ReadToFunction(Bind(&Append, wrap_ref(result), _1), Bind(&SetFlag, wrap_ref(endOfData)), TimedCancellationToken(TimeDuration::FromSeconds(10)));
+
+		return result;
+	}
+
+}
+
+
+TEST(DataPipelineTest, Transfer)
+{
+	const ITaskExecutorPtr executor = make_shared_ptr<AsyncTaskExecutor>("pipelineTest");
+	const ByteArray data = MakeSequence(1024 * 1024);
+
+	const IDataSourcePtr pipeline = DataPipeline::Builder("test", executor, 4096)
+			.AddStage("first", make_shared_ptr<BufferedDataMediator>(), 1000)
+			.AddStage("second", make_shared_ptr<PassThroughMediator>(), 3000)
+			.Build("pipelineTestReader", make_shared_ptr<ByteArrayDataSource>(data));
+
+	const std::vector<u8> result = ReadAll(*pipeline);
+	ASSERT_TRUE(ConstByteData(result) == ConstByteData(data));
+}
+
+
+TEST(DataPipelineTest, NoStages)
+{
+	const DataPipelinePtr pipeline = DataPipeline::Builder("test", make_shared_ptr<AsyncTaskExecutor>("pipelineTest")).Build();
+
+	const ByteArray data = MakeSequence(100);
+	ASSERT_EQ(pipeline->Process(data, DummyCancellationToken()), data.size());
+	pipeline->EndOfData(DummyCancellationToken());
+
+	const std::vector<u8> result = ReadAll(*pipeline);
+	ASSERT_TRUE(ConstByteData(result) == ConstByteData(data));
+}
+
+
+TEST(DataPipelineTest, ZeroCopyHandoff)
+{
+	const PassThroughMediatorPtr first = make_shared_ptr<PassThroughMediator>();
+	const PassThroughMediatorPtr second = make_shared_ptr<PassThroughMediator>();
+
+	const DataPipelinePtr pipeline = DataPipeline::Builder("test", make_shared_ptr<AsyncTaskExecutor>("pipelineTest"))
+			.AddStage("first", first)
+			.AddStage("second", second)
+			.Build();
+
+	const ByteArray data = MakeSequence(100);
+	ASSERT_EQ(pipeline->Process(data, DummyCancellationToken()), data.size());
+	pipeline->EndOfData(DummyCancellationToken());
+
+	const std::vector<u8> result = ReadAll(*pipeline);
+	ASSERT_TRUE(ConstByteData(result) == ConstByteData(data));
+
+	ASSERT_EQ(first->Received.size(), 1u);
+	ASSERT_EQ(second->Received, first->Received);
+}
+
+
+TEST(DataPipelineTest, Backpressure)
+{
+	const size_t Capacity = 16;
+
+	const DataPipelinePtr pipeline = DataPipeline::Builder("test", make_shared_ptr<AsyncTaskExecutor>("pipelineTest"), Capacity)
+			.AddStage("first", make_shared_ptr<PassThroughMediator>(), Capacity)
+			.AddStage("second", make_shared_ptr<PassThroughMediator>(), Capacity)
+			.Build();
+
+	const ByteArray data = MakeSequence(Capacity);
+
+	size_t accepted = 0;
+	for (size_t i = 0; i < 10; ++i)
+		accepted += pipeline->Process(data, TimedCancellationToken(TimeDuration::FromMilliseconds(100)));
+
+	ASSERT_GE(accepted, 3 * Capacity);
+	ASSERT_LT(accepted, 10 * Capacity);
+
+	size_t read = 0;
+	while (read < accepted)
+		pipeline->ReadToFunction([&read](ConstByteData data, const ICancellationToken&) { read += data.size(); return data.size(); }, DummyCancellationToken());
+
+	ASSERT_EQ(pipeline->Process(data, TimedCancellationToken(TimeDuration::FromSeconds(10))), Capacity);
+}
+
+
+TEST(DataPipelineTest, StageException)
+{
+	const DataPipelinePtr pipeline = DataPipeline::Builder("test", make_shared_ptr<AsyncTaskExecutor>("pipelineTest"))
+			.AddStage("throwing", make_shared_ptr<ThrowingMediator>())
+			.Build();
+
+	pipeline->Process(MakeSequence(100), DummyCancellationToken());
+	ASSERT_ANY_THROW(ReadAll(*pipeline));
+	ASSERT_ANY_THROW(pipeline->Process(MakeSequence(100), DummyCancellationToken()));
+}
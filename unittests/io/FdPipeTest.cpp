@@ -0,0 +1,102 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/posix/FdPipe.h>
+
+#include <stingraykit/function/bind.h>
+#include <stingraykit/thread/Thread.h>
+#include <stingraykit/thread/TimedCancellationToken.h>
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+using namespace stingray;
+
+namespace
+{
+
+	struct PipePair
+	{
+		FdPipePtr		Reader;
+		FdPipePtr		Writer;
+
+		PipePair()
+		{
+			int fds[2];
+			STINGRAYKIT_CHECK(::pipe(fds) == 0, "pipe failed");
+			Reader = make_shared_ptr<FdPipe>(fds[0]);
+			Writer = make_shared_ptr<FdPipe>(fds[1]);
+		}
+	};
+
+
+	void ReadUntilCancelled(const FdPipePtr& pipe, bool& cancelled, const ICancellationToken& token)
+	{
+		u8 byte;
+		try
+		{ pipe->Read(ByteData(&byte, 1), token); }
+		catch (const OperationCancelledException&)
+		{ cancelled = true; }
+	}
+
+}
+
+
+TEST(FdPipeTest, ReadWrite)
+{
+	PipePair pipe;
+	ASSERT_FALSE(pipe.Reader->Peek());
+
+	const u8 data[] = { 1, 2, 3, 4, 5 };
+	ASSERT_EQ(pipe.Writer->Write(ConstByteData(data)), 5u);
+	ASSERT_TRUE(pipe.Reader->Peek());
+
+	u8 result[10];
+	ASSERT_EQ(pipe.Reader->Read(ByteData(result)), 5u);
+	ASSERT_EQ(ConstByteData(result, 5), ConstByteData(data));
+
+	pipe.Writer.reset();
+	ASSERT_THROW(pipe.Reader->Read(ByteData(result)), PipeClosedException);
+}
+
+
+TEST(FdPipeTest, Timeout)
+{
+	PipePair pipe;
+
+	u8 byte;
+	ASSERT_THROW(pipe.Reader->Read(ByteData(&byte, 1), TimedCancellationToken(TimeDuration::FromMilliseconds(50))), TimeoutException);
+
+	// Fills pipe buffer until write blocks
+	const ByteArray chunk(65536);
+	ASSERT_THROW(
+		while (true)
+			pipe.Writer->Write(chunk, TimedCancellationToken(TimeDuration::FromMilliseconds(50))),
+		TimeoutException);
+}
+
+
+TEST(FdPipeTest, Cancellation)
+{
+	PipePair pipe;
+
+	bool cancelled = false;
+	{
+		const Thread reader("fdPipeReader", Bind(&ReadUntilCancelled, pipe.Reader, wrap_ref(cancelled), _1));
+		Thread::Sleep(TimeDuration::FromMilliseconds(50));
+	}
+
+	ASSERT_TRUE(cancelled);
+
+	const u8 data[] = { 42 };
+	pipe.Writer->Write(ConstByteData(data));
+
+	u8 byte = 0;
+	ASSERT_EQ(pipe.Reader->Read(ByteData(&byte, 1)), 1u);
+	ASSERT_EQ(byte, 42);
+}
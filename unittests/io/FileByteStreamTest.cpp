@@ -0,0 +1,161 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/posix/FileByteStream.h>
+
+#include <stingraykit/io/ByteStreamWithOffset.h>
+#include <stingraykit/SystemException.h>
+
+#include <gtest/gtest.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+using namespace stingray;
+
+namespace
+{
+
+	class FileByteStreamTest : public testing::Test
+	{
+	protected:
+		std::string		_path;
+
+	protected:
+		void SetUp() override
+		{
+			char path[] = "/tmp/stingraykit-file-XXXXXX";
+			const int fd = ::mkstemp(path);
+			ASSERT_GE(fd, 0);
+			::close(fd);
+			_path = path;
+		}
+
+		void TearDown() override
+		{ ::unlink(_path.c_str()); }
+	};
+
+
+	ByteArray MakeSequence(size_t size, u8 first = 0)
+	{
+		ByteArray result(size);
+		for (size_t i = 0; i < size; ++i)
+			result[i] = (u8)(first + i);
+		return result;
+	}
+
+}
+
+
+TEST_F(FileByteStreamTest, ReadWrite)
+{
+	{
+		FileByteStream stream(_path, FileByteStream::Config().EnableTruncate().AccessHint(FileAccessHint::Sequential));
+		ASSERT_EQ(stream.Write(MakeSequence(100)), 100u);
+		ASSERT_EQ(stream.Tell(), 100u);
+		ASSERT_EQ(stream.GetSize(), 100u);
+
+		ASSERT_EQ(stream.WriteAt(10, MakeSequence(5, 200)), 5u);
+		ASSERT_EQ(stream.Tell(), 100u);
+
+		stream.Seek(-10, SeekMode::End);
+		ByteArray tail(20);
+		ASSERT_EQ(stream.Read(tail), 10u);
+		ASSERT_EQ(ConstByteData(tail, 0, 10), ConstByteData(MakeSequence(10, 90)));
+		ASSERT_EQ(stream.Read(tail), 0u);
+
+		stream.Advise(0, 0, FileAccessHint::WillNeed);
+		stream.Sync();
+	}
+
+	FileByteStream stream(_path);
+	ASSERT_ANY_THROW(stream.Write(MakeSequence(1)));
+
+	ByteArray data(15);
+	ASSERT_EQ(stream.ReadAt(5, data), 15u);
+	ASSERT_EQ(ConstByteData(data, 0, 5), ConstByteData(MakeSequence(5, 5)));
+	ASSERT_EQ(ConstByteData(data, 5, 5), ConstByteData(MakeSequence(5, 200)));
+	ASSERT_EQ(stream.Tell(), 0u);
+
+	ASSERT_THROW(FileByteStream("/nonexistent/stingraykit-file"), FileNotFoundException);
+}
+
+
+TEST_F(FileByteStreamTest, MmapRead)
+{
+	FileByteStream(_path, FileByteStream::Config().EnableWrite()).Write(MakeSequence(4096));
+
+	FileByteStream stream(_path, FileByteStream::Config().EnableMmapRead());
+	ByteArray data(1000);
+	stream.Seek(3000);
+	ASSERT_EQ(stream.Read(data), 1000u);
+	ASSERT_EQ(data, MakeSequence(1000, (u8)3000));
+	ASSERT_EQ(stream.Read(data), 96u);
+	ASSERT_EQ(stream.Read(data), 0u);
+
+	ASSERT_ANY_THROW(FileByteStream::Config().EnableMmapRead().EnableWrite());
+}
+
+
+TEST_F(FileByteStreamTest, DirectIo)
+{
+	const size_t alignment = 4096;
+
+	try
+	{
+		FileByteStream stream(_path, FileByteStream::Config().EnableTruncate().EnableDirectIo(alignment, 4 * alignment));
+
+		const ByteArray data(MakeSequence(10 * alignment + 100, 7));
+		for (size_t written = 0; written < data.size(); )
+			written += stream.Write(ConstByteData(data, written, std::min<size_t>(1000, data.size() - written)));
+
+		ASSERT_EQ(stream.GetSize(), data.size());
+
+		ByteArray readData(data.size());
+		ASSERT_EQ(stream.ReadAt(0, readData), data.size());
+		ASSERT_EQ(readData, data);
+
+		// Unaligned head goes through page cache
+		stream.Seek(10);
+		ASSERT_EQ(stream.Write(MakeSequence(alignment)), alignment - 10);
+		ASSERT_EQ(stream.Write(MakeSequence(100)), 100u);
+		stream.Sync();
+	}
+	catch (const SystemException& ex)
+	{
+		if (ex.GetErrorCode() == EINVAL)
+			GTEST_SKIP() << "O_DIRECT is not supported by file system";
+		throw;
+	}
+
+	FileByteStream stream(_path);
+	ByteArray data(alignment + 200);
+	ASSERT_EQ(stream.Read(data), data.size());
+	ASSERT_EQ(ConstByteData(data, 10, alignment - 10), ConstByteData(MakeSequence(alignment), 0, alignment - 10));
+	ASSERT_EQ(ConstByteData(data, alignment, 100), ConstByteData(MakeSequence(100)));
+	ASSERT_EQ(ConstByteData(data, alignment + 100, 100), ConstByteData(MakeSequence(100, (u8)(7 + alignment + 100))));
+}
+
+
+TEST_F(FileByteStreamTest, ByteStreamWithOffset)
+{
+	const FileByteStreamPtr file = make_shared_ptr<FileByteStream>(_path, FileByteStream::Config().EnableWrite());
+	file->Write(MakeSequence(100));
+	file->Seek(50);
+
+	ByteStreamWithOffset stream(file, 20);
+	ByteArray data(10);
+	ASSERT_EQ(stream.Read(data, DummyCancellationToken()), 10u);
+	ASSERT_EQ(data, MakeSequence(10, 20));
+	ASSERT_EQ(stream.Tell(), 10u);
+
+	ASSERT_EQ(stream.Write(MakeSequence(5, 100), DummyCancellationToken()), 5u);
+	ASSERT_EQ(file->Tell(), 50u);
+
+	ASSERT_EQ(file->ReadAt(30, data), 10u);
+	ASSERT_EQ(ConstByteData(data, 0, 5), ConstByteData(MakeSequence(5, 100)));
+}
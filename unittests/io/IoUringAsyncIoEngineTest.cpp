@@ -0,0 +1,184 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/posix/IoUringAsyncIoEngine.h>
+
+#include <stingraykit/io/AsyncByteStream.h>
+#include <stingraykit/io/MemoryByteStream.h>
+#include <stingraykit/io/posix/FileByteStream.h>
+#include <stingraykit/time/ElapsedTime.h>
+#include <stingraykit/SystemException.h>
+
+#include <gtest/gtest.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+using namespace stingray;
+
+namespace
+{
+
+	class IoUringAsyncIoEngineTest : public testing::Test
+	{
+	protected:
+		std::vector<std::string>	_paths;
+
+	protected:
+		void TearDown() override
+		{
+			for (size_t i = 0; i < _paths.size(); ++i)
+				::unlink(_paths[i].c_str());
+		}
+
+		std::string CreateFile()
+		{
+			char path[] = "/tmp/stingraykit-uring-XXXXXX";
+			const int fd = ::mkstemp(path);
+			STINGRAYKIT_CHECK(fd >= 0, SystemException("mkstemp"));
+			::close(fd);
+			_paths.push_back(path);
+			return path;
+		}
+	};
+
+
+	ByteArray MakePattern(size_t size, u8 seed)
+	{
+		ByteArray result(size);
+		for (size_t i = 0; i < size; ++i)
+			result[i] = (u8)(seed + i * 7 + i / 251);
+		return result;
+	}
+
+
+	void WriteFully(const IByteStreamPtr& stream, ConstByteData data)
+	{
+		for (size_t offset = 0; offset < data.size(); )
+		{
+			const size_t written = (size_t)stream->Write(ConstByteData(data, offset));
+			offset += written;
+			if (written == 0)
+				Thread::Sleep(1);
+		}
+	}
+
+
+	const size_t BenchmarkStreams = 64;
+	const size_t BenchmarkStreamSize = 8 * 1024 * 1024;
+	const size_t BenchmarkChunkSize = 64 * 1024;
+
+	s64 WriteStreams(const std::vector<std::string>& paths, const IAsyncIoEnginePtr& engine)
+	{
+		const ByteArray chunk(MakePattern(BenchmarkChunkSize, 0));
+		const AsyncByteStream::Config config = AsyncByteStream::Config().BufferSize(4 * 1024 * 1024);
+
+		ElapsedTime elapsed;
+		{
+			std::vector<ISyncableByteStreamPtr> streams;
+			for (size_t i = 0; i < paths.size(); ++i)
+				streams.push_back(make_shared_ptr<AsyncByteStream>(StringBuilder() % "bench" % i, make_shared_ptr<FileByteStream>(paths[i], FileByteStream::Config().EnableTruncate()), engine, config));
+
+			for (size_t offset = 0; offset < BenchmarkStreamSize; offset += BenchmarkChunkSize)
+				for (size_t i = 0; i < streams.size(); ++i)
+					WriteFully(streams[i], chunk);
+
+			for (size_t i = 0; i < streams.size(); ++i)
+				streams[i]->Sync();
+		}
+		return elapsed.ElapsedMilliseconds();
+	}
+
+}
+
+
+TEST_F(IoUringAsyncIoEngineTest, Write)
+{
+	IAsyncIoEnginePtr engine;
+	try
+	{ engine = make_shared_ptr<IoUringAsyncIoEngine>("TestEngine", 4); }
+	catch (const std::exception& ex)
+	{ GTEST_SKIP() << "io_uring is not available: " << ex.what(); }
+
+	static const size_t Streams = 6;
+	static const size_t StreamSize = 1000000;
+	static const size_t WriteSize = 3001;
+
+	std::vector<std::string> paths;
+	std::vector<ISyncableByteStreamPtr> streams;
+	for (size_t i = 0; i < Streams; ++i)
+	{
+		paths.push_back(CreateFile());
+		streams.push_back(make_shared_ptr<AsyncByteStream>(StringBuilder() % "TestStream" % i, make_shared_ptr<FileByteStream>(paths.back(), FileByteStream::Config().EnableTruncate()), engine));
+	}
+
+	// Served by fallback thread pool
+	const ByteArrayByteStreamPtr memory = make_shared_ptr<ByteArrayByteStream>(ByteArray());
+	streams.push_back(make_shared_ptr<AsyncByteStream>("TestMemoryStream", memory, engine));
+
+	std::vector<ByteArray> patterns;
+	for (size_t i = 0; i < streams.size(); ++i)
+		patterns.push_back(MakePattern(StreamSize, (u8)i));
+
+	for (size_t offset = 0; offset < StreamSize; offset += WriteSize)
+		for (size_t i = 0; i < streams.size(); ++i)
+			WriteFully(streams[i], ConstByteData(patterns[i], offset, std::min(WriteSize, StreamSize - offset)));
+
+	for (size_t i = 0; i < streams.size(); ++i)
+		streams[i]->Sync();
+
+	streams.clear();
+
+	for (size_t i = 0; i < Streams; ++i)
+	{
+		FileByteStream file(paths[i]);
+		ASSERT_EQ(file.GetSize(), StreamSize);
+
+		ByteArray data(StreamSize);
+		ASSERT_EQ(file.Read(data), StreamSize);
+		ASSERT_EQ(data, patterns[i]) << "Contents mismatch in stream " << i;
+	}
+
+	ASSERT_EQ(memory->GetData(), patterns.back());
+}
+
+
+TEST_F(IoUringAsyncIoEngineTest, Create)
+{
+	const IAsyncIoEnginePtr engine = IoUringAsyncIoEngine::Create("TestEngine");
+	ASSERT_TRUE(engine);
+
+	const std::string path = CreateFile();
+	{
+		const ISyncableByteStreamPtr stream = make_shared_ptr<AsyncByteStream>("TestStream", make_shared_ptr<FileByteStream>(path, FileByteStream::Config().EnableWrite()), engine);
+		WriteFully(stream, MakePattern(100, 1));
+		stream->Seek(50);
+		WriteFully(stream, MakePattern(10, 2));
+		stream->Sync();
+	}
+
+	FileByteStream file(path);
+	ByteArray data(100);
+	ASSERT_EQ(file.Read(data), 100u);
+	ASSERT_TRUE(ConstByteData(data, 0, 50) == ConstByteData(MakePattern(100, 1), 0, 50));
+	ASSERT_TRUE(ConstByteData(data, 50, 10) == ConstByteData(MakePattern(10, 2)));
+	ASSERT_TRUE(ConstByteData(data, 60) == ConstByteData(MakePattern(100, 1), 60));
+}
+
+
+TEST_F(IoUringAsyncIoEngineTest, DISABLED_ManyStreamsBenchmark)
+{
+	std::vector<std::string> paths;
+	for (size_t i = 0; i < BenchmarkStreams; ++i)
+		paths.push_back(CreateFile());
+
+	const s64 threadsMs = WriteStreams(paths, null);
+	const s64 threadPoolMs = WriteStreams(paths, make_shared_ptr<ThreadPoolAsyncIoEngine>("benchPool"));
+	const s64 ioUringMs = WriteStreams(paths, IoUringAsyncIoEngine::Create("benchUring"));
+
+	Logger::Info() << BenchmarkStreams << " streams x " << BenchmarkStreamSize << " bytes: thread per stream " << threadsMs << " ms, thread pool " << threadPoolMs << " ms, io_uring " << ioUringMs << " ms";
+}
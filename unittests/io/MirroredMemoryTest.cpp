@@ -0,0 +1,118 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <stingraykit/io/posix/MirroredMemory.h>
+
+#include <stingraykit/io/BithreadCircularBuffer.h>
+#include <stingraykit/io/DataBuffer.h>
+#include <stingraykit/thread/DummyCancellationToken.h>
+
+#include <gtest/gtest.h>
+
+using namespace stingray;
+
+namespace
+{
+
+	struct CollectingConsumer final : public virtual IDataConsumer
+	{
+		std::vector<u8>		Data;
+		size_t				Calls = 0;
+
+		size_t Process(ConstByteData data, const ICancellationToken& token) override
+		{
+			++Calls;
+			Data.insert(Data.end(), data.begin(), data.end());
+			return data.size();
+		}
+
+		void EndOfData(const ICancellationToken& token) override
+		{ }
+	};
+
+}
+
+
+TEST(MirroredMemoryTest, Mirror)
+{
+	const size_t size = MirroredMemory::GetGranularity();
+	ASSERT_EQ(MirroredMemory::RoundUp(1), size);
+	ASSERT_EQ(MirroredMemory::RoundUp(size), size);
+	ASSERT_ANY_THROW(MirroredMemory::Allocate(size + 1));
+
+	const BytesOwner storage = MirroredMemory::Allocate(size);
+	ASSERT_EQ(storage.size(), 2 * size);
+
+	for (size_t i = 0; i < size; ++i)
+		storage[i] = (u8)i;
+
+	for (size_t i = 0; i < size; ++i)
+		ASSERT_EQ(storage[i + size], (u8)i);
+
+	storage[2 * size - 1] = 42;
+	ASSERT_EQ(storage[size - 1], 42);
+}
+
+
+TEST(MirroredMemoryTest, BithreadCircularBuffer)
+{
+	const size_t size = MirroredMemory::GetGranularity();
+	BithreadCircularBuffer buffer(MirroredMemory::Allocate(size), MirroredStorageTag());
+	ASSERT_EQ(buffer.GetTotalSize(), size);
+
+	const size_t offset = size - 10;
+	{
+		BithreadCircularBuffer::Writer w = buffer.Write();
+		ASSERT_EQ(w.size(), size);
+		w.Push(offset);
+	}
+	buffer.Read().Pop(offset);
+
+	{
+		BithreadCircularBuffer::Writer w = buffer.Write();
+		ASSERT_EQ(w.size(), size);
+		for (size_t i = 0; i < 100; ++i)
+			w.data()[i] = (u8)i;
+		w.Push(100);
+	}
+
+	BithreadCircularBuffer::Reader r = buffer.Read();
+	ASSERT_EQ(r.size(), 100u);
+	ASSERT_FALSE(r.IsBufferEnd());
+	for (size_t i = 0; i < 100; ++i)
+		ASSERT_EQ(r.data()[i], (u8)i);
+	r.Pop(100);
+
+	ASSERT_EQ(buffer.GetDataSize(), 0u);
+}
+
+
+TEST(MirroredMemoryTest, DataBuffer)
+{
+	const size_t size = MirroredMemory::GetGranularity();
+	DataBuffer buffer(false, MirroredMemory::Allocate(size), MirroredStorageTag());
+
+	std::vector<u8> expected;
+	CollectingConsumer consumer;
+
+	for (size_t round = 0; round < 5; ++round)
+	{
+		std::vector<u8> data(size * 3 / 4);
+		for (size_t i = 0; i < data.size(); ++i)
+			data[i] = (u8)(round * 7 + i);
+
+		ASSERT_EQ(buffer.Process(ConstByteData(data), DummyCancellationToken()), data.size());
+		expected.insert(expected.end(), data.begin(), data.end());
+
+		const size_t calls = consumer.Calls;
+		buffer.Read(consumer, DummyCancellationToken());
+		ASSERT_EQ(consumer.Calls, calls + 1);
+	}
+
+	ASSERT_EQ(consumer.Data, expected);
+}
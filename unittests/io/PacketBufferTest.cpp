@@ -0,0 +1,248 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/PacketBuffer.h>
+
+#include <stingraykit/function/bind.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/thread/Thread.h>
+#include <stingraykit/thread/TimedCancellationToken.h>
+#include <stingraykit/time/ElapsedTime.h>
+
+#include <gtest/gtest.h>
+
+using namespace stingray;
+
+namespace
+{
+
+	using TestPacket = Packet<int>;
+	using TestPacketBuffer = PacketBuffer<int>;
+
+
+	class SingleConsumer : public virtual IPacketConsumer<int>
+	{
+	public:
+		std::vector<int>		Received;
+		size_t					Calls;
+		size_t					Limit;
+
+	public:
+		explicit SingleConsumer(size_t limit = std::numeric_limits<size_t>::max()) : Calls(0), Limit(limit) { }
+
+		bool Process(const TestPacket& packet, const ICancellationToken&) override
+		{
+			++Calls;
+			if (Received.size() == Limit)
+				return false;
+
+			Received.push_back(packet.GetMetadata());
+			return true;
+		}
+
+		void EndOfData() override { }
+	};
+
+
+	class BatchConsumer : public SingleConsumer
+	{
+	public:
+		std::vector<size_t>		Batches;
+		bool					CheckData;
+
+	public:
+		explicit BatchConsumer(size_t limit = std::numeric_limits<size_t>::max()) : SingleConsumer(limit), CheckData(true) { }
+
+		size_t ProcessBatch(const PacketVector& packets, const ICancellationToken& token) override
+		{
+			Batches.push_back(packets.size());
+
+			size_t result = 0;
+			for (; result < packets.size() && Received.size() < Limit; ++result)
+			{
+				if (CheckData)
+				{
+					EXPECT_EQ(packets[result].GetSize(), (size_t)packets[result].GetMetadata() % 32 + 1);
+					EXPECT_EQ(packets[result].GetData()[0], (u8)packets[result].GetMetadata());
+				}
+				Received.push_back(packets[result].GetMetadata());
+			}
+			return result;
+		}
+	};
+
+
+	void PushPacket(TestPacketBuffer& buffer, int index)
+	{
+		ByteArray data(index % 32 + 1);
+		std::fill(data.begin(), data.end(), (u8)index);
+		ASSERT_TRUE(buffer.Process(TestPacket(data, index), DummyCancellationToken()));
+	}
+
+
+	const size_t BenchmarkPackets = 1000000;
+
+	template < typename ConsumerType >
+	s64 MeasureReads(ConsumerType& consumer)
+	{
+		TestPacketBuffer buffer(false, 64 * 1024);
+
+		s64 result = 0;
+		for (size_t i = 0; i < BenchmarkPackets; )
+		{
+			for (; buffer.GetFreeSize() >= 64 && i < BenchmarkPackets; ++i)
+				PushPacket(buffer, i);
+
+			ElapsedTime elapsed;
+			while (buffer.GetDataSize() != 0)
+				buffer.Read(consumer, DummyCancellationToken());
+			result += elapsed.ElapsedMicroseconds();
+
+			consumer.Received.clear();
+		}
+
+		return result / 1000;
+	}
+
+
+	const size_t ThroughputPackets = 4 * 1000 * 1000;
+
+	class ThroughputConsumer final : public virtual IPacketConsumer<int>
+	{
+	public:
+		atomic<bool>	Finished;
+
+	public:
+		ThroughputConsumer() : Finished(false) { }
+
+		bool Process(const TestPacket& packet, const ICancellationToken&) override { return true; }
+		size_t ProcessBatch(const PacketVector& packets, const ICancellationToken&) override { return packets.size(); }
+		void EndOfData() override { Finished = true; }
+	};
+
+	void ProduceThroughputPackets(TestPacketBuffer& buffer, size_t packetSize, const ICancellationToken& token)
+	{
+		ByteArray data(packetSize);
+		for (size_t i = 0; i < ThroughputPackets && token; ++i)
+			ConsumeAll(buffer, TestPacket(data, i), token);
+
+		buffer.EndOfData();
+	}
+
+
+	std::vector<int> MakeRange(int first, int last)
+	{
+		std::vector<int> result;
+		for (int i = first; i < last; ++i)
+			result.push_back(i);
+		return result;
+	}
+
+}
+
+
+TEST(PacketBufferTest, Batch)
+{
+	TestPacketBuffer buffer(false, 4096);
+	for (int i = 0; i < 100; ++i)
+		PushPacket(buffer, i);
+
+	BatchConsumer consumer;
+	buffer.Read(consumer, DummyCancellationToken());
+
+	ASSERT_EQ(consumer.Batches, std::vector<size_t>(1, 100));
+	ASSERT_EQ(consumer.Received, MakeRange(0, 100));
+	ASSERT_EQ(buffer.GetDataSize(), 0u);
+}
+
+
+TEST(PacketBufferTest, PartialBatch)
+{
+	TestPacketBuffer buffer(false, 4096);
+	for (int i = 0; i < 10; ++i)
+		PushPacket(buffer, i);
+
+	BatchConsumer consumer(4);
+	buffer.Read(consumer, DummyCancellationToken());
+	ASSERT_EQ(consumer.Received, MakeRange(0, 4));
+
+	consumer.Limit = 10;
+	buffer.Read(consumer, DummyCancellationToken());
+	ASSERT_EQ(consumer.Received, MakeRange(0, 10));
+	ASSERT_EQ(consumer.Batches, std::vector<size_t>({ 10, 6 }));
+}
+
+
+TEST(PacketBufferTest, SinglePacketFallback)
+{
+	TestPacketBuffer buffer(false, 4096);
+	for (int i = 0; i < 10; ++i)
+		PushPacket(buffer, i);
+
+	SingleConsumer consumer(3);
+	buffer.Read(consumer, DummyCancellationToken());
+	ASSERT_EQ(consumer.Received, MakeRange(0, 3));
+	ASSERT_EQ(consumer.Calls, 4u);
+
+	consumer.Limit = 10;
+	buffer.Read(consumer, DummyCancellationToken());
+	ASSERT_EQ(consumer.Received, MakeRange(0, 10));
+}
+
+
+TEST(PacketBufferTest, Wraparound)
+{
+	TestPacketBuffer buffer(false, 100);
+
+	BatchConsumer consumer;
+	int pushed = 0;
+
+	for (size_t round = 0; round < 50; ++round)
+	{
+		while (buffer.GetFreeSize() >= 2 * 32)
+			PushPacket(buffer, pushed++);
+
+		while (buffer.GetDataSize() != 0)
+			buffer.Read(consumer, DummyCancellationToken());
+	}
+
+	ASSERT_EQ(consumer.Received, MakeRange(0, pushed));
+}
+
+
+TEST(PacketBufferTest, DISABLED_SmallPacketsBenchmark)
+{
+	SingleConsumer singleConsumer;
+	const s64 singleMs = MeasureReads(singleConsumer);
+
+	BatchConsumer batchConsumer;
+	batchConsumer.CheckData = false;
+	const s64 batchMs = MeasureReads(batchConsumer);
+
+	Logger::Info() << BenchmarkPackets << " small packets: single reads " << singleMs << " ms, batched reads " << batchMs << " ms";
+}
+
+
+TEST(PacketBufferTest, DISABLED_ThroughputBenchmark)
+{
+	for (size_t packetSize = 16; packetSize <= 1024; packetSize *= 4)
+	{
+		TestPacketBuffer buffer(false, 1024 * 1024);
+		ThroughputConsumer consumer;
+
+		ElapsedTime elapsed;
+		{
+			Thread writer("throughputWriter", Bind(&ProduceThroughputPackets, wrap_ref(buffer), packetSize, _1));
+
+			TimedCancellationToken token(TimeDuration::Minute());
+			while (!consumer.Finished && token)
+				buffer.Read(consumer, token);
+		}
+
+		Logger::Info() << ThroughputPackets << " packets of " << packetSize << " bytes through writer and reader threads: " << elapsed.ElapsedMilliseconds() << " ms";
+	}
+}
@@ -0,0 +1,166 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/PagedBuffer.h>
+
+#include <gtest/gtest.h>
+
+using namespace stingray;
+
+namespace
+{
+
+	const u64 PageSize = 64;
+	const size_t ChunkSize = 16;
+
+	class CountingPagedBuffer : public MemoryPagedBuffer
+	{
+	public:
+		size_t		Created;
+
+	public:
+		explicit CountingPagedBuffer(size_t maxFreePages = 0)
+			: MemoryPagedBuffer("test", PageSize, ChunkSize, maxFreePages), Created(0)
+		{ }
+
+	protected:
+		IPagePtr CreatePage(size_t chunkSize) override
+		{
+			++Created;
+			return MemoryPagedBuffer::CreatePage(chunkSize);
+		}
+	};
+
+
+	ByteArray MakeSequence(size_t size, u8 first = 0)
+	{
+		ByteArray result(size);
+		for (size_t i = 0; i < size; ++i)
+			result[i] = (u8)(first + i);
+		return result;
+	}
+
+
+	BytesOwner MakePage(u8 value)
+	{
+		const BytesOwner result = BytesOwner::Create(PageSize);
+		std::fill(result.begin(), result.end(), value);
+		return result;
+	}
+
+
+	size_t Append(std::vector<u8>& result, ConstByteData data)
+	{
+		std::copy(data.begin(), data.end(), std::back_inserter(result));
+		return data.size();
+	}
+
+}
+
+
+TEST(PagedBufferTest, PushRead)
+{
+	CountingPagedBuffer buffer;
+
+	const ByteArray data = MakeSequence(200);
+	buffer.Push(data, DummyCancellationToken());
+	ASSERT_EQ(buffer.GetStorageSize(), 200u);
+	ASSERT_EQ(buffer.Created, 4u);
+
+	std::vector<u8> result;
+	for (size_t i = 0; i < 3; ++i)
+		buffer.ReadToFunction(Bind(&Append, wrap_ref(result), _1), DummyCancellationToken());
+
+	ASSERT_EQ(result.size(), 192u);
+	ASSERT_TRUE(ConstByteData(result) == ConstByteData(data, 0, 192));
+}
+
+
+TEST(PagedBufferTest, PushPage)
+{
+	CountingPagedBuffer buffer;
+
+	const BytesOwner page = MakePage(1);
+	buffer.PushPage(page, DummyCancellationToken());
+	ASSERT_EQ(buffer.Created, 0u);
+
+	const ConstBytesOwner bytes = buffer.ReadBytes(DummyCancellationToken());
+	ASSERT_EQ(bytes.data(), page.data());
+	ASSERT_EQ(bytes.size(), PageSize);
+
+	buffer.Pop(PageSize);
+	ASSERT_EQ(buffer.GetStorageSize(), 0u);
+	ASSERT_EQ(bytes[PageSize - 1], 1);
+
+	ASSERT_ANY_THROW(buffer.PushPage(BytesOwner::Create(PageSize / 2), DummyCancellationToken()));
+}
+
+
+TEST(PagedBufferTest, PushPageAfterPartialPage)
+{
+	CountingPagedBuffer buffer;
+
+	buffer.Push(MakeSequence(ChunkSize), DummyCancellationToken());
+
+	const BytesOwner page = MakePage(2);
+	buffer.PushPage(page, DummyCancellationToken());
+	ASSERT_EQ(buffer.GetStorageSize(), ChunkSize + PageSize);
+
+	const ConstBytesOwner first = buffer.ReadBytes(DummyCancellationToken());
+	ASSERT_EQ(first.size(), PageSize);
+	ASSERT_NE(first.data(), page.data());
+	ASSERT_EQ(first[0], 0);
+	ASSERT_EQ(first[ChunkSize], 2);
+}
+
+
+TEST(PagedBufferTest, Recycling)
+{
+	CountingPagedBuffer buffer(2);
+
+	for (size_t i = 0; i < 100; ++i)
+	{
+		buffer.Push(MakeSequence(2 * PageSize, (u8)i), DummyCancellationToken());
+
+		std::vector<u8> result;
+		buffer.ReadToFunction(Bind(&Append, wrap_ref(result), _1), DummyCancellationToken());
+		buffer.ReadToFunction(Bind(&Append, wrap_ref(result), _1), DummyCancellationToken());
+		ASSERT_TRUE(ConstByteData(result) == ConstByteData(MakeSequence(2 * PageSize, (u8)i)));
+
+		buffer.Pop(2 * PageSize);
+	}
+
+	ASSERT_EQ(buffer.Created, 2u);
+}
+
+
+TEST(PagedBufferTest, NoRecyclingByDefault)
+{
+	CountingPagedBuffer buffer;
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		buffer.Push(MakeSequence(PageSize, (u8)i), DummyCancellationToken());
+		buffer.Pop(PageSize);
+	}
+
+	ASSERT_EQ(buffer.Created, 3u);
+}
+
+
+TEST(PagedBufferTest, RetainedPageIsNotRecycled)
+{
+	CountingPagedBuffer buffer(2);
+
+	buffer.Push(MakeSequence(PageSize, 1), DummyCancellationToken());
+	const ConstBytesOwner bytes = buffer.ReadBytes(DummyCancellationToken());
+	buffer.Pop(PageSize);
+
+	buffer.Push(MakeSequence(PageSize, 100), DummyCancellationToken());
+	ASSERT_EQ(buffer.Created, 2u);
+	ASSERT_TRUE(ConstByteData(bytes) == ConstByteData(MakeSequence(PageSize, 1)));
+}
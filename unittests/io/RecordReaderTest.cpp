@@ -0,0 +1,280 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/io/RecordReader.h>
+
+#include <stingraykit/io/ByteStreamHelpers.h>
+#include <stingraykit/io/MemoryByteStream.h>
+#include <stingraykit/io/PipeReader.h>
+#include <stingraykit/io/posix/FileByteStream.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/time/ElapsedTime.h>
+
+#include <gtest/gtest.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+using namespace stingray;
+
+namespace
+{
+
+	class ChunkedStream : public virtual IPipe
+	{
+	private:
+		std::string		_data;
+		size_t			_chunkSize;
+		size_t			_offset;
+		bool			_throwAtEnd;
+
+	public:
+		ChunkedStream(const std::string& data, size_t chunkSize, bool throwAtEnd = false)
+			: _data(data), _chunkSize(chunkSize), _offset(0), _throwAtEnd(throwAtEnd)
+		{ }
+
+		u64 Read(ByteData data, const ICancellationToken&) override
+		{
+			STINGRAYKIT_CHECK(!_throwAtEnd || _offset != _data.size(), PipeClosedException());
+
+			const size_t count = std::min(std::min(data.size(), _chunkSize), _data.size() - _offset);
+			std::copy(_data.data() + _offset, _data.data() + _offset + count, data.data());
+			_offset += count;
+			return count;
+		}
+
+		u64 Write(ConstByteData, const ICancellationToken&) override
+		{ STINGRAYKIT_THROW(NotSupportedException()); }
+
+		bool Peek(const ICancellationToken&) override
+		{ return _offset != _data.size(); }
+	};
+
+
+	std::vector<std::string> ReadRecords(const std::string& data, string_view delimiter, size_t chunkSize, size_t bufferSize)
+	{
+		RecordReader reader(make_shared_ptr<ChunkedStream>(data, chunkSize), bufferSize);
+
+		std::vector<std::string> result;
+		for (optional<string_view> record = reader.ReadRecord(delimiter); record; record = reader.ReadRecord(delimiter))
+			result.push_back(record->copy());
+		return result;
+	}
+
+
+	/// @brief Stream over data which can not be read again, like pipe exposed as IByteStream
+	class NonSeekableStream : public virtual IByteStream
+	{
+	private:
+		std::string		_data;
+		size_t			_offset;
+
+	public:
+		explicit NonSeekableStream(const std::string& data)
+			: _data(data), _offset(0)
+		{ }
+
+		u64 Read(ByteData data, const ICancellationToken&) override
+		{
+			const size_t count = std::min(data.size(), _data.size() - _offset);
+			std::copy(_data.data() + _offset, _data.data() + _offset + count, data.data());
+			_offset += count;
+			return count;
+		}
+
+		u64 Write(ConstByteData, const ICancellationToken&) override
+		{ STINGRAYKIT_THROW(NotSupportedException()); }
+
+		void Seek(s64, SeekMode) override
+		{ STINGRAYKIT_THROW(NotSupportedException()); }
+
+		u64 Tell() const override
+		{ return _offset; }
+	};
+
+
+	std::vector<std::string> MakeLines(const std::initializer_list<const char*>& lines)
+	{ return std::vector<std::string>(lines.begin(), lines.end()); }
+
+}
+
+
+TEST(RecordReaderTest, Lines)
+{
+	const std::string data = "first\nsecond\r\n\nlast";
+
+	for (size_t chunkSize = 1; chunkSize < data.size(); ++chunkSize)
+		for (size_t bufferSize = 1; bufferSize < 8; ++bufferSize)
+		{
+			RecordReader reader(make_shared_ptr<ChunkedStream>(data, chunkSize), bufferSize);
+
+			std::vector<std::string> lines;
+			for (optional<string_view> line = reader.ReadLine(); line; line = reader.ReadLine())
+				lines.push_back(line->copy());
+
+			ASSERT_EQ(lines, MakeLines({ "first", "second", "", "last" }));
+		}
+}
+
+
+TEST(RecordReaderTest, MultiByteDelimiter)
+{
+	const std::string data = "header: 1\r\n\r\nbody\r\n\r\n\r\n\r\ntail\r\n\r";
+
+	for (size_t chunkSize = 1; chunkSize < data.size(); ++chunkSize)
+		for (size_t bufferSize = 1; bufferSize < 8; ++bufferSize)
+			ASSERT_EQ(ReadRecords(data, "\r\n\r\n", chunkSize, bufferSize), MakeLines({ "header: 1", "body", "", "tail\r\n\r" }));
+
+	ASSERT_EQ(ReadRecords("aab", "ab", 1, 1), MakeLines({ "a" }));
+	ASSERT_EQ(ReadRecords("", "ab", 1, 1), MakeLines({ }));
+	ASSERT_ANY_THROW(ReadRecords("a", "", 1, 1));
+}
+
+
+TEST(RecordReaderTest, Read)
+{
+	RecordReader reader(make_shared_ptr<ChunkedStream>("line\nraw data", 100));
+	ASSERT_EQ(reader.ReadLine(), string_view("line"));
+
+	u8 buffer[3];
+	ASSERT_EQ(reader.Read(ByteData(buffer, sizeof(buffer))), 3u);
+	ASSERT_EQ(string_view(reinterpret_cast<const char*>(buffer), 3), "raw");
+
+	const ConstByteData rest = reader.ReadBuffered();
+	ASSERT_EQ(string_view(reinterpret_cast<const char*>(rest.data()), rest.size()), " data");
+	ASSERT_EQ(reader.Read(ByteData(buffer, sizeof(buffer))), 0u);
+	ASSERT_FALSE(reader.ReadLine());
+}
+
+
+TEST(RecordReaderTest, PipeReader)
+{
+	PipeReader reader(make_shared_ptr<ChunkedStream>("first\r\nsecond\nx", 3, true));
+
+	ASSERT_EQ(reader.ReadLine(DummyCancellationToken()), "first");
+	ASSERT_EQ(reader.ReadByte(DummyCancellationToken()), 's');
+	ASSERT_EQ(reader.ReadLine(DummyCancellationToken()), "econd");
+	ASSERT_EQ(reader.ReadLine(DummyCancellationToken()), "x");
+	ASSERT_THROW(reader.ReadLine(DummyCancellationToken()), PipeClosedException);
+
+	PipeReader unsupported(make_shared_ptr<ChunkedStream>("a\rb\n", 3, true));
+	ASSERT_THROW(unsupported.ReadLine(DummyCancellationToken()), NotSupportedException);
+}
+
+
+TEST(RecordReaderTest, ByteStreamHelpersReadLine)
+{
+	std::string data = "first\nsecond\r\nthird\rfourth\r\r\n";
+	data += std::string(1000, 'x');
+	data += "\r";
+
+	ConstByteArrayByteStream stream(ConstByteArray(data.begin(), data.end()));
+
+	ASSERT_EQ(ReadLine(stream), std::string("first"));
+	ASSERT_EQ(ReadLine(stream), std::string("second"));
+	ASSERT_EQ(ReadLine(stream), std::string("third"));
+	ASSERT_EQ(ReadLine(stream), std::string("fourth"));
+	ASSERT_EQ(ReadLine(stream), std::string(""));
+	ASSERT_EQ(ReadLine(stream), std::string(1000, 'x'));
+	ASSERT_EQ(stream.Tell(), data.size());
+	ASSERT_FALSE(ReadLine(stream));
+}
+
+
+TEST(RecordReaderTest, ByteStreamHelpersReadLineNonSeekable)
+{
+	NonSeekableStream stream("first\nsecond\r\nthird");
+
+	ASSERT_EQ(ReadLine(stream), std::string("first"));
+
+	u8 byte = 0;
+	ASSERT_EQ(stream.Read(ByteData(&byte, sizeof(byte)), DummyCancellationToken()), 1u);
+	ASSERT_EQ(byte, 's');
+
+	ASSERT_EQ(ReadLine(stream), std::string("econd"));
+	ASSERT_EQ(ReadLine(stream), std::string("third"));
+	ASSERT_FALSE(ReadLine(stream));
+}
+
+
+TEST(RecordReaderTest, ByteStreamHelpersReadLineFromFile)
+{
+	char path[] = "/tmp/stingraykit-lines-XXXXXX";
+	const int fd = ::mkstemp(path);
+	ASSERT_GE(fd, 0);
+	::close(fd);
+
+	// \r\n is split by the end of the first block read
+	const std::string data = std::string(255, 'a') + "\r\nb\rc\n\nd";
+	{
+		FileByteStream file(path, FileByteStream::Config().EnableTruncate());
+		WriteAll(file, ConstByteData(reinterpret_cast<const u8*>(data.data()), data.size()));
+	}
+
+	FileByteStream file(path);
+	const optional<std::string> first = ReadLine(file);
+	ASSERT_EQ(file.Tell(), 257u);
+	ASSERT_EQ(ReadLine(file), std::string("b"));
+	ASSERT_EQ(ReadLine(file), std::string("c"));
+	ASSERT_EQ(ReadLine(file), std::string(""));
+	ASSERT_EQ(ReadLine(file), std::string("d"));
+	ASSERT_EQ(file.Tell(), data.size());
+	ASSERT_FALSE(ReadLine(file));
+
+	::unlink(path);
+
+	ASSERT_EQ(first, std::string(255, 'a'));
+}
+
+
+TEST(RecordReaderTest, DISABLED_OneGigabyteFileBenchmark)
+{
+	const size_t MinFileSize = 1024 * 1024 * 1024;
+
+	char path[] = "/tmp/stingraykit-lines-XXXXXX";
+	const int fd = ::mkstemp(path);
+	ASSERT_GE(fd, 0);
+	::close(fd);
+
+	size_t expectedLines = 0;
+	size_t fileSize = 0;
+	{
+		std::string block;
+		while (block.size() < 1024 * 1024)
+		{
+			block += std::string(expectedLines % 120, 'a' + expectedLines % 26);
+			block += "\n";
+			++expectedLines;
+		}
+
+		FileByteStream file(path, FileByteStream::Config().EnableTruncate());
+		size_t blocks = 0;
+		for (; fileSize < MinFileSize; fileSize += block.size(), ++blocks)
+			WriteAll(file, ConstByteData(reinterpret_cast<const u8*>(block.data()), block.size()));
+
+		expectedLines *= blocks;
+	}
+
+	size_t lines = 0;
+	size_t bytes = 0;
+	ElapsedTime elapsed;
+	{
+		RecordReader reader(make_shared_ptr<FileByteStream>(path, FileByteStream::Config().AccessHint(FileAccessHint::Sequential)));
+		for (optional<string_view> line = reader.ReadLine(); line; line = reader.ReadLine())
+		{
+			++lines;
+			bytes += line->size() + 1;
+		}
+	}
+	const s64 elapsedMs = elapsed.ElapsedMilliseconds();
+
+	::unlink(path);
+
+	ASSERT_EQ(lines, expectedLines);
+	ASSERT_EQ(bytes, fileSize);
+	Logger::Info() << "RecordReader read " << lines << " lines (" << bytes / (1024 * 1024) << " MiB) in " << elapsedMs << " ms";
+}
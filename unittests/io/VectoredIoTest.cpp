@@ -0,0 +1,234 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <stingraykit/io/AsyncByteStream.h>
+#include <stingraykit/io/BithreadCircularBuffer.h>
+#include <stingraykit/io/BufferedPipe.h>
+#include <stingraykit/io/DataBuffer.h>
+#include <stingraykit/io/IDataSource.h>
+#include <stingraykit/io/MemoryByteStream.h>
+#include <stingraykit/io/MemoryCircularBuffer.h>
+#include <stingraykit/thread/TimedCancellationToken.h>
+
+#include <gtest/gtest.h>
+
+using namespace stingray;
+
+namespace
+{
+
+	class CountingPipe : public virtual IPipe
+	{
+	private:
+		ByteArrayByteStream		_stream;
+
+	public:
+		size_t					Reads = 0;
+		size_t					Writes = 0;
+
+	public:
+		explicit CountingPipe(const ByteArray& data) : _stream(data)
+		{ }
+
+		ByteArray GetData() const
+		{ return _stream.GetData(); }
+
+		u64 Read(ByteData data, const ICancellationToken& token) override
+		{
+			++Reads;
+			return _stream.Read(data, token);
+		}
+
+		u64 Write(ConstByteData data, const ICancellationToken& token) override
+		{
+			++Writes;
+			return _stream.Write(data, token);
+		}
+
+		bool Peek(const ICancellationToken& token) override
+		{ return _stream.Tell() != _stream.GetData().size(); }
+	};
+
+
+	class CollectingConsumer : public virtual IDataConsumer
+	{
+	private:
+		const size_t		_limit;
+
+	public:
+		std::vector<u8>		Data;
+
+	public:
+		explicit CollectingConsumer(size_t limit = std::numeric_limits<size_t>::max()) : _limit(limit)
+		{ }
+
+		size_t Process(ConstByteData data, const ICancellationToken& token) override
+		{
+			const size_t size = std::min(data.size(), _limit - Data.size());
+			Data.insert(Data.end(), data.data(), data.data() + size);
+			return size;
+		}
+
+		void EndOfData(const ICancellationToken& token) override
+		{ }
+	};
+
+
+	ByteArray MakeSequence(size_t size, u8 first = 0)
+	{
+		ByteArray result(size);
+		for (size_t i = 0; i < size; ++i)
+			result[i] = (u8)(first + i);
+		return result;
+	}
+
+}
+
+
+TEST(VectoredIoTest, MemoryByteStream)
+{
+	const ByteArray header(MakeSequence(3));
+	const ByteArray payload(MakeSequence(5, 3));
+
+	ByteArrayByteStream stream((ByteArray()));
+	ASSERT_EQ(stream.WriteV({ header, ConstByteData(), payload }, DummyCancellationToken()), 8u);
+	ASSERT_EQ(stream.GetData(), MakeSequence(8));
+
+	stream.Seek(0);
+
+	ByteArray first(2), second(4), third(4);
+	ASSERT_EQ(stream.ReadV({ first, second, third }, DummyCancellationToken()), 8u);
+	ASSERT_EQ(first, MakeSequence(2));
+	ASSERT_EQ(second, MakeSequence(4, 2));
+	ASSERT_EQ(ByteData(third, 0, 2), ByteData(MakeSequence(2, 6)));
+
+	ConstByteDataByteStream constStream((ConstByteData(header)));
+	ASSERT_ANY_THROW(constStream.WriteV({ payload }, DummyCancellationToken()));
+}
+
+
+TEST(VectoredIoTest, DefaultImplementation)
+{
+	CountingPipe pipe(MakeSequence(6));
+
+	ByteArray first(4), second(4);
+	ASSERT_EQ(pipe.ReadV({ first, second }), 6u);
+	ASSERT_EQ(pipe.Reads, 2u);
+	ASSERT_EQ(first, MakeSequence(4));
+
+	ASSERT_EQ(pipe.WriteV({ MakeSequence(2), MakeSequence(2, 2) }), 4u);
+	ASSERT_EQ(pipe.Writes, 2u);
+	ASSERT_EQ(ConstByteData(pipe.GetData(), 6), ConstByteData(MakeSequence(4)));
+
+	CollectingConsumer consumer(5);
+	ASSERT_EQ(consumer.ProcessV({ MakeSequence(3), MakeSequence(3, 3), MakeSequence(3, 6) }, DummyCancellationToken()), 5u);
+	ASSERT_EQ(consumer.Data, std::vector<u8>({ 0, 1, 2, 3, 4 }));
+}
+
+
+TEST(VectoredIoTest, BufferedPipe)
+{
+	const shared_ptr<CountingPipe> pipe = make_shared_ptr<CountingPipe>(MakeSequence(100));
+	BufferedPipe buffered(pipe, 16);
+
+	ByteArray first(4), second(4);
+	ASSERT_EQ(buffered.ReadV({ first, second }, DummyCancellationToken()), 8u);
+	ASSERT_EQ(pipe->Reads, 1u);
+	ASSERT_EQ(second, MakeSequence(4, 4));
+
+	// Does not block for more data, when buffered data was already returned
+	ByteArray big(20);
+	ASSERT_EQ(buffered.ReadV({ big, first }, DummyCancellationToken()), 8u);
+	ASSERT_EQ(pipe->Reads, 1u);
+	ASSERT_EQ(ByteData(big, 0, 8), ByteData(MakeSequence(8, 8)));
+
+	// Large reads bypass the buffer
+	ASSERT_EQ(buffered.ReadV({ big, first }, DummyCancellationToken()), 24u);
+	ASSERT_EQ(big, MakeSequence(20, 16));
+	ASSERT_EQ(first, MakeSequence(4, 36));
+}
+
+
+TEST(VectoredIoTest, BithreadCircularBuffer)
+{
+	BithreadCircularBuffer buffer(10);
+
+	ASSERT_EQ(buffer.WriteV({ MakeSequence(3), MakeSequence(4, 3) }), 7u);
+
+	ByteArray first(5);
+	ASSERT_EQ(buffer.ReadV({ first }), 5u);
+	ASSERT_EQ(first, MakeSequence(5));
+
+	// Wraps around the end of storage
+	ASSERT_EQ(buffer.WriteV({ MakeSequence(4, 7), MakeSequence(6, 11) }), 8u);
+	ASSERT_EQ(buffer.GetDataSize(), 10u);
+
+	ByteArray second(3), third(20);
+	ASSERT_EQ(buffer.ReadV({ second, third }), 10u);
+	ASSERT_EQ(second, MakeSequence(3, 5));
+	ASSERT_EQ(ByteData(third, 0, 7), ByteData(MakeSequence(7, 8)));
+	ASSERT_EQ(buffer.GetDataSize(), 0u);
+}
+
+
+TEST(VectoredIoTest, MemoryCircularBuffer)
+{
+	{
+		MemoryCircularBuffer<false> buffer(10);
+		buffer.Push(MakeSequence(6));
+		buffer.Pop(6);
+
+		buffer.PushV({ MakeSequence(3), MakeSequence(5, 3) });
+		ASSERT_EQ(buffer.GetSize(), 8u);
+		ASSERT_EQ(*buffer.GetAllData(), std::vector<u8>({ 0, 1, 2, 3, 4, 5, 6, 7 }));
+
+		ASSERT_THROW(buffer.PushV({ MakeSequence(1), MakeSequence(2) }), BufferIsFullException);
+		ASSERT_EQ(buffer.GetSize(), 8u);
+	}
+
+	{
+		MemoryCircularBuffer<true> buffer(4);
+		buffer.Push(MakeSequence(2));
+		buffer.PushV({ MakeSequence(3, 10), MakeSequence(2, 20) });
+		ASSERT_EQ(*buffer.GetAllData(), std::vector<u8>({ 11, 12, 20, 21 }));
+	}
+}
+
+
+TEST(VectoredIoTest, DataBuffer)
+{
+	DataBuffer buffer(false, 8, DataBuffer::Parameters().SetInputPacketSize(2));
+
+	// Regions kept in a plain array are passed without copying the list
+	const ByteArray first(MakeSequence(3)), second(MakeSequence(3, 3)), third(MakeSequence(4, 6));
+	const ConstByteData regions[] = { first, second, third };
+	ASSERT_EQ(buffer.ProcessV(regions, DummyCancellationToken()), 8u);
+	ASSERT_EQ(buffer.GetDataSize(), 8u);
+
+	CollectingConsumer consumer;
+	buffer.Read(consumer, TimedCancellationToken(TimeDuration()));
+	ASSERT_EQ(consumer.Data, std::vector<u8>({ 0, 1, 2, 3, 4, 5, 6, 7 }));
+
+	// Total size, not size of every region, must be a multiple of input packet size
+	ASSERT_EQ(buffer.ProcessV({ MakeSequence(1, 8), MakeSequence(3, 9) }, DummyCancellationToken()), 4u);
+	ASSERT_EQ(buffer.ProcessV({ MakeSequence(1, 12) }, DummyCancellationToken()), 1u);
+	ASSERT_EQ(buffer.GetDataSize(), 4u);
+}
+
+
+TEST(VectoredIoTest, AsyncByteStream)
+{
+	const ByteArrayByteStreamPtr dstStream = make_shared_ptr<ByteArrayByteStream>(ByteArray());
+	const AsyncByteStreamPtr stream = make_shared_ptr<AsyncByteStream>("VectoredStream", dstStream);
+
+	ASSERT_EQ(stream->WriteV({ MakeSequence(3), ConstByteData(), MakeSequence(5, 3) }, DummyCancellationToken()), 8u);
+	ASSERT_EQ(stream->Tell(), 8u);
+	stream->Sync();
+
+	ASSERT_EQ(dstStream->GetData(), MakeSequence(8));
+}
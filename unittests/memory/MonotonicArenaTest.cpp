@@ -0,0 +1,243 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/memory/MonotonicArena.h>
+
+#include <stingraykit/collection/flat_map.h>
+#include <stingraykit/collection/inplace_vector.h>
+#include <stingraykit/collection/ordered_map.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/time/ElapsedTime.h>
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+using namespace stingray;
+
+namespace
+{
+
+	class CountingResource : public virtual IMemoryResource
+	{
+	public:
+		size_t		Allocations = 0;
+		size_t		Deallocations = 0;
+
+	public:
+		void* Allocate(size_t size, size_t alignment) override
+		{
+			++Allocations;
+			return NewDeleteMemoryResource::Instance().Allocate(size, alignment);
+		}
+
+		void Deallocate(void* ptr, size_t size, size_t alignment) override
+		{
+			++Deallocations;
+			NewDeleteMemoryResource::Instance().Deallocate(ptr, size, alignment);
+		}
+	};
+
+
+	template < typename Key, typename Value >
+	using ArenaOrderedMap = ordered_map<Key, Value, std::less<Key>, ArenaAllocator<std::pair<const Key, Value>>>;
+
+	template < typename Key, typename Value >
+	using ArenaStdMap = std::map<Key, Value, std::less<Key>, ArenaAllocator<std::pair<const Key, Value>>>;
+
+
+	const int BenchmarkItems = 100000;
+	const int BenchmarkRounds = 20;
+
+	template < typename MapType >
+	void FillMap(MapType& map)
+	{
+		for (int i = 0; i < BenchmarkItems; ++i)
+			map.emplace((i * 7919) % BenchmarkItems, i);
+	}
+
+}
+
+
+TEST(MonotonicArenaTest, Allocate)
+{
+	MonotonicArena arena(64);
+
+	void* const first = arena.Allocate(1, 1);
+	void* const second = arena.Allocate(8, 8);
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(second) % 8, 0u);
+	ASSERT_LT(first, second);
+
+	void* const big = arena.Allocate(1000, 16);
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(big) % 16, 0u);
+	memset(big, 0xAA, 1000);
+
+	ASSERT_ANY_THROW(arena.Allocate(1, 3));
+}
+
+
+TEST(MonotonicArenaTest, Release)
+{
+	CountingResource upstream;
+
+	{
+		MonotonicArena arena(128, upstream);
+		for (size_t i = 0; i < 100; ++i)
+			arena.Allocate(32, 8);
+
+		const size_t blocks = upstream.Allocations;
+		ASSERT_GT(blocks, 1u);
+		ASSERT_LT(blocks, 10u);
+		ASSERT_GE(arena.GetReservedSize(), 100u * 32);
+
+		arena.Release();
+		ASSERT_EQ(upstream.Deallocations, blocks);
+		ASSERT_EQ(arena.GetReservedSize(), 0u);
+
+		arena.Allocate(32, 8);
+	}
+
+	ASSERT_EQ(upstream.Allocations, upstream.Deallocations);
+}
+
+
+TEST(MonotonicArenaTest, InitialBuffer)
+{
+	CountingResource upstream;
+	u8 buffer[256];
+
+	MonotonicArena arena(buffer, sizeof(buffer), upstream);
+	void* const first = arena.Allocate(100, 4);
+	ASSERT_GE(static_cast<u8*>(first), buffer);
+	ASSERT_LT(static_cast<u8*>(first), buffer + sizeof(buffer));
+	ASSERT_EQ(upstream.Allocations, 0u);
+
+	arena.Allocate(200, 4);
+	ASSERT_EQ(upstream.Allocations, 1u);
+
+	arena.Release();
+	ASSERT_EQ(arena.Allocate(100, 4), first);
+}
+
+
+TEST(MonotonicArenaTest, Containers)
+{
+	CountingResource upstream;
+	MonotonicArena arena(4096, upstream);
+
+	{
+		ArenaOrderedMap<int, std::string> orderedMap(&arena);
+		for (int i = 0; i < 100; ++i)
+			orderedMap.emplace(100 - i, ToString(i));
+
+		ASSERT_EQ(orderedMap.size(), 100u);
+		ASSERT_EQ(orderedMap.begin()->first, 100);
+		ASSERT_EQ(orderedMap.get_allocator().GetResource(), &arena);
+
+		const ArenaOrderedMap<int, std::string> copy(orderedMap);
+		ASSERT_EQ(copy.get_allocator().GetResource(), &arena);
+		ASSERT_EQ(copy.size(), 100u);
+
+		flat_map<int, int, std::less<int>, ArenaAllocator<std::pair<int, int>>> flatMap(&arena);
+		for (int i = 0; i < 100; ++i)
+			flatMap.emplace(i, i);
+		ASSERT_EQ(flatMap.size(), 100u);
+
+		inplace_vector<std::string, 4, ArenaAllocator<std::string>> vec((ArenaAllocator<std::string>(&arena)));
+		for (int i = 0; i < 10; ++i)
+			vec.push_back(ToString(i));
+		ASSERT_EQ(vec.size(), 10u);
+		ASSERT_EQ(vec.back(), "9");
+
+		std::vector<int, ArenaAllocator<int>> stdVec(&arena);
+		stdVec.resize(1000);
+	}
+
+	ASSERT_EQ(upstream.Deallocations, 0u);
+	arena.Release();
+	ASSERT_EQ(upstream.Allocations, upstream.Deallocations);
+}
+
+
+TEST(MonotonicArenaTest, DefaultAllocator)
+{
+	ordered_map<int, int, std::less<int>, ArenaAllocator<std::pair<const int, int>>> map;
+	map.emplace(1, 1);
+	ASSERT_EQ(map.get_allocator().GetResource(), &NewDeleteMemoryResource::Instance());
+}
+
+
+TEST(MonotonicArenaTest, DISABLED_OrderedMapInsertBenchmark)
+{
+	s64 defaultMs = 0;
+	{
+		ElapsedTime elapsed;
+		for (int round = 0; round < BenchmarkRounds; ++round)
+		{
+			ordered_map<int, int> map;
+			FillMap(map);
+		}
+		defaultMs = elapsed.ElapsedMilliseconds();
+	}
+
+	s64 arenaMs = 0;
+	{
+		MonotonicArena arena;
+		ElapsedTime elapsed;
+		for (int round = 0; round < BenchmarkRounds; ++round)
+		{
+			{
+				ArenaOrderedMap<int, int> map(&arena);
+				FillMap(map);
+			}
+			arena.Release();
+		}
+		arenaMs = elapsed.ElapsedMilliseconds();
+	}
+
+	Logger::Info() << "ordered_map, " << BenchmarkRounds << " x " << BenchmarkItems << " inserts: default allocator " << defaultMs << " ms, arena " << arenaMs << " ms";
+}
+
+
+TEST(MonotonicArenaTest, DISABLED_SnapshotCopyBenchmark)
+{
+	// Transactional collections take a copy of their std::map on the first write after a snapshot was taken
+	s64 defaultMs = 0;
+	{
+		std::map<int, int> items;
+		FillMap(items);
+
+		ElapsedTime elapsed;
+		for (int round = 0; round < BenchmarkRounds; ++round)
+		{
+			const std::map<int, int> snapshot(items);
+			items.erase(snapshot.begin()->first);
+		}
+		defaultMs = elapsed.ElapsedMilliseconds();
+	}
+
+	s64 arenaMs = 0;
+	{
+		MonotonicArena itemsArena;
+		ArenaStdMap<int, int> items(&itemsArena);
+		FillMap(items);
+
+		MonotonicArena snapshotArena;
+		ElapsedTime elapsed;
+		for (int round = 0; round < BenchmarkRounds; ++round)
+		{
+			{
+				const ArenaStdMap<int, int> snapshot(items, &snapshotArena);
+				items.erase(snapshot.begin()->first);
+			}
+			snapshotArena.Release();
+		}
+		arenaMs = elapsed.ElapsedMilliseconds();
+	}
+
+	Logger::Info() << "std::map snapshot copy, " << BenchmarkRounds << " x " << BenchmarkItems << " items: default allocator " << defaultMs << " ms, arena " << arenaMs << " ms";
+}
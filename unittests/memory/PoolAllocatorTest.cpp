@@ -0,0 +1,288 @@
+// Copyright (c) 2011 - 2025, GS Group, https://github.com/GSGroup
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <stingraykit/memory/PoolAllocator.h>
+
+#include <stingraykit/function/bind.h>
+#include <stingraykit/log/Logger.h>
+#include <stingraykit/thread/Thread.h>
+#include <stingraykit/time/ElapsedTime.h>
+
+#include <gtest/gtest.h>
+
+using namespace stingray;
+
+namespace
+{
+
+	struct AllocatorStats
+	{
+		size_t		Allocations = 0;
+		size_t		Deallocations = 0;
+	};
+
+
+	template < typename T >
+	class CountingAllocator
+	{
+		template < typename U >
+		friend class CountingAllocator;
+
+	public:
+		using value_type = T;
+
+	private:
+		AllocatorStats*		_stats;
+
+	public:
+		explicit CountingAllocator(AllocatorStats& stats) : _stats(&stats)
+		{ }
+
+		template < typename U >
+		CountingAllocator(const CountingAllocator<U>& other) : _stats(other._stats)
+		{ }
+
+		T* allocate(size_t n)
+		{
+			++_stats->Allocations;
+			return std::allocator<T>().allocate(n);
+		}
+
+		void deallocate(T* ptr, size_t n)
+		{
+			++_stats->Deallocations;
+			std::allocator<T>().deallocate(ptr, n);
+		}
+
+		bool operator == (const CountingAllocator& other) const { return _stats == other._stats; }
+		bool operator != (const CountingAllocator& other) const { return !(*this == other); }
+	};
+
+
+	struct Tracked
+	{
+		int&		Destructions;
+		int			Value;
+
+		Tracked(int& destructions, int value) : Destructions(destructions), Value(value)
+		{ }
+
+		~Tracked()
+		{ ++Destructions; }
+	};
+
+
+	struct Throwing
+	{
+		Throwing()
+		{ throw std::runtime_error("ctor"); }
+	};
+
+
+	void DeallocateAll(const std::vector<void*>& blocks, size_t size)
+	{
+		for (void* block : blocks)
+			SizeClassPool::Deallocate(block, size);
+	}
+
+
+	const size_t ChurnIterations = 1000000;
+	const size_t ChurnThreads = 4;
+	const size_t ChurnWindow = 64;
+
+	template < typename Factory >
+	void Churn(const Factory& factory)
+	{
+		std::vector<shared_ptr<std::pair<u64, u64>>> window(ChurnWindow);
+		for (size_t i = 0; i < ChurnIterations; ++i)
+			window[i % ChurnWindow] = factory(i);
+	}
+
+	shared_ptr<std::pair<u64, u64>> MakeDefault(size_t i)
+	{ return make_shared_ptr<std::pair<u64, u64>>(i, i); }
+
+	shared_ptr<std::pair<u64, u64>> MakePooled(size_t i)
+	{ return allocate_shared_ptr<std::pair<u64, u64>>(PoolAllocator<std::pair<u64, u64>>(), i, i); }
+
+	template < typename Factory >
+	s64 MeasureChurn(const Factory& factory)
+	{
+		ElapsedTime elapsed;
+		{
+			std::vector<ThreadPtr> threads;
+			for (size_t i = 0; i < ChurnThreads; ++i)
+				threads.push_back(make_shared_ptr<Thread>(StringBuilder() % "churn" % i, Bind(&Churn<Factory>, factory)));
+		}
+		return elapsed.ElapsedMilliseconds();
+	}
+
+}
+
+
+TEST(PoolAllocatorTest, SizeClasses)
+{
+	std::vector<void*> blocks;
+	for (size_t size = 1; size <= SizeClassPool::MaxPooledSize + SizeClassPool::Granularity; ++size)
+	{
+		void* const block = SizeClassPool::Allocate(size);
+		ASSERT_TRUE(block);
+		ASSERT_EQ(reinterpret_cast<uintptr_t>(block) % alignof(u64), 0u);
+
+		memset(block, 0xAA, size);
+		blocks.push_back(block);
+	}
+
+	for (size_t size = 1; size <= SizeClassPool::MaxPooledSize + SizeClassPool::Granularity; ++size)
+		SizeClassPool::Deallocate(blocks[size - 1], size);
+}
+
+
+TEST(PoolAllocatorTest, Reuse)
+{
+	void* const first = SizeClassPool::Allocate(24);
+	SizeClassPool::Deallocate(first, 24);
+
+	void* const second = SizeClassPool::Allocate(32);
+	ASSERT_EQ(first, second);
+	SizeClassPool::Deallocate(second, 32);
+}
+
+
+TEST(PoolAllocatorTest, CrossThreadDeallocation)
+{
+	std::vector<void*> blocks;
+	for (size_t i = 0; i < 10000; ++i)
+		blocks.push_back(SizeClassPool::Allocate(48));
+
+	{
+		const Thread thread("poolDealloc", Bind(&DeallocateAll, wrap_const_ref(blocks), 48));
+	}
+
+	for (size_t i = 0; i < 10000; ++i)
+		SizeClassPool::Deallocate(SizeClassPool::Allocate(48), 48);
+}
+
+
+TEST(PoolAllocatorTest, StdContainer)
+{
+	std::vector<int, PoolAllocator<int>> vec;
+	for (int i = 0; i < 1000; ++i)
+		vec.push_back(i);
+
+	ASSERT_EQ(vec.size(), 1000u);
+	for (int i = 0; i < 1000; ++i)
+		ASSERT_EQ(vec[i], i);
+}
+
+
+TEST(PoolAllocatorTest, AllocateSharedPtr)
+{
+	AllocatorStats stats;
+	int destructions = 0;
+
+	{
+		weak_ptr<Tracked> weak;
+		{
+			const shared_ptr<Tracked> ptr = allocate_shared_ptr<Tracked>(CountingAllocator<Tracked>(stats), destructions, 42);
+			ASSERT_EQ(ptr->Value, 42);
+			ASSERT_EQ(stats.Allocations, 1u);
+
+			weak = ptr;
+			const shared_ptr<Tracked> copy = ptr;
+			ASSERT_EQ(ptr.use_count(), 2u);
+		}
+
+		ASSERT_EQ(destructions, 1);
+		ASSERT_TRUE(weak.expired());
+		ASSERT_EQ(stats.Deallocations, 0u);
+	}
+
+	ASSERT_EQ(stats.Deallocations, 1u);
+
+	const shared_ptr<Tracked> pooled = allocate_shared_ptr<Tracked>(PoolAllocator<Tracked>(), destructions, 1);
+	ASSERT_EQ(pooled->Value, 1);
+}
+
+
+TEST(PoolAllocatorTest, AllocateSharedPtrThrowing)
+{
+	AllocatorStats stats;
+
+	ASSERT_ANY_THROW(allocate_shared_ptr<Throwing>(CountingAllocator<Throwing>(stats)));
+	ASSERT_EQ(stats.Allocations, 1u);
+	ASSERT_EQ(stats.Deallocations, 1u);
+}
+
+
+TEST(PoolAllocatorTest, DeleterWithAllocator)
+{
+	AllocatorStats stats;
+	int destructions = 0;
+	bool deleterCalled = false;
+
+	{
+		const shared_ptr<Tracked> ptr(new Tracked(destructions, 0), [&deleterCalled](Tracked* tracked) { deleterCalled = true; delete tracked; }, CountingAllocator<int>(stats));
+		ASSERT_EQ(stats.Allocations, 1u);
+	}
+
+	ASSERT_TRUE(deleterCalled);
+	ASSERT_EQ(destructions, 1);
+	ASSERT_EQ(stats.Deallocations, 1u);
+}
+
+
+TEST(PoolAllocatorTest, ByteBufferPoolCapacity)
+{
+	ASSERT_EQ(ByteBufferPool::GetCapacity(0), SizeClassPool::Granularity);
+	ASSERT_EQ(ByteBufferPool::GetCapacity(17), 32u);
+	ASSERT_EQ(ByteBufferPool::GetCapacity(SizeClassPool::MaxPooledSize), SizeClassPool::MaxPooledSize);
+	ASSERT_EQ(ByteBufferPool::GetCapacity(SizeClassPool::MaxPooledSize + 1), 2 * SizeClassPool::MaxPooledSize);
+	ASSERT_EQ(ByteBufferPool::GetCapacity(1500), 2048u);
+	ASSERT_EQ(ByteBufferPool::GetCapacity(ByteBufferPool::MaxPooledSize), ByteBufferPool::MaxPooledSize);
+	ASSERT_EQ(ByteBufferPool::GetCapacity(ByteBufferPool::MaxPooledSize + 1), ByteBufferPool::MaxPooledSize + 1);
+
+	for (size_t size = 1; size <= 2 * ByteBufferPool::MaxPooledSize; size = size * 3 / 2 + 1)
+	{
+		const size_t capacity = ByteBufferPool::GetCapacity(size);
+		ASSERT_GE(capacity, size);
+
+		void* const buffer = ByteBufferPool::Allocate(size);
+		ASSERT_EQ(reinterpret_cast<uintptr_t>(buffer) % alignof(u64), 0u);
+
+		memset(buffer, 0xAA, capacity);
+		ByteBufferPool::Deallocate(buffer, capacity);
+	}
+}
+
+
+TEST(PoolAllocatorTest, ByteBufferPoolReuse)
+{
+	const size_t capacity = ByteBufferPool::GetCapacity(1500);
+
+	void* const first = ByteBufferPool::Allocate(1500);
+	ByteBufferPool::Deallocate(first, capacity);
+
+	void* const second = ByteBufferPool::Allocate(2000);
+	ASSERT_EQ(first, second);
+	ByteBufferPool::Deallocate(second, capacity);
+
+	std::vector<void*> buffers;
+	for (size_t i = 0; i < 2 * ByteBufferPool::MaxCachedBytes / capacity; ++i)
+		buffers.push_back(ByteBufferPool::Allocate(capacity));
+
+	for (void* buffer : buffers)
+		ByteBufferPool::Deallocate(buffer, capacity);
+}
+
+
+TEST(PoolAllocatorTest, DISABLED_SharedPtrChurnBenchmark)
+{
+	const s64 defaultMs = MeasureChurn(&MakeDefault);
+	const s64 pooledMs = MeasureChurn(&MakePooled);
+
+	Logger::Info() << "shared_ptr churn, " << ChurnThreads << " threads x " << ChurnIterations << " iterations: make_shared_ptr " << defaultMs << " ms, allocate_shared_ptr with PoolAllocator " << pooledMs << " ms";
+}